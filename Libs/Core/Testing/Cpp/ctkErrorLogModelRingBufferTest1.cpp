@@ -0,0 +1,161 @@
+/*=========================================================================
+
+  Library:   CTK
+
+  Copyright (c) Kitware Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=========================================================================*/
+// Qt includes
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QTime>
+
+// CTK includes
+#include "ctkErrorLogModel.h"
+#include "ctkModelTester.h"
+
+// STL includes
+#include <cstdlib>
+#include <iostream>
+
+// Helper functions
+#include "Testing/Cpp/ctkErrorLogModelTestHelper.cpp"
+
+//-----------------------------------------------------------------------------
+int ctkErrorLogModelRingBufferTest1(int argc, char * argv [])
+{
+  QCoreApplication app(argc, argv);
+  Q_UNUSED(app);
+  ctkErrorLogModel model;
+  ctkModelTester modelTester;
+  modelTester.setVerbose(false);
+  QString errorMsg;
+
+  try
+    {
+    modelTester.setModel(&model);
+
+    // --------------------------------------------------------------------------
+    // Bounded number of entries
+    model.setMaximumEntryCount(100);
+    QDateTime dateTime = QDateTime::currentDateTime();
+    for (int i = 0; i < 250; ++i)
+      {
+      model.addEntry(dateTime, "0x1",
+                     i % 2 ? ctkErrorLogLevel::Warning : ctkErrorLogLevel::Info,
+                     "origin", QString("message %1").arg(i));
+      }
+    if (model.rowCount() > 100 || model.rowCount() < 90)
+      {
+      errorMsg = QString("Line %1 - Expected at most 100 rows - Current rowCount: %2\n");
+      printErrorMessage(errorMsg.arg(__LINE__).arg(model.rowCount()));
+      return EXIT_FAILURE;
+      }
+    QString lastMessage =
+        model.index(model.rowCount() - 1, ctkErrorLogModel::DescriptionColumn)
+        .data(ctkErrorLogModel::DescriptionTextRole).toString();
+    if (lastMessage != "message 249")
+      {
+      errorMsg = QString("Line %1 - Expected last message: [message 249] - Current: [%2]\n");
+      printErrorMessage(errorMsg.arg(__LINE__).arg(lastMessage));
+      return EXIT_FAILURE;
+      }
+
+    // --------------------------------------------------------------------------
+    // Filter by level
+    int rowCount = model.rowCount();
+    model.filterEntry(ctkErrorLogLevel::Warning);
+    errorMsg = checkRowCount(__LINE__, model.rowCount(), /* expected = */ rowCount / 2);
+    if (!errorMsg.isEmpty())
+      {
+      printErrorMessage(errorMsg);
+      return EXIT_FAILURE;
+      }
+    model.filterEntry(ctkErrorLogLevel::Warning, /* disableFilter= */ true);
+    errorMsg = checkRowCount(__LINE__, model.rowCount(), /* expected = */ 0);
+    if (!errorMsg.isEmpty())
+      {
+      printErrorMessage(errorMsg);
+      return EXIT_FAILURE;
+      }
+    model.filterEntry(ctkErrorLogLevel::Info | ctkErrorLogLevel::Warning);
+    errorMsg = checkRowCount(__LINE__, model.rowCount(), /* expected = */ rowCount);
+    if (!errorMsg.isEmpty())
+      {
+      printErrorMessage(errorMsg);
+      return EXIT_FAILURE;
+      }
+
+    // --------------------------------------------------------------------------
+    // File sink
+    model.clear();
+    QString filePath = QDir::tempPath() + "/ctkErrorLogModelRingBufferTest1.log";
+    QFile::remove(filePath);
+    model.setFilePath(filePath);
+    for (int i = 0; i < 10; ++i)
+      {
+      model.addEntry(dateTime, "0x1", ctkErrorLogLevel::Info, "origin",
+                     QString("message %1").arg(i));
+      }
+    model.setFilePath(QString());
+    QFile file(filePath);
+    file.open(QFile::ReadOnly);
+    int lineCount = QString(file.readAll()).split("\n", QString::SkipEmptyParts).count();
+    file.close();
+    QFile::remove(filePath);
+    errorMsg = checkInteger(__LINE__, "LineCount", lineCount, 10);
+    if (!errorMsg.isEmpty())
+      {
+      printErrorMessage(errorMsg);
+      return EXIT_FAILURE;
+      }
+    }
+  catch (const char* error)
+    {
+    std::cerr << error << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // --------------------------------------------------------------------------
+  // Sustained message rate, without model tester
+  ctkErrorLogModel benchmarkModel;
+  benchmarkModel.setMaximumEntryCount(20000);
+  benchmarkModel.filterEntry(ctkErrorLogLevel::Warning | ctkErrorLogLevel::Error);
+  const int messageCount = 100000;
+  QStringList origins;
+  origins << "vtkImageReader" << "itkImageFileReader" << "vtkRenderer" << "Python";
+  QTime time;
+  time.start();
+  for (int i = 0; i < messageCount; ++i)
+    {
+    benchmarkModel.addEntry(QDateTime::currentDateTime(), QString::number(i % 3),
+                            i % 5 ? ctkErrorLogLevel::Info : ctkErrorLogLevel::Warning,
+                            origins.at(i % origins.count()), "Pipeline message");
+    }
+  int elapsed = qMax(1, time.elapsed());
+  std::cout << "ctkErrorLogModel: " << messageCount * 1000.0 / elapsed
+            << " messages/s" << std::endl;
+
+  if (benchmarkModel.rowCount() == 0 || benchmarkModel.rowCount() > 20000)
+    {
+    errorMsg = QString("Line %1 - Unexpected rowCount: %2\n");
+    printErrorMessage(errorMsg.arg(__LINE__).arg(benchmarkModel.rowCount()));
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
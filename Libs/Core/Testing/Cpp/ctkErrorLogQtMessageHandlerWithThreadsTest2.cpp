@@ -0,0 +1,130 @@
+/*=========================================================================
+
+  Library:   CTK
+
+  Copyright (c) Kitware Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=========================================================================*/
+
+// Qt includes
+#include <QCoreApplication>
+#include <QDebug>
+#include <QSignalSpy>
+
+// CTK includes
+#include "ctkErrorLogQtMessageHandler.h"
+
+// STL includes
+#include <cstdlib>
+#include <iostream>
+
+// Helper functions
+#include "Testing/Cpp/ctkErrorLogModelTestHelper.cpp"
+
+namespace
+{
+//-----------------------------------------------------------------------------
+class LogQtMessageThread : public LogMessageThread
+{
+public:
+  LogQtMessageThread(int id, int maxIteration) : LogMessageThread(id, maxIteration){}
+
+  virtual void logMessage(const QDateTime& dateTime, int threadId, int counterIdx)
+  {
+    QString msg = QString("counterIdx:%1 - %2 - Message from thread: %3\n")
+        .arg(counterIdx).arg(dateTime.toString()).arg(threadId);
+
+    qWarning().nospace() << qPrintable(msg);
+  }
+};
+
+}
+
+//-----------------------------------------------------------------------------
+int ctkErrorLogQtMessageHandlerWithThreadsTest2(int argc, char * argv [])
+{
+  QCoreApplication app(argc, argv);
+  Q_UNUSED(app);
+
+  ctkErrorLogModel model;
+  QSignalSpy rowsInsertedSpy(model.sourceModel(), SIGNAL(rowsInserted(QModelIndex,int,int)));
+
+  // --------------------------------------------------------------------------
+  // Monitor Qt messages, logged synchronously from the thread of the model
+
+  model.registerMsgHandler(new ctkErrorLogQtMessageHandler);
+  model.setMsgHandlerEnabled(ctkErrorLogQtMessageHandler::HandlerName, true);
+  model.setAsynchronousLogging(false);
+
+  int threadCount = 15;
+  int maxIteration = 20;
+  startLogMessageThreads<LogQtMessageThread>(threadCount, maxIteration);
+
+  // The event loop of the model is not running, threads waiting on it
+  // would never finish.
+  foreach(const QSharedPointer<LogMessageThread>& thread, ThreadList)
+    {
+    if (!thread->wait(5000))
+      {
+      model.disableAllMsgHandler();
+      std::cerr << "Line " << __LINE__ << " - Problem with ctkErrorLogModel: "
+                << "logging threads are blocked." << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  QString errorMsg = checkRowCount(__LINE__, model.rowCount(), /* expected = */ 0);
+  if (!errorMsg.isEmpty())
+    {
+    model.disableAllMsgHandler();
+    printErrorMessage(errorMsg);
+    return EXIT_FAILURE;
+    }
+
+  // The whole burst is inserted at once
+  processEvents(500);
+
+  int expectedMessageCount = threadCount * maxIteration;
+  errorMsg = checkRowCount(__LINE__, model.rowCount(), /* expected = */ expectedMessageCount);
+  if (errorMsg.isEmpty())
+    {
+    errorMsg = checkInteger(__LINE__, "rowsInserted", rowsInsertedSpy.count(), /* expected = */ 1);
+    }
+  if (!errorMsg.isEmpty())
+    {
+    model.disableAllMsgHandler();
+    printErrorMessage(errorMsg);
+    printTextMessages(model);
+    return EXIT_FAILURE;
+    }
+
+  // A message from the thread of the model is added at once
+  qWarning() << "Message from the thread of the model";
+  errorMsg = checkRowCount(__LINE__, model.rowCount(), /* expected = */ expectedMessageCount + 1);
+  if (errorMsg.isEmpty())
+    {
+    errorMsg = checkInteger(__LINE__, "rowsInserted", rowsInsertedSpy.count(), /* expected = */ 2);
+    }
+  if (!errorMsg.isEmpty())
+    {
+    model.disableAllMsgHandler();
+    printErrorMessage(errorMsg);
+    printTextMessages(model);
+    return EXIT_FAILURE;
+    }
+
+  model.disableAllMsgHandler();
+  return EXIT_SUCCESS;
+}
@@ -20,6 +20,7 @@
 
 // Qt includes
 #include <QApplication>
+#include <QAtomicPointer>
 #include <QDateTime>
 #include <QDebug>
 #include <QFile>
@@ -28,14 +29,17 @@
 #include <QMetaType>
 #include <QMutexLocker>
 #include <QPointer>
-#include <QStandardItem>
 #include <QStatusBar>
+#include <QTextStream>
+#include <QThread>
+#include <QTimer>
 
 // CTK includes
 #include "ctkErrorLogModel.h"
 #include <ctkPimpl.h>
 
 // STD includes
+#include <algorithm>
 #include <cstdio> // For _fileno or fileno
 #ifdef _MSC_VER
 # include <io.h> // For _write()
@@ -170,6 +174,373 @@ void ctkErrorLogTerminalOutput::output(const QString& text)
   }
 }
 
+// --------------------------------------------------------------------------
+// ctkErrorLogModelEntry
+
+// --------------------------------------------------------------------------
+struct ctkErrorLogModelEntry
+{
+  QDateTime DateTime;
+  QString ThreadId;
+  ctkErrorLogLevel::LogLevel LogLevel;
+  QString Origin;
+  QString Text;
+  /// Next entry in the queue of pending entries
+  ctkErrorLogModelEntry* Next;
+};
+
+// --------------------------------------------------------------------------
+// ctkErrorLogEntryModel
+
+// --------------------------------------------------------------------------
+/// Table of the log entries stored column by column in a ring buffer.
+/// When the buffer is full, the oldest tenth of the entries is removed at
+/// once so that the proxy model doesn't remap its rows for every entry.
+class ctkErrorLogEntryModel : public QAbstractTableModel
+{
+public:
+  typedef QAbstractTableModel Superclass;
+  ctkErrorLogEntryModel(QObject* parentObject = 0);
+
+  virtual int rowCount(const QModelIndex& parent = QModelIndex())const;
+  virtual int columnCount(const QModelIndex& parent = QModelIndex())const;
+  virtual QVariant data(const QModelIndex& index, int role = Qt::DisplayRole)const;
+  virtual Qt::ItemFlags flags(const QModelIndex& index)const;
+
+  /// Append the entries, inserting all the rows at once. If \a grouping is
+  /// true and an entry has the same thread, level and origin than the
+  /// previous entry within a second, its text is appended to the
+  /// description of the previous entry instead.
+  void addEntries(const QVector<ctkErrorLogModelEntry*>& entries, bool grouping);
+
+  ctkErrorLogLevel::LogLevel logLevel(int row)const;
+
+  void clear();
+
+  int maximumEntryCount()const;
+  void setMaximumEntryCount(int count);
+
+protected:
+  int bufferIndex(int row)const;
+  int internString(const QString& value);
+  void removeOldestEntries(int count);
+
+  // Columns
+  QVector<qint64>  Times; // In msecs since epoch
+  QVector<int>     ThreadIds;
+  QVector<int>     LogLevels;
+  QVector<int>     Origins;
+  QVector<QString> Descriptions;
+  /// Size of the first text of the description, the description of
+  /// grouped entries is longer.
+  QVector<int>     FirstTextSizes;
+
+  /// Thread ids and origins are stored once
+  QHash<QString, int> StringIds;
+  QVector<QString>    Strings;
+
+  /// Buffer index of the oldest entry
+  int First;
+  int Count;
+  int MaximumEntryCount;
+
+  ctkErrorLogLevel ErrorLogLevel;
+};
+
+// --------------------------------------------------------------------------
+ctkErrorLogEntryModel::ctkErrorLogEntryModel(QObject* parentObject)
+  : Superclass(parentObject)
+  , First(0)
+  , Count(0)
+  , MaximumEntryCount(100000)
+{
+}
+
+// --------------------------------------------------------------------------
+int ctkErrorLogEntryModel::rowCount(const QModelIndex& parent)const
+{
+  return parent.isValid() ? 0 : this->Count;
+}
+
+// --------------------------------------------------------------------------
+int ctkErrorLogEntryModel::columnCount(const QModelIndex& parent)const
+{
+  return parent.isValid() ? 0 : ctkErrorLogModel::DescriptionColumn + 1;
+}
+
+// --------------------------------------------------------------------------
+QVariant ctkErrorLogEntryModel::data(const QModelIndex& index, int role)const
+{
+  if (!index.isValid() || index.row() >= this->Count)
+    {
+    return QVariant();
+    }
+  int entry = this->bufferIndex(index.row());
+  if (role == ctkErrorLogModel::DescriptionTextRole
+      && index.column() == ctkErrorLogModel::DescriptionColumn)
+    {
+    return this->Descriptions.at(entry);
+    }
+  if (role != Qt::DisplayRole && role != Qt::EditRole)
+    {
+    return QVariant();
+    }
+  switch(index.column())
+    {
+    case ctkErrorLogModel::TimeColumn:
+      {
+      qint64 msecs = this->Times.at(entry);
+      return QDateTime::fromTime_t(static_cast<uint>(msecs / 1000)).addMSecs(msecs % 1000)
+          .toString("dd.MM.yyyy hh:mm:ss");
+      }
+    case ctkErrorLogModel::ThreadIdColumn:
+      return this->Strings.at(this->ThreadIds.at(entry));
+    case ctkErrorLogModel::LogLevelColumn:
+      return this->ErrorLogLevel.logLevelAsString(
+            static_cast<ctkErrorLogLevel::LogLevel>(this->LogLevels.at(entry)));
+    case ctkErrorLogModel::OriginColumn:
+      return this->Strings.at(this->Origins.at(entry));
+    case ctkErrorLogModel::DescriptionColumn:
+      {
+      const QString& description = this->Descriptions.at(entry);
+      int firstTextSize = this->FirstTextSizes.at(entry);
+      QString displayText = description.left(qMin(firstTextSize, 160));
+      if (firstTextSize > 160 || description.size() > firstTextSize)
+        {
+        displayText.append("...");
+        }
+      return displayText;
+      }
+    default:
+      break;
+    }
+  return QVariant();
+}
+
+// --------------------------------------------------------------------------
+Qt::ItemFlags ctkErrorLogEntryModel::flags(const QModelIndex& index)const
+{
+  if (!index.isValid())
+    {
+    return Qt::NoItemFlags;
+    }
+  return Qt::ItemIsSelectable | Qt::ItemIsEnabled;
+}
+
+// --------------------------------------------------------------------------
+int ctkErrorLogEntryModel::bufferIndex(int row)const
+{
+  return (this->First + row) % this->MaximumEntryCount;
+}
+
+// --------------------------------------------------------------------------
+int ctkErrorLogEntryModel::internString(const QString& value)
+{
+  QHash<QString, int>::const_iterator it = this->StringIds.constFind(value);
+  if (it != this->StringIds.constEnd())
+    {
+    return it.value();
+    }
+  int id = this->Strings.size();
+  this->Strings.append(value);
+  this->StringIds.insert(value, id);
+  return id;
+}
+
+// --------------------------------------------------------------------------
+void ctkErrorLogEntryModel::removeOldestEntries(int count)
+{
+  count = qMin(count, this->Count);
+  if (count <= 0)
+    {
+    return;
+    }
+  this->beginRemoveRows(QModelIndex(), 0, count - 1);
+  for (int row = 0; row < count; ++row)
+    {
+    // Release the text of the removed entries
+    this->Descriptions[this->bufferIndex(row)] = QString();
+    }
+  this->First = this->bufferIndex(count);
+  this->Count -= count;
+  this->endRemoveRows();
+}
+
+// --------------------------------------------------------------------------
+void ctkErrorLogEntryModel::addEntries(const QVector<ctkErrorLogModelEntry*>& entries,
+                                       bool grouping)
+{
+  // New rows, in the same layout than the buffer
+  QVector<qint64> times;
+  QVector<int> threadIds;
+  QVector<int> logLevels;
+  QVector<int> origins;
+  QVector<QString> descriptions;
+  QVector<int> firstTextSizes;
+  times.reserve(entries.size());
+  bool lastRowChanged = false;
+
+  int groupingIntervalInMsecs = 1000;
+  foreach(const ctkErrorLogModelEntry* entry, entries)
+    {
+    qint64 msecs = static_cast<qint64>(entry->DateTime.toTime_t()) * 1000
+        + entry->DateTime.time().msec();
+    int threadIdId = this->internString(entry->ThreadId);
+    int originId = this->internString(entry->Origin);
+
+    if (grouping && !times.isEmpty())
+      {
+      int last = times.size() - 1;
+      if (threadIds.at(last) == threadIdId
+          && logLevels.at(last) == entry->LogLevel
+          && origins.at(last) == originId
+          && msecs - times.at(last) <= groupingIntervalInMsecs)
+        {
+        descriptions[last].append("\n").append(entry->Text);
+        continue;
+        }
+      }
+    else if (grouping && this->Count > 0)
+      {
+      int last = this->bufferIndex(this->Count - 1);
+      if (this->ThreadIds.at(last) == threadIdId
+          && this->LogLevels.at(last) == entry->LogLevel
+          && this->Origins.at(last) == originId
+          && msecs - this->Times.at(last) <= groupingIntervalInMsecs)
+        {
+        this->Descriptions[last].append("\n").append(entry->Text);
+        lastRowChanged = true;
+        continue;
+        }
+      }
+
+    times.append(msecs);
+    threadIds.append(threadIdId);
+    logLevels.append(entry->LogLevel);
+    origins.append(originId);
+    descriptions.append(entry->Text);
+    firstTextSizes.append(entry->Text.size());
+    }
+
+  if (lastRowChanged)
+    {
+    QModelIndex descriptionIndex =
+        this->index(this->Count - 1, ctkErrorLogModel::DescriptionColumn);
+    emit this->dataChanged(descriptionIndex, descriptionIndex);
+    }
+
+  int first = qMax(0, times.size() - this->MaximumEntryCount);
+  int count = times.size() - first;
+  if (count == 0)
+    {
+    return;
+    }
+  if (this->Count + count > this->MaximumEntryCount)
+    {
+    this->removeOldestEntries(qMax(this->MaximumEntryCount / 10,
+                                   this->Count + count - this->MaximumEntryCount));
+    }
+
+  this->beginInsertRows(QModelIndex(), this->Count, this->Count + count - 1);
+  for (int i = first; i < times.size(); ++i)
+    {
+    int entry = this->bufferIndex(this->Count);
+    if (entry == this->Times.size())
+      {
+      // The buffer is filled for the first time
+      this->Times.append(times.at(i));
+      this->ThreadIds.append(threadIds.at(i));
+      this->LogLevels.append(logLevels.at(i));
+      this->Origins.append(origins.at(i));
+      this->Descriptions.append(descriptions.at(i));
+      this->FirstTextSizes.append(firstTextSizes.at(i));
+      }
+    else
+      {
+      this->Times[entry] = times.at(i);
+      this->ThreadIds[entry] = threadIds.at(i);
+      this->LogLevels[entry] = logLevels.at(i);
+      this->Origins[entry] = origins.at(i);
+      this->Descriptions[entry] = descriptions.at(i);
+      this->FirstTextSizes[entry] = firstTextSizes.at(i);
+      }
+    ++this->Count;
+    }
+  this->endInsertRows();
+}
+
+// --------------------------------------------------------------------------
+ctkErrorLogLevel::LogLevel ctkErrorLogEntryModel::logLevel(int row)const
+{
+  if (row < 0 || row >= this->Count)
+    {
+    return ctkErrorLogLevel::None;
+    }
+  return static_cast<ctkErrorLogLevel::LogLevel>(this->LogLevels.at(this->bufferIndex(row)));
+}
+
+// --------------------------------------------------------------------------
+void ctkErrorLogEntryModel::clear()
+{
+  this->beginResetModel();
+  this->Times.clear();
+  this->ThreadIds.clear();
+  this->LogLevels.clear();
+  this->Origins.clear();
+  this->Descriptions.clear();
+  this->FirstTextSizes.clear();
+  this->StringIds.clear();
+  this->Strings.clear();
+  this->First = 0;
+  this->Count = 0;
+  this->endResetModel();
+}
+
+// --------------------------------------------------------------------------
+int ctkErrorLogEntryModel::maximumEntryCount()const
+{
+  return this->MaximumEntryCount;
+}
+
+// --------------------------------------------------------------------------
+void ctkErrorLogEntryModel::setMaximumEntryCount(int count)
+{
+  count = qMax(1, count);
+  if (count == this->MaximumEntryCount)
+    {
+    return;
+    }
+  this->removeOldestEntries(this->Count - count);
+
+  // Move the entries at the beginning of the buffer
+  this->beginResetModel();
+  QVector<qint64> times(this->Count);
+  QVector<int> threadIds(this->Count);
+  QVector<int> logLevels(this->Count);
+  QVector<int> origins(this->Count);
+  QVector<QString> descriptions(this->Count);
+  QVector<int> firstTextSizes(this->Count);
+  for (int row = 0; row < this->Count; ++row)
+    {
+    int entry = this->bufferIndex(row);
+    times[row] = this->Times.at(entry);
+    threadIds[row] = this->ThreadIds.at(entry);
+    logLevels[row] = this->LogLevels.at(entry);
+    origins[row] = this->Origins.at(entry);
+    descriptions[row] = this->Descriptions.at(entry);
+    firstTextSizes[row] = this->FirstTextSizes.at(entry);
+    }
+  this->Times = times;
+  this->ThreadIds = threadIds;
+  this->LogLevels = logLevels;
+  this->Origins = origins;
+  this->Descriptions = descriptions;
+  this->FirstTextSizes = firstTextSizes;
+  this->First = 0;
+  this->MaximumEntryCount = count;
+  this->endResetModel();
+}
+
 // --------------------------------------------------------------------------
 // ctkErrorLogModelPrivate
 
@@ -188,12 +559,33 @@ public:
   /// Convenient method that could be used for debugging purposes.
   void appendToFile(const QString& fileName, const QString& text);
 
-  void setMessageHandlerConnection(ctkErrorLogAbstractMessageHandler * msgHandler, bool asynchronous);
+  /// Open \a fileName in LogFile unless it is already opened.
+  /// \note AppendToFileMutex must be locked.
+  bool openLogFile(const QString& fileName);
+
+  void setMessageHandlerConnection(ctkErrorLogAbstractMessageHandler * msgHandler);
+
+  /// Push \a entry on PendingEntries. Lock-free, called from any thread.
+  /// Return true if there were no pending entries.
+  bool pushPendingEntry(ctkErrorLogModelEntry* entry);
 
-  QStandardItemModel StandardItemModel;
+  /// Take all the pending entries, oldest first.
+  QVector<ctkErrorLogModelEntry*> takePendingEntries();
+
+  /// Write the entries into the log file and add them to the entry model
+  void addEntries(const QVector<ctkErrorLogModelEntry*>& entries);
+
+  ctkErrorLogEntryModel EntryModel;
+
+  /// Entries sent by the message handlers, most recent first
+  QAtomicPointer<ctkErrorLogModelEntry> PendingEntries;
+  /// Started when the first entry is pushed on PendingEntries
+  QTimer PendingEntriesTimer;
 
   QHash<QString, ctkErrorLogAbstractMessageHandler*> RegisteredHandlers;
 
+  /// Until filterEntry() is called, all the entries are accepted
+  bool LogLevelFilterEnabled;
   ctkErrorLogLevel::LogLevels CurrentLogLevelFilter;
 
   bool LogEntryGrouping;
@@ -206,6 +598,10 @@ public:
   ctkErrorLogTerminalOutput StdOutTerminalOutput;
 
   QMutex AppendToFileMutex;
+  /// Kept opened between the entries, the stream buffers the writes
+  QFile LogFile;
+  QTextStream LogFileStream;
+  QString FilePath;
 };
 
 // --------------------------------------------------------------------------
@@ -218,6 +614,7 @@ ctkErrorLogModelPrivate::ctkErrorLogModelPrivate(ctkErrorLogModel& object)
   this->LogEntryGrouping = false;
   this->AsynchronousLogging = true;
   this->AddingEntry = false;
+  this->LogLevelFilterEnabled = false;
 }
 
 // --------------------------------------------------------------------------
@@ -231,6 +628,8 @@ ctkErrorLogModelPrivate::~ctkErrorLogModelPrivate()
     msgHandler->setEnabled(false);
     delete msgHandler;
     }
+  qDeleteAll(this->takePendingEntries());
+  this->LogFileStream.flush();
 }
 
 // --------------------------------------------------------------------------
@@ -241,33 +640,118 @@ void ctkErrorLogModelPrivate::init()
   //
   // WARNING - Using a QSortFilterProxyModel slows down the insertion of rows by a factor 10
   //
-  q->setSourceModel(&this->StandardItemModel);
-  q->setFilterKeyColumn(ctkErrorLogModel::LogLevelColumn);
+  // Entries are filtered by level in filterAcceptsRow()
+  q->setSourceModel(&this->EntryModel);
+
+  // Messages received within the interval are inserted at once
+  this->PendingEntriesTimer.setSingleShot(true);
+  this->PendingEntriesTimer.setInterval(50);
+  QObject::connect(&this->PendingEntriesTimer, SIGNAL(timeout()),
+                   q, SLOT(addPendingEntries()));
+}
+
+// --------------------------------------------------------------------------
+bool ctkErrorLogModelPrivate::pushPendingEntry(ctkErrorLogModelEntry* entry)
+{
+  do
+    {
+    entry->Next = this->PendingEntries;
+    }
+  while (!this->PendingEntries.testAndSetOrdered(entry->Next, entry));
+  return entry->Next == 0;
+}
+
+// --------------------------------------------------------------------------
+QVector<ctkErrorLogModelEntry*> ctkErrorLogModelPrivate::takePendingEntries()
+{
+  ctkErrorLogModelEntry* entry = this->PendingEntries.fetchAndStoreOrdered(0);
+  QVector<ctkErrorLogModelEntry*> entries;
+  for (; entry; entry = entry->Next)
+    {
+    entries.append(entry);
+    }
+  std::reverse(entries.begin(), entries.end());
+  return entries;
+}
+
+// --------------------------------------------------------------------------
+void ctkErrorLogModelPrivate::addEntries(const QVector<ctkErrorLogModelEntry*>& entries)
+{
+  if (entries.isEmpty())
+    {
+    return;
+    }
+  if (!this->FilePath.isEmpty())
+    {
+    QMutexLocker locker(&this->AppendToFileMutex);
+    if (this->openLogFile(this->FilePath))
+      {
+      bool flush = false;
+      foreach(const ctkErrorLogModelEntry* entry, entries)
+        {
+        this->LogFileStream << entry->DateTime.toString("dd.MM.yyyy hh:mm:ss.zzz")
+                            << " [" << this->ErrorLogLevel(entry->LogLevel) << "]"
+                            << " [" << entry->Origin << "]"
+                            << " [" << entry->ThreadId << "] "
+                            << entry->Text << "\n";
+        flush = flush || entry->LogLevel >= ctkErrorLogLevel::Warning;
+        }
+      // Make sure errors are on disk if the application crashes
+      if (flush)
+        {
+        this->LogFileStream.flush();
+        }
+      }
+    }
+
+  this->EntryModel.addEntries(entries, this->LogEntryGrouping);
+}
+
+// --------------------------------------------------------------------------
+bool ctkErrorLogModelPrivate::openLogFile(const QString& fileName)
+{
+  if (this->LogFile.isOpen() && this->LogFile.fileName() == fileName)
+    {
+    return true;
+    }
+  this->LogFileStream.flush();
+  this->LogFileStream.setDevice(0);
+  this->LogFile.close();
+  this->LogFile.setFileName(fileName);
+  if (!this->LogFile.open(QFile::Append))
+    {
+    return false;
+    }
+  this->LogFileStream.setDevice(&this->LogFile);
+  return true;
 }
 
 // --------------------------------------------------------------------------
 void ctkErrorLogModelPrivate::appendToFile(const QString& fileName, const QString& text)
 {
   QMutexLocker locker(&this->AppendToFileMutex);
-  QFile f(fileName);
-  f.open(QFile::Append);
-  QTextStream s(&f);
-  s << QDateTime::currentDateTime().toString() << " - " << text << "\n";
-  f.close();
+  if (!this->openLogFile(fileName))
+    {
+    return;
+    }
+  this->LogFileStream << QDateTime::currentDateTime().toString() << " - " << text << "\n";
+  this->LogFileStream.flush();
 }
 
 // --------------------------------------------------------------------------
 void ctkErrorLogModelPrivate::setMessageHandlerConnection(
-    ctkErrorLogAbstractMessageHandler * msgHandler, bool asynchronous)
+    ctkErrorLogAbstractMessageHandler * msgHandler)
 {
   Q_Q(ctkErrorLogModel);
 
   msgHandler->disconnect();
 
+  // Called in the thread of the handler, the entries are queued without
+  // waiting for the thread of the model.
   QObject::connect(msgHandler,
         SIGNAL(messageHandled(QDateTime,QString,ctkErrorLogLevel::LogLevel,QString,QString)),
-        q, SLOT(addEntry(QDateTime,QString,ctkErrorLogLevel::LogLevel,QString,QString)),
-        asynchronous ? Qt::QueuedConnection : Qt::BlockingQueuedConnection);
+        q, SLOT(queueEntry(QDateTime,QString,ctkErrorLogLevel::LogLevel,QString,QString)),
+        Qt::DirectConnection);
 }
 
 // --------------------------------------------------------------------------
@@ -301,7 +785,7 @@ bool ctkErrorLogModel::registerMsgHandler(ctkErrorLogAbstractMessageHandler * ms
     return false;
     }
 
-  d->setMessageHandlerConnection(msgHandler, d->AsynchronousLogging);
+  d->setMessageHandlerConnection(msgHandler);
 
   msgHandler->setTerminalOutput(Self::StandardError, &d->StdErrTerminalOutput);
   msgHandler->setTerminalOutput(Self::StandardOutput, &d->StdOutTerminalOutput);
@@ -430,103 +914,70 @@ void ctkErrorLogModel::addEntry(const QDateTime& currentDateTime, const QString&
 
   d->AddingEntry = true;
 
-  QString timeFormat("dd.MM.yyyy hh:mm:ss");
+  ctkErrorLogModelEntry entry;
+  entry.DateTime = currentDateTime;
+  entry.ThreadId = threadId;
+  entry.LogLevel = logLevel;
+  entry.Origin = origin;
+  entry.Text = text;
+  entry.Next = 0;
+  d->addEntries(QVector<ctkErrorLogModelEntry*>() << &entry);
 
-  bool groupEntry = false;
-  if (d->LogEntryGrouping)
-    {
-    // Retrieve threadId associated with last row
-    QModelIndex lastRowThreadIdIndex =
-        d->StandardItemModel.index(d->StandardItemModel.rowCount() - 1, ctkErrorLogModel::ThreadIdColumn);
-
-    bool threadIdMatched = threadId == lastRowThreadIdIndex.data().toString();
-
-    // Retrieve logLevel associated with last row
-    QModelIndex lastRowLogLevelIndex =
-        d->StandardItemModel.index(d->StandardItemModel.rowCount() - 1, ctkErrorLogModel::LogLevelColumn);
-
-    bool logLevelMatched = d->ErrorLogLevel(logLevel) == lastRowLogLevelIndex.data().toString();
-
-    // Retrieve origin associated with last row
-    QModelIndex lastRowOriginIndex =
-        d->StandardItemModel.index(d->StandardItemModel.rowCount() - 1, ctkErrorLogModel::OriginColumn);
-
-    bool originMatched = origin == lastRowOriginIndex.data().toString();
-
-    // Retrieve time associated with last row
-    QModelIndex lastRowTimeIndex =
-            d->StandardItemModel.index(d->StandardItemModel.rowCount() - 1, ctkErrorLogModel::TimeColumn);
-    QDateTime lastRowDateTime = QDateTime::fromString(lastRowTimeIndex.data().toString(), timeFormat);
-
-    int groupingIntervalInMsecs = 1000;
-    bool withinGroupingInterval = lastRowDateTime.time().msecsTo(currentDateTime.time()) <= groupingIntervalInMsecs;
+  d->AddingEntry = false;
+}
 
-    groupEntry = threadIdMatched && logLevelMatched && originMatched && withinGroupingInterval;
+//------------------------------------------------------------------------------
+void ctkErrorLogModel::queueEntry(const QDateTime& currentDateTime, const QString& threadId,
+                                  ctkErrorLogLevel::LogLevel logLevel,
+                                  const QString& origin, const QString& text)
+{
+  Q_D(ctkErrorLogModel);
+  if (!d->AsynchronousLogging && QThread::currentThread() == this->thread())
+    {
+    this->addPendingEntries();
+    this->addEntry(currentDateTime, threadId, logLevel, origin, text);
+    return;
     }
 
-  if (!groupEntry)
+  ctkErrorLogModelEntry* entry = new ctkErrorLogModelEntry;
+  entry->DateTime = currentDateTime;
+  entry->ThreadId = threadId;
+  entry->LogLevel = logLevel;
+  entry->Origin = origin;
+  entry->Text = text;
+  if (d->pushPendingEntry(entry))
     {
-    QList<QStandardItem*> itemList;
-
-    // Time item
-    QStandardItem * timeItem = new QStandardItem(currentDateTime.toString(timeFormat));
-    timeItem->setEditable(false);
-    itemList << timeItem;
-
-    // ThreadId item
-    QStandardItem * threadIdItem = new QStandardItem(threadId);
-    threadIdItem->setEditable(false);
-    itemList << threadIdItem;
-
-    // LogLevel item
-    QStandardItem * logLevelItem = new QStandardItem(d->ErrorLogLevel(logLevel));
-    logLevelItem->setEditable(false);
-    itemList << logLevelItem;
-
-    // Origin item
-    QStandardItem * originItem = new QStandardItem(origin);
-    originItem->setEditable(false);
-    itemList << originItem;
-
-    // Description item
-    QStandardItem * descriptionItem = new QStandardItem();
-    QString descriptionText(text);
-    descriptionItem->setData(descriptionText.left(160).append((descriptionText.size() > 160) ? "..." : ""), Qt::DisplayRole);
-    descriptionItem->setData(descriptionText, ctkErrorLogModel::DescriptionTextRole);
-    descriptionItem->setEditable(false);
-    itemList << descriptionItem;
-
-    d->StandardItemModel.invisibleRootItem()->appendRow(itemList);
+    // First pending entry, start the timer in the thread of the model
+    QMetaObject::invokeMethod(&d->PendingEntriesTimer, "start", Qt::QueuedConnection);
     }
-  else
-    {
-    // Retrieve description associated with last row
-    QModelIndex lastRowDescriptionIndex =
-        d->StandardItemModel.index(d->StandardItemModel.rowCount() - 1, ctkErrorLogModel::DescriptionColumn);
-
-    QStringList updatedDescription;
-    updatedDescription << lastRowDescriptionIndex.data(ctkErrorLogModel::DescriptionTextRole).toString();
-    updatedDescription << text;
-
-    d->StandardItemModel.setData(lastRowDescriptionIndex, updatedDescription.join("\n"),
-                                 ctkErrorLogModel::DescriptionTextRole);
+}
 
-    // Append '...' to displayText if needed
-    QString displayText = lastRowDescriptionIndex.data().toString();
-    if (!displayText.endsWith("..."))
+//------------------------------------------------------------------------------
+void ctkErrorLogModel::addPendingEntries()
+{
+  Q_D(ctkErrorLogModel);
+  if (d->AddingEntry)
+    {
+    // Entries are being added, try again later. Entries pushed meanwhile
+    // did not start the timer since the pending list was not empty.
+    if (d->PendingEntries)
       {
-      d->StandardItemModel.setData(lastRowDescriptionIndex, displayText.append("..."), Qt::DisplayRole);
+      d->PendingEntriesTimer.start();
       }
+    return;
     }
-
+  QVector<ctkErrorLogModelEntry*> entries = d->takePendingEntries();
+  d->AddingEntry = true;
+  d->addEntries(entries);
   d->AddingEntry = false;
+  qDeleteAll(entries);
 }
 
 //------------------------------------------------------------------------------
 void ctkErrorLogModel::clear()
 {
   Q_D(ctkErrorLogModel);
-  d->StandardItemModel.invisibleRootItem()->removeRows(0, d->StandardItemModel.rowCount());
+  d->EntryModel.clear();
 }
 
 //------------------------------------------------------------------------------
@@ -535,81 +986,84 @@ void ctkErrorLogModel::filterEntry(const ctkErrorLogLevel::LogLevels& logLevel,
 {
   Q_D(ctkErrorLogModel);
 
-  QStringList patterns;
-  if (!this->filterRegExp().pattern().isEmpty())
+  ctkErrorLogLevel::LogLevels logLevelFilter = d->LogLevelFilterEnabled ?
+        d->CurrentLogLevelFilter : ctkErrorLogLevel::LogLevels(ctkErrorLogLevel::None);
+  if (!disableFilter)
     {
-    patterns << this->filterRegExp().pattern().split("|");
+    logLevelFilter |= logLevel;
+    }
+  else
+    {
+    logLevelFilter &= ~logLevel;
     }
-  patterns.removeAll(d->ErrorLogLevel(ctkErrorLogLevel::None));
-
-//  foreach(QString s, patterns)
-//    {
-//    std::cout << "pattern:" << qPrintable(s) << std::endl;
-//    }
 
-  QMetaEnum logLevelEnum = d->ErrorLogLevel.metaObject()->enumerator(0);
-  Q_ASSERT(QString("LogLevel").compare(logLevelEnum.name()) == 0);
+  bool filterChanged = !d->LogLevelFilterEnabled || logLevelFilter != d->CurrentLogLevelFilter;
+  d->LogLevelFilterEnabled = true;
+  d->CurrentLogLevelFilter = logLevelFilter;
 
-  // Loop over enum values and append associated name to 'patterns' if
-  // it has been specified within 'logLevel'
-  for (int i = 1; i < logLevelEnum.keyCount(); ++i)
+  if (filterChanged)
     {
-    int aLogLevel = logLevelEnum.value(i);
-    if (logLevel & aLogLevel)
-      {
-      QString logLevelAsString = d->ErrorLogLevel(static_cast<ctkErrorLogLevel::LogLevel>(aLogLevel));
-      if (!disableFilter)
-        {
-        patterns << logLevelAsString;
-        d->CurrentLogLevelFilter |= static_cast<ctkErrorLogLevel::LogLevels>(aLogLevel);
-        }
-      else
-        {
-        patterns.removeAll(logLevelAsString);
-        d->CurrentLogLevelFilter ^= static_cast<ctkErrorLogLevel::LogLevels>(aLogLevel);
-        }
-      }
+    this->invalidateFilter();
+    emit this->logLevelFilterChanged();
     }
+}
 
-  if (patterns.isEmpty())
+//------------------------------------------------------------------------------
+ctkErrorLogLevel::LogLevels ctkErrorLogModel::logLevelFilter()const
+{
+  Q_D(const ctkErrorLogModel);
+  if (!d->LogLevelFilterEnabled)
     {
-    // If there are no patterns, let's filter with the None level so that
-    // all entries are filtered out.
-    patterns << d->ErrorLogLevel(ctkErrorLogLevel::None);
+    return ctkErrorLogLevel::LogLevels(QFlag(~0));
     }
+  return d->CurrentLogLevelFilter | ctkErrorLogLevel::Unknown;
+}
 
-  bool filterChanged = true;
-  QStringList currentPatterns = this->filterRegExp().pattern().split("|");
-  if (currentPatterns.count() == patterns.count())
+//------------------------------------------------------------------------------
+bool ctkErrorLogModel::filterAcceptsRow(int sourceRow, const QModelIndex& sourceParent)const
+{
+  Q_D(const ctkErrorLogModel);
+  Q_UNUSED(sourceParent);
+  if (!d->LogLevelFilterEnabled)
     {
-    foreach(const QString& p, patterns)
-      {
-      currentPatterns.removeAll(p);
-      }
-    filterChanged = currentPatterns.count() > 0;
+    return true;
     }
+  return d->CurrentLogLevelFilter & d->EntryModel.logLevel(sourceRow);
+}
 
-  this->setFilterRegExp(patterns.join("|"));
+//------------------------------------------------------------------------------
+int ctkErrorLogModel::maximumEntryCount()const
+{
+  Q_D(const ctkErrorLogModel);
+  return d->EntryModel.maximumEntryCount();
+}
 
-  if (filterChanged)
-    {
-    emit this->logLevelFilterChanged();
-    }
+//------------------------------------------------------------------------------
+void ctkErrorLogModel::setMaximumEntryCount(int count)
+{
+  Q_D(ctkErrorLogModel);
+  d->EntryModel.setMaximumEntryCount(count);
 }
 
 //------------------------------------------------------------------------------
-ctkErrorLogLevel::LogLevels ctkErrorLogModel::logLevelFilter()const
+QString ctkErrorLogModel::filePath()const
 {
   Q_D(const ctkErrorLogModel);
-  QMetaEnum logLevelEnum = d->ErrorLogLevel.metaObject()->enumerator(0);
-  Q_ASSERT(QString("LogLevel").compare(logLevelEnum.name()) == 0);
+  return d->FilePath;
+}
 
-  ctkErrorLogLevel::LogLevels filter = ctkErrorLogLevel::Unknown;
-  foreach(const QString& filterAsString, this->filterRegExp().pattern().split("|"))
+//------------------------------------------------------------------------------
+void ctkErrorLogModel::setFilePath(const QString& filePath)
+{
+  Q_D(ctkErrorLogModel);
+  QMutexLocker locker(&d->AppendToFileMutex);
+  d->FilePath = filePath;
+  if (filePath.isEmpty())
     {
-    filter |= static_cast<ctkErrorLogLevel::LogLevels>(logLevelEnum.keyToValue(filterAsString.toLatin1()));
+    d->LogFileStream.flush();
+    d->LogFileStream.setDevice(0);
+    d->LogFile.close();
     }
-  return filter;
 }
 
 //------------------------------------------------------------------------------
@@ -641,13 +1095,8 @@ void ctkErrorLogModel::setAsynchronousLogging(bool value)
     {
     return;
     }
-
-  foreach(const QString& handlerName, d->RegisteredHandlers.keys())
-    {
-    d->setMessageHandlerConnection(
-          d->RegisteredHandlers.value(handlerName), value);
-    }
-
+  // Add the entries queued so far before the next synchronous entry
+  this->addPendingEntries();
   d->AsynchronousLogging = value;
 }
 
@@ -98,6 +98,8 @@ class CTK_CORE_EXPORT ctkErrorLogModel : public QSortFilterProxyModel
   Q_PROPERTY(bool logEntryGrouping READ logEntryGrouping WRITE setLogEntryGrouping)
   Q_PROPERTY(TerminalOutput terminalOutputs READ terminalOutputs WRITE  setTerminalOutputs)
   Q_PROPERTY(bool asynchronousLogging READ asynchronousLogging WRITE  setAsynchronousLogging)
+  Q_PROPERTY(int maximumEntryCount READ maximumEntryCount WRITE setMaximumEntryCount)
+  Q_PROPERTY(QString filePath READ filePath WRITE setFilePath)
 public:
   typedef QSortFilterProxyModel Superclass;
   typedef ctkErrorLogModel Self;
@@ -159,24 +161,54 @@ public:
   /// Remove all message from model
   void clear();
 
+  /// Return the levels of the entries shown by the model.
+  /// All levels are shown until filterEntry() is called.
   ctkErrorLogLevel::LogLevels logLevelFilter()const;
 
+  /// Show (or hide if \a disableFilter is true) the entries of level \a logLevel.
   void filterEntry(const ctkErrorLogLevel::LogLevels& logLevel = ctkErrorLogLevel::Unknown, bool disableFilter = false);
 
   bool logEntryGrouping()const;
   void setLogEntryGrouping(bool value);
 
+  /// The messages of the handlers are queued without blocking their
+  /// thread and added to the model in batches from the thread of the model.
+  /// If asynchronous logging is disabled, the messages sent from the thread
+  /// of the model are added immediately.
+  /// True by default.
   bool asynchronousLogging()const;
   void setAsynchronousLogging(bool value);
 
+  /// Maximum number of entries kept by the model. When it is reached, the
+  /// oldest tenth of the entries is removed. 100000 by default.
+  int maximumEntryCount()const;
+  void setMaximumEntryCount(int count);
+
+  /// If not empty, every message added to the model is also appended to the
+  /// file \a filePath, including the grouped and filtered out ones.
+  /// The file is kept opened and the writes are buffered, they are flushed
+  /// on warnings and errors.
+  QString filePath()const;
+  void setFilePath(const QString& filePath);
+
 public Q_SLOTS:
   void addEntry(const QDateTime& currentDateTime, const QString& threadId,
                 ctkErrorLogLevel::LogLevel logLevel, const QString& origin, const QString& text);
 
+  /// Add the entries queued by the message handlers
+  void addPendingEntries();
+
+protected Q_SLOTS:
+  /// Queue an entry sent by a message handler, thread-safe.
+  void queueEntry(const QDateTime& currentDateTime, const QString& threadId,
+                  ctkErrorLogLevel::LogLevel logLevel, const QString& origin, const QString& text);
+
 Q_SIGNALS:
   void logLevelFilterChanged();
 
 protected:
+  virtual bool filterAcceptsRow(int sourceRow, const QModelIndex& sourceParent)const;
+
   QScopedPointer<ctkErrorLogModelPrivate> d_ptr;
 
 private:
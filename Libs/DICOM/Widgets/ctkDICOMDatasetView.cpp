@@ -27,6 +27,7 @@
 // CTK includes
 #include "ctkLogger.h"
 #include "ctkQImageView.h"
+#include "ctkQImageViewSliceProvider.h"
 
 // ctkDICOMCore includes
 #include "ctkDICOMFilterProxyModel.h"
@@ -48,6 +49,91 @@
 
 static ctkLogger logger("org.commontk.DICOM.Widgets.ctkDICOMDatasetView");
 
+//--------------------------------------------------------------------------
+// Render the windowed pixels of dcmImage in an 8 bits QImage
+static QImage ctkDICOMDatasetViewToQImage(DicomImage& dcmImage)
+{
+    QImage image;
+    /* get image extension and prepare image header */
+    const unsigned long width = dcmImage.getWidth();
+    const unsigned long height = dcmImage.getHeight();
+    unsigned long offset = 0;
+    unsigned long length = 0;
+    QString header;
+
+    if (dcmImage.isMonochrome())
+    {
+      // write PGM header (binary monochrome image format)
+      header = QString("P5 %1 %2 255\n").arg(width).arg(height);
+      offset = header.length();
+      length = width * height + offset;
+    }
+    else
+    {
+      // write PPM header (binary color image format)
+      header = QString("P6 %1 %2 255\n").arg(width).arg(height);
+      offset = header.length();
+      length = width * height * 3 /* RGB */ + offset;
+    }
+    /* create output buffer for DicomImage class */
+    QByteArray buffer;
+    /* copy header to output buffer and resize it for pixel data */
+    buffer.append(header);
+    buffer.resize(length);
+
+    /* render pixel data to buffer */
+    if (dcmImage.getOutputData(static_cast<void *>(buffer.data() + offset), length - offset, 8, 0))
+    {  
+      if (!image.loadFromData( buffer ))
+        {
+            logger.error("QImage couldn't created");
+        }
+    }
+    return image;
+}
+
+//--------------------------------------------------------------------------
+/// Decode the DICOM files of a series on demand, with their default window
+class ctkDICOMDatasetViewSliceProvider : public ctkQImageViewSliceProvider
+{
+public:
+  ctkDICOMDatasetViewSliceProvider(const QStringList& files)
+    : Files(files)
+  {
+  }
+
+  virtual int numberOfSlices() const
+  {
+    return this->Files.size();
+  }
+
+  virtual QImage loadSlice(int slice)
+  {
+    DicomImage dcmImage(QDir::toNativeSeparators(this->Files[slice]).toStdString().c_str());
+    EI_Status result = dcmImage.getStatus();
+    if (result != EIS_Normal)
+    {
+      logger.error(QString("Rendering of DICOM image failed: ") + DicomImage::getString(result));
+      return QImage();
+    }
+    if (dcmImage.isMonochrome())
+    {
+      if (dcmImage.getWindowCount() > 0)
+      {
+        dcmImage.setWindow(0);
+      }
+      else
+      {
+        dcmImage.setMinMaxWindow(OFTrue /* ignore extreme values */);
+      }
+    }
+    return ctkDICOMDatasetViewToQImage(dcmImage);
+  }
+
+protected:
+  QStringList Files;
+};
+
 //--------------------------------------------------------------------------
 class ctkDICOMDatasetViewPrivate 
 {
@@ -68,6 +154,7 @@ public:
   double DicomIntensityLevel;
   double DicomIntensityWindow;
   bool AutoWindowLevel;
+  QScopedPointer<ctkDICOMDatasetViewSliceProvider> SliceProvider;
 
   void init();
 
@@ -238,6 +325,8 @@ ctkDICOMDatasetView::ctkDICOMDatasetView(
 // -------------------------------------------------------------------------
 ctkDICOMDatasetView::~ctkDICOMDatasetView()
 {
+  // Stop prefetching before the provider is deleted
+  this->setSliceProvider(0);
 }
 
 // -------------------------------------------------------------------------
@@ -264,7 +353,6 @@ void ctkDICOMDatasetView::addImage( const QImage & image )
 void ctkDICOMDatasetView::addImage( DicomImage & dcmImage, bool defaultIntensity )
 {
     Q_D(ctkDICOMDatasetView);
-    QImage image;
     // Check whether we have a valid image
     EI_Status result = dcmImage.getStatus();
     if (result != EIS_Normal)
@@ -293,42 +381,24 @@ void ctkDICOMDatasetView::addImage( DicomImage & dcmImage, bool defaultIntensity
     {
       dcmImage.setWindow(d->DicomIntensityLevel, d->DicomIntensityWindow);
     }
-    /* get image extension and prepare image header */
-    const unsigned long width = dcmImage.getWidth();
-    const unsigned long height = dcmImage.getHeight();
-    unsigned long offset = 0;
-    unsigned long length = 0;
-    QString header;
+    this->addImage(ctkDICOMDatasetViewToQImage(dcmImage));
+}
 
-    if (dcmImage.isMonochrome())
-    {
-      // write PGM header (binary monochrome image format)
-      header = QString("P5 %1 %2 255\n").arg(width).arg(height);
-      offset = header.length();
-      length = width * height + offset;
-    }
-    else
-    {
-      // write PPM header (binary color image format)
-      header = QString("P6 %1 %2 255\n").arg(width).arg(height);
-      offset = header.length();
-      length = width * height * 3 /* RGB */ + offset;
-    }
-    /* create output buffer for DicomImage class */
-    QByteArray buffer;
-    /* copy header to output buffer and resize it for pixel data */
-    buffer.append(header);
-    buffer.resize(length);
+// -------------------------------------------------------------------------
+void ctkDICOMDatasetView::setImageFiles(const QStringList& files)
+{
+    Q_D(ctkDICOMDatasetView);
 
-    /* render pixel data to buffer */
-    if (dcmImage.getOutputData(static_cast<void *>(buffer.data() + offset), length - offset, 8, 0))
-    {  
-      if (!image.loadFromData( buffer ))
-        {
-            logger.error("QImage couldn't created");
-        }
+    // The previous provider is deleted once the view stopped prefetching it
+    QScopedPointer<ctkDICOMDatasetViewSliceProvider> previousProvider(d->SliceProvider.take());
+    d->CurrentImageIndex = QModelIndex();
+    if (files.isEmpty())
+    {
+        this->clearImages();
+        return;
     }
-    this->addImage(image);
+    d->SliceProvider.reset(new ctkDICOMDatasetViewSliceProvider(files));
+    this->setSliceProvider(d->SliceProvider.data());
 }
 
 // -------------------------------------------------------------------------
@@ -25,6 +25,7 @@
 #include <QWidget>
 #include <QImage>
 #include <QModelIndex>
+#include <QStringList>
 
 /// CTK includes
 #include "ctkQImageView.h"
@@ -58,6 +59,11 @@ public:
 
   QModelIndex currentImageIndex();
 
+  /// Display the DICOM files \a files as a stack of slices decoded on
+  /// demand with their default window.
+  /// \sa ctkQImageView::setSliceProvider()
+  void setImageFiles(const QStringList& files);
+
 Q_SIGNALS:
 
   void requestNextImage();
@@ -27,6 +27,8 @@
 #include <service/cm/ctkConfigurationAdmin.h>
 #include <service/cm/ctkConfiguration.h>
 
+#include <QDir>
+#include <QFile>
 #include <QTest>
 #include <QDebug>
 
@@ -313,3 +315,90 @@ void ctkConfigurationAdminTestSuite::testPersistentFactoryConfig()
   config = cm->getConfiguration(pid);
   QVERIFY(config->getProperties().isEmpty());
 }
+
+//----------------------------------------------------------------------------
+void ctkConfigurationAdminTestSuite::testPersistentManyFactoryConfigs()
+{
+  // enough updates to have the configuration journal compacted
+  const int count = 400;
+  QStringList pids;
+  for (int i = 0; i < count; ++i)
+  {
+    ctkConfigurationPtr config = cm->createFactoryConfiguration("test.many");
+    ctkDictionary props;
+    props.insert("index", i);
+    for (int update = 0; update < 3; ++update)
+    {
+      props.insert("update", update);
+      config->update(props);
+    }
+    pids << config->getPid();
+  }
+  for (int i = 0; i < count; i += 2)
+  {
+    cm->getConfiguration(pids[i])->remove();
+  }
+
+  cleanup();
+  init();
+
+  QString factoryFilter = QString("(") + ctkConfigurationAdmin::SERVICE_FACTORYPID + "=test.many)";
+  QList<ctkConfigurationPtr> configs = cm->listConfigurations(factoryFilter);
+  QCOMPARE(configs.size(), count / 2);
+  foreach (ctkConfigurationPtr config, configs)
+  {
+    QCOMPARE(config->getFactoryPid(), QString("test.many"));
+    QCOMPARE(config->getProperties().value("index").toInt() % 2, 1);
+    QCOMPARE(config->getProperties().value("update").toInt(), 2);
+  }
+
+  configs = cm->listConfigurations(QString("(&") + factoryFilter + "(index=7))");
+  QCOMPARE(configs.size(), 1);
+  QCOMPARE(configs.front()->getPid(), pids[7]);
+
+  configs = cm->listConfigurations(QString("(") + ctkPluginConstants::SERVICE_PID + "=" + pids[8] + ")");
+  QVERIFY(configs.isEmpty());
+
+  for (int i = 1; i < count; i += 2)
+  {
+    cm->getConfiguration(pids[i])->remove();
+  }
+
+  cleanup();
+  init();
+  QVERIFY(cm->listConfigurations(factoryFilter).isEmpty());
+}
+
+//----------------------------------------------------------------------------
+void ctkConfigurationAdminTestSuite::testPersistentTruncatedJournal()
+{
+  ctkConfigurationPtr kept = cm->getConfiguration("test.kept");
+  ctkDictionary props;
+  props.insert("testkey", "kept");
+  kept->update(props);
+  ctkConfigurationPtr torn = cm->getConfiguration("test.torn");
+  props.insert("testkey", "first");
+  torn->update(props);
+  props.insert("testkey", "second");
+  torn->update(props);
+  cleanup();
+
+  // simulate a crash while the last record was written
+  QDir dataStorage = context->getDataFile("test").absoluteDir();
+  QVERIFY(dataStorage.cdUp());
+  QFile journal(dataStorage.filePath(QString::number(cmPluginId) + "/store/configurations.journal"));
+  QVERIFY(journal.exists());
+  QVERIFY(journal.resize(journal.size() - 1));
+
+  init();
+  kept = cm->getConfiguration("test.kept");
+  QCOMPARE(kept->getProperties().value("testkey").toString(), QString("kept"));
+  torn = cm->getConfiguration("test.torn");
+  QCOMPARE(torn->getProperties().value("testkey").toString(), QString("first"));
+  kept->remove();
+  torn->remove();
+  cleanup();
+  init();
+  QVERIFY(cm->getConfiguration("test.kept")->getProperties().isEmpty());
+  QVERIFY(cm->getConfiguration("test.torn")->getProperties().isEmpty());
+}
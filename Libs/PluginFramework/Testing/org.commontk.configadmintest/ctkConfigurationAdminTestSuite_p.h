@@ -65,6 +65,8 @@ private Q_SLOTS:
   void testListConfigurationNull();
   void testPersistentConfig();
   void testPersistentFactoryConfig();
+  void testPersistentManyFactoryConfigs();
+  void testPersistentTruncatedJournal();
 
 private:
 
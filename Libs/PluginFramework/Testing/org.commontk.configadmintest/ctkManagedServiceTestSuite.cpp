@@ -48,11 +48,35 @@ void _ManagedServiceUpdateTest::updated(
   ts->updateCount++;
 }
 
+//----------------------------------------------------------------------------
+_ManagedServiceBlockingTest::_ManagedServiceBlockingTest(
+  ctkManagedServiceTestSuite* ts)
+  : ts(ts)
+{
+
+}
+
+//----------------------------------------------------------------------------
+void _ManagedServiceBlockingTest::updated(
+  const ctkDictionary& properties)
+{
+  Q_UNUSED(properties)
+
+  QMutexLocker l(&ts->mutex);
+  ts->blockingUpdateCount++;
+  ts->blockingUpdate.wakeAll();
+  while (ts->blocking)
+  {
+    if (!ts->blockingUpdate.wait(&ts->mutex, 10000))
+      break;
+  }
+}
+
 //----------------------------------------------------------------------------
 ctkManagedServiceTestSuite::ctkManagedServiceTestSuite(
   ctkPluginContext* pc, long cmPluginId)
   : context(pc), cmPluginId(cmPluginId), cm(0), updateCount(0),
-    locked(false)
+    locked(false), blockingUpdateCount(0), blocking(false)
 {
 
 }
@@ -196,3 +220,46 @@ void ctkManagedServiceTestSuite::testGeneralManagedService()
   }
   reg.unregister();
 }
+
+//----------------------------------------------------------------------------
+void ctkManagedServiceTestSuite::testBlockingManagedService()
+{
+  updateCount = 0;
+  blockingUpdateCount = 0;
+  _ManagedServiceUpdateTest ms(this);
+  _ManagedServiceBlockingTest blockingMs(this);
+
+  ctkDictionary blockingDict;
+  blockingDict.insert(ctkPluginConstants::SERVICE_PID, "test.blocking");
+  ctkDictionary dict;
+  dict.insert(ctkPluginConstants::SERVICE_PID, "test");
+
+  ctkServiceRegistration blockingReg;
+  ctkServiceRegistration reg;
+  {
+    QMutexLocker l(&mutex);
+    blocking = true;
+    blockingReg = context->registerService<ctkManagedService>(&blockingMs, blockingDict);
+    if (blockingUpdateCount == 0)
+      blockingUpdate.wait(&mutex, 5000);
+    if (blockingUpdateCount == 0)
+    {
+      blocking = false;
+      QFAIL("should have updated");
+    }
+
+    // the update of "test" must not wait for the one of "test.blocking"
+    reg = context->registerService<ctkManagedService>(&ms, dict);
+    locked = true;
+    lock.wait(&mutex, 5000);
+    bool updated = !locked;
+    locked = false;
+    blocking = false;
+    blockingUpdate.wakeAll();
+    if (!updated)
+      QFAIL("should have updated while another ctkManagedService is busy");
+    QCOMPARE(1, updateCount);
+  }
+  reg.unregister();
+  blockingReg.unregister();
+}
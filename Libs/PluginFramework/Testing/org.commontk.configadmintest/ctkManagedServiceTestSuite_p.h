@@ -50,6 +50,22 @@ private:
   ctkManagedServiceTestSuite* const ts;
 };
 
+class _ManagedServiceBlockingTest : public QObject, public ctkManagedService
+{
+  Q_OBJECT
+  Q_INTERFACES(ctkManagedService)
+
+public:
+
+  _ManagedServiceBlockingTest(ctkManagedServiceTestSuite* ts);
+
+  void updated(const ctkDictionary& properties);
+
+private:
+
+  ctkManagedServiceTestSuite* const ts;
+};
+
 class ctkManagedServiceTestSuite : public QObject,
     public ctkTestSuiteInterface
 {
@@ -67,6 +83,7 @@ private Q_SLOTS:
 
   void testSamePidManagedService();
   void testGeneralManagedService();
+  void testBlockingManagedService();
 
 private:
 
@@ -78,8 +95,12 @@ private:
   bool locked;
   QMutex mutex;
   QWaitCondition lock;
+  int blockingUpdateCount;
+  bool blocking;
+  QWaitCondition blockingUpdate;
 
   friend class _ManagedServiceUpdateTest;
+  friend class _ManagedServiceBlockingTest;
 };
 
 #endif // CTKMANAGEDSERVICETESTSUITE_P_H
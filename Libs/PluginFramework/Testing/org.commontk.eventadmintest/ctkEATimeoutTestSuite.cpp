@@ -0,0 +1,179 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#include "ctkEATimeoutTestSuite_p.h"
+
+#include <ctkPluginContext.h>
+#include <service/event/ctkEventConstants.h>
+#include <service/event/ctkEventAdmin.h>
+
+#include <QTest>
+
+static const QString TimeoutTopic = "org/commontk/eventadmintest/timeout";
+
+//----------------------------------------------------------------------------
+ctkEATimeoutEventHandler::ctkEATimeoutEventHandler(bool blocking, unsigned long maxBlockTime)
+  : blocking(blocking), maxBlockTime(maxBlockTime), receivedEvents(0),
+    blocked(false), released(false)
+{
+
+}
+
+//----------------------------------------------------------------------------
+int ctkEATimeoutEventHandler::getReceivedEvents() const
+{
+  QMutexLocker l(&mutex);
+  return receivedEvents;
+}
+
+//----------------------------------------------------------------------------
+bool ctkEATimeoutEventHandler::isBlocked() const
+{
+  QMutexLocker l(&mutex);
+  return blocked;
+}
+
+//----------------------------------------------------------------------------
+void ctkEATimeoutEventHandler::release()
+{
+  QMutexLocker l(&mutex);
+  released = true;
+  releaseCondition.wakeAll();
+}
+
+//----------------------------------------------------------------------------
+void ctkEATimeoutEventHandler::handleEvent(const ctkEvent& event)
+{
+  Q_UNUSED(event)
+
+  QMutexLocker l(&mutex);
+  if (++receivedEvents == 1 && blocking)
+  {
+    blocked = true;
+    while (!released)
+    {
+      if (!releaseCondition.wait(&mutex, maxBlockTime))
+      {
+        break;
+      }
+    }
+    blocked = false;
+  }
+}
+
+//----------------------------------------------------------------------------
+ctkEATimeoutEventSender::ctkEATimeoutEventSender(ctkEventAdmin* eventAdmin, const QString& topic)
+  : eventAdmin(eventAdmin), topic(topic)
+{
+  setObjectName("ctkEATimeoutEventSender");
+}
+
+//----------------------------------------------------------------------------
+void ctkEATimeoutEventSender::run()
+{
+  eventAdmin->sendEvent(ctkEvent(topic, ctkDictionary()));
+}
+
+//----------------------------------------------------------------------------
+ctkEATimeoutTestSuite::ctkEATimeoutTestSuite(ctkPluginContext* context, long eventPluginId)
+  : pluginContext(context), eventPluginId(eventPluginId), timeout(0), eventAdmin(0),
+    slowHandler(0), fastHandler(0)
+{
+
+}
+
+//----------------------------------------------------------------------------
+ctkEATimeoutTestSuite::~ctkEATimeoutTestSuite()
+{
+  delete slowHandler;
+  delete fastHandler;
+}
+
+//----------------------------------------------------------------------------
+void ctkEATimeoutTestSuite::initTestCase()
+{
+  pluginContext->getPlugin(eventPluginId)->start();
+
+  // the same default as the EventAdmin implementation
+  QVariant timeoutProp = pluginContext->getProperty("org.commontk.eventadmin.Timeout");
+  timeout = timeoutProp.isValid() ? timeoutProp.toInt() : 5000;
+  QVERIFY2(timeout > 100, "the timeout must be enabled for this test suite");
+
+  ctkServiceReference serviceReference = pluginContext->getServiceReference<ctkEventAdmin>();
+  QVERIFY2(serviceReference, "Should be able to get reference to ctkEventAdmin service");
+  eventAdmin = pluginContext->getService<ctkEventAdmin>(serviceReference);
+  QVERIFY2(eventAdmin, "Should be able to get instance to ctkEventAdmin object");
+
+  // the slow handler blocks at most four times the timeout
+  slowHandler = new ctkEATimeoutEventHandler(true, 4 * timeout);
+  fastHandler = new ctkEATimeoutEventHandler(false, 0);
+
+  ctkDictionary props;
+  props.insert(ctkEventConstants::EVENT_TOPIC, QStringList(TimeoutTopic));
+  slowHandlerRegistration = pluginContext->registerService<ctkEventHandler>(slowHandler, props);
+  fastHandlerRegistration = pluginContext->registerService<ctkEventHandler>(fastHandler, props);
+}
+
+//----------------------------------------------------------------------------
+void ctkEATimeoutTestSuite::cleanupTestCase()
+{
+  try
+  {
+    slowHandlerRegistration.unregister();
+  }
+  catch (const std::logic_error&) {}
+  try
+  {
+    fastHandlerRegistration.unregister();
+  }
+  catch (const std::logic_error&) {}
+}
+
+//----------------------------------------------------------------------------
+void ctkEATimeoutTestSuite::testSlowHandlerBlacklisted()
+{
+  ctkEATimeoutEventSender sender(eventAdmin, TimeoutTopic);
+  sender.start();
+
+  // wait until the watchdog detected the timeout of the blocked handler
+  QTest::qWait(2 * timeout);
+  const bool blockedAfterTimeout = slowHandler->isBlocked();
+
+  // the slow handler is blacklisted while it is still running
+  eventAdmin->sendEvent(ctkEvent(TimeoutTopic, ctkDictionary()));
+  const int slowHandlerEvents = slowHandler->getReceivedEvents();
+
+  // let the sender return before checking, it must not outlive this method
+  slowHandler->release();
+  const bool senderReturned = sender.wait(4 * timeout);
+
+  QVERIFY2(blockedAfterTimeout, "the slow handler should still be running");
+  QCOMPARE(slowHandlerEvents, 1);
+  QVERIFY2(senderReturned, "the sender should return once the handler returned");
+
+  // the fast handler received both events and is not blacklisted
+  QCOMPARE(fastHandler->getReceivedEvents(), 2);
+
+  eventAdmin->sendEvent(ctkEvent(TimeoutTopic, ctkDictionary()));
+  QCOMPARE(slowHandler->getReceivedEvents(), 1);
+  QCOMPARE(fastHandler->getReceivedEvents(), 3);
+}
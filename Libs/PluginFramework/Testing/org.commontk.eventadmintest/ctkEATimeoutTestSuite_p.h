@@ -0,0 +1,133 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#ifndef CTKEATIMEOUTTESTSUITE_P_H
+#define CTKEATIMEOUTTESTSUITE_P_H
+
+#include <QObject>
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+
+#include <service/event/ctkEventHandler.h>
+#include <ctkTestSuiteInterface.h>
+#include <ctkServiceRegistration.h>
+
+struct ctkEventAdmin;
+
+class ctkEATimeoutEventHandler : public QObject, public ctkEventHandler
+{
+  Q_OBJECT
+  Q_INTERFACES(ctkEventHandler)
+
+private:
+
+  /** if true, the first event blocks until release() is called */
+  const bool blocking;
+
+  /** the maximum time to block in milliseconds */
+  const unsigned long maxBlockTime;
+
+  int receivedEvents;
+  bool blocked;
+  bool released;
+
+  mutable QMutex mutex;
+  QWaitCondition releaseCondition;
+
+public:
+
+  ctkEATimeoutEventHandler(bool blocking, unsigned long maxBlockTime);
+
+  int getReceivedEvents() const;
+  bool isBlocked() const;
+
+  /**
+   * Lets a blocked handleEvent() call return.
+   */
+  void release();
+
+  void handleEvent(const ctkEvent& event);
+};
+
+class ctkEATimeoutEventSender : public QThread
+{
+
+private:
+
+  ctkEventAdmin* eventAdmin;
+  QString topic;
+
+public:
+
+  ctkEATimeoutEventSender(ctkEventAdmin* eventAdmin, const QString& topic);
+
+protected:
+
+  void run();
+};
+
+/**
+ * Test suite for the delivery timeout of synchronous events.
+ *
+ * A handler which does not return within the configured timeout
+ * (org.commontk.eventadmin.Timeout) must be blacklisted while it is still
+ * running, and must not receive further events. Other handlers of the same
+ * event are not affected.
+ */
+class ctkEATimeoutTestSuite : public QObject, public ctkTestSuiteInterface
+{
+  Q_OBJECT
+  Q_INTERFACES(ctkTestSuiteInterface)
+
+private:
+
+  ctkPluginContext* pluginContext;
+
+  long eventPluginId;
+
+  /** the delivery timeout in milliseconds */
+  int timeout;
+
+  ctkEventAdmin* eventAdmin;
+
+  ctkEATimeoutEventHandler* slowHandler;
+  ctkEATimeoutEventHandler* fastHandler;
+
+  ctkServiceRegistration slowHandlerRegistration;
+  ctkServiceRegistration fastHandlerRegistration;
+
+public:
+
+  ctkEATimeoutTestSuite(ctkPluginContext* context, long eventPluginId);
+  ~ctkEATimeoutTestSuite();
+
+private Q_SLOTS:
+
+  void initTestCase();
+  void cleanupTestCase();
+
+  void testSlowHandlerBlacklisted();
+
+};
+
+#endif // CTKEATIMEOUTTESTSUITE_P_H
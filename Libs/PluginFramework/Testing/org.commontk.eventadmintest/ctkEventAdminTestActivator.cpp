@@ -32,11 +32,13 @@
 #include "ctkEAScenario2TestSuite_p.h"
 #include "ctkEAScenario3TestSuite_p.h"
 #include "ctkEAScenario4TestSuite_p.h"
+#include "ctkEATimeoutTestSuite_p.h"
 
 //----------------------------------------------------------------------------
 ctkEventAdminTestActivator::ctkEventAdminTestActivator()
   : topicWildcardTestSuite(0), topicWildcardTestSuiteSS(0),
-    scenario1TestSuite(0), scenario1TestSuiteSS(0), scenario2TestSuite(0)
+    scenario1TestSuite(0), scenario1TestSuiteSS(0), scenario2TestSuite(0),
+    timeoutTestSuite(0)
 {
 
 }
@@ -49,6 +51,7 @@ ctkEventAdminTestActivator::~ctkEventAdminTestActivator()
   delete scenario1TestSuite;
   delete scenario1TestSuiteSS;
   delete scenario2TestSuite;
+  delete timeoutTestSuite;
 }
 
 //----------------------------------------------------------------------------
@@ -98,6 +101,9 @@ void ctkEventAdminTestActivator::start(ctkPluginContext* context)
 
   scenario4TestSuite = new ctkEAScenario4TestSuite(context, eventPluginId);
   context->registerService<ctkTestSuiteInterface>(scenario4TestSuite);
+
+  timeoutTestSuite = new ctkEATimeoutTestSuite(context, eventPluginId);
+  context->registerService<ctkTestSuiteInterface>(timeoutTestSuite);
 }
 
 //----------------------------------------------------------------------------
@@ -112,6 +118,7 @@ void ctkEventAdminTestActivator::stop(ctkPluginContext* context)
   delete scenario2TestSuite;
   delete scenario3TestSuite;
   delete scenario4TestSuite;
+  delete timeoutTestSuite;
 
   topicWildcardTestSuite = 0;
   topicWildcardTestSuiteSS = 0;
@@ -120,6 +127,7 @@ void ctkEventAdminTestActivator::stop(ctkPluginContext* context)
   scenario2TestSuite = 0;
   scenario3TestSuite = 0;
   scenario4TestSuite = 0;
+  timeoutTestSuite = 0;
 }
 
 Q_EXPORT_PLUGIN2(org_commontk_eventadmintest, ctkEventAdminTestActivator)
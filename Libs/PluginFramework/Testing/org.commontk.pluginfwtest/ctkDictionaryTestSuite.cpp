@@ -0,0 +1,139 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#include "ctkDictionaryTestSuite_p.h"
+
+#include <ctkDictionary.h>
+#include <ctkLDAPSearchFilter.h>
+#include <ctkPluginContext.h>
+#include <ctkPluginConstants.h>
+#include <service/event/ctkEvent.h>
+
+#include <QTest>
+
+//----------------------------------------------------------------------------
+static ctkDictionary createTestProperties()
+{
+  ctkDictionary props;
+  props.insert("service.vendor", "CommonTK");
+  props.insert("service.description", "ctkDictionary benchmark");
+  props.insert("org.commontk.test.key1", 1);
+  props.insert("org.commontk.test.key2", 2);
+  props.insert("org.commontk.test.key3", 3);
+  props.insert(ctkPluginConstants::SERVICE_PID, "org.commontk.test.pid");
+  return props;
+}
+
+//----------------------------------------------------------------------------
+ctkDictionaryTestSuite::ctkDictionaryTestSuite(ctkPluginContext* pc)
+  : pc(pc), service(0)
+{
+}
+
+//----------------------------------------------------------------------------
+void ctkDictionaryTestSuite::initTestCase()
+{
+  service = new QObject();
+  reg = pc->registerService("ctkDictionaryTestSuite", service, createTestProperties());
+  QVERIFY(reg);
+}
+
+//----------------------------------------------------------------------------
+void ctkDictionaryTestSuite::cleanupTestCase()
+{
+  reg.unregister();
+  delete service;
+}
+
+//----------------------------------------------------------------------------
+void ctkDictionaryTestSuite::testCaseInsensitiveKeys()
+{
+  ctkCaseInsensitiveString lower("service.pid");
+  ctkCaseInsensitiveString mixed("Service.PID");
+  ctkCaseInsensitiveString other("service.pie");
+
+  QVERIFY(lower == mixed);
+  QVERIFY(!(lower == other));
+  QCOMPARE(qHash(lower), qHash(mixed));
+  QVERIFY(!(lower < mixed) && !(mixed < lower));
+  QVERIFY(lower < other);
+  QVERIFY(ctkCaseInsensitiveString("a") < ctkCaseInsensitiveString("AB"));
+  QCOMPARE(QString(mixed), QString("Service.PID"));
+
+  ctkDictionary props = createTestProperties();
+  QCOMPARE(props.value("SERVICE.PID").toString(), QString("org.commontk.test.pid"));
+  props.insert("ORG.COMMONTK.TEST.KEY1", 10);
+  QCOMPARE(props.value("org.commontk.test.key1").toInt(), 10);
+  QCOMPARE(props.size(), createTestProperties().size());
+}
+
+//----------------------------------------------------------------------------
+void ctkDictionaryTestSuite::benchmarkDictionaryLookup()
+{
+  ctkDictionary props = createTestProperties();
+  const QString key("Org.CommonTK.Test.Key2");
+  int sum = 0;
+  QBENCHMARK
+  {
+    sum += props.value(key).toInt();
+  }
+  QVERIFY(sum > 0);
+}
+
+//----------------------------------------------------------------------------
+void ctkDictionaryTestSuite::benchmarkServiceReferenceProperty()
+{
+  ctkServiceReference ref = reg.getReference();
+  qlonglong sum = 0;
+  QBENCHMARK
+  {
+    sum += ref.getProperty(ctkPluginConstants::SERVICE_ID).toLongLong();
+    sum += ref.getProperty(ctkPluginConstants::OBJECTCLASS).toStringList().size();
+  }
+  QVERIFY(sum > 0);
+}
+
+//----------------------------------------------------------------------------
+void ctkDictionaryTestSuite::benchmarkEventProperty()
+{
+  ctkEvent event("org/commontk/test/DICTIONARY", createTestProperties());
+  int sum = 0;
+  QBENCHMARK
+  {
+    sum += event.getProperty("org.commontk.test.key3").toInt();
+    sum += event.getProperty("event.topics").toString().size();
+  }
+  QVERIFY(sum > 0);
+}
+
+//----------------------------------------------------------------------------
+void ctkDictionaryTestSuite::benchmarkFilterMatch()
+{
+  ctkDictionary props = createTestProperties();
+  ctkLDAPSearchFilter filter("(&(service.pid=org.commontk.test.pid)(org.commontk.test.key1=1))");
+  bool matched = false;
+  QBENCHMARK
+  {
+    matched = filter.match(props);
+  }
+  QVERIFY(matched);
+}
@@ -0,0 +1,79 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#ifndef CTKDICTIONARYTESTSUITE_P_H
+#define CTKDICTIONARYTESTSUITE_P_H
+
+#include <QObject>
+
+#include <ctkTestSuiteInterface.h>
+#include <ctkServiceRegistration.h>
+
+class ctkPluginContext;
+
+/**
+ * Tests the case insensitive key handling of ctkDictionary and
+ * benchmarks property lookups on the service registry and
+ * event admin paths.
+ */
+class ctkDictionaryTestSuite : public QObject,
+    public ctkTestSuiteInterface
+{
+  Q_OBJECT
+  Q_INTERFACES(ctkTestSuiteInterface)
+
+public:
+
+  ctkDictionaryTestSuite(ctkPluginContext* pc);
+
+private Q_SLOTS:
+
+  void initTestCase();
+  void cleanupTestCase();
+
+  // test functions
+
+  // Checks that keys differing only in case are equal,
+  // hash identically and are ordered consistently.
+  void testCaseInsensitiveKeys();
+
+  // Benchmarks a plain ctkDictionary lookup
+  void benchmarkDictionaryLookup();
+
+  // Benchmarks ctkServiceReference::getProperty()
+  void benchmarkServiceReferenceProperty();
+
+  // Benchmarks ctkEvent::getProperty()
+  void benchmarkEventProperty();
+
+  // Benchmarks LDAP filter evaluation on a ctkDictionary
+  void benchmarkFilterMatch();
+
+private:
+
+  ctkPluginContext* pc;
+  ctkServiceRegistration reg;
+  QObject* service;
+
+};
+
+#endif // CTKDICTIONARYTESTSUITE_P_H
@@ -0,0 +1,151 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#include "ctkLogStreamTestSuite_p.h"
+
+#include <service/log/ctkLogService.h>
+
+#include <QTest>
+
+//----------------------------------------------------------------------------
+class _TestLogService : public ctkLogService
+{
+
+public:
+
+  _TestLogService(int logLevel)
+    : logLevel(logLevel), count(0)
+  {
+  }
+
+  void log(int level, const QString& message, const std::exception* exception,
+           const char* file, const char* function, int line)
+  {
+    Q_UNUSED(exception)
+    Q_UNUSED(file)
+    Q_UNUSED(function)
+    Q_UNUSED(line)
+
+    lastLevel = level;
+    lastMessage = message;
+    ++count;
+  }
+
+  void log(const ctkServiceReference& sr, int level, const QString& message,
+           const std::exception* exception,
+           const char* file, const char* function, int line)
+  {
+    Q_UNUSED(sr)
+    log(level, message, exception, file, function, line);
+  }
+
+  int getLogLevel() const
+  {
+    return logLevel;
+  }
+
+  int logLevel;
+  int count;
+  int lastLevel;
+  QString lastMessage;
+};
+
+//----------------------------------------------------------------------------
+struct _FormatCounter
+{
+  _FormatCounter() : count(0) {}
+  mutable int count;
+};
+
+//----------------------------------------------------------------------------
+static QTextStream& operator<<(QTextStream& ts, const _FormatCounter& counter)
+{
+  ++counter.count;
+  return ts << "counter";
+}
+
+//----------------------------------------------------------------------------
+void ctkLogStreamTestSuite::testDiscardedLevels()
+{
+  _TestLogService log(ctkLogService::LOG_WARNING);
+  ctkLogService* logService = &log;
+  _FormatCounter counter;
+
+  QVERIFY(logService->isLogged(ctkLogService::LOG_ERROR));
+  QVERIFY(logService->isLogged(ctkLogService::LOG_WARNING));
+  QVERIFY(!logService->isLogged(ctkLogService::LOG_INFO));
+  QVERIFY(!logService->isLogged(ctkLogService::LOG_DEBUG));
+
+  CTK_DEBUG(logService) << "debug " << counter;
+  CTK_INFO(logService) << "info " << counter;
+  QCOMPARE(counter.count, 0);
+  QCOMPARE(log.count, 0);
+
+  ctkLogService* noLogService = 0;
+  CTK_ERROR(noLogService) << "error " << counter;
+  QCOMPARE(counter.count, 0);
+}
+
+//----------------------------------------------------------------------------
+void ctkLogStreamTestSuite::testLoggedLevels()
+{
+  _TestLogService log(ctkLogService::LOG_WARNING);
+  ctkLogService* logService = &log;
+  _FormatCounter counter;
+
+  CTK_WARN(logService) << "warning " << 1 << " " << true << " " << counter;
+  QCOMPARE(counter.count, 1);
+  QCOMPARE(log.count, 1);
+  QCOMPARE(log.lastLevel, ctkLogService::LOG_WARNING);
+  QCOMPARE(log.lastMessage, QString("warning 1 true counter"));
+
+  CTK_ERROR(logService) << QString("error");
+  QCOMPARE(log.count, 2);
+  QCOMPARE(log.lastLevel, ctkLogService::LOG_ERROR);
+  QCOMPARE(log.lastMessage, QString("error"));
+}
+
+//----------------------------------------------------------------------------
+void ctkLogStreamTestSuite::benchmarkDiscardedDebug()
+{
+  _TestLogService log(ctkLogService::LOG_WARNING);
+  ctkLogService* logService = &log;
+  int i = 0;
+  QBENCHMARK
+  {
+    CTK_DEBUG(logService) << "iteration " << i++ << " of " << QString("benchmarkDiscardedDebug");
+  }
+  QCOMPARE(log.count, 0);
+}
+
+//----------------------------------------------------------------------------
+void ctkLogStreamTestSuite::benchmarkLoggedDebug()
+{
+  _TestLogService log(ctkLogService::LOG_DEBUG);
+  ctkLogService* logService = &log;
+  int i = 0;
+  QBENCHMARK
+  {
+    CTK_DEBUG(logService) << "iteration " << i++ << " of " << QString("benchmarkLoggedDebug");
+  }
+  QCOMPARE(log.count, i);
+}
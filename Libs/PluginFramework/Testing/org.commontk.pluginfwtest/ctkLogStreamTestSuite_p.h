@@ -0,0 +1,59 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#ifndef CTKLOGSTREAMTESTSUITE_P_H
+#define CTKLOGSTREAMTESTSUITE_P_H
+
+#include <QObject>
+
+#include <ctkTestSuiteInterface.h>
+
+/**
+ * Tests the level checks of the logging macros and benchmarks
+ * the cost of logging statements for levels which are discarded.
+ */
+class ctkLogStreamTestSuite : public QObject,
+    public ctkTestSuiteInterface
+{
+  Q_OBJECT
+  Q_INTERFACES(ctkTestSuiteInterface)
+
+private Q_SLOTS:
+
+  // test functions
+
+  // Checks that messages of discarded levels are neither
+  // formatted nor passed to the log service.
+  void testDiscardedLevels();
+
+  // Checks the message passed for logged levels.
+  void testLoggedLevels();
+
+  // Benchmarks a CTK_DEBUG statement with debug messages discarded
+  void benchmarkDiscardedDebug();
+
+  // Benchmarks a CTK_DEBUG statement with debug messages logged
+  void benchmarkLoggedDebug();
+
+};
+
+#endif // CTKLOGSTREAMTESTSUITE_P_H
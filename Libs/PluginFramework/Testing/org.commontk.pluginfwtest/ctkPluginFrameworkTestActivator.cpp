@@ -21,6 +21,8 @@
 
 #include "ctkPluginFrameworkTestActivator_p.h"
 
+#include "ctkDictionaryTestSuite_p.h"
+#include "ctkLogStreamTestSuite_p.h"
 #include "ctkPluginFrameworkTestSuite_p.h"
 #include "ctkServiceListenerTestSuite_p.h"
 #include "ctkServiceTrackerTestSuite_p.h"
@@ -50,6 +52,16 @@ void ctkPluginFrameworkTestActivator::start(ctkPluginContext* context)
   props.clear();
   props.insert(ctkPluginConstants::SERVICE_PID, serviceTrackerTestSuite->metaObject()->className());
   context->registerService<ctkTestSuiteInterface>(serviceTrackerTestSuite, props);
+
+  dictionaryTestSuite = new ctkDictionaryTestSuite(context);
+  props.clear();
+  props.insert(ctkPluginConstants::SERVICE_PID, dictionaryTestSuite->metaObject()->className());
+  context->registerService<ctkTestSuiteInterface>(dictionaryTestSuite, props);
+
+  logStreamTestSuite = new ctkLogStreamTestSuite();
+  props.clear();
+  props.insert(ctkPluginConstants::SERVICE_PID, logStreamTestSuite->metaObject()->className());
+  context->registerService<ctkTestSuiteInterface>(logStreamTestSuite, props);
 }
 
 //----------------------------------------------------------------------------
@@ -60,6 +72,8 @@ void ctkPluginFrameworkTestActivator::stop(ctkPluginContext* context)
   delete frameworkTestSuite;
   delete serviceListenerTestSuite;
   delete serviceTrackerTestSuite;
+  delete dictionaryTestSuite;
+  delete logStreamTestSuite;
 }
 
 Q_EXPORT_PLUGIN2(org_commontk_pluginfwtest, ctkPluginFrameworkTestActivator)
@@ -42,6 +42,8 @@ private:
   QObject* frameworkTestSuite;
   QObject* serviceListenerTestSuite;
   QObject* serviceTrackerTestSuite;
+  QObject* dictionaryTestSuite;
+  QObject* logStreamTestSuite;
 };
 
 #endif // CTKPLUGINFRAMEWORKTESTACTIVATOR_H
@@ -22,28 +22,29 @@
 
 #include "ctkCaseInsensitiveString.h"
 
-#include <QHash>  // for qHash(const QString&)
+#include <QDataStream>
 
 //----------------------------------------------------------------------------
 ctkCaseInsensitiveString::ctkCaseInsensitiveString()
+  : hashValue(0)
 {
 }
 
 //----------------------------------------------------------------------------
 ctkCaseInsensitiveString::ctkCaseInsensitiveString(const char* str)
-  : str(str)
+  : str(str), hashValue(computeHash(this->str))
 {
 }
 
 //----------------------------------------------------------------------------
 ctkCaseInsensitiveString::ctkCaseInsensitiveString(const QString& str)
-  : str(str)
+  : str(str), hashValue(computeHash(str))
 {
 }
 
 //----------------------------------------------------------------------------
 ctkCaseInsensitiveString::ctkCaseInsensitiveString(const ctkCaseInsensitiveString& str)
-  : str(str.str)
+  : str(str.str), hashValue(str.hashValue)
 {
 }
 
@@ -51,19 +52,46 @@ ctkCaseInsensitiveString::ctkCaseInsensitiveString(const ctkCaseInsensitiveStrin
 ctkCaseInsensitiveString& ctkCaseInsensitiveString::operator=(const ctkCaseInsensitiveString& str)
 {
   this->str = str.str;
+  this->hashValue = str.hashValue;
   return *this;
 }
 
 //----------------------------------------------------------------------------
 bool ctkCaseInsensitiveString::operator==(const ctkCaseInsensitiveString& str) const
 {
-  return this->str.toLower() == str.str.toLower();
+  if (this->hashValue != str.hashValue) return false;
+
+  const int len = this->str.size();
+  if (len != str.str.size()) return false;
+
+  const QChar* c1 = this->str.unicode();
+  const QChar* c2 = str.str.unicode();
+  if (c1 == c2) return true;
+
+  for (int i = 0; i < len; ++i)
+  {
+    if (c1[i] != c2[i] && c1[i].toCaseFolded() != c2[i].toCaseFolded())
+      return false;
+  }
+  return true;
 }
 
 //----------------------------------------------------------------------------
 bool ctkCaseInsensitiveString::operator<(const ctkCaseInsensitiveString& str) const
 {
-  return this->str.toLower() < str.str.toLower();
+  const int len1 = this->str.size();
+  const int len2 = str.str.size();
+  const QChar* c1 = this->str.unicode();
+  const QChar* c2 = str.str.unicode();
+
+  const int len = qMin(len1, len2);
+  for (int i = 0; i < len; ++i)
+  {
+    const ushort f1 = c1[i].toCaseFolded().unicode();
+    const ushort f2 = c2[i].toCaseFolded().unicode();
+    if (f1 != f2) return f1 < f2;
+  }
+  return len1 < len2;
 }
 
 //----------------------------------------------------------------------------
@@ -72,10 +100,34 @@ ctkCaseInsensitiveString::operator QString() const
   return this->str;
 }
 
+//----------------------------------------------------------------------------
+uint ctkCaseInsensitiveString::hash() const
+{
+  return this->hashValue;
+}
+
+//----------------------------------------------------------------------------
+uint ctkCaseInsensitiveString::computeHash(const QString& str)
+{
+  // Same algorithm as qHash(const QString&), applied to the
+  // case folded characters without creating a folded copy
+  const QChar* p = str.unicode();
+  int n = str.size();
+  uint h = 0;
+
+  while (n--)
+  {
+    h = (h << 4) + (*p++).toCaseFolded().unicode();
+    h ^= (h & 0xf0000000) >> 23;
+    h &= 0x0fffffff;
+  }
+  return h;
+}
+
 //----------------------------------------------------------------------------
 uint qHash(const ctkCaseInsensitiveString& str)
 {
-  return qHash(QString(str).toLower());
+  return str.hash();
 }
 
 //----------------------------------------------------------------------------
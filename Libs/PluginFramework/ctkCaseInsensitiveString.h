@@ -34,6 +34,11 @@
  * used in Qt container classes as a key type representing
  * case insensitive strings. However, case is preserved when
  * retrieving the actual QString.
+ *
+ * Comparisons and hashing fold the case of each character in
+ * place and never allocate. The hash value is computed once on
+ * construction, so repeated lookups with the same key instance
+ * (e.g. a static constant) do not need to re-hash the string.
  */
 class CTK_PLUGINFW_EXPORT ctkCaseInsensitiveString
 {
@@ -78,8 +83,8 @@ public:
    * String comparison ignoring case.
    *
    * @param str The string with which to compare this instance.
-   * @return <code>true</code> if both strings are equal after being
-   *         converted to lower case strings, <code>false</code> otherwise.
+   * @return <code>true</code> if both strings are equal after their
+   *         case has been folded, <code>false</code> otherwise.
    */
   bool operator==(const ctkCaseInsensitiveString& str) const;
 
@@ -87,9 +92,9 @@ public:
    * Less than operator ignoring case.
    *
    * @param str The string with which to compare this instance.
-   * @return <code>true</code> if the lower case variant of the
+   * @return <code>true</code> if the case folded variant of the
    *         current string is lexicographically less then
-   *         the lower case variant of <code>str</code>, <code>false</code>
+   *         the case folded variant of <code>str</code>, <code>false</code>
    *         otherwise.
    */
   bool operator<(const ctkCaseInsensitiveString& str) const;
@@ -100,16 +105,24 @@ public:
    */
   operator QString() const;
 
+  /**
+   * Returns the case insensitive hash value of this string.
+   */
+  uint hash() const;
+
 private:
 
+  static uint computeHash(const QString& str);
+
   QString str;
+  uint hashValue;
 };
 
 /**
  * \ingroup PluginFramework
  * @{
  *
- * Returns a hash value for the lower case string.
+ * Returns a hash value for the case folded string.
  *
  * @param str The string to be hashed.
  */
@@ -20,40 +20,10 @@
 =============================================================================*/
 
 
-#ifndef CTKEASYNCMASTERTHREAD_P_H
-#define CTKEASYNCMASTERTHREAD_P_H
+#include "ctkDictionaryKeys_p.h"
 
-#include "ctkEAInterruptibleThread_p.h"
-
-
-/**
- * Used to execute synchronuous tasks. This is not done
- * in the main thread because we need to be able to
- * interrupt the thread waiting on a synchronuous task
- * (for example on a timeout). ctkEAInterruptibleThread
- * provides this capability.
- */
-class ctkEASyncMasterThread : public QObject
-{
-  Q_OBJECT
-
-public:
-  ctkEASyncMasterThread();
-
-  void syncRun(QRunnable* command);
-
-  void stop();
-
-public Q_SLOTS:
-
-  void runCommand();
-
-private:
-
-  ctkEAInterruptibleThread thread;
-  QRunnable* command;
-  QMutex mutex;
-  QWaitCondition waitCond;
-};
-
-#endif // CTKEASYNCMASTERTHREAD_P_H
+const ctkCaseInsensitiveString ctkDictionaryKeys::OBJECTCLASS = "objectclass";
+const ctkCaseInsensitiveString ctkDictionaryKeys::SERVICE_ID = "service.id";
+const ctkCaseInsensitiveString ctkDictionaryKeys::SERVICE_PID = "service.pid";
+const ctkCaseInsensitiveString ctkDictionaryKeys::SERVICE_RANKING = "service.ranking";
+const ctkCaseInsensitiveString ctkDictionaryKeys::EVENT_TOPIC = "event.topics";
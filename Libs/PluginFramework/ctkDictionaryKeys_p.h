@@ -0,0 +1,58 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#ifndef CTKDICTIONARYKEYS_P_H
+#define CTKDICTIONARYKEYS_P_H
+
+#include "ctkCaseInsensitiveString.h"
+
+/**
+ * \ingroup PluginFramework
+ *
+ * Interned ctkCaseInsensitiveString instances for property keys
+ * which are looked up on hot paths of the service registry and the
+ * event admin. Using these instead of the ctkPluginConstants and
+ * ctkEventConstants QString values avoids re-hashing the key on
+ * every ctkDictionary lookup.
+ *
+ * The values are initialized from string literals to avoid depending
+ * on the static initialization order of the QString constants.
+ */
+struct ctkDictionaryKeys
+{
+  // ATTENTION!!! Keep in sync with ctkPluginConstants::OBJECTCLASS
+  static const ctkCaseInsensitiveString OBJECTCLASS; // = "objectclass"
+
+  // ATTENTION!!! Keep in sync with ctkPluginConstants::SERVICE_ID
+  static const ctkCaseInsensitiveString SERVICE_ID; // = "service.id"
+
+  // ATTENTION!!! Keep in sync with ctkPluginConstants::SERVICE_PID
+  static const ctkCaseInsensitiveString SERVICE_PID; // = "service.pid"
+
+  // ATTENTION!!! Keep in sync with ctkPluginConstants::SERVICE_RANKING
+  static const ctkCaseInsensitiveString SERVICE_RANKING; // = "service.ranking"
+
+  // ATTENTION!!! Keep in sync with ctkEventConstants::EVENT_TOPIC
+  static const ctkCaseInsensitiveString EVENT_TOPIC; // = "event.topics"
+};
+
+#endif // CTKDICTIONARYKEYS_P_H
@@ -278,8 +278,9 @@ bool ctkLDAPExpr::query( const QString &filter, const ctkDictionary &pd )
 bool ctkLDAPExpr::evaluate( const ctkDictionary &p, bool matchCase ) const
 {
   if ((d->m_operator & SIMPLE) != 0) {
-    return compare(p[ matchCase ? d->m_attrName : d->m_attrName.toLower() ],
-      d->m_operator, d->m_attrValue);
+    // ctkDictionary keys are case insensitive, so there is no need
+    // to create a lower case copy of the attribute name
+    return compare(p.value(d->m_attrName), d->m_operator, d->m_attrValue);
   } else { // (d->m_operator & COMPLEX) != 0
     switch (d->m_operator) {
     case AND:
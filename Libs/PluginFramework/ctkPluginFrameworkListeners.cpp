@@ -23,6 +23,7 @@
 
 #include "ctkPluginFrameworkContext_p.h"
 #include "ctkPluginConstants.h"
+#include "ctkDictionaryKeys_p.h"
 #include "ctkLDAPExpr_p.h"
 #include "ctkServiceReferencePrivate.h"
 
@@ -130,20 +131,20 @@ QSet<ctkServiceSlotEntry> ctkPluginFrameworkListeners::getMatchingServiceSlots(
   }
 
   // Check the cache
-  QStringList c = sr.d_func()->getProperty(ctkPluginConstants::OBJECTCLASS, lockProps).toStringList();
+  QStringList c = sr.d_func()->getProperty(ctkDictionaryKeys::OBJECTCLASS, lockProps).toStringList();
   foreach (QString objClass, c)
   {
     addToSet(set, OBJECTCLASS_IX, objClass);
   }
 
   bool ok = false;
-  qlonglong service_id = sr.d_func()->getProperty(ctkPluginConstants::SERVICE_ID, lockProps).toLongLong(&ok);
+  qlonglong service_id = sr.d_func()->getProperty(ctkDictionaryKeys::SERVICE_ID, lockProps).toLongLong(&ok);
   if (ok)
   {
     addToSet(set, SERVICE_ID_IX, QString::number(service_id));
   }
 
-  QStringList service_pids = sr.d_func()->getProperty(ctkPluginConstants::SERVICE_PID, lockProps).toStringList();
+  QStringList service_pids = sr.d_func()->getProperty(ctkDictionaryKeys::SERVICE_PID, lockProps).toStringList();
   foreach (QString service_pid, service_pids)
   {
     addToSet(set, SERVICE_PID_IX, service_pid);
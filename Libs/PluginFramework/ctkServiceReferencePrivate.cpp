@@ -25,6 +25,7 @@
 #include <QMutexLocker>
 
 #include "ctkPluginConstants.h"
+#include "ctkDictionaryKeys_p.h"
 #include "ctkServiceFactory.h"
 #include "ctkServiceException.h"
 #include "ctkPluginPrivate_p.h"
@@ -59,7 +60,7 @@ QObject* ctkServiceReferencePrivate::getService(QSharedPointer<ctkPlugin> plugin
       if (count == 0)
       {
         QStringList classes =
-            registration->properties.value(ctkPluginConstants::OBJECTCLASS).toStringList();
+            registration->properties.value(ctkDictionaryKeys::OBJECTCLASS).toStringList();
         registration->dependents[plugin] = 1;
         if (ctkServiceFactory* serviceFactory = qobject_cast<ctkServiceFactory*>(registration->getService()))
         {
@@ -177,7 +178,7 @@ ctkDictionary ctkServiceReferencePrivate::getProperties() const
 }
 
 //----------------------------------------------------------------------------
-QVariant ctkServiceReferencePrivate::getProperty(const QString& key, bool lock) const
+QVariant ctkServiceReferencePrivate::getProperty(const ctkCaseInsensitiveString& key, bool lock) const
 {
   if (lock)
   {
@@ -92,7 +92,7 @@ public:
    * @return The property value to which the key is mapped; an invalid QVariant
    *         if there is no property named after the key.
    */
-  QVariant getProperty(const QString& key, bool lock) const;
+  QVariant getProperty(const ctkCaseInsensitiveString& key, bool lock) const;
 
   /**
    * Reference count for implicitly shared private implementation.
@@ -24,6 +24,7 @@
 #include "ctkPluginFrameworkContext_p.h"
 #include "ctkPluginPrivate_p.h"
 #include "ctkPluginConstants.h"
+#include "ctkDictionaryKeys_p.h"
 
 #include "ctkServices_p.h"
 #include "ctkServiceFactory.h"
@@ -117,12 +118,12 @@ void ctkServiceRegistration::setProperties(const ctkDictionary& props)
     if (d->available)
     {
       // NYI! Optimize the MODIFIED_ENDMATCH code
-      int old_rank = d->properties.value(ctkPluginConstants::SERVICE_RANKING).toInt();
+      int old_rank = d->properties.value(ctkDictionaryKeys::SERVICE_RANKING).toInt();
       before = d->plugin->fwCtx->listeners.getMatchingServiceSlots(d->reference, false);
-      QStringList classes = d->properties.value(ctkPluginConstants::OBJECTCLASS).toStringList();
-      qlonglong sid = d->properties.value(ctkPluginConstants::SERVICE_ID).toLongLong();
+      QStringList classes = d->properties.value(ctkDictionaryKeys::OBJECTCLASS).toStringList();
+      qlonglong sid = d->properties.value(ctkDictionaryKeys::SERVICE_ID).toLongLong();
       d->properties = ctkServices::createServiceProperties(props, classes, sid);
-      int new_rank = d->properties.value(ctkPluginConstants::SERVICE_RANKING).toInt();
+      int new_rank = d->properties.value(ctkDictionaryKeys::SERVICE_RANKING).toInt();
       if (old_rank != new_rank)
       {
         d->plugin->fwCtx->services->updateServiceRegistrationOrder(*this, classes);
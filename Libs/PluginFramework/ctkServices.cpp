@@ -29,6 +29,7 @@
 
 #include "ctkServiceFactory.h"
 #include "ctkPluginConstants.h"
+#include "ctkDictionaryKeys_p.h"
 #include "ctkPluginFrameworkContext_p.h"
 #include "ctkServiceException.h"
 #include "ctkServiceRegistrationPrivate.h"
@@ -53,10 +54,10 @@ ctkDictionary ctkServices::createServiceProperties(const ctkDictionary& in,
 
   if (!classes.isEmpty())
   {
-    props.insert(ctkPluginConstants::OBJECTCLASS, classes);
+    props.insert(ctkDictionaryKeys::OBJECTCLASS, classes);
   }
 
-  props.insert(ctkPluginConstants::SERVICE_ID, sid != -1 ? sid : nextServiceID++);
+  props.insert(ctkDictionaryKeys::SERVICE_ID, sid != -1 ? sid : nextServiceID++);
 
   return props;
 }
@@ -271,7 +272,7 @@ void ctkServices::removeServiceRegistration(const ctkServiceRegistration& sr)
 {
   QMutexLocker lock(&mutex);
 
-  QStringList classes = sr.d_func()->properties.value(ctkPluginConstants::OBJECTCLASS).toStringList();
+  QStringList classes = sr.d_func()->properties.value(ctkDictionaryKeys::OBJECTCLASS).toStringList();
   services.remove(sr);
   for (QStringListIterator i(classes); i.hasNext(); )
   {
@@ -22,6 +22,7 @@
 #include "ctkEvent.h"
 
 #include "ctkEventConstants.h"
+#include <ctkDictionaryKeys_p.h>
 
 #include <stdexcept>
 
@@ -34,7 +35,7 @@ public:
     : topic(topic), properties(properties)
   {
     validateTopicName(topic);
-    this->properties.insert(ctkEventConstants::EVENT_TOPIC, topic);
+    this->properties.insert(ctkDictionaryKeys::EVENT_TOPIC, topic);
   }
 
   static void validateTopicName(const QString& topic)
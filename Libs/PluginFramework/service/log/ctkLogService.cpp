@@ -27,6 +27,12 @@ const int ctkLogService::LOG_WARNING = 2;
 const int ctkLogService::LOG_INFO = 3;
 const int ctkLogService::LOG_DEBUG = 4;
 
+//----------------------------------------------------------------------------
+bool ctkLogService::isLogged(int level) const
+{
+  return level <= getLogLevel();
+}
+
 //----------------------------------------------------------------------------
 ctkLogStreamWithServiceRef::ctkLogStreamWithServiceRef(ctkLogService* logService, const ctkServiceReference& sr,
                                                        int level, const std::exception* exc, const char* file,
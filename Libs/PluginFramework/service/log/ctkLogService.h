@@ -155,6 +155,19 @@ struct CTK_PLUGINFW_EXPORT ctkLogService
    */
   virtual int getLogLevel() const = 0;
 
+  /**
+   * Checks if a message with the given level would be logged, that is if
+   * <code>level</code> is not less severe than the current log level. The
+   * logging macros use this to skip formatting messages which are discarded.
+   *
+   * <p>
+   * The default implementation compares <code>level</code> with getLogLevel().
+   *
+   * \param level The severity of the message.
+   * \return <code>true</code> if messages with this level are logged.
+   */
+  virtual bool isLogged(int level) const;
+
 };
 
 Q_DECLARE_INTERFACE(ctkLogService, "org.commontk.service.log.LogService")
@@ -196,82 +209,82 @@ public:
  */
 
 #define CTK_DEBUG(logService) \
-  ((logService && logService->getLogLevel() >= ctkLogService::LOG_DEBUG) ? \
+  ((logService && logService->isLogged(ctkLogService::LOG_DEBUG)) ? \
   ctkLogStream(logService, ctkLogService::LOG_DEBUG, 0, __FILE__, __FUNCTION__, __LINE__) : \
   ctkNullLogStream())
 
 #define CTK_DEBUG_EXC(logService, exc) \
-  ((logService && logService->getLogLevel() >= ctkLogService::LOG_DEBUG) ? \
+  ((logService && logService->isLogged(ctkLogService::LOG_DEBUG)) ? \
   ctkLogStream(logService, ctkLogService::LOG_DEBUG, exc, __FILE__, __FUNCTION__, __LINE__) : \
   ctkNullLogStream())
 
 #define CTK_DEBUG_SR(logService, serviceRef) \
-  ((logService && logService->getLogLevel() >= ctkLogService::LOG_DEBUG) ? \
+  ((logService && logService->isLogged(ctkLogService::LOG_DEBUG)) ? \
   static_cast<ctkLogStream>(ctkLogStreamWithServiceRef(logService, serviceRef, ctkLogService::LOG_DEBUG, 0, __FILE__, __FUNCTION__, __LINE__)) : \
   static_cast<ctkLogStream>(ctkNullLogStream()))
 
 #define CTK_DEBUG_SR_EXC(logService, serviceRef, exc) \
-  ((logService && logService->getLogLevel() >= ctkLogService::LOG_DEBUG) ? \
+  ((logService && logService->isLogged(ctkLogService::LOG_DEBUG)) ? \
   static_cast<ctkLogStream>(ctkLogStreamWithServiceRef(logService, serviceRef, ctkLogService::LOG_DEBUG, exc, __FILE__, __FUNCTION__, __LINE__)) : \
   static_cast<ctkLogStream>(ctkNullLogStream()))
 
 #define CTK_INFO(logService) \
-  ((logService && logService->getLogLevel() >= ctkLogService::LOG_INFO) ? \
+  ((logService && logService->isLogged(ctkLogService::LOG_INFO)) ? \
   ctkLogStream(logService, ctkLogService::LOG_INFO, 0, __FILE__, __FUNCTION__, __LINE__) : \
   ctkNullLogStream())
 
 #define CTK_INFO_EXC(logService, exc) \
-  ((logService && logService->getLogLevel() >= ctkLogService::LOG_INFO) ? \
+  ((logService && logService->isLogged(ctkLogService::LOG_INFO)) ? \
   ctkLogStream(logService, ctkLogService::LOG_INFO, exc, __FILE__, __FUNCTION__, __LINE__) : \
   ctkNullLogStream())
 
 #define CTK_INFO_SR(logService, serviceRef) \
-  ((logService && logService->getLogLevel() >= ctkLogService::LOG_INFO) ? \
+  ((logService && logService->isLogged(ctkLogService::LOG_INFO)) ? \
   static_cast<ctkLogStream>(ctkLogStreamWithServiceRef(logService, serviceRef, ctkLogService::LOG_INFO, 0, __FILE__, __FUNCTION__, __LINE__)) : \
   static_cast<ctkLogStream>(ctkNullLogStream()))
 
 #define CTK_INFO_SR_EXC(logService, serviceRef, exc) \
-  ((logService && logService->getLogLevel() >= ctkLogService::LOG_INFO) ? \
+  ((logService && logService->isLogged(ctkLogService::LOG_INFO)) ? \
   static_cast<ctkLogStream>(ctkLogStreamWithServiceRef(logService, serviceRef, ctkLogService::LOG_INFO, exc, __FILE__, __FUNCTION__, __LINE__)) : \
   static_cast<ctkLogStream>(ctkNullLogStream()))
 
 #define CTK_WARN(logService) \
-  ((logService && logService->getLogLevel() >= ctkLogService::LOG_WARNING) ? \
+  ((logService && logService->isLogged(ctkLogService::LOG_WARNING)) ? \
   ctkLogStream(logService, ctkLogService::LOG_WARNING, 0, __FILE__, __FUNCTION__, __LINE__) : \
   ctkNullLogStream())
 
 #define CTK_WARN_EXC(logService, exc) \
-  ((logService && logService->getLogLevel() >= ctkLogService::LOG_WARNING) ? \
+  ((logService && logService->isLogged(ctkLogService::LOG_WARNING)) ? \
   ctkLogStream(logService, ctkLogService::LOG_WARNING, exc, __FILE__, __FUNCTION__, __LINE__) : \
   ctkNullLogStream())
 
 #define CTK_WARN_SR(logService, serviceRef) \
-  ((logService && logService->getLogLevel() >= ctkLogService::LOG_WARNING) ? \
+  ((logService && logService->isLogged(ctkLogService::LOG_WARNING)) ? \
   static_cast<ctkLogStream>(ctkLogStreamWithServiceRef(logService, serviceRef, ctkLogService::LOG_WARNING, 0, __FILE__, __FUNCTION__, __LINE__)) : \
   static_cast<ctkLogStream>(ctkNullLogStream()))
 
 #define CTK_WARN_SR_EXC(logService, serviceRef, exc) \
-  ((logService && logService->getLogLevel() >= ctkLogService::LOG_WARNING) ? \
+  ((logService && logService->isLogged(ctkLogService::LOG_WARNING)) ? \
   static_cast<ctkLogStream>(ctkLogStreamWithServiceRef(logService, serviceRef, ctkLogService::LOG_WARNING, exc, __FILE__, __FUNCTION__, __LINE__)) : \
   static_cast<ctkLogStream>(ctkNullLogStream()))
 
 #define CTK_ERROR(logService) \
-  ((logService && logService->getLogLevel() >= ctkLogService::LOG_ERROR) ? \
+  ((logService && logService->isLogged(ctkLogService::LOG_ERROR)) ? \
   ctkLogStream(logService, ctkLogService::LOG_ERROR, 0, __FILE__, __FUNCTION__, __LINE__) : \
   ctkNullLogStream())
 
 #define CTK_ERROR_EXC(logService, exc) \
-  ((logService && logService->getLogLevel() >= ctkLogService::LOG_ERROR) ? \
+  ((logService && logService->isLogged(ctkLogService::LOG_ERROR)) ? \
   ctkLogStream(logService, ctkLogService::LOG_ERROR, exc, __FILE__, __FUNCTION__, __LINE__) : \
   ctkNullLogStream())
 
 #define CTK_ERROR_SR(logService, serviceRef) \
-  ((logService && logService->getLogLevel() >= ctkLogService::LOG_ERRO) ? \
+  ((logService && logService->isLogged(ctkLogService::LOG_ERROR)) ? \
   static_cast<ctkLogStream>(ctkLogStreamWithServiceRef(logService, serviceRef, ctkLogService::LOG_ERROR, 0, __FILE__, __FUNCTION__, __LINE__)) : \
   static_cast<ctkLogStream>(ctkNullLogStream()))
 
 #define CTK_ERROR_SR_EXC(logService, serviceRef, exc) \
-  ((logService && logService->getLogLevel() >= ctkLogService::LOG_ERROR) ? \
+  ((logService && logService->isLogged(ctkLogService::LOG_ERROR)) ? \
   static_cast<ctkLogStream>(ctkLogStreamWithServiceRef(logService, serviceRef, ctkLogService::LOG_ERROR, exc, __FILE__, __FUNCTION__, __LINE__)) : \
   static_cast<ctkLogStream>(ctkNullLogStream()))
 
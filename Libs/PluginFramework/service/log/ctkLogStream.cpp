@@ -26,20 +26,18 @@
 //----------------------------------------------------------------------------
 ctkLogStream::ctkLogStream(ctkLogService* logService, int level, const std::exception* exc,
                            const char* file, const char* function, int line)
-  : logged(false), logService(logService), level(level), exc(exc),
+  : ts(0), logged(false), logService(logService), level(level), exc(exc),
     file(file), function(function), line(line)
 {
-  ts.setString(&msg);
 }
 
 //----------------------------------------------------------------------------
 ctkLogStream::ctkLogStream(const ctkLogStream& logStream)
- : msg(logStream.msg), logged(false),
+ : msg(logStream.msg), ts(0), logged(false),
    logService(logStream.logService), level(logStream.level),
    exc(logStream.exc), file(logStream.file), function(logStream.function),
    line(logStream.line)
 {
-  ts.setString(&msg);
 }
 
 //----------------------------------------------------------------------------
@@ -49,5 +47,16 @@ ctkLogStream::~ctkLogStream()
   {
     logService->log(level, msg, exc, file, function, line);
   }
+  delete ts;
+}
+
+//----------------------------------------------------------------------------
+QTextStream& ctkLogStream::textStream()
+{
+  if (ts == 0)
+  {
+    ts = new QTextStream(&msg);
+  }
+  return *ts;
 }
 
@@ -31,6 +31,10 @@ struct ctkLogService;
 
 /**
  * \ingroup LogService
+ *
+ * Collects a log message and passes it to the log service when destroyed.
+ * A stream without a log service, as created by the logging macros for
+ * levels which are not logged, ignores its input without formatting it.
  */
 class CTK_PLUGINFW_EXPORT ctkLogStream
 {
@@ -45,26 +49,29 @@ public:
   template<class T>
   ctkLogStream& operator <<(const T& t)
   {
-    ts << t;
+    if (logService) textStream() << t;
     return *this;
   }
 
   ctkLogStream& operator <<(const char* c)
   {
-    ts << c;
+    if (logService) textStream() << c;
     return *this;
   }
 
   ctkLogStream& operator <<(bool b)
   {
-    ts << (b ? "true" : "false");
+    if (logService) textStream() << (b ? "true" : "false");
     return *this;
   }
 
 protected:
 
+  QTextStream& textStream();
+
   QString msg;
-  QTextStream ts;
+  /** Created on first use */
+  QTextStream* ts;
   bool logged;
 
   ctkLogService* logService;
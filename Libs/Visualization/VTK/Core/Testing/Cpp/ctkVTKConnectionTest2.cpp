@@ -0,0 +1,205 @@
+/*=========================================================================
+
+  Library:   CTK
+
+  Copyright (c) Kitware Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=========================================================================*/
+// Qt includes
+#include <QCoreApplication>
+#include <QDebug>
+#include <QObject>
+
+// CTKVTK includes
+#include "ctkVTKConnection.h"
+
+// VTK includes
+#include <vtkCommand.h>
+#include <vtkObject.h>
+#include <vtkSmartPointer.h>
+
+// STD includes
+#include <cstdlib>
+#include <iostream>
+
+//-----------------------------------------------------------------------------
+class ctkVTKConnectionTestReceiver: public QObject
+{
+  Q_OBJECT
+public:
+  ctkVTKConnectionTestReceiver()
+    : CallCount(0), LastCaller(0), LastEvent(vtkCommand::NoEvent), LastSender(0)
+  {
+  }
+  int           CallCount;
+  vtkObject*    LastCaller;
+  unsigned long LastEvent;
+  QObject*      LastSender;
+
+public Q_SLOTS:
+  void onEvent(vtkObject* caller, void* vtkNotUsed(callData), unsigned long event)
+  {
+    ++this->CallCount;
+    this->LastCaller = caller;
+    this->LastEvent = event;
+    this->LastSender = this->sender();
+  }
+};
+
+//-----------------------------------------------------------------------------
+int ctkVTKConnectionTest2( int argc, char * argv [] )
+{
+  QCoreApplication app(argc, argv);
+
+  vtkSmartPointer<vtkObject> obj = vtkSmartPointer<vtkObject>::New();
+
+  // Direct connection: the slot is called without going through a signal
+  ctkVTKConnectionTestReceiver directReceiver;
+  ctkVTKConnection* directConnection = new ctkVTKConnection(&directReceiver);
+  directConnection->observeDeletion(true);
+  directConnection->setup(obj, vtkCommand::ModifiedEvent,
+                          &directReceiver, SLOT(onEvent(vtkObject*,void*,ulong)),
+                          0.f, Qt::DirectConnection);
+  obj->Modified();
+  if (directReceiver.CallCount != 1 ||
+      directReceiver.LastCaller != obj.GetPointer() ||
+      directReceiver.LastEvent != vtkCommand::ModifiedEvent ||
+      directReceiver.LastSender != 0)
+    {
+    std::cerr << "Line " << __LINE__ << " - Direct connection failed: "
+              << directReceiver.CallCount << " calls" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  directConnection->setBlocked(true);
+  obj->Modified();
+  directConnection->setBlocked(false);
+  if (directReceiver.CallCount != 1)
+    {
+    std::cerr << "Line " << __LINE__ << " - Blocked connection called the slot"
+              << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Auto connections still emit the signal
+  ctkVTKConnectionTestReceiver autoReceiver;
+  ctkVTKConnection* autoConnection = new ctkVTKConnection(&autoReceiver);
+  autoConnection->observeDeletion(true);
+  autoConnection->setup(obj, vtkCommand::ModifiedEvent,
+                        &autoReceiver, SLOT(onEvent(vtkObject*,void*,ulong)));
+  obj->Modified();
+  if (autoReceiver.CallCount != 1 || directReceiver.CallCount != 2 ||
+      autoReceiver.LastSender != autoConnection)
+    {
+    std::cerr << "Line " << __LINE__ << " - Auto connection failed: "
+              << autoReceiver.CallCount << " calls" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  delete directConnection;
+  obj->Modified();
+  if (directReceiver.CallCount != 2)
+    {
+    std::cerr << "Line " << __LINE__ << " - Deleted connection called the slot"
+              << std::endl;
+    return EXIT_FAILURE;
+    }
+  delete autoConnection;
+
+  // A slot with incompatible arguments is rejected, not called directly
+  ctkVTKConnectionTestReceiver mismatchReceiver;
+  mismatchReceiver.setObjectName("mismatch");
+  ctkVTKConnection* mismatchConnection = new ctkVTKConnection(&mismatchReceiver);
+  mismatchConnection->observeDeletion(true);
+  mismatchConnection->setup(obj, vtkCommand::ModifiedEvent,
+                            &mismatchReceiver, SLOT(setObjectName(QString)),
+                            0.f, Qt::DirectConnection);
+  obj->Modified();
+  if (mismatchReceiver.objectName() != "mismatch")
+    {
+    std::cerr << "Line " << __LINE__ << " - Incompatible slot called" << std::endl;
+    return EXIT_FAILURE;
+    }
+  delete mismatchConnection;
+
+  // Queued connection with compression: one call per event loop iteration
+  ctkVTKConnectionTestReceiver queuedReceiver;
+  ctkVTKConnection* queuedConnection = new ctkVTKConnection(&queuedReceiver);
+  queuedConnection->observeDeletion(true);
+  queuedConnection->setEventCompression(true);
+  if (!queuedConnection->eventCompression())
+    {
+    std::cerr << "Line " << __LINE__ << " - setEventCompression failed"
+              << std::endl;
+    return EXIT_FAILURE;
+    }
+  queuedConnection->setup(obj, vtkCommand::AnyEvent,
+                          &queuedReceiver, SLOT(onEvent(vtkObject*,void*,ulong)),
+                          0.f, Qt::QueuedConnection);
+  for (int i = 0; i < 100; ++i)
+    {
+    obj->Modified();
+    }
+  obj->InvokeEvent(vtkCommand::UserEvent);
+  if (queuedReceiver.CallCount != 0)
+    {
+    std::cerr << "Line " << __LINE__ << " - Queued connection called the slot"
+              << std::endl;
+    return EXIT_FAILURE;
+    }
+  QCoreApplication::processEvents();
+  if (queuedReceiver.CallCount != 1 ||
+      queuedReceiver.LastEvent != vtkCommand::UserEvent)
+    {
+    std::cerr << "Line " << __LINE__ << " - Events not compressed: "
+              << queuedReceiver.CallCount << " calls" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Deleting the connection drops the pending event
+  obj->Modified();
+  delete queuedConnection;
+  QCoreApplication::processEvents();
+  if (queuedReceiver.CallCount != 1)
+    {
+    std::cerr << "Line " << __LINE__ << " - Pending event called after deletion"
+              << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Without compression, every event is queued
+  ctkVTKConnectionTestReceiver uncompressedReceiver;
+  ctkVTKConnection* uncompressedConnection = new ctkVTKConnection(&uncompressedReceiver);
+  uncompressedConnection->observeDeletion(true);
+  uncompressedConnection->setup(obj, vtkCommand::ModifiedEvent,
+                                &uncompressedReceiver, SLOT(onEvent(vtkObject*,void*,ulong)),
+                                0.f, Qt::QueuedConnection);
+  for (int i = 0; i < 10; ++i)
+    {
+    obj->Modified();
+    }
+  QCoreApplication::processEvents();
+  if (uncompressedReceiver.CallCount != 10)
+    {
+    std::cerr << "Line " << __LINE__ << " - Queued connection failed: "
+              << uncompressedReceiver.CallCount << " calls" << std::endl;
+    return EXIT_FAILURE;
+    }
+  delete uncompressedConnection;
+
+  return EXIT_SUCCESS;
+}
+
+#include "moc_ctkVTKConnectionTest2.cpp"
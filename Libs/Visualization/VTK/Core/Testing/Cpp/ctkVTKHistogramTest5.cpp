@@ -0,0 +1,141 @@
+// Qt includes
+#include <QCoreApplication>
+#include <QSharedPointer>
+
+// CTKVTK includes
+#include "ctkVTKHistogram.h"
+
+// VTK includes
+#include <vtkSmartPointer.h>
+#include <vtkDataArray.h>
+#include <vtkMath.h>
+
+// STD includes
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+int binValue(const ctkVTKHistogram& histogram, int index)
+{
+  QSharedPointer<ctkControlPoint> point(histogram.controlPoint(index));
+  return point->value().toInt();
+}
+
+int totalCount(const ctkVTKHistogram& histogram)
+{
+  int total = 0;
+  for (int i = 0; i < histogram.count(); ++i)
+    {
+    total += binValue(histogram, i);
+    }
+  return total;
+}
+}
+
+int ctkVTKHistogramTest5( int argc, char * argv [])
+{
+  Q_UNUSED(argc);
+  Q_UNUSED(argv);
+
+//---------------------------------------------------
+// test 5 : large arrays, processed by several threads
+//---------------------------------------------------
+
+  //------Test short array (single pass)--------------
+  const int tupleCount = 1000000;
+  vtkSmartPointer<vtkDataArray> shortArray;
+  shortArray.TakeReference(vtkDataArray::CreateDataArray(VTK_SHORT));
+  shortArray->SetNumberOfTuples(tupleCount);
+  for (int i = 0; i < tupleCount; ++i)
+    {
+    shortArray->SetTuple1(i, (i * 7919) % 2000 - 1000);
+    }
+  ctkVTKHistogram shortHistogram(shortArray);
+  shortHistogram.build();
+
+  qreal range[2];
+  shortHistogram.range(range[0], range[1]);
+  if (shortHistogram.count() != 2000 ||
+      range[0] != -1000 || range[1] != 999)
+    {
+    std::cerr << "Line : " << __LINE__
+              << " - Problem with ctkVTKHistogram::build: "
+              << shortHistogram.count() << " bins, range "
+              << range[0] << " " << range[1] << std::endl;
+    return EXIT_FAILURE;
+    }
+  for (int i = 0; i < shortHistogram.count(); ++i)
+    {
+    if (binValue(shortHistogram, i) != tupleCount / 2000)
+      {
+      std::cerr << "Line : " << __LINE__
+                << " - Problem with ctkVTKHistogram::build: bin " << i
+                << " has " << binValue(shortHistogram, i) << " values"
+                << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  //------Test short array with user bins-------------
+  shortHistogram.setNumberOfBins(10);
+  shortHistogram.build();
+  if (shortHistogram.count() != 10 ||
+      binValue(shortHistogram, 0) != tupleCount / 10 ||
+      binValue(shortHistogram, 9) != tupleCount / 10)
+    {
+    std::cerr << "Line : " << __LINE__
+              << " - Problem with ctkVTKHistogram::setNumberOfBins "
+              << shortHistogram.count() << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  //------Test wide int array (capped bins)-----------
+  vtkSmartPointer<vtkDataArray> intArray;
+  intArray.TakeReference(vtkDataArray::CreateDataArray(VTK_INT));
+  intArray->SetNumberOfTuples(tupleCount);
+  for (int i = 0; i < tupleCount; ++i)
+    {
+    intArray->SetTuple1(i, i * 1000 - 100000000);
+    }
+  ctkVTKHistogram intHistogram(intArray);
+  intHistogram.build();
+  if (intHistogram.count() != 65536)
+    {
+    std::cerr << "Line : " << __LINE__
+              << " - Problem with ctkVTKHistogram::build: "
+              << intHistogram.count() << " bins" << std::endl;
+    return EXIT_FAILURE;
+    }
+  if (totalCount(intHistogram) != tupleCount ||
+      binValue(intHistogram, 0) == 0 ||
+      binValue(intHistogram, 65535) == 0)
+    {
+    std::cerr << "Line : " << __LINE__
+              << " - Problem with ctkVTKHistogram::build: "
+              << totalCount(intHistogram) << " values" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  //------Test float array with NaNs------------------
+  vtkSmartPointer<vtkDataArray> floatArray;
+  floatArray.TakeReference(vtkDataArray::CreateDataArray(VTK_FLOAT));
+  floatArray->SetNumberOfTuples(tupleCount);
+  for (int i = 0; i < tupleCount; ++i)
+    {
+    floatArray->SetTuple1(i, i % 100 == 0 ? vtkMath::Nan() : i * 0.001);
+    }
+  ctkVTKHistogram floatHistogram(floatArray);
+  floatHistogram.setNumberOfBins(256);
+  floatHistogram.build();
+  if (floatHistogram.count() != 256 ||
+      totalCount(floatHistogram) != tupleCount - tupleCount / 100)
+    {
+    std::cerr << "Line : " << __LINE__
+              << " - Problem with ctkVTKHistogram::build: "
+              << totalCount(floatHistogram) << " values" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,175 @@
+// Qt includes
+#include <QCoreApplication>
+#include <QSharedPointer>
+
+// CTKVTK includes
+#include "ctkVTKHistogram.h"
+
+// VTK includes
+#include <vtkSmartPointer.h>
+#include <vtkDataArray.h>
+
+// STD includes
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+int binValue(const ctkVTKHistogram& histogram, int index)
+{
+  QSharedPointer<ctkControlPoint> point(histogram.controlPoint(index));
+  return point->value().toInt();
+}
+
+/// Compare an incrementally updated histogram with a full build
+bool checkHistogram(const ctkVTKHistogram& histogram, vtkDataArray* dataArray,
+                    int numberOfBins, int line)
+{
+  ctkVTKHistogram builtHistogram(dataArray);
+  builtHistogram.setNumberOfBins(numberOfBins);
+  builtHistogram.build();
+  if (histogram.count() != builtHistogram.count() ||
+      histogram.maxValue() != builtHistogram.maxValue())
+    {
+    std::cerr << "Line : " << line
+              << " - Problem with ctkVTKHistogram::endModifyTuples: "
+              << histogram.count() << " bins instead of "
+              << builtHistogram.count() << ", max "
+              << histogram.maxValue().toInt() << " instead of "
+              << builtHistogram.maxValue().toInt() << std::endl;
+    return false;
+    }
+  for (int i = 0; i < histogram.count(); ++i)
+    {
+    if (binValue(histogram, i) != binValue(builtHistogram, i))
+      {
+      std::cerr << "Line : " << line
+                << " - Problem with ctkVTKHistogram::endModifyTuples: bin "
+                << i << " has " << binValue(histogram, i) << " values instead of "
+                << binValue(builtHistogram, i) << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+}
+
+int ctkVTKHistogramTest6( int argc, char * argv [])
+{
+  Q_UNUSED(argc);
+  Q_UNUSED(argv);
+
+//---------------------------------------------------
+// test 6 : incremental updates of modified tuples
+//---------------------------------------------------
+
+  // 64 slices of 64x64 voxels
+  const int sliceSize = 64 * 64;
+  const int tupleCount = 64 * sliceSize;
+
+  //------Test short array----------------------------
+  vtkSmartPointer<vtkDataArray> shortArray;
+  shortArray.TakeReference(vtkDataArray::CreateDataArray(VTK_SHORT));
+  shortArray->SetNumberOfTuples(tupleCount);
+  for (int i = 0; i < tupleCount; ++i)
+    {
+    shortArray->SetTuple1(i, (i * 7919) % 1000);
+    }
+  ctkVTKHistogram shortHistogram(shortArray);
+  shortHistogram.build();
+
+  // Paint slices 10 to 12 with a single value, the max moves to its bin
+  shortHistogram.beginModifyTuples(10 * sliceSize, 13 * sliceSize);
+  for (int i = 10 * sliceSize; i < 13 * sliceSize; ++i)
+    {
+    shortArray->SetTuple1(i, 500);
+    }
+  shortHistogram.endModifyTuples();
+  if (!checkHistogram(shortHistogram, shortArray, -1, __LINE__))
+    {
+    return EXIT_FAILURE;
+    }
+
+  // Erase the painted value, the max goes back to the other bins
+  shortHistogram.beginModifyTuples(10 * sliceSize, 13 * sliceSize);
+  for (int i = 10 * sliceSize; i < 13 * sliceSize; ++i)
+    {
+    shortArray->SetTuple1(i, i % 1000);
+    }
+  shortHistogram.endModifyTuples();
+  if (!checkHistogram(shortHistogram, shortArray, -1, __LINE__))
+    {
+    return EXIT_FAILURE;
+    }
+
+  // A value out of the range rebuilds the histogram
+  shortHistogram.beginModifyTuples(0, 1);
+  shortArray->SetTuple1(0, 2000);
+  shortHistogram.endModifyTuples();
+  qreal range[2];
+  shortHistogram.range(range[0], range[1]);
+  if (range[1] != 2000 ||
+      !checkHistogram(shortHistogram, shortArray, -1, __LINE__))
+    {
+    std::cerr << "Line : " << __LINE__
+              << " - Problem with ctkVTKHistogram::endModifyTuples: range "
+              << range[0] << " " << range[1] << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  //------Test int array with user bins---------------
+  vtkSmartPointer<vtkDataArray> intArray;
+  intArray.TakeReference(vtkDataArray::CreateDataArray(VTK_INT));
+  intArray->SetNumberOfTuples(tupleCount);
+  for (int i = 0; i < tupleCount; ++i)
+    {
+    intArray->SetTuple1(i, i * 100 - 1000000);
+    }
+  ctkVTKHistogram intHistogram(intArray);
+  intHistogram.setNumberOfBins(100);
+  intHistogram.build();
+  intHistogram.beginModifyTuples(5 * sliceSize, 6 * sliceSize);
+  for (int i = 5 * sliceSize; i < 6 * sliceSize; ++i)
+    {
+    intArray->SetTuple1(i, -1000000 + i % 1000);
+    }
+  intHistogram.endModifyTuples();
+  if (!checkHistogram(intHistogram, intArray, 100, __LINE__))
+    {
+    return EXIT_FAILURE;
+    }
+
+  //------Test float array----------------------------
+  vtkSmartPointer<vtkDataArray> floatArray;
+  floatArray.TakeReference(vtkDataArray::CreateDataArray(VTK_FLOAT));
+  floatArray->SetNumberOfTuples(tupleCount);
+  for (int i = 0; i < tupleCount; ++i)
+    {
+    floatArray->SetTuple1(i, (i % 1000) * 0.01);
+    }
+  ctkVTKHistogram floatHistogram(floatArray);
+  floatHistogram.setNumberOfBins(64);
+  floatHistogram.build();
+  floatHistogram.beginModifyTuples(20 * sliceSize, 40 * sliceSize);
+  for (int i = 20 * sliceSize; i < 40 * sliceSize; ++i)
+    {
+    floatArray->SetTuple1(i, 1.5);
+    }
+  floatHistogram.endModifyTuples();
+  if (!checkHistogram(floatHistogram, floatArray, 64, __LINE__))
+    {
+    return EXIT_FAILURE;
+    }
+
+  //------Test without build--------------------------
+  ctkVTKHistogram unbuiltHistogram(floatArray);
+  unbuiltHistogram.setNumberOfBins(64);
+  unbuiltHistogram.beginModifyTuples(0, sliceSize);
+  unbuiltHistogram.endModifyTuples();
+  if (!checkHistogram(unbuiltHistogram, floatArray, 64, __LINE__))
+    {
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,205 @@
+/*=========================================================================
+
+  Library:   CTK
+
+  Copyright (c) Kitware Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=========================================================================*/
+
+// Qt includes
+#include <QCoreApplication>
+#include <QDebug>
+#include <QStringList>
+#include <QTimer>
+
+// CTKVTK includes
+#include "ctkVTKConnection.h"
+#include "ctkVTKObjectEventsObserver.h"
+
+// STD includes
+#include <cstdlib>
+#include <iostream>
+
+// VTK includes
+#include <vtkCommand.h>
+#include <vtkObject.h>
+#include <vtkSmartPointer.h>
+#include <vtkTimerLog.h>
+
+//-----------------------------------------------------------------------------
+int ctkVTKObjectEventsObserverTest2( int argc, char * argv [] )
+{
+  QCoreApplication app(argc, argv);
+
+  const int objects = 10000;
+
+  QList<vtkSmartPointer<vtkObject> > vtkObjects;
+  for (int i = 0; i < objects; ++i)
+    {
+    vtkObjects << vtkSmartPointer<vtkObject>::New();
+    }
+
+  QObject* topObject = new QObject(0);
+  // It could be here any kind of Qt object, QTimer has a no op slot so use it
+  QTimer* slotObject = new QTimer(topObject);
+  ctkVTKObjectEventsObserver* observer = new ctkVTKObjectEventsObserver(topObject);
+
+  vtkSmartPointer<vtkTimerLog> timerLog =
+    vtkSmartPointer<vtkTimerLog>::New();
+
+  // Connect
+  QStringList ids;
+  timerLog->StartTimer();
+  foreach(vtkObject* obj, vtkObjects)
+    {
+    ids << observer->addConnection(obj, vtkCommand::ModifiedEvent,
+                                   slotObject, SLOT(stop()));
+    }
+  timerLog->StopTimer();
+  qDebug() << objects << "connections added:" << timerLog->GetElapsedTime() << "seconds";
+
+  if (ids.contains(QString()) || ids.toSet().count() != objects)
+    {
+    std::cerr << "Line " << __LINE__ << " - addConnection failed" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // The same connection can't be added twice
+  if (!observer->addConnection(vtkObjects[objects / 2], vtkCommand::ModifiedEvent,
+                               slotObject, SLOT(stop())).isEmpty())
+    {
+    std::cerr << "Line " << __LINE__ << " - Connection added twice" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Lookup
+  timerLog->StartTimer();
+  foreach(vtkObject* obj, vtkObjects)
+    {
+    if (!observer->containsConnection(obj, vtkCommand::ModifiedEvent,
+                                      slotObject, SLOT(stop())) ||
+        observer->containsConnection(obj, vtkCommand::StartEvent))
+      {
+      std::cerr << "Line " << __LINE__ << " - containsConnection failed" << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+  timerLog->StopTimer();
+  qDebug() << objects << "connections found:" << timerLog->GetElapsedTime() << "seconds";
+
+  // Block
+  timerLog->StartTimer();
+  foreach(const QString& id, ids)
+    {
+    observer->blockConnection(id, true);
+    }
+  foreach(vtkObject* obj, vtkObjects)
+    {
+    if (observer->blockConnection(false, obj, vtkCommand::ModifiedEvent, slotObject) != 1)
+      {
+      std::cerr << "Line " << __LINE__ << " - blockConnection failed" << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+  timerLog->StopTimer();
+  qDebug() << 2 * objects << "connections blocked/unblocked:" << timerLog->GetElapsedTime() << "seconds";
+
+  // Reconnect: move each connection to the next vtkObject
+  timerLog->StartTimer();
+  for (int i = objects - 1; i >= 0; --i)
+    {
+    vtkObject* newObject = i + 1 < objects ? vtkObjects[i + 1].GetPointer() : 0;
+    observer->addConnection(vtkObjects[i], newObject, vtkCommand::ModifiedEvent,
+                            slotObject, SLOT(stop()));
+    }
+  timerLog->StopTimer();
+  qDebug() << objects << "connections reconnected:" << timerLog->GetElapsedTime() << "seconds";
+
+  if (observer->containsConnection(vtkObjects[0]) ||
+      !observer->containsConnection(vtkObjects[1], vtkCommand::ModifiedEvent))
+    {
+    std::cerr << "Line " << __LINE__ << " - Reconnection failed" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Disconnect
+  int removed = 0;
+  timerLog->StartTimer();
+  foreach(vtkObject* obj, vtkObjects)
+    {
+    removed += observer->removeConnection(obj, vtkCommand::ModifiedEvent,
+                                          slotObject, SLOT(stop()));
+    }
+  timerLog->StopTimer();
+  qDebug() << objects << "connections removed:" << timerLog->GetElapsedTime() << "seconds";
+
+  if (removed != objects - 1 ||
+      observer->containsConnection(vtkObjects[1]) ||
+      observer->removeAllConnections() != 0)
+    {
+    std::cerr << "Line " << __LINE__ << " - removeConnection failed: "
+              << removed << " connections removed" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Connections deleted outside of the observer are not found anymore
+  observer->addConnection(vtkObjects[0], vtkCommand::ModifiedEvent,
+                          slotObject, SLOT(stop()));
+  delete observer->findChild<ctkVTKConnection*>();
+  if (observer->containsConnection(vtkObjects[0]))
+    {
+    std::cerr << "Line " << __LINE__ << " - Deleted connection found" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // reconnection(): each receiver is moved to the next vtkObject
+  QList<QTimer*> receivers;
+  for (int i = 0; i < objects; ++i)
+    {
+    receivers << new QTimer(topObject);
+    observer->reconnection(vtkObjects[i], vtkCommand::ModifiedEvent,
+                           receivers[i], SLOT(stop()));
+    }
+  timerLog->StartTimer();
+  for (int i = 0; i < objects; ++i)
+    {
+    observer->reconnection(vtkObjects[(i + 1) % objects], vtkCommand::ModifiedEvent,
+                           receivers[i], SLOT(stop()));
+    }
+  timerLog->StopTimer();
+  qDebug() << objects << "connections reconnected with reconnection():"
+           << timerLog->GetElapsedTime() << "seconds";
+
+  for (int i = 0; i < objects; ++i)
+    {
+    if (observer->containsConnection(vtkObjects[i], vtkCommand::ModifiedEvent,
+                                     receivers[i], SLOT(stop())) ||
+        !observer->containsConnection(vtkObjects[(i + 1) % objects], vtkCommand::ModifiedEvent,
+                                      receivers[i], SLOT(stop())))
+      {
+      std::cerr << "Line " << __LINE__ << " - reconnection failed" << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+  if (observer->removeAllConnections() != objects)
+    {
+    std::cerr << "Line " << __LINE__ << " - reconnection left extra connections" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  delete topObject;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,134 @@
+/*=========================================================================
+
+  Library:   CTK
+
+  Copyright (c) Kitware Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=========================================================================*/
+
+// CTKVTK includes
+#include "vtkLightBoxRendererManager.h"
+
+// VTK includes
+#include <vtkCamera.h>
+#include <vtkImageData.h>
+#include <vtkNew.h>
+#include <vtkRenderer.h>
+#include <vtkRendererCollection.h>
+#include <vtkRenderWindow.h>
+#include <vtkTimerLog.h>
+
+// STD includes
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+//----------------------------------------------------------------------------
+/// Average time to render a frame where the color window changes, so
+/// that the slices are displayed again.
+double frameTime(vtkLightBoxRendererManager* lightBox, int layout, int frames)
+{
+  lightBox->SetRenderWindowLayout(layout, layout);
+  lightBox->GetRenderWindow()->Render();
+
+  vtkNew<vtkTimerLog> timerLog;
+  timerLog->StartTimer();
+  for (int frame = 0; frame < frames; ++frame)
+    {
+    lightBox->SetColorWindow(200. + frame);
+    lightBox->GetRenderWindow()->Render();
+    }
+  timerLog->StopTimer();
+  return timerLog->GetElapsedTime() / frames;
+}
+}
+
+//----------------------------------------------------------------------------
+int vtkLightBoxRendererManagerTest2(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  // Synthetic volume, large enough for a 12x12 layout
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(128, 128, 144);
+  image->SetScalarTypeToShort();
+  image->SetNumberOfScalarComponents(1);
+  image->AllocateScalars();
+  short* ptr = static_cast<short*>(image->GetScalarPointer());
+  for (vtkIdType i = 0; i < image->GetNumberOfPoints(); ++i)
+    {
+    ptr[i] = static_cast<short>(i % 1024);
+    }
+
+  vtkNew<vtkRenderWindow> rw;
+  rw->SetSize(768, 768);
+  rw->SetMultiSamples(0);
+
+  vtkNew<vtkLightBoxRendererManager> lightBox;
+  lightBox->Initialize(rw.GetPointer());
+  lightBox->SetImageData(image.GetPointer());
+
+  // The camera is kept when switching the rendering mode
+  vtkNew<vtkCamera> camera;
+  lightBox->SetActiveCamera(camera.GetPointer());
+  lightBox->SetRenderingMode(vtkLightBoxRendererManager::SingleRenderer);
+  if (lightBox->GetActiveCamera() != camera.GetPointer())
+    {
+    std::cerr << "line " << __LINE__ << " - Problem with SetRenderingMode()" << std::endl;
+    return EXIT_FAILURE;
+    }
+  lightBox->SetRenderingMode(vtkLightBoxRendererManager::MultipleRenderers);
+  if (lightBox->GetActiveCamera() != camera.GetPointer())
+    {
+    std::cerr << "line " << __LINE__ << " - Problem with SetRenderingMode()" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  const int layouts[3] = {4, 8, 12};
+  const int frames = 20;
+  for (int i = 0; i < 3; ++i)
+    {
+    lightBox->SetRenderingMode(vtkLightBoxRendererManager::MultipleRenderers);
+    double multipleRenderersTime = frameTime(lightBox.GetPointer(), layouts[i], frames);
+    if (lightBox->GetRenderWindowItemCount() != layouts[i] * layouts[i] ||
+        rw->GetRenderers()->GetNumberOfItems() != layouts[i] * layouts[i])
+      {
+      std::cerr << "line " << __LINE__ << " - Problem with SetRenderWindowLayout()" << std::endl;
+      return EXIT_FAILURE;
+      }
+
+    lightBox->SetRenderingMode(vtkLightBoxRendererManager::SingleRenderer);
+    double singleRendererTime = frameTime(lightBox.GetPointer(), layouts[i], frames);
+    if (lightBox->GetRenderWindowItemCount() != layouts[i] * layouts[i] ||
+        rw->GetRenderers()->GetNumberOfItems() != 1 ||
+        lightBox->GetRenderer(0) != lightBox->GetRenderer(layouts[i] - 1, layouts[i] - 1))
+      {
+      std::cerr << "line " << __LINE__ << " - Problem with SetRenderingMode()" << std::endl;
+      return EXIT_FAILURE;
+      }
+
+    lightBox->SetHighlighted(1, 1, true);
+    if (!lightBox->GetHighlighted(1, 1) || lightBox->GetHighlighted(0, 0))
+      {
+      std::cerr << "line " << __LINE__ << " - Problem with SetHighlighted()" << std::endl;
+      return EXIT_FAILURE;
+      }
+
+    std::cout << layouts[i] << "x" << layouts[i] << " layout: "
+              << multipleRenderersTime * 1000. << " ms/frame (MultipleRenderers), "
+              << singleRendererTime * 1000. << " ms/frame (SingleRenderer)" << std::endl;
+    }
+
+  return EXIT_SUCCESS;
+}
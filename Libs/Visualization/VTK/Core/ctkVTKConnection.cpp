@@ -20,10 +20,13 @@
 
 // Qt includes
 #include <QDebug>
+#include <QMetaObject>
+#include <QMutexLocker>
 #include <QPointer>
 #include <QRegExp>
 #include <QString>
 #include <QTextStream>
+#include <QThread>
 
 // CTK includes
 #include "ctkVTKConnection.h"
@@ -62,6 +65,14 @@ ctkVTKConnectionPrivate::ctkVTKConnectionPrivate(ctkVTKConnection& object)
   this->Blocked     = false;
   this->Id          = convertPointerToString(this);
   this->ObserveDeletion = false;
+  this->SlotIndex   = -1;
+  this->SignalConnected = false;
+  this->EventCompression = false;
+  this->CompressedEventPending = false;
+  this->CompressedCaller = 0;
+  this->CompressedEvent = vtkCommand::NoEvent;
+  this->CompressedClientData = 0;
+  this->CompressedCallData = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -81,8 +92,16 @@ void ctkVTKConnectionPrivate::connect()
     return;
     }
 
-  switch (this->SlotType)
+  this->QtObjectGuard = const_cast<QObject*>(this->QtObject);
+  this->SlotIndex = this->slotIndex();
+  // Direct connections never go through the signal
+  this->SignalConnected =
+    this->SlotIndex == -1 || this->ConnectionType != Qt::DirectConnection;
+
+  switch (this->SignalConnected ? this->SlotType : -1)
     {
+    case -1:
+      break;
     case ctkVTKConnectionPrivate::ARG_VTKOBJECT_AND_VTKOBJECT:
       QObject::connect(q, SIGNAL(emitExecute(vtkObject*,vtkObject*)),
         this->QtObject, this->QtSlot.toLatin1(), this->ConnectionType);
@@ -128,7 +147,7 @@ void ctkVTKConnectionPrivate::disconnect()
     return; 
     }
 
-  if (this->QtObject)
+  if (this->QtObject && this->SignalConnected)
     {
     switch (this->SlotType)
       {
@@ -163,9 +182,62 @@ void ctkVTKConnectionPrivate::disconnect()
                         q, SIGNAL(isBroke()));
     }
 
+  this->SignalConnected = false;
+    {
+    QMutexLocker locker(&this->CompressedEventMutex);
+    this->CompressedEventPending = false;
+    }
   this->Connected = false;
 }
 
+//-----------------------------------------------------------------------------
+int ctkVTKConnectionPrivate::slotIndex()const
+{
+  if (!this->QtObject)
+    {
+    return -1;
+    }
+  QByteArray method = this->QtSlot.toLatin1();
+  // Skip the code added by the SLOT() and SIGNAL() macros
+  if (method.size() && (method[0] == '1' || method[0] == '2'))
+    {
+    method = method.mid(1);
+    }
+  method = QMetaObject::normalizedSignature(method.constData());
+  // Same check as QObject::connect, the signal path reports the error
+  const char* signal =
+    this->SlotType == ctkVTKConnectionPrivate::ARG_VTKOBJECT_AND_VTKOBJECT ?
+    "emitExecute(vtkObject*,vtkObject*)" : "emitExecute(vtkObject*,void*,ulong,void*)";
+  if (!QMetaObject::checkConnectArgs(signal, method.constData()))
+    {
+    return -1;
+    }
+  return this->QtObject->metaObject()->indexOfMethod(method.constData());
+}
+
+//-----------------------------------------------------------------------------
+void ctkVTKConnectionPrivate::invokeSlot(vtkObject* vtk_obj, unsigned long vtk_event,
+                                         void* client_data, void* call_data)
+{
+  QObject* receiver = this->QtObjectGuard.data();
+  if (!receiver)
+    {
+    return;
+    }
+  // The slot reads the arguments it declares, the others are ignored
+  if (this->SlotType == ctkVTKConnectionPrivate::ARG_VTKOBJECT_AND_VTKOBJECT)
+    {
+    vtkObject* callDataAsVtkObject = reinterpret_cast<vtkObject*>( call_data );
+    void* args[] = {0, &vtk_obj, &callDataAsVtkObject};
+    QMetaObject::metacall(receiver, QMetaObject::InvokeMetaMethod, this->SlotIndex, args);
+    }
+  else
+    {
+    void* args[] = {0, &vtk_obj, &call_data, &vtk_event, &client_data};
+    QMetaObject::metacall(receiver, QMetaObject::InvokeMetaMethod, this->SlotIndex, args);
+    }
+}
+
 //-----------------------------------------------------------------------------
 // ctkVTKConnection methods
 
@@ -356,33 +428,62 @@ void ctkVTKConnectionPrivate::execute(vtkObject* vtk_obj, unsigned long vtk_even
      vtk_event != vtkCommand::DeleteEvent ||
      this->VTKEvent == vtkCommand::DeleteEvent)
     {
-    vtkObject* callDataAsVtkObject = 0;
-    switch (this->SlotType)
+    if (this->SlotIndex != -1 &&
+        this->EventCompression &&
+        this->ConnectionType == Qt::QueuedConnection &&
+        vtk_event != vtkCommand::DeleteEvent)
       {
-      case ctkVTKConnectionPrivate::ARG_VTKOBJECT_AND_VTKOBJECT:
-        if (this->VTKEvent == vtk_event)
-          {
-          callDataAsVtkObject = reinterpret_cast<vtkObject*>( call_data );
-          if (!callDataAsVtkObject)
+      QMutexLocker locker(&this->CompressedEventMutex);
+      this->CompressedCaller = vtk_obj;
+      this->CompressedEvent = vtk_event;
+      this->CompressedClientData = client_data;
+      this->CompressedCallData = call_data;
+      if (!this->CompressedEventPending)
+        {
+        this->CompressedEventPending = true;
+        QMetaObject::invokeMethod(q, "invokeCompressedEvent", Qt::QueuedConnection);
+        }
+      return;
+      }
+    if (this->SlotIndex != -1 &&
+        this->ConnectionType == Qt::DirectConnection)
+      {
+      if (this->SlotType != ctkVTKConnectionPrivate::ARG_VTKOBJECT_AND_VTKOBJECT ||
+          this->VTKEvent == vtk_event)
+        {
+        this->invokeSlot(vtk_obj, vtk_event, client_data, call_data);
+        }
+      }
+    else
+      {
+      vtkObject* callDataAsVtkObject = 0;
+      switch (this->SlotType)
+        {
+        case ctkVTKConnectionPrivate::ARG_VTKOBJECT_AND_VTKOBJECT:
+          if (this->VTKEvent == vtk_event)
             {
-            qCritical() << "The VTKEvent(" << this->VTKEvent<< ") triggered by vtkObject("
-              << this->VTKObject->GetClassName() << ") "
-              << "doesn't return data of type vtkObject." << endl
-              << "The slot (" << this->QtSlot <<  ") owned by "
-              << "QObject(" << this->QtObject->objectName() << ")"
-              << " may be incorrect.";
+            callDataAsVtkObject = reinterpret_cast<vtkObject*>( call_data );
+            if (!callDataAsVtkObject)
+              {
+              qCritical() << "The VTKEvent(" << this->VTKEvent<< ") triggered by vtkObject("
+                << this->VTKObject->GetClassName() << ") "
+                << "doesn't return data of type vtkObject." << endl
+                << "The slot (" << this->QtSlot <<  ") owned by "
+                << "QObject(" << this->QtObject->objectName() << ")"
+                << " may be incorrect.";
+              }
+            emit q->emitExecute(vtk_obj, callDataAsVtkObject);
             }
-          emit q->emitExecute(vtk_obj, callDataAsVtkObject);
-          }
-        break;
-      case ctkVTKConnectionPrivate::ARG_VTKOBJECT_VOID_ULONG_VOID:
-        emit q->emitExecute(vtk_obj, call_data, vtk_event, client_data);
-        break;
-      default:
-        // Should never reach
-        qCritical() << "Unknown SlotType:" << this->SlotType;
-        return;
-        break;
+          break;
+        case ctkVTKConnectionPrivate::ARG_VTKOBJECT_VOID_ULONG_VOID:
+          emit q->emitExecute(vtk_obj, call_data, vtk_event, client_data);
+          break;
+        default:
+          // Should never reach
+          qCritical() << "Unknown SlotType:" << this->SlotType;
+          return;
+          break;
+        }
       }
     }
 
@@ -407,6 +508,61 @@ bool ctkVTKConnection::deletionObserved()const
   return d->ObserveDeletion;
 }
 
+//-----------------------------------------------------------------------------
+void ctkVTKConnection::setEventCompression(bool enable)
+{
+  Q_D(ctkVTKConnection);
+  d->EventCompression = enable;
+}
+
+//-----------------------------------------------------------------------------
+bool ctkVTKConnection::eventCompression()const
+{
+  Q_D(const ctkVTKConnection);
+  return d->EventCompression;
+}
+
+//-----------------------------------------------------------------------------
+void ctkVTKConnection::invokeCompressedEvent()
+{
+  Q_D(ctkVTKConnection);
+  vtkObject* caller;
+  unsigned long event;
+  void* clientData;
+  void* callData;
+    {
+    QMutexLocker locker(&d->CompressedEventMutex);
+    if (!d->CompressedEventPending)
+      {
+      // Disconnected in the meantime
+      return;
+      }
+    d->CompressedEventPending = false;
+    caller = d->CompressedCaller;
+    event = d->CompressedEvent;
+    clientData = d->CompressedClientData;
+    callData = d->CompressedCallData;
+    }
+  QObject* receiver = d->QtObjectGuard.data();
+  if (d->Blocked || !receiver)
+    {
+    return;
+    }
+  if (receiver->thread() == QThread::currentThread())
+    {
+    d->invokeSlot(caller, event, clientData, callData);
+    }
+  // The slot is queued in the thread of the receiver through the signal
+  else if (d->SlotType == ctkVTKConnectionPrivate::ARG_VTKOBJECT_AND_VTKOBJECT)
+    {
+    emit emitExecute(caller, reinterpret_cast<vtkObject*>(callData));
+    }
+  else
+    {
+    emit emitExecute(caller, callData, event, clientData);
+    }
+}
+
 //-----------------------------------------------------------------------------
 void ctkVTKConnection::disconnect()
 {
@@ -41,6 +41,8 @@ class vtkCallbackCommand;
 /// vtkObject*, void*, unsigned long, void*: sender, callData, eventId, clientData
 /// Of course the slot can contain less parameters, but always the same order
 /// though.
+/// For Qt::DirectConnection, the slot is called directly from the VTK
+/// callback without emitting a signal, QObject::sender() is then null.
 class CTK_VISUALIZATION_VTK_CORE_EXPORT ctkVTKConnection : public QObject
 {
 Q_OBJECT
@@ -91,6 +93,15 @@ public:
   /// false by default, it is slower to observe vtk object deletion
   void observeDeletion(bool enable);
   bool deletionObserved()const;
+
+  /// For Qt::QueuedConnection only. If enabled, the events fired while the
+  /// slot call is pending are compressed: the slot is called once with the
+  /// arguments of the last event. Observe the deletion of the vtk object if
+  /// it can be deleted before the slot is called. The events may be fired
+  /// from any thread, the slot is called in the thread of the receiver.
+  /// false by default.
+  void setEventCompression(bool enable);
+  bool eventCompression()const;
   
 Q_SIGNALS:
   /// 
@@ -112,6 +123,7 @@ Q_SIGNALS:
 protected Q_SLOTS:
   void vtkObjectDeleted();
   void qobjectDeleted();
+  void invokeCompressedEvent();
 
 protected:
   QScopedPointer<ctkVTKConnectionPrivate> d_ptr;
@@ -22,6 +22,8 @@
 #define __ctkVTKConnection_p_h
 
 // Qt includes
+#include <QMutex>
+#include <QPointer>
 #include <QString>
 class QObject;
 
@@ -64,6 +66,12 @@ public:
   /// Called by 'DoCallback' to emit signal
   void execute(vtkObject* vtk_obj, unsigned long vtk_event, void* client_data, void* call_data);
 
+  /// Index of QtSlot in the meta object of QtObject, -1 if not found
+  int slotIndex()const;
+
+  /// Call the slot without going through the signal, in the current thread
+  void invokeSlot(vtkObject* vtk_obj, unsigned long vtk_event, void* client_data, void* call_data);
+
   vtkSmartPointer<vtkCallbackCommand> Callback;
   vtkObject*                          VTKObject;
   const QObject*                      QtObject;
@@ -76,6 +84,23 @@ public:
   bool                                Blocked;
   QString                             Id;
   bool                                ObserveDeletion;
+
+  /// Resolved when connecting, the slot is then called directly for direct
+  /// connections and for auto connections within the thread of QtObject
+  int                                 SlotIndex;
+  QPointer<QObject>                   QtObjectGuard;
+  /// False if the slot is always called directly
+  bool                                SignalConnected;
+
+  bool                                EventCompression;
+  /// The VTK object may fire events from another thread than the connection,
+  /// the compressed event is guarded by CompressedEventMutex
+  QMutex                              CompressedEventMutex;
+  bool                                CompressedEventPending;
+  vtkObject*                          CompressedCaller;
+  unsigned long                       CompressedEvent;
+  void*                               CompressedClientData;
+  void*                               CompressedCallData;
 };
 
 #endif
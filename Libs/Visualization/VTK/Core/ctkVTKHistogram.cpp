@@ -30,10 +30,12 @@
 #include <vtkDataArray.h>
 #include <vtkIntArray.h>
 #include <vtkMath.h>
+#include <vtkMultiThreader.h>
 #include <vtkSmartPointer.h>
 
 /// STL include
 #include <limits>
+#include <vector>
 
 //--------------------------------------------------------------------------
 static ctkLogger logger("org.commontk.libs.visualization.core.ctkVTKHistogram");
@@ -52,7 +54,41 @@ public:
   int                           MinBin;
   int                           MaxBin;
 
-  int computeNumberOfBins()const;
+  /// How the values were mapped to bins by the last build(), reused by
+  /// the incremental updates.
+  enum BinMappingType
+  {
+    NoMapping,
+    /// Bin of (value - Range[0]) * BinScale
+    ScaledMapping,
+    /// Bin of (value - Range[0]) * BinFixedScale >> 32 for integers,
+    /// value - Range[0] if BinFixedScale is 0
+    FixedPointMapping
+  };
+  BinMappingType                BinMapping;
+  double                        BinScale;
+  quint64                       BinFixedScale;
+
+  /// State between beginModifyTuples() and endModifyTuples()
+  bool                          ModifyingTuples;
+  vtkIdType                     ModifiedTuples[2];
+  bool                          RemovedBinsValid;
+  std::vector<int>              RemovedBins;
+
+  /// Maximum number of bins when the number of bins is not set by the user:
+  /// wide ranges of values share bins instead of having one bin per value.
+  static const int MaximumNumberOfBins = 65536;
+  /// Arrays with fewer values per thread are processed by fewer threads.
+  static const vtkIdType MinimumValuesPerThread = 65536;
+
+  int computeNumberOfBins(bool integerValues)const;
+  int numberOfThreads(vtkIdType tupleCount)const;
+  /// Histogram of the tuples from beginTuple to endTuple excluded with the
+  /// bin mapping of the last build(). Returns false if a value is out of
+  /// the range.
+  bool tupleBins(vtkIdType beginTuple, vtkIdType endTuple,
+                 std::vector<int>& bins)const;
+  void updateMinMaxBins();
 };
 
 //-----------------------------------------------------------------------------
@@ -64,42 +100,63 @@ ctkVTKHistogramPrivate::ctkVTKHistogramPrivate()
   this->Range[0] = this->Range[1] = 0.;
   this->MinBin = 0;
   this->MaxBin = 0;
+  this->BinMapping = NoMapping;
+  this->BinScale = 0.;
+  this->BinFixedScale = 0;
+  this->ModifyingTuples = false;
+  this->ModifiedTuples[0] = this->ModifiedTuples[1] = 0;
+  this->RemovedBinsValid = false;
 }
 
 //-----------------------------------------------------------------------------
-int ctkVTKHistogramPrivate::computeNumberOfBins()const
+int ctkVTKHistogramPrivate::computeNumberOfBins(bool integerValues)const
 {
-  if (this->DataArray.GetPointer() == 0)
+  if (this->Range[1] < this->Range[0])
     {
-    return -1;
+    // no value
+    this->Range[0] = this->Range[1] = 0.;
+    return 0;
     }
-  
-  if (this->DataArray->GetDataType() == VTK_CHAR ||
-      this->DataArray->GetDataType() == VTK_SIGNED_CHAR ||
-      this->DataArray->GetDataType() == VTK_UNSIGNED_CHAR)
+  if (this->UserNumberOfBins > 0)
     {
-    this->Range[0] = this->DataArray->GetDataTypeMin();
-    this->Range[1] = this->DataArray->GetDataTypeMax();
+    return this->UserNumberOfBins;
     }
-  else
+  double valueCount = this->Range[1] - this->Range[0] + (integerValues ? 1. : 0.);
+  if (valueCount > MaximumNumberOfBins)
     {
-    this->DataArray->GetRange(this->Range, this->Component);
-    if (this->DataArray->GetDataType() == VTK_FLOAT ||
-        this->DataArray->GetDataType() == VTK_DOUBLE)
-      {
-      this->Range[1] += 0.01;
-      }
-    //else
-    //  {
-    //  this->Range[1] += 1;
-    //  }
+    return MaximumNumberOfBins;
     }
-  if (this->UserNumberOfBins > 0)
+  return static_cast<int>(this->Range[1] - this->Range[0]) + 1;
+}
+
+//-----------------------------------------------------------------------------
+int ctkVTKHistogramPrivate::numberOfThreads(vtkIdType tupleCount)const
+{
+  vtkIdType threadCount = qMin<vtkIdType>(
+    vtkMultiThreader::GetGlobalDefaultNumberOfThreads(),
+    tupleCount / MinimumValuesPerThread);
+  return qMax(1, static_cast<int>(threadCount));
+}
+
+//-----------------------------------------------------------------------------
+void ctkVTKHistogramPrivate::updateMinMaxBins()
+{
+  const int binCount = this->Bins->GetNumberOfTuples();
+  if (binCount <= 0)
     {
-    return this->UserNumberOfBins;
+    this->MinBin = 0;
+    this->MaxBin = 0;
+    return;
+    }
+  int* binPtr = this->Bins->GetPointer(0);
+  int* endPtr = this->Bins->GetPointer(binCount-1);
+  this->MinBin = *endPtr;
+  this->MaxBin = *endPtr;
+  for (;binPtr < endPtr; ++binPtr)
+    {
+    this->MinBin = qMin(*binPtr, this->MinBin);
+    this->MaxBin = qMax(*binPtr, this->MaxBin);
     }
-
-  return static_cast<int>(this->Range[1] - this->Range[0]) + 1;
 }
 
 //-----------------------------------------------------------------------------
@@ -204,6 +261,7 @@ void ctkVTKHistogram::setDataArray(vtkDataArray* newDataArray)
 {
   Q_D(ctkVTKHistogram);
   d->DataArray = newDataArray;
+  d->BinMapping = ctkVTKHistogramPrivate::NoMapping;
   this->qvtkReconnect(d->DataArray,vtkCommand::ModifiedEvent,
                       this, SIGNAL(changed()));
   emit changed();
@@ -238,71 +296,437 @@ void ctkVTKHistogram::setNumberOfBins(int number)
   d->UserNumberOfBins = number;
 }
 
+namespace
+{
+
+//-----------------------------------------------------------------------------
+/// Runs functor(threadId, beginTuple, endTuple) on consecutive, equally
+/// sized ranges of tuples, each in its own thread.
+template <class Functor>
+struct ParallelForData
+{
+  Functor* Function;
+  vtkIdType NumberOfTuples;
+};
+
+//-----------------------------------------------------------------------------
+template <class Functor>
+VTK_THREAD_RETURN_TYPE parallelForThread(void* arg)
+{
+  ThreadInfoStruct* info = static_cast<ThreadInfoStruct*>(arg);
+  ParallelForData<Functor>* data = static_cast<ParallelForData<Functor>*>(info->UserData);
+  vtkIdType begin = data->NumberOfTuples * info->ThreadID / info->NumberOfThreads;
+  vtkIdType end = data->NumberOfTuples * (info->ThreadID + 1) / info->NumberOfThreads;
+  (*data->Function)(info->ThreadID, begin, end);
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+//-----------------------------------------------------------------------------
+template <class Functor>
+void parallelFor(Functor* functor, vtkIdType numberOfTuples, int numberOfThreads)
+{
+  if (numberOfThreads <= 1)
+    {
+    (*functor)(0, 0, numberOfTuples);
+    return;
+    }
+  ParallelForData<Functor> data;
+  data.Function = functor;
+  data.NumberOfTuples = numberOfTuples;
+  vtkSmartPointer<vtkMultiThreader> threader = vtkSmartPointer<vtkMultiThreader>::New();
+  threader->SetNumberOfThreads(numberOfThreads);
+  threader->SetSingleMethod(&parallelForThread<Functor>, &data);
+  threader->SingleMethodExecute();
+}
+
+//-----------------------------------------------------------------------------
+/// Sums the per-thread histograms into bins.
+void mergeBins(vtkIntArray* bins, const std::vector<std::vector<int> >& threadBins)
+{
+  const int binCount = bins->GetNumberOfTuples();
+  int* binsPtr = bins->WritePointer(0, binCount);
+  memset(binsPtr, 0, binCount * sizeof(int));
+  for (size_t thread = 0; thread < threadBins.size(); ++thread)
+    {
+    const int* threadBinsPtr = &threadBins[thread][0];
+    for (int i = 0; i < binCount; ++i)
+      {
+      binsPtr[i] += threadBinsPtr[i];
+      }
+    }
+}
+
 //-----------------------------------------------------------------------------
+/// Counts each possible value of an 8 or 16 bit integer type, the range and
+/// the histogram are then computed from the counts without reading the
+/// array again.
 template <class T>
-void populateBins(vtkIntArray* bins, const ctkVTKHistogram* histogram)
+struct ValueCounter
 {
-  vtkDataArray* scalars = histogram->dataArray();
-  int* binsPtr = bins->WritePointer(0, bins->GetNumberOfTuples());
+  const T* Data;
+  int Stride;
+  std::vector<std::vector<int> > Counts;
 
-  // reset bins to 0
-  memset(binsPtr, 0, bins->GetNumberOfComponents()*bins->GetNumberOfTuples()*sizeof(int));
+  void operator()(int thread, vtkIdType begin, vtkIdType end)
+    {
+    std::vector<int>& counts = this->Counts[thread];
+    counts.assign(1 << (8 * sizeof(T)), 0);
+    int* countsPtr = &counts[0];
+    const int typeMin = std::numeric_limits<T>::min();
+    const T* ptr = this->Data + begin * this->Stride;
+    const T* endPtr = this->Data + end * this->Stride;
+    for (; ptr < endPtr; ptr += this->Stride)
+      {
+      ++countsPtr[static_cast<int>(*ptr) - typeMin];
+      }
+    }
+};
 
-  const vtkIdType componentNumber = scalars->GetNumberOfComponents();
-  const vtkIdType tupleNumber = scalars->GetNumberOfTuples();
-  int component = histogram->component();
+//-----------------------------------------------------------------------------
+/// Computes the range of the values, skipping NaNs.
+template <class T>
+struct RangeComputer
+{
+  const T* Data;
+  int Stride;
+  std::vector<T> Min;
+  std::vector<T> Max;
 
-  double range[2];
-  histogram->range(range[0], range[1]);
-  T offset = static_cast<T>(range[0]);
+  void operator()(int thread, vtkIdType begin, vtkIdType end)
+    {
+    T min = std::numeric_limits<T>::max();
+    T max = std::numeric_limits<T>::is_integer ?
+      std::numeric_limits<T>::min() : -std::numeric_limits<T>::max();
+    const T* ptr = this->Data + begin * this->Stride;
+    const T* endPtr = this->Data + end * this->Stride;
+    for (; ptr < endPtr; ptr += this->Stride)
+      {
+      const T value = *ptr;
+      if (value != value) // NaN
+        {
+        continue;
+        }
+      min = value < min ? value : min;
+      max = value > max ? value : max;
+      }
+    this->Min[thread] = min;
+    this->Max[thread] = max;
+    }
+};
 
-  T* ptr = static_cast<T*>(scalars->WriteVoidPointer(0, tupleNumber));
-  T* endPtr = ptr + tupleNumber * componentNumber;
-  ptr += component;
-  for (; ptr < endPtr; ptr += componentNumber)
+//-----------------------------------------------------------------------------
+/// Fills the histogram of the values in a known range.
+///
+/// Bin indices of integers up to 32 bits are computed with integer
+/// arithmetic, either one bin per value or with a 32.32 fixed point scale,
+/// by blocks so that the index computation can be vectorized.
+template <class T>
+struct BinFiller
+{
+  const T* Data;
+  int Stride;
+  int BinCount;
+  double Min;
+  /// Bins per value
+  double Scale;
+  /// Fixed point bins per value, 0 for one bin per value
+  quint64 FixedScale;
+  bool IntegerIndices;
+  std::vector<std::vector<int> > Bins;
+
+  void operator()(int thread, vtkIdType begin, vtkIdType end)
     {
-    Q_ASSERT( (static_cast<long long>(*ptr) - offset) == 
-              (static_cast<int>(*ptr) - offset));
-    binsPtr[static_cast<int>(*ptr - offset)]++;
+    std::vector<int>& bins = this->Bins[thread];
+    bins.assign(this->BinCount, 0);
+    int* binsPtr = &bins[0];
+    const T* ptr = this->Data + begin * this->Stride;
+    const T* endPtr = this->Data + end * this->Stride;
+    if (this->IntegerIndices)
+      {
+      const qint64 min = static_cast<qint64>(this->Min);
+      const quint64 fixedScale = this->FixedScale;
+      const int stride = this->Stride;
+      const int blockSize = 256;
+      int indices[blockSize];
+      while (ptr < endPtr)
+        {
+        const int count = static_cast<int>(
+          qMin<vtkIdType>(blockSize, (endPtr - ptr + stride - 1) / stride));
+        if (fixedScale == 0)
+          {
+          for (int i = 0; i < count; ++i)
+            {
+            indices[i] = static_cast<int>(static_cast<qint64>(ptr[i * stride]) - min);
+            }
+          }
+        else
+          {
+          for (int i = 0; i < count; ++i)
+            {
+            const quint64 offset = static_cast<quint64>(static_cast<qint64>(ptr[i * stride]) - min);
+            indices[i] = static_cast<int>((offset * fixedScale) >> 32);
+            }
+          }
+        for (int i = 0; i < count; ++i)
+          {
+          ++binsPtr[indices[i]];
+          }
+        ptr += count * stride;
+        }
+      return;
+      }
+    const int lastBin = this->BinCount - 1;
+    for (; ptr < endPtr; ptr += this->Stride)
+      {
+      const double value = static_cast<double>(*ptr);
+      if (value != value) // NaN
+        {
+        continue;
+        }
+      int index = vtkMath::Floor((value - this->Min) * this->Scale);
+      binsPtr[qBound(0, index, lastBin)]++;
+      }
     }
-}
+};
 
 //-----------------------------------------------------------------------------
 template <class T>
-void populateIrregularBins(vtkIntArray* bins, const ctkVTKHistogram* histogram)
+void populateBins(ctkVTKHistogramPrivate* d, const T* data)
 {
-  vtkDataArray* scalars = histogram->dataArray();
+  const int stride = d->DataArray->GetNumberOfComponents();
+  const vtkIdType tupleCount = d->DataArray->GetNumberOfTuples();
+  const int threadCount = d->numberOfThreads(tupleCount);
+  data += d->Component;
+  const bool integerValues = std::numeric_limits<T>::is_integer;
+
+  if (integerValues && sizeof(T) <= 2)
+    {
+    ValueCounter<T> counter;
+    counter.Data = data;
+    counter.Stride = stride;
+    counter.Counts.resize(threadCount);
+    parallelFor(&counter, tupleCount, threadCount);
+    std::vector<int>& counts = counter.Counts[0];
+    for (int thread = 1; thread < threadCount; ++thread)
+      {
+      const std::vector<int>& threadCounts = counter.Counts[thread];
+      for (size_t i = 0; i < counts.size(); ++i)
+        {
+        counts[i] += threadCounts[i];
+        }
+      }
+
+    const int typeMin = std::numeric_limits<T>::min();
+    int first = 0;
+    int last = static_cast<int>(counts.size()) - 1;
+    if (sizeof(T) == 2)
+      {
+      // the full range of 8 bit types is shown, as before
+      while (first <= last && counts[first] == 0)
+        {
+        ++first;
+        }
+      while (last >= first && counts[last] == 0)
+        {
+        --last;
+        }
+      }
+    d->Range[0] = first + typeMin;
+    d->Range[1] = last + typeMin;
 
-  int* binsPtr = bins->WritePointer(0, bins->GetNumberOfComponents()*bins->GetNumberOfTuples());
-  // reset bins to 0
-  memset(binsPtr, 0, bins->GetNumberOfTuples() * sizeof(int));
+    const int binCount = d->computeNumberOfBins(true);
+    d->Bins->SetNumberOfTuples(binCount);
+    if (binCount <= 0)
+      {
+      return;
+      }
+    int* binsPtr = d->Bins->WritePointer(0, binCount);
+    memset(binsPtr, 0, binCount * sizeof(int));
+    const double scale = binCount / (d->Range[1] - d->Range[0] + 1.);
+    d->BinMapping = ctkVTKHistogramPrivate::ScaledMapping;
+    d->BinScale = scale;
+    for (int i = first; i <= last; ++i)
+      {
+      if (counts[i] != 0)
+        {
+        binsPtr[qMin(static_cast<int>((i - first) * scale), binCount - 1)] += counts[i];
+        }
+      }
+    return;
+    }
 
-  const vtkIdType componentNumber = scalars->GetNumberOfComponents();
-  const vtkIdType tupleNumber = scalars->GetNumberOfTuples();
-  int component = histogram->component();
+  RangeComputer<T> rangeComputer;
+  rangeComputer.Data = data;
+  rangeComputer.Stride = stride;
+  rangeComputer.Min.resize(threadCount);
+  rangeComputer.Max.resize(threadCount);
+  parallelFor(&rangeComputer, tupleCount, threadCount);
+  d->Range[0] = VTK_DOUBLE_MAX;
+  d->Range[1] = VTK_DOUBLE_MIN;
+  for (int thread = 0; thread < threadCount; ++thread)
+    {
+    if (rangeComputer.Min[thread] <= rangeComputer.Max[thread])
+      {
+      d->Range[0] = qMin(d->Range[0], static_cast<double>(rangeComputer.Min[thread]));
+      d->Range[1] = qMax(d->Range[1], static_cast<double>(rangeComputer.Max[thread]));
+      }
+    }
+  if (!integerValues && d->Range[0] <= d->Range[1])
+    {
+    d->Range[1] += 0.01;
+    }
 
-  double range[2];
-  histogram->range(range[0], range[1]);
-  double offset = range[0];
+  const int binCount = d->computeNumberOfBins(integerValues);
+  d->Bins->SetNumberOfTuples(binCount);
+  if (binCount <= 0)
+    {
+    return;
+    }
 
-  double binWidth = 1.;
-  if (range[1] != range[0])
+  BinFiller<T> filler;
+  filler.Data = data;
+  filler.Stride = stride;
+  filler.BinCount = binCount;
+  filler.Min = d->Range[0];
+  filler.Scale = binCount / (d->Range[1] - d->Range[0] + (integerValues ? 1. : 0.));
+  // one bin per value or a fixed point scale: the offset of a value
+  // from the minimum fits in 32 bits for integers up to 32 bits
+  filler.IntegerIndices = integerValues && sizeof(T) <= 4;
+  filler.FixedScale = 0;
+  const double valueCount = d->Range[1] - d->Range[0] + 1.;
+  if (filler.IntegerIndices && binCount != valueCount)
     {
-    binWidth = static_cast<double>(bins->GetNumberOfTuples()) / (range[1] - range[0]);
+    filler.FixedScale = static_cast<quint64>(
+      (static_cast<quint64>(binCount) << 32) / static_cast<quint64>(valueCount));
     }
+  filler.Bins.resize(threadCount);
+  parallelFor(&filler, tupleCount, threadCount);
+  mergeBins(d->Bins, filler.Bins);
+
+  d->BinMapping = filler.IntegerIndices ?
+    ctkVTKHistogramPrivate::FixedPointMapping : ctkVTKHistogramPrivate::ScaledMapping;
+  d->BinScale = filler.Scale;
+  d->BinFixedScale = filler.FixedScale;
+}
 
-  T* ptr = static_cast<T*>(scalars->WriteVoidPointer(0, tupleNumber));
-  T* endPtr = ptr + tupleNumber * componentNumber;
-  ptr += component;
-  for (; ptr < endPtr; ptr += componentNumber)
+//-----------------------------------------------------------------------------
+/// Histogram of a range of tuples with the bin mapping of the last build,
+/// counting the values out of the range of the histogram.
+template <class T>
+struct TupleBinner
+{
+  const T* Data;
+  int Stride;
+  int BinCount;
+  double Min;
+  double Max;
+  ctkVTKHistogramPrivate::BinMappingType Mapping;
+  double Scale;
+  quint64 FixedScale;
+  std::vector<std::vector<int> > Bins;
+  std::vector<vtkIdType> OutOfRange;
+
+  void operator()(int thread, vtkIdType begin, vtkIdType end)
     {
-    if (std::numeric_limits<T>::has_quiet_NaN && 
-        std::numeric_limits<T>::quiet_NaN() == *ptr)
+    std::vector<int>& bins = this->Bins[thread];
+    bins.assign(this->BinCount, 0);
+    int* binsPtr = &bins[0];
+    vtkIdType outOfRange = 0;
+    const int lastBin = this->BinCount - 1;
+    const T* ptr = this->Data + begin * this->Stride;
+    const T* endPtr = this->Data + end * this->Stride;
+    for (; ptr < endPtr; ptr += this->Stride)
       {
-      continue;
+      const double value = static_cast<double>(*ptr);
+      if (value != value) // NaN
+        {
+        continue;
+        }
+      if (value < this->Min || value > this->Max)
+        {
+        ++outOfRange;
+        continue;
+        }
+      int index = 0;
+      if (this->Mapping == ctkVTKHistogramPrivate::FixedPointMapping)
+        {
+        const quint64 offset = static_cast<quint64>(
+          static_cast<qint64>(*ptr) - static_cast<qint64>(this->Min));
+        index = static_cast<int>(
+          this->FixedScale == 0 ? offset : (offset * this->FixedScale) >> 32);
+        }
+      else
+        {
+        index = vtkMath::Floor((value - this->Min) * this->Scale);
+        }
+      binsPtr[qBound(0, index, lastBin)]++;
+      }
+    this->OutOfRange[thread] = outOfRange;
+    }
+};
+
+//-----------------------------------------------------------------------------
+template <class T>
+bool computeTupleBins(const ctkVTKHistogramPrivate* d, const T* data,
+                      vtkIdType beginTuple, vtkIdType endTuple,
+                      std::vector<int>& bins)
+{
+  const int stride = d->DataArray->GetNumberOfComponents();
+  const vtkIdType tupleCount = endTuple - beginTuple;
+  const int threadCount = d->numberOfThreads(tupleCount);
+
+  TupleBinner<T> binner;
+  binner.Data = data + beginTuple * stride + d->Component;
+  binner.Stride = stride;
+  binner.BinCount = static_cast<int>(bins.size());
+  binner.Min = d->Range[0];
+  binner.Max = d->Range[1];
+  binner.Mapping = d->BinMapping;
+  binner.Scale = d->BinScale;
+  binner.FixedScale = d->BinFixedScale;
+  binner.Bins.resize(threadCount);
+  binner.OutOfRange.resize(threadCount);
+  parallelFor(&binner, tupleCount, threadCount);
+
+  bool inRange = true;
+  for (int thread = 0; thread < threadCount; ++thread)
+    {
+    const std::vector<int>& threadBins = binner.Bins[thread];
+    for (size_t i = 0; i < bins.size(); ++i)
+      {
+      bins[i] += threadBins[i];
       }
-    binsPtr[vtkMath::Floor((static_cast<double>(*ptr) - offset) * binWidth)]++;
+    inRange = inRange && binner.OutOfRange[thread] == 0;
+    }
+  return inRange;
+}
+
+} // end of anonymous namespace
+
+//-----------------------------------------------------------------------------
+bool ctkVTKHistogramPrivate::tupleBins(vtkIdType beginTuple, vtkIdType endTuple,
+                                       std::vector<int>& bins)const
+{
+  const int binCount = this->Bins->GetNumberOfTuples();
+  if (this->BinMapping == NoMapping ||
+      this->DataArray.GetPointer() == 0 ||
+      binCount <= 0)
+    {
+    return false;
+    }
+  bins.assign(binCount, 0);
+  if (beginTuple >= endTuple)
+    {
+    return true;
     }
+  bool inRange = false;
+  switch(this->DataArray->GetDataType())
+    {
+    vtkTemplateMacro(inRange = computeTupleBins<VTK_TT>(
+      this, static_cast<VTK_TT*>(this->DataArray->GetVoidPointer(0)),
+      beginTuple, endTuple, bins));
+    }
+  return inRange;
 }
 
 //-----------------------------------------------------------------------------
@@ -310,6 +734,8 @@ void ctkVTKHistogram::build()
 {
   Q_D(ctkVTKHistogram);
 
+  d->Bins->SetNumberOfComponents(1);
+  d->BinMapping = ctkVTKHistogramPrivate::NoMapping;
   if (d->DataArray.GetPointer() == 0)
     {
     d->MinBin = 0;
@@ -318,43 +744,87 @@ void ctkVTKHistogram::build()
     return;
     }
 
-  const int binCount = d->computeNumberOfBins();
+  switch(d->DataArray->GetDataType())
+    {
+    vtkTemplateMacro(populateBins<VTK_TT>(
+      d, static_cast<VTK_TT*>(d->DataArray->GetVoidPointer(0))));
+    }
 
-  d->Bins->SetNumberOfComponents(1);
-  d->Bins->SetNumberOfTuples(binCount);
+  d->updateMinMaxBins();
+  if (d->Bins->GetNumberOfTuples() <= 0)
+    {
+    return;
+    }
+  emit changed();
+}
 
-  if (binCount <= 0)
+//-----------------------------------------------------------------------------
+void ctkVTKHistogram::beginModifyTuples(vtkIdType beginTuple, vtkIdType endTuple)
+{
+  Q_D(ctkVTKHistogram);
+  if (d->ModifyingTuples)
     {
-    d->MinBin = 0;
-    d->MaxBin = 0;
+    logger.warn("beginModifyTuples called twice without endModifyTuples");
+    }
+  const vtkIdType tupleCount =
+    d->DataArray.GetPointer() ? d->DataArray->GetNumberOfTuples() : 0;
+  d->ModifyingTuples = true;
+  d->ModifiedTuples[0] = qBound<vtkIdType>(0, beginTuple, tupleCount);
+  d->ModifiedTuples[1] = qBound<vtkIdType>(0, endTuple, tupleCount);
+  // Values out of the range mean the array was modified since the last build
+  d->RemovedBinsValid =
+    d->tupleBins(d->ModifiedTuples[0], d->ModifiedTuples[1], d->RemovedBins);
+}
+
+//-----------------------------------------------------------------------------
+void ctkVTKHistogram::endModifyTuples()
+{
+  Q_D(ctkVTKHistogram);
+  if (!d->ModifyingTuples)
+    {
+    logger.warn("endModifyTuples called without beginModifyTuples");
+    return;
+    }
+  d->ModifyingTuples = false;
+
+  std::vector<int> addedBins;
+  if (!d->RemovedBinsValid ||
+      d->DataArray.GetPointer() == 0 ||
+      d->DataArray->GetNumberOfTuples() < d->ModifiedTuples[1] ||
+      !d->tupleBins(d->ModifiedTuples[0], d->ModifiedTuples[1], addedBins) ||
+      addedBins.size() != d->RemovedBins.size())
+    {
+    this->build();
     return;
     }
 
-  // What is the type of the array, discrete or reals
-  if (static_cast<double>(binCount) != (d->Range[1] - d->Range[0] + 1))
+  // Only the modified bins can change the min/max, unless a bin that was the
+  // min or the max moves inward
+  bool rescanMinMax = false;
+  int* binsPtr = d->Bins->GetPointer(0);
+  for (size_t i = 0; i < addedBins.size(); ++i)
     {
-    switch(d->DataArray->GetDataType())
+    const int delta = addedBins[i] - d->RemovedBins[i];
+    if (delta == 0)
       {
-      vtkTemplateMacro(populateIrregularBins<VTK_TT>(d->Bins, this));
+      continue;
       }
-    }
-  else
-    {
-    switch(d->DataArray->GetDataType())
+    const int oldValue = binsPtr[i];
+    const int newValue = oldValue + delta;
+    binsPtr[i] = newValue;
+    if ((oldValue == d->MaxBin && newValue < oldValue) ||
+        (oldValue == d->MinBin && newValue > oldValue))
       {
-      vtkTemplateMacro(populateBins<VTK_TT>(d->Bins, this));
+      rescanMinMax = true;
       }
+    d->MinBin = qMin(newValue, d->MinBin);
+    d->MaxBin = qMax(newValue, d->MaxBin);
     }
-  // update Min/Max values
-  int* binPtr = d->Bins->GetPointer(0);
-  int* endPtr = d->Bins->GetPointer(binCount-1);
-  d->MinBin = *endPtr;
-  d->MaxBin = *endPtr;
-  for (;binPtr < endPtr; ++binPtr)
+  if (rescanMinMax)
     {
-    d->MinBin = qMin(*binPtr, d->MinBin);
-    d->MaxBin = qMax(*binPtr, d->MaxBin);
+    d->updateMinMaxBins();
     }
+  d->Bins->Modified();
   emit changed();
 }
 
@@ -27,6 +27,9 @@
 #include "ctkVisualizationVTKCoreExport.h"
 #include "ctkVTKObject.h"
 
+// VTK includes
+#include <vtkType.h>
+
 class vtkDataArray;
 class ctkVTKHistogramPrivate;
 
@@ -64,6 +67,19 @@ public:
   virtual void removeControlPoint( qreal pos );
 
   virtual void build();
+
+  /// Incremental update of the histogram when only a range of tuples of the
+  /// data array is modified, e.g. a few slices of an image being painted.
+  /// Call beginModifyTuples() before the values are modified and
+  /// endModifyTuples() once they are: the old values are removed from the
+  /// bins, the new values added, and changed() is emitted.
+  /// The range and the number of bins of the last build() are kept. The
+  /// histogram is fully rebuilt if a new value is out of the range or if
+  /// build() has not been called.
+  /// The tuples are from \a beginTuple to \a endTuple excluded; the slices
+  /// k0 to k1 of an image are the tuples k0*dimX*dimY to (k1+1)*dimX*dimY.
+  void beginModifyTuples(vtkIdType beginTuple, vtkIdType endTuple);
+  void endModifyTuples();
 protected:
   qreal indexToPos(int index)const;
   int posToIndex(qreal pos)const;
@@ -23,6 +23,7 @@
 #include <QVariant>
 #include <QList>
 #include <QHash>
+#include <QPair>
 #include <QDebug>
 
 // CTK includes
@@ -94,9 +95,36 @@ public:
     return q->findChildren<ctkVTKConnection*>();
   }
 
+  /// Add the connection to the lookup tables
+  void indexConnection(ctkVTKConnection* connection,
+                       vtkObject* vtk_obj, unsigned long vtk_event,
+                       const QObject* qt_obj);
+  /// Remove the connection from the lookup tables, the connection may already
+  /// be destroyed
+  void unindexConnection(QObject* connection);
+
   bool StrictTypeCheck;
   bool AllBlocked;
   bool ObserveDeletion;
+
+  struct ConnectionKey
+  {
+    QString       Id;
+    vtkObject*    VTKObject;
+    unsigned long VTKEvent;
+    const QObject* QtObject;
+  };
+  typedef QHash<unsigned long, QList<ctkVTKConnection*> > ConnectionsByEvent;
+  typedef QPair<const QObject*, unsigned long> ReceiverKey;
+
+  /// Lookup tables of the connections. The vtkObject of a connection is reset
+  /// when the vtkObject is deleted, candidates must then be checked with
+  /// ctkVTKConnection::isEqual()
+  QHash<QString, ctkVTKConnection*>        ConnectionsById;
+  QHash<vtkObject*, ConnectionsByEvent>    ConnectionsByObject;
+  /// Used when no vtkObject is given, e.g. by reconnection()
+  QHash<ReceiverKey, QList<ctkVTKConnection*> > ConnectionsByReceiver;
+  QHash<QObject*, ConnectionKey>           ConnectionKeys;
 };
 
 //-----------------------------------------------------------------------------
@@ -116,14 +144,7 @@ ctkVTKObjectEventsObserverPrivate::ctkVTKObjectEventsObserverPrivate(ctkVTKObjec
 ctkVTKConnection*
 ctkVTKObjectEventsObserverPrivate::findConnection(const QString& id)const
 {
-  foreach(ctkVTKConnection* connection, this->connections())
-    {
-    if (connection->id() == id)
-      {
-      return connection;
-      }
-    }
-  return 0;
+  return this->ConnectionsById.value(id, 0);
 }
 
 //-----------------------------------------------------------------------------
@@ -132,14 +153,9 @@ ctkVTKObjectEventsObserverPrivate::findConnection(
   vtkObject* vtk_obj, unsigned long vtk_event,
   const QObject* qt_obj, const char* qt_slot)const
 {
-  foreach (ctkVTKConnection* connection, this->connections())
-    {
-    if (connection->isEqual(vtk_obj, vtk_event, qt_obj, qt_slot))
-      {
-      return connection;
-      }
-    }
-  return 0;
+  QList<ctkVTKConnection*> foundConnections =
+    this->findConnections(vtk_obj, vtk_event, qt_obj, qt_slot);
+  return foundConnections.isEmpty() ? 0 : foundConnections.first();
 }
 
 //-----------------------------------------------------------------------------
@@ -155,9 +171,36 @@ ctkVTKObjectEventsObserverPrivate::findConnections(
     all_info = false;
     }
 
+  // Only the connections observing vtk_obj, or connected to qt_obj
+  // for vtk_event, can match
+  QList<ctkVTKConnection*> candidates;
+  if (vtk_obj)
+    {
+    ConnectionsByEvent connectionsByEvent = this->ConnectionsByObject.value(vtk_obj);
+    if (vtk_event != vtkCommand::NoEvent)
+      {
+      candidates = connectionsByEvent.value(vtk_event);
+      }
+    else
+      {
+      foreach(const QList<ctkVTKConnection*>& eventConnections, connectionsByEvent)
+        {
+        candidates << eventConnections;
+        }
+      }
+    }
+  else if (qt_obj && vtk_event != vtkCommand::NoEvent)
+    {
+    candidates = this->ConnectionsByReceiver.value(ReceiverKey(qt_obj, vtk_event));
+    }
+  else
+    {
+    candidates = this->connections();
+    }
+
   QList<ctkVTKConnection*> foundConnections;
-  // Loop through all connection
-  foreach (ctkVTKConnection* connection, this->connections())
+  // Loop through all candidate connections
+  foreach (ctkVTKConnection* connection, candidates)
     {
     if (connection->isEqual(vtk_obj, vtk_event, qt_obj, qt_slot))
       {
@@ -171,6 +214,68 @@ ctkVTKObjectEventsObserverPrivate::findConnections(
   return foundConnections;
 }
 
+//-----------------------------------------------------------------------------
+void ctkVTKObjectEventsObserverPrivate::indexConnection(
+  ctkVTKConnection* connection, vtkObject* vtk_obj, unsigned long vtk_event,
+  const QObject* qt_obj)
+{
+  Q_Q(ctkVTKObjectEventsObserver);
+  ConnectionKey key;
+  key.Id = connection->id();
+  key.VTKObject = vtk_obj;
+  key.VTKEvent = vtk_event;
+  key.QtObject = qt_obj;
+  this->ConnectionKeys.insert(connection, key);
+  this->ConnectionsById.insert(key.Id, connection);
+  this->ConnectionsByObject[vtk_obj][vtk_event].append(connection);
+  this->ConnectionsByReceiver[ReceiverKey(qt_obj, vtk_event)].append(connection);
+  QObject::connect(connection, SIGNAL(destroyed(QObject*)),
+                   q, SLOT(onConnectionDestroyed(QObject*)));
+}
+
+//-----------------------------------------------------------------------------
+void ctkVTKObjectEventsObserverPrivate::unindexConnection(QObject* connection)
+{
+  QHash<QObject*, ConnectionKey>::iterator keyIt =
+    this->ConnectionKeys.find(connection);
+  if (keyIt == this->ConnectionKeys.end())
+    {
+    return;
+    }
+  const ConnectionKey& key = keyIt.value();
+  this->ConnectionsById.remove(key.Id);
+  QHash<vtkObject*, ConnectionsByEvent>::iterator objectIt =
+    this->ConnectionsByObject.find(key.VTKObject);
+  if (objectIt != this->ConnectionsByObject.end())
+    {
+    ConnectionsByEvent::iterator eventIt = objectIt.value().find(key.VTKEvent);
+    if (eventIt != objectIt.value().end())
+      {
+      // Only the address is compared, the connection may be destroyed
+      eventIt.value().removeOne(static_cast<ctkVTKConnection*>(connection));
+      if (eventIt.value().isEmpty())
+        {
+        objectIt.value().erase(eventIt);
+        }
+      }
+    if (objectIt.value().isEmpty())
+      {
+      this->ConnectionsByObject.erase(objectIt);
+      }
+    }
+  QHash<ReceiverKey, QList<ctkVTKConnection*> >::iterator receiverIt =
+    this->ConnectionsByReceiver.find(ReceiverKey(key.QtObject, key.VTKEvent));
+  if (receiverIt != this->ConnectionsByReceiver.end())
+    {
+    receiverIt.value().removeOne(static_cast<ctkVTKConnection*>(connection));
+    if (receiverIt.value().isEmpty())
+      {
+      this->ConnectionsByReceiver.erase(receiverIt);
+      }
+    }
+  this->ConnectionKeys.erase(keyIt);
+}
+
 //-----------------------------------------------------------------------------
 // ctkVTKObjectEventsObserver methods
 
@@ -305,6 +410,7 @@ QString ctkVTKObjectEventsObserver::addConnection(vtkObject* vtk_obj, unsigned l
   ctkVTKConnection * connection = ctkVTKConnectionFactory::instance()->createConnection(this);
   connection->observeDeletion(d->ObserveDeletion);
   connection->setup(vtk_obj, vtk_event, qt_obj, qt_slot, priority, connectionType);
+  d->indexConnection(connection, vtk_obj, vtk_event, qt_obj);
 
   // If required, establish connection
   connection->setBlocked(d->AllBlocked);
@@ -398,3 +504,10 @@ bool ctkVTKObjectEventsObserver::containsConnection(vtkObject* vtk_obj, unsigned
   Q_D(const ctkVTKObjectEventsObserver);
   return (d->findConnection(vtk_obj, vtk_event, qt_obj, qt_slot) != 0);
 }
+
+//-----------------------------------------------------------------------------
+void ctkVTKObjectEventsObserver::onConnectionDestroyed(QObject* connection)
+{
+  Q_D(ctkVTKObjectEventsObserver);
+  d->unindexConnection(connection);
+}
@@ -161,6 +161,9 @@ public:
   bool containsConnection(vtkObject* vtk_obj, unsigned long vtk_event = vtkCommand::NoEvent,
                           const QObject* qt_obj =0, const char* qt_slot =0)const;
 
+protected Q_SLOTS:
+  void onConnectionDestroyed(QObject* connection);
+
 protected:
   QScopedPointer<ctkVTKObjectEventsObserverPrivate> d_ptr;
 
@@ -21,6 +21,7 @@
 #include "vtkLightBoxRendererManager.h"
 
 // VTK includes
+#include <vtkCallbackCommand.h>
 #include <vtkCamera.h>
 #include <vtkCellArray.h>
 #include <vtkCornerAnnotation.h>
@@ -37,9 +38,12 @@
 #include <vtkRenderWindowInteractor.h>
 #include <vtkSmartPointer.h>
 #include <vtkTextProperty.h>
+#include <vtkTimeStamp.h>
 #include <vtkWeakPointer.h>
 
 // STD includes
+#include <algorithm>
+#include <limits>
 #include <vector>
 #include <cassert>
 
@@ -49,6 +53,99 @@ vtkStandardNewMacro(vtkLightBoxRendererManager);
 
 namespace
 {
+//-----------------------------------------------------------------------------
+/// Set the points of a box around the area [xMin, xMin + width] x
+/// [yMin, yMin + height] given in normalized viewport coordinates.
+void SetHighlightedBoxPoints(vtkPoints* points, double xMin, double yMin,
+                             double width, double height)
+{
+  // Normalized Viewport means :
+  // 0. -> 0;
+  // 1. -> width - 1 ;
+  // For a line of a width of 1, from (0.f,0.f) to (10.f,0.f), the line is on
+  // 2 pixels. What pixel to draw the line on ?
+  //
+  //     |       |       |       |       |       |       |
+  //  1  |       |       |       |       |       |       |
+  //     |       |       |       |       |       |       |
+  //     +-------+-------+-------+-------+-------+-------+
+  //     |       |       |       |       |       |       |
+  //  0  | What pixel    |================================
+  //     | line shall    |
+  //     +--be drawn---(0,0)
+  //     |  above or     |
+  // -1  |   below?      |================================
+  //     |       |       |       |       |       |       |
+  //  ^  +-------+-------+-------+-------+-------+-------+
+  //     |       |       |       |       |       |       |
+  // 1px |       |       |       |       |       |       |
+  //     |       |       |       |       |       |       |
+  //  V  +-------+-------+-------+-------+-------+-------+
+  //     <  1px  >  -1       0       1       2       3
+  // It depends of the graphic card, this is why we need to add an offset.
+  // 0.0002 seems to work for most of the window sizes.
+  double shift = 0.0002;
+  double xMax = xMin + width;
+  double yMax = yMin + height;
+  points->SetNumberOfPoints(6);
+  points->SetPoint(0, xMin + shift, yMin + shift, 0); // bottom-left
+  points->SetPoint(1, xMax + shift, yMin + shift, 0); // bottom-right
+  points->SetPoint(2, xMax + shift, yMax + shift + 0.1 * height, 0); // top-right to fill the 1,1 pixel
+  points->SetPoint(3, xMax + shift, yMax + shift, 0); // top-right
+  points->SetPoint(4, xMin + shift, yMax + shift, 0); // top-left
+  points->SetPoint(5, xMin + shift, yMin + shift - 0.1 * height, 0); // bottom-left to fill the 0,0 pixel.
+  points->Modified();
+}
+
+//-----------------------------------------------------------------------------
+/// Create a box actor drawing the lines between \a points and add it to \a renderer
+vtkSmartPointer<vtkActor2D> CreateHighlightedBoxActor(vtkRenderer* renderer, vtkPoints* points,
+                                                      const double highlightedBoxColor[3],
+                                                      bool visible)
+{
+  vtkNew<vtkPolyData> poly;
+  vtkNew<vtkCellArray> cells;
+  cells->InsertNextCell(6);
+  cells->InsertCellPoint(0);
+  cells->InsertCellPoint(1);
+  cells->InsertCellPoint(2);
+  cells->InsertCellPoint(3);
+  cells->InsertCellPoint(4);
+  cells->InsertCellPoint(5);
+  poly->SetPoints(points);
+  poly->SetLines(cells.GetPointer());
+
+  vtkNew<vtkCoordinate> coordinate;
+  coordinate->SetCoordinateSystemToNormalizedViewport();
+  coordinate->SetViewport(renderer);
+
+  vtkNew<vtkPolyDataMapper2D> polyDataMapper;
+  polyDataMapper->SetInput(poly.GetPointer());
+  polyDataMapper->SetTransformCoordinate(coordinate.GetPointer());
+  polyDataMapper->SetTransformCoordinateUseDouble(true);
+
+  vtkSmartPointer<vtkActor2D> actor = vtkSmartPointer<vtkActor2D>::New();
+  actor->SetMapper(polyDataMapper.GetPointer());
+  actor->GetProperty()->SetColor(highlightedBoxColor[0],
+                                 highlightedBoxColor[1],
+                                 highlightedBoxColor[2]);
+  actor->GetProperty()->SetDisplayLocationToForeground();
+  actor->GetProperty()->SetLineWidth(1.0f);
+  actor->SetVisibility(visible);
+
+  renderer->AddActor2D(actor);
+  return actor;
+}
+
+//-----------------------------------------------------------------------------
+/// Map \a value into [0, 255] the same way vtkImageMapper does
+inline unsigned char MapWindowLevel(double value, double shift, double scale)
+{
+  double mapped = (value + shift) * scale;
+  return mapped <= 0. ? 0 :
+    (mapped >= 255. ? 255 : static_cast<unsigned char>(mapped));
+}
+
 //-----------------------------------------------------------------------------
 // RenderWindowItem
 //-----------------------------------------------------------------------------
@@ -74,6 +171,21 @@ public:
   vtkSmartPointer<vtkImageMapper>             ImageMapper;
   vtkSmartPointer<vtkActor2D>                 HighlightedBoxActor;
 };
+
+//-----------------------------------------------------------------------------
+// RenderWindowTile
+//-----------------------------------------------------------------------------
+/// In SingleRenderer mode, a RenderWindowItem is only an area of the shared
+/// renderer and of the atlas. Tiles are recycled when the layout changes.
+class RenderWindowTile
+{
+public:
+  RenderWindowTile(vtkRenderer* renderer, const double highlightedBoxColor[3]);
+  void SetViewport(double xMin, double yMin, double viewportWidth, double viewportHeight);
+
+  vtkSmartPointer<vtkPoints>                  HighlightedBoxPoints;
+  vtkSmartPointer<vtkActor2D>                 HighlightedBoxActor;
+};
 }
 
 // --------------------------------------------------------------------------
@@ -129,77 +241,37 @@ void RenderWindowItem::SetupHighlightedBoxActor(const double highlightedBoxColor
   assert(!this->HighlightedBoxActor);
   
   // Create a highlight actor (2D box around viewport)
-  vtkNew<vtkPolyData> poly;
   vtkNew<vtkPoints> points;
-  // Normalized Viewport means :
-  // 0. -> 0;
-  // 1. -> width - 1 ;
-  // For a line of a width of 1, from (0.f,0.f) to (10.f,0.f), the line is on
-  // 2 pixels. What pixel to draw the line on ?
-  //
-  //     |       |       |       |       |       |       |
-  //  1  |       |       |       |       |       |       |
-  //     |       |       |       |       |       |       |
-  //     +-------+-------+-------+-------+-------+-------+
-  //     |       |       |       |       |       |       |
-  //  0  | What pixel    |================================
-  //     | line shall    |
-  //     +--be drawn---(0,0)
-  //     |  above or     |
-  // -1  |   below?      |================================
-  //     |       |       |       |       |       |       |
-  //  ^  +-------+-------+-------+-------+-------+-------+
-  //     |       |       |       |       |       |       |
-  // 1px |       |       |       |       |       |       |
-  //     |       |       |       |       |       |       |
-  //  V  +-------+-------+-------+-------+-------+-------+
-  //     <  1px  >  -1       0       1       2       3
-  // It depends of the graphic card, this is why we need to add an offset.
-  // 0.0002 seems to work for most of the window sizes.
-  double shift = 0.0002;
-  points->InsertNextPoint(0. + shift, 0. + shift, 0); // bottom-left
-  points->InsertNextPoint(1. + shift, 0. + shift, 0); // bottom-right
-  points->InsertNextPoint(1. + shift, 1. + shift + 0.1, 0); // top-right to fill the 1,1 pixel
-  points->InsertNextPoint(1. + shift, 1. + shift, 0); // top-right
-  points->InsertNextPoint(0. + shift, 1. + shift, 0); // top-left
-  points->InsertNextPoint(0. + shift, 0. + shift - 0.1, 0); // bottom-left to fill the 0,0 pixel.
-  
-  vtkNew<vtkCellArray> cells;
-  cells->InsertNextCell(6);
-  cells->InsertCellPoint(0);
-  cells->InsertCellPoint(1);
-  cells->InsertCellPoint(2);
-  cells->InsertCellPoint(3);
-  cells->InsertCellPoint(4);
-  cells->InsertCellPoint(5);
-  poly->SetPoints(points.GetPointer());
-  poly->SetLines(cells.GetPointer());
-
-  vtkNew<vtkCoordinate> coordinate;
-  coordinate->SetCoordinateSystemToNormalizedViewport();
-  coordinate->SetViewport(this->Renderer);
+  SetHighlightedBoxPoints(points.GetPointer(), 0., 0., 1., 1.);
+  this->HighlightedBoxActor = CreateHighlightedBoxActor(
+    this->Renderer, points.GetPointer(), highlightedBoxColor, visible);
+}
 
-  vtkNew<vtkPolyDataMapper2D> polyDataMapper;
-  polyDataMapper->SetInput(poly.GetPointer());
-  polyDataMapper->SetTransformCoordinate(coordinate.GetPointer());
-  polyDataMapper->SetTransformCoordinateUseDouble(true);
+//-----------------------------------------------------------------------------
+void RenderWindowItem::SetHighlightedBoxColor(double* newHighlightedBoxColor)
+{
+  this->HighlightedBoxActor->GetProperty()->SetColor(newHighlightedBoxColor);
+}
 
-  this->HighlightedBoxActor = vtkSmartPointer<vtkActor2D>::New();
-  this->HighlightedBoxActor->SetMapper(polyDataMapper.GetPointer());
-  this->HighlightedBoxActor->GetProperty()->SetColor(highlightedBoxColor[0],
-                                                     highlightedBoxColor[1],
-                                                     highlightedBoxColor[2]);
-  this->HighlightedBoxActor->GetProperty()->SetDisplayLocationToForeground();
-  this->HighlightedBoxActor->GetProperty()->SetLineWidth(1.0f);
-  this->HighlightedBoxActor->SetVisibility(visible);
+// --------------------------------------------------------------------------
+// RenderWindowTile methods
 
-  this->Renderer->AddActor2D(this->HighlightedBoxActor);
+//-----------------------------------------------------------------------------
+RenderWindowTile::RenderWindowTile(vtkRenderer* renderer,
+                                   const double highlightedBoxColor[3])
+{
+  this->HighlightedBoxPoints = vtkSmartPointer<vtkPoints>::New();
+  SetHighlightedBoxPoints(this->HighlightedBoxPoints, 0., 0., 1., 1.);
+  this->HighlightedBoxActor = CreateHighlightedBoxActor(
+    renderer, this->HighlightedBoxPoints, highlightedBoxColor, false);
 }
 
 //-----------------------------------------------------------------------------
-void RenderWindowItem::SetHighlightedBoxColor(double* newHighlightedBoxColor)
+void RenderWindowTile::SetViewport(double xMin, double yMin,
+                                   double viewportWidth, double viewportHeight)
 {
-  this->HighlightedBoxActor->GetProperty()->SetColor(newHighlightedBoxColor);
+  SetHighlightedBoxPoints(this->HighlightedBoxPoints,
+                          xMin, yMin, viewportWidth, viewportHeight);
 }
 
 //-----------------------------------------------------------------------------
@@ -215,9 +287,31 @@ public:
   void SetupCornerAnnotation();
   void setupRendering();
 
+  /// Create or delete RenderWindowItem(s) to have \a count items
+  void resizeRenderWindowItemList(int count);
+
+  /// Z slice displayed in the item at (\a rowId, \a columnId) according to \a layoutType
+  int sliceIndex(int rowId, int columnId, int layoutType)const;
+
   /// Update render window ImageMapper Z slice according to \a layoutType
   void updateRenderWindowItemsZIndex(int layoutType);
 
+  /// Create the renderer and the atlas actor used in SingleRenderer mode
+  void setupTiledRenderer();
+
+  /// Position the tiles in the tiled renderer, hide the unused ones
+  void setupTiles();
+
+  /// Extract all the visible slices into the atlas if anything changed
+  /// since the last time it was built
+  void updateAtlas();
+  template <class T>
+  void fillAtlas(const T* scalars, unsigned char* atlasPtr);
+
+  /// Keep the atlas up to date with the render window size
+  static void onStartRender(vtkObject* caller, unsigned long eid,
+                            void* clientData, void* callData);
+
   vtkSmartPointer<vtkRenderWindow>              RenderWindow;
   int                                           RenderWindowRowCount;
   int                                           RenderWindowColumnCount;
@@ -238,6 +332,21 @@ public:
   
   /// .. and its associated convenient typedef
   typedef std::vector<RenderWindowItem*>::iterator RenderWindowItemListIt;
+
+  int                                           RenderingMode;
+
+  /// SingleRenderer mode: the renderer shared by all the tiles and the atlas
+  /// image containing all the visible slices
+  vtkSmartPointer<vtkRenderer>                  TiledRenderer;
+  vtkSmartPointer<vtkImageData>                 Atlas;
+  vtkSmartPointer<vtkImageMapper>               AtlasMapper;
+  int                                           AtlasSize[2];
+  /// Modified when the content of the atlas must be extracted again
+  vtkTimeStamp                                  AtlasInputTime;
+  vtkTimeStamp                                  AtlasBuildTime;
+
+  /// Collection of RenderWindowTile, never shrinks
+  std::vector<RenderWindowTile*>                TileList;
   
   /// Reference to the public interface
   vtkLightBoxRendererManager*                         External;
@@ -254,6 +363,9 @@ vtkLightBoxRendererManager::vtkInternal::vtkInternal(vtkLightBoxRendererManager*
   this->RenderWindowRowCount = 0;
   this->RenderWindowColumnCount = 0;
   this->RenderWindowLayoutType = vtkLightBoxRendererManager::LeftRightTopBottom;
+  this->RenderingMode = vtkLightBoxRendererManager::MultipleRenderers;
+  this->AtlasSize[0] = 0;
+  this->AtlasSize[1] = 0;
   this->ColorWindow = 255;
   this->ColorLevel = 127.5;
   this->RendererLayer = 0;
@@ -281,11 +393,24 @@ vtkLightBoxRendererManager::vtkInternal::~vtkInternal()
     delete *it;
     }
   this->RenderWindowItemList.clear();
+  for(std::vector<RenderWindowTile*>::iterator it = this->TileList.begin();
+      it != this->TileList.end();
+      ++it)
+    {
+    delete *it;
+    }
+  this->TileList.clear();
 }
 
 // --------------------------------------------------------------------------
 void vtkLightBoxRendererManager::vtkInternal::SetupCornerAnnotation()
 {
+  if (this->TiledRenderer &&
+      this->RenderingMode == vtkLightBoxRendererManager::SingleRenderer &&
+      !this->TiledRenderer->HasViewProp(this->CornerAnnotation))
+    {
+    this->TiledRenderer->AddViewProp(this->CornerAnnotation);
+    }
   for(RenderWindowItemListIt it = this->RenderWindowItemList.begin();
       it != this->RenderWindowItemList.end();
       ++it)
@@ -312,6 +437,17 @@ void vtkLightBoxRendererManager::vtkInternal::setupRendering()
     {
     this->RenderWindow->GetRenderers()->RemoveItem((*it)->Renderer);
     }
+  if (this->TiledRenderer)
+    {
+    this->RenderWindow->GetRenderers()->RemoveItem(this->TiledRenderer);
+    }
+
+  if (this->RenderingMode == vtkLightBoxRendererManager::SingleRenderer)
+    {
+    this->setupTiles();
+    this->RenderWindow->AddRenderer(this->TiledRenderer);
+    return;
+    }
 
   // Compute the width and height of each RenderWindowItem
   double viewportWidth  = 1.0 / static_cast<double>(this->RenderWindowColumnCount);
@@ -344,9 +480,69 @@ void vtkLightBoxRendererManager::vtkInternal::setupRendering()
     }
 }
 
+// --------------------------------------------------------------------------
+void vtkLightBoxRendererManager::vtkInternal::resizeRenderWindowItemList(int count)
+{
+  int extraItem = count - static_cast<int>(this->RenderWindowItemList.size());
+  if (extraItem > 0)
+    {
+    //std::cout << "Creating " << extraItem << " RenderWindowItem";
+
+    // Create extra RenderWindowItem(s)
+    while(extraItem > 0)
+      {
+      RenderWindowItem * item =
+          new RenderWindowItem(this->RendererBackgroundColor,
+                               this->HighlightedBoxColor,
+                               this->ColorWindow, this->ColorLevel);
+      item->Renderer->SetLayer(this->RendererLayer);
+      item->ImageMapper->SetInput(this->ImageData);
+      this->RenderWindowItemList.push_back(item);
+      --extraItem;
+      }
+    }
+  else
+    {
+    //std::cout << "Removing " << extraItem << " RenderWindowItem";
+
+    // Remove extra RenderWindowItem(s)
+    extraItem = extraItem >= 0 ? extraItem : -extraItem; // Compute Abs
+    while(extraItem > 0)
+      {
+      this->RenderWindow->GetRenderers()->RemoveItem(
+        this->RenderWindowItemList.back()->Renderer);
+      delete this->RenderWindowItemList.back();
+      this->RenderWindowItemList.pop_back();
+      --extraItem;
+      }
+    }
+}
+
+// --------------------------------------------------------------------------
+int vtkLightBoxRendererManager::vtkInternal::sliceIndex(int rowId, int columnId,
+                                                         int layoutType)const
+{
+  // Default to ctkVTKSliceView::LeftRightTopBottom
+  int zSliceIndex = rowId * this->RenderWindowColumnCount + columnId;
+
+  if (layoutType == vtkLightBoxRendererManager::LeftRightBottomTop)
+    {
+    zSliceIndex = (this->RenderWindowRowCount - rowId - 1) *
+                  this->RenderWindowColumnCount + columnId;
+    }
+  return zSliceIndex;
+}
+
 // --------------------------------------------------------------------------
 void vtkLightBoxRendererManager::vtkInternal::updateRenderWindowItemsZIndex(int layoutType)
 {
+  if (this->RenderingMode == vtkLightBoxRendererManager::SingleRenderer)
+    {
+    // The slices are extracted when the atlas is built
+    this->AtlasInputTime.Modified();
+    return;
+    }
+
   for (int rowId = 0; rowId < this->RenderWindowRowCount; ++rowId)
     {
     for (int columnId = 0; columnId < this->RenderWindowColumnCount; ++columnId)
@@ -357,16 +553,247 @@ void vtkLightBoxRendererManager::vtkInternal::updateRenderWindowItemsZIndex(int
       RenderWindowItem * item = this->RenderWindowItemList.at(itemId);
       assert(item->ImageMapper->GetInput());
 
-      // Default to ctkVTKSliceView::LeftRightTopBottom
-      int zSliceIndex = rowId * this->RenderWindowColumnCount + columnId;
+      item->ImageMapper->SetZSlice(this->sliceIndex(rowId, columnId, layoutType));
+      }
+    }
+}
+
+// --------------------------------------------------------------------------
+void vtkLightBoxRendererManager::vtkInternal::setupTiledRenderer()
+{
+  if (this->TiledRenderer)
+    {
+    return;
+    }
+  this->TiledRenderer = vtkSmartPointer<vtkRenderer>::New();
+  this->TiledRenderer->SetLayer(this->RendererLayer);
+  this->TiledRenderer->SetBackground(this->RendererBackgroundColor[0],
+                                     this->RendererBackgroundColor[1],
+                                     this->RendererBackgroundColor[2]);
+
+  // The atlas is already windowed, the mapper displays it as is
+  this->Atlas = vtkSmartPointer<vtkImageData>::New();
+  this->AtlasMapper = vtkSmartPointer<vtkImageMapper>::New();
+  this->AtlasMapper->SetInput(this->Atlas);
+  this->AtlasMapper->SetColorWindow(255.);
+  this->AtlasMapper->SetColorLevel(127.5);
+
+  vtkNew<vtkActor2D> actor2D;
+  actor2D->SetMapper(this->AtlasMapper);
+  actor2D->GetProperty()->SetDisplayLocationToBackground();
+  this->TiledRenderer->AddActor2D(actor2D.GetPointer());
+
+  vtkNew<vtkCallbackCommand> startRenderCallback;
+  startRenderCallback->SetCallback(vtkInternal::onStartRender);
+  startRenderCallback->SetClientData(this);
+  this->TiledRenderer->AddObserver(vtkCommand::StartEvent, startRenderCallback.GetPointer());
+}
+
+// --------------------------------------------------------------------------
+void vtkLightBoxRendererManager::vtkInternal::setupTiles()
+{
+  this->setupTiledRenderer();
+
+  const int tileCount = this->RenderWindowRowCount * this->RenderWindowColumnCount;
+  while (static_cast<int>(this->TileList.size()) < tileCount)
+    {
+    this->TileList.push_back(
+      new RenderWindowTile(this->TiledRenderer, this->HighlightedBoxColor));
+    }
+
+  // Compute the width and height of each tile
+  double viewportWidth  = 1.0 / static_cast<double>(this->RenderWindowColumnCount);
+  double viewportHeight = 1.0 / static_cast<double>(this->RenderWindowRowCount);
+
+  for ( int rowId = 0; rowId < this->RenderWindowRowCount; ++rowId )
+    {
+    double yMin = (this->RenderWindowRowCount - 1 - rowId) * viewportHeight;
+    for ( int columnId = 0; columnId < this->RenderWindowColumnCount; ++columnId )
+      {
+      RenderWindowTile* tile =
+        this->TileList.at(this->External->ComputeRenderWindowItemId(rowId, columnId));
+      tile->SetViewport(columnId * viewportWidth, yMin, viewportWidth, viewportHeight);
+      }
+    }
+  // Recycled tiles are not highlighted anymore
+  for (int tileId = tileCount; tileId < static_cast<int>(this->TileList.size()); ++tileId)
+    {
+    this->TileList[tileId]->HighlightedBoxActor->SetVisibility(false);
+    }
 
-      if (layoutType == vtkLightBoxRendererManager::LeftRightBottomTop)
+  this->AtlasInputTime.Modified();
+}
+
+// --------------------------------------------------------------------------
+void vtkLightBoxRendererManager::vtkInternal::onStartRender(
+  vtkObject* vtkNotUsed(caller), unsigned long vtkNotUsed(eid),
+  void* clientData, void* vtkNotUsed(callData))
+{
+  vtkInternal* self = reinterpret_cast<vtkInternal*>(clientData);
+  self->updateAtlas();
+}
+
+// --------------------------------------------------------------------------
+void vtkLightBoxRendererManager::vtkInternal::updateAtlas()
+{
+  if (!this->RenderWindow || !this->Atlas)
+    {
+    return;
+    }
+  if (this->ImageData)
+    {
+    this->ImageData->Update();
+    }
+
+  int* windowSize = this->RenderWindow->GetSize();
+  if (windowSize[0] == this->AtlasSize[0] &&
+      windowSize[1] == this->AtlasSize[1] &&
+      this->AtlasBuildTime > this->AtlasInputTime &&
+      (!this->ImageData || this->AtlasBuildTime > this->ImageData->GetMTime()))
+    {
+    return;
+    }
+
+  // The atlas is only reallocated when the render window is resized
+  if (windowSize[0] != this->AtlasSize[0] ||
+      windowSize[1] != this->AtlasSize[1])
+    {
+    this->Atlas->SetDimensions(std::max(windowSize[0], 1), std::max(windowSize[1], 1), 1);
+    this->Atlas->SetScalarTypeToUnsignedChar();
+    this->Atlas->SetNumberOfScalarComponents(3);
+    this->Atlas->AllocateScalars();
+    this->AtlasSize[0] = windowSize[0];
+    this->AtlasSize[1] = windowSize[1];
+    }
+
+  unsigned char* atlasPtr = static_cast<unsigned char*>(this->Atlas->GetScalarPointer());
+  if (this->ImageData && this->ImageData->GetNumberOfPoints() > 0 &&
+      this->RenderWindowRowCount > 0 && this->RenderWindowColumnCount > 0)
+    {
+    switch (this->ImageData->GetScalarType())
+      {
+      vtkTemplateMacro(this->fillAtlas(
+        static_cast<const VTK_TT*>(this->ImageData->GetScalarPointer()), atlasPtr));
+      default:
+        break;
+      }
+    }
+  else
+    {
+    // Nothing to display
+    unsigned char* endPtr = atlasPtr + this->Atlas->GetNumberOfPoints() * 3;
+    for (; atlasPtr < endPtr; atlasPtr += 3)
+      {
+      for (int i = 0; i < 3; ++i)
         {
-        zSliceIndex = (this->RenderWindowRowCount - rowId - 1) *
-                      this->RenderWindowColumnCount + columnId;
+        atlasPtr[i] = static_cast<unsigned char>(this->RendererBackgroundColor[i] * 255.);
         }
+      }
+    }
+
+  this->Atlas->Modified();
+  this->AtlasBuildTime.Modified();
+}
 
-      item->ImageMapper->SetZSlice(zSliceIndex);
+// --------------------------------------------------------------------------
+template <class T>
+void vtkLightBoxRendererManager::vtkInternal::fillAtlas(const T* scalars,
+                                                        unsigned char* atlasPtr)
+{
+  int extent[6];
+  this->ImageData->GetExtent(extent);
+  vtkIdType increments[3];
+  this->ImageData->GetIncrements(increments);
+  const int componentCount = this->ImageData->GetNumberOfScalarComponents();
+  const int sliceWidth = extent[1] - extent[0] + 1;
+  const int sliceHeight = extent[3] - extent[2] + 1;
+
+  int atlasDimensions[3];
+  this->Atlas->GetDimensions(atlasDimensions);
+  const int atlasWidth = atlasDimensions[0];
+  const int atlasHeight = atlasDimensions[1];
+
+  unsigned char background[3];
+  for (int i = 0; i < 3; ++i)
+    {
+    background[i] = static_cast<unsigned char>(this->RendererBackgroundColor[i] * 255.);
+    }
+
+  // Same window/level as vtkImageMapper
+  const double shift = this->ColorWindow / 2.0 - this->ColorLevel;
+  const double scale = 255.0 / this->ColorWindow;
+  // Small integer types are windowed through a lookup table
+  const bool useLookupTable = std::numeric_limits<T>::is_integer && sizeof(T) <= 2;
+  std::vector<unsigned char> lookupTable;
+  const int typeMin = useLookupTable ? static_cast<int>(std::numeric_limits<T>::min()) : 0;
+  if (useLookupTable)
+    {
+    const int typeMax = static_cast<int>(std::numeric_limits<T>::max());
+    lookupTable.resize(typeMax - typeMin + 1);
+    for (int value = typeMin; value <= typeMax; ++value)
+      {
+      lookupTable[value - typeMin] = MapWindowLevel(value, shift, scale);
+      }
+    }
+
+  // Pixel boundaries of the rows (bottom to top) and the columns of tiles
+  std::vector<int> rowStart(this->RenderWindowRowCount + 1);
+  for (int row = 0; row <= this->RenderWindowRowCount; ++row)
+    {
+    rowStart[row] = row * atlasHeight / this->RenderWindowRowCount;
+    }
+  std::vector<int> columnStart(this->RenderWindowColumnCount + 1);
+  for (int columnId = 0; columnId <= this->RenderWindowColumnCount; ++columnId)
+    {
+    columnStart[columnId] = columnId * atlasWidth / this->RenderWindowColumnCount;
+    }
+
+  // Each visible slice row is read once and written at its place in the atlas
+  for (int row = 0; row < this->RenderWindowRowCount; ++row)
+    {
+    const int rowId = this->RenderWindowRowCount - 1 - row;
+    for (int y = rowStart[row]; y < rowStart[row + 1]; ++y)
+      {
+      const int sliceY = y - rowStart[row];
+      unsigned char* outPtr = atlasPtr + 3 * static_cast<vtkIdType>(y) * atlasWidth;
+      for (int columnId = 0; columnId < this->RenderWindowColumnCount; ++columnId)
+        {
+        const int tileWidth = columnStart[columnId + 1] - columnStart[columnId];
+        int width = 0;
+        if (sliceY < sliceHeight)
+          {
+          // clamped to the image extent
+          int z = this->sliceIndex(rowId, columnId, this->RenderWindowLayoutType);
+          z = std::min(std::max(z, extent[4]), extent[5]);
+          const T* inPtr = scalars + (z - extent[4]) * increments[2] + sliceY * increments[1];
+          width = std::min(tileWidth, sliceWidth);
+          for (int x = 0; x < width; ++x, inPtr += componentCount, outPtr += 3)
+            {
+            if (componentCount < 3)
+              {
+              unsigned char gray = useLookupTable ?
+                lookupTable[static_cast<int>(inPtr[0]) - typeMin] :
+                MapWindowLevel(inPtr[0], shift, scale);
+              outPtr[0] = outPtr[1] = outPtr[2] = gray;
+              }
+            else
+              {
+              for (int c = 0; c < 3; ++c)
+                {
+                outPtr[c] = useLookupTable ?
+                  lookupTable[static_cast<int>(inPtr[c]) - typeMin] :
+                  MapWindowLevel(inPtr[c], shift, scale);
+                }
+              }
+            }
+          }
+        for (int x = width; x < tileWidth; ++x, outPtr += 3)
+          {
+          outPtr[0] = background[0];
+          outPtr[1] = background[1];
+          outPtr[2] = background[2];
+          }
+        }
       }
     }
 }
@@ -458,12 +885,13 @@ void vtkLightBoxRendererManager::SetImageData(vtkImageData* newImageData)
     (*it)->ImageMapper->SetInput(newImageData);
     }
 
+  this->Internal->ImageData = newImageData;
+
   if (newImageData)
     {
     this->Internal->updateRenderWindowItemsZIndex(this->Internal->RenderWindowLayoutType);
     }
-
-  this->Internal->ImageData = newImageData;
+  this->Internal->AtlasInputTime.Modified();
 
   this->Modified();
 }
@@ -471,14 +899,14 @@ void vtkLightBoxRendererManager::SetImageData(vtkImageData* newImageData)
 //----------------------------------------------------------------------------
 vtkCamera* vtkLightBoxRendererManager::GetActiveCamera()
 {
-  if (this->Internal->RenderWindowItemList.size() == 0)
+  if (this->GetRenderWindowItemCount() == 0)
     {
     return 0;
     }
 
   // Obtain reference of the first renderer
-  vtkRenderer * firstRenderer = this->Internal->RenderWindowItemList.at(0)->Renderer;
-  if (firstRenderer->IsActiveCameraCreated())
+  vtkRenderer * firstRenderer = this->GetRenderer(0);
+  if (firstRenderer && firstRenderer->IsActiveCameraCreated())
     {
     return firstRenderer->GetActiveCamera();
     }
@@ -511,6 +939,10 @@ void vtkLightBoxRendererManager::SetActiveCamera(vtkCamera* newActiveCamera)
     {
     (*it)->Renderer->SetActiveCamera(newActiveCamera);
     }
+  if (this->Internal->TiledRenderer)
+    {
+    this->Internal->TiledRenderer->SetActiveCamera(newActiveCamera);
+    }
 
   this->Modified();
 }
@@ -530,22 +962,34 @@ void vtkLightBoxRendererManager::ResetCamera()
     {
     (*it)->Renderer->ResetCamera();
     }
+  if (this->Internal->TiledRenderer)
+    {
+    this->Internal->TiledRenderer->ResetCamera();
+    }
   this->Modified();
 }
 
 //----------------------------------------------------------------------------
 int vtkLightBoxRendererManager::GetRenderWindowItemCount()
 {
+  if (this->Internal->RenderingMode == vtkLightBoxRendererManager::SingleRenderer)
+    {
+    return this->Internal->RenderWindowRowCount * this->Internal->RenderWindowColumnCount;
+    }
   return static_cast<int>(this->Internal->RenderWindowItemList.size());
 }
 
 //----------------------------------------------------------------------------
 vtkRenderer* vtkLightBoxRendererManager::GetRenderer(int id)
 {
-  if (id < 0 || id >= static_cast<int>(this->Internal->RenderWindowItemList.size()))
+  if (id < 0 || id >= this->GetRenderWindowItemCount())
     {
     return 0;
     }
+  if (this->Internal->RenderingMode == vtkLightBoxRendererManager::SingleRenderer)
+    {
+    return this->Internal->TiledRenderer;
+    }
   return this->Internal->RenderWindowItemList.at(id)->Renderer;
 }
 
@@ -579,6 +1023,56 @@ int vtkLightBoxRendererManager::GetRenderWindowLayoutType() const
   return this->Internal->RenderWindowLayoutType;
 }
 
+//----------------------------------------------------------------------------
+int vtkLightBoxRendererManager::GetRenderingMode() const
+{
+  return this->Internal->RenderingMode;
+}
+
+//----------------------------------------------------------------------------
+void vtkLightBoxRendererManager::SetRenderingMode(int mode)
+{
+  if (this->Internal->RenderingMode == mode)
+    {
+    return;
+    }
+
+  // The camera is retrieved from the renderers of the current mode
+  vtkCamera* activeCamera = this->IsInitialized() ? this->GetActiveCamera() : 0;
+  if (activeCamera)
+    {
+    activeCamera->Register(this);
+    }
+
+  this->Internal->RenderingMode = mode;
+
+  if (this->IsInitialized())
+    {
+    this->Internal->resizeRenderWindowItemList(
+      mode == vtkLightBoxRendererManager::MultipleRenderers ?
+      this->Internal->RenderWindowRowCount * this->Internal->RenderWindowColumnCount : 0);
+    // Tiles are not highlighted when reused
+    for (int tileId = 0; tileId < static_cast<int>(this->Internal->TileList.size()); ++tileId)
+      {
+      this->Internal->TileList[tileId]->HighlightedBoxActor->SetVisibility(false);
+      }
+    this->Internal->setupRendering();
+    this->Internal->SetupCornerAnnotation();
+    if (this->Internal->ImageData)
+      {
+      this->Internal->updateRenderWindowItemsZIndex(this->Internal->RenderWindowLayoutType);
+      }
+
+    if (activeCamera)
+      {
+      this->SetActiveCamera(activeCamera);
+      activeCamera->UnRegister(this);
+      }
+    }
+
+  this->Modified();
+}
+
 //----------------------------------------------------------------------------
 void vtkLightBoxRendererManager::SetRenderWindowLayout(int rowCount, int columnCount)
 {
@@ -602,38 +1096,10 @@ void vtkLightBoxRendererManager::SetRenderWindowLayout(int rowCount, int columnC
     return;
     }
 
-  int extraItem = (rowCount * columnCount)
-    - static_cast<int>(this->Internal->RenderWindowItemList.size());
-  if (extraItem > 0)
-    {
-    //std::cout << "Creating " << extraItem << " RenderWindowItem";
-
-    // Create extra RenderWindowItem(s)
-    while(extraItem > 0)
-      {
-      RenderWindowItem * item =
-          new RenderWindowItem(this->Internal->RendererBackgroundColor,
-                               this->Internal->HighlightedBoxColor,
-                               this->Internal->ColorWindow, this->Internal->ColorLevel);
-      item->Renderer->SetLayer(this->Internal->RendererLayer);
-      item->ImageMapper->SetInput(this->Internal->ImageData);
-      this->Internal->RenderWindowItemList.push_back(item);
-      --extraItem;
-      }
-    }
-  else
-    {
-    //std::cout << "Removing " << extraItem << " RenderWindowItem";
-
-    // Remove extra RenderWindowItem(s)
-    extraItem = extraItem >= 0 ? extraItem : -extraItem; // Compute Abs
-    while(extraItem > 0)
-      {
-      delete this->Internal->RenderWindowItemList.back();
-      this->Internal->RenderWindowItemList.pop_back();
-      --extraItem;
-      }
-    }
+  // In SingleRenderer mode, the tiles are recycled by setupRendering()
+  this->Internal->resizeRenderWindowItemList(
+    this->Internal->RenderingMode == vtkLightBoxRendererManager::MultipleRenderers ?
+    rowCount * columnCount : 0);
 
   this->Internal->RenderWindowRowCount = rowCount;
   this->Internal->RenderWindowColumnCount = columnCount;
@@ -680,10 +1146,14 @@ bool vtkLightBoxRendererManager::GetHighlightedById(int id)
     vtkErrorMacro(<< "SetHighlightedById failed - vtkLightBoxRendererManager is NOT initialized");
     return false;
     }
-  if (id < 0 || id >= static_cast<int>(this->Internal->RenderWindowItemList.size()))
+  if (id < 0 || id >= this->GetRenderWindowItemCount())
     {
     return false;
     }
+  if (this->Internal->RenderingMode == vtkLightBoxRendererManager::SingleRenderer)
+    {
+    return this->Internal->TileList.at(id)->HighlightedBoxActor->GetVisibility();
+    }
   return this->Internal->RenderWindowItemList.at(id)->HighlightedBoxActor->GetVisibility();
 }
 
@@ -701,11 +1171,18 @@ void vtkLightBoxRendererManager::SetHighlightedById(int id, bool highlighted)
     vtkErrorMacro(<< "SetHighlightedById failed - vtkLightBoxRendererManager is NOT initialized");
     return;
     }
-  if (id < 0 || id >= static_cast<int>(this->Internal->RenderWindowItemList.size()))
+  if (id < 0 || id >= this->GetRenderWindowItemCount())
     {
     return;
     }
-  this->Internal->RenderWindowItemList.at(id)->HighlightedBoxActor->SetVisibility(highlighted);
+  if (this->Internal->RenderingMode == vtkLightBoxRendererManager::SingleRenderer)
+    {
+    this->Internal->TileList.at(id)->HighlightedBoxActor->SetVisibility(highlighted);
+    }
+  else
+    {
+    this->Internal->RenderWindowItemList.at(id)->HighlightedBoxActor->SetVisibility(highlighted);
+    }
 
   this->Modified();
 }
@@ -743,6 +1220,12 @@ void vtkLightBoxRendererManager::SetHighlightedBoxColor(double newHighlightedBox
     {
     (*it)->SetHighlightedBoxColor(newHighlightedBoxColor);
     }
+  for(std::vector<RenderWindowTile*>::iterator tileIt = this->Internal->TileList.begin();
+      tileIt != this->Internal->TileList.end();
+      ++tileIt)
+    {
+    (*tileIt)->HighlightedBoxActor->GetProperty()->SetColor(newHighlightedBoxColor);
+    }
 
   this->Modified();
 }
@@ -808,6 +1291,10 @@ void vtkLightBoxRendererManager::SetCornerAnnotation(vtkCornerAnnotation* annota
       (*it)->Renderer->RemoveViewProp(this->Internal->CornerAnnotation);
       }
     }
+  if (this->Internal->TiledRenderer)
+    {
+    this->Internal->TiledRenderer->RemoveViewProp(this->Internal->CornerAnnotation);
+    }
   this->Internal->CornerAnnotation = annotation;
 }
 
@@ -828,10 +1315,18 @@ void vtkLightBoxRendererManager::SetBackgroundColor(const double newBackgroundCo
                                    newBackgroundColor[1],
                                    newBackgroundColor[2]);
     }
+  if (this->Internal->TiledRenderer)
+    {
+    this->Internal->TiledRenderer->SetBackground(newBackgroundColor[0],
+                                                 newBackgroundColor[1],
+                                                 newBackgroundColor[2]);
+    }
 
   this->Internal->RendererBackgroundColor[0] = newBackgroundColor[0];
   this->Internal->RendererBackgroundColor[1] = newBackgroundColor[1];
   this->Internal->RendererBackgroundColor[2] = newBackgroundColor[2];
+  // The background is visible around the slices in the atlas
+  this->Internal->AtlasInputTime.Modified();
 
   this->Modified();
 }
@@ -886,6 +1381,7 @@ void vtkLightBoxRendererManager::SetColorWindowAndLevel(double colorWindow, doub
 
   this->Internal->ColorWindow = colorWindow;
   this->Internal->ColorLevel = colorLevel;
+  this->Internal->AtlasInputTime.Modified();
 
   this->Modified();
 }
@@ -68,6 +68,7 @@ class CTK_VISUALIZATION_VTK_CORE_EXPORT vtkLightBoxRendererManager : public vtkO
   int GetRenderWindowItemCount();
   
   /// Get a reference to the associated vtkRenderer(s) identified by its \a id
+  /// \note In SingleRenderer mode, all the items share the same renderer.
   vtkRenderer* GetRenderer(int id);
   
   /// Get a reference to the associated vtkRenderer(s) given its position in the grid
@@ -85,6 +86,23 @@ class CTK_VISUALIZATION_VTK_CORE_EXPORT vtkLightBoxRendererManager : public vtkO
   /// Set current \a layoutType
   void SetRenderWindowLayoutType(int layoutType);
 
+  /// The rendering mode determines how the grid is rendered.
+  /// MultipleRenderers: each render view item has its own vtkRenderer and
+  /// vtkImageMapper, each extracting its slice.
+  /// SingleRenderer: the visible slices are extracted in one pass into a
+  /// single atlas image drawn by one renderer shared by all the items. This
+  /// is much faster for large layouts.
+  /// \sa SetRenderingMode() GetRenderingMode()
+  enum RenderingModeType{MultipleRenderers = 0, SingleRenderer};
+
+  /// Get current rendering mode
+  /// \note By default, the value is MultipleRenderers
+  int GetRenderingMode() const;
+
+  /// Set current rendering \a mode
+  /// \note Highlighted items are reset when the mode changes.
+  void SetRenderingMode(int mode);
+
   /// Split the current vtkRenderWindow in \a rowCount per \a columnCount grid
   void SetRenderWindowLayout(int rowCount, int columnCount);
 
@@ -22,6 +22,7 @@
 #include <QEvent>
 #include <QMouseEvent>
 #include <QPointF>
+#include <QTimer>
 #include <QTimerEvent>
 
 // CTK includes
@@ -37,6 +38,7 @@
 
 // STD includes
 #include <cmath>
+#include <cstring>
 
 //--------------------------------------------------------------------------
 static ctkLogger logger("org.commontk.visualization.vtk.widgets.ctkVTKMagnifyView");
@@ -59,6 +61,8 @@ ctkVTKMagnifyViewPrivate::ctkVTKMagnifyViewPrivate(ctkVTKMagnifyView& object)
   this->EventHandler.UpdateInterval = 20;
   this->EventHandler.TimerId = 0;
 
+  this->WaitingForPaint = false;
+  this->PixelData = vtkSmartPointer<vtkUnsignedCharArray>::New();
 }
 
 // --------------------------------------------------------------------------
@@ -115,7 +119,12 @@ void ctkVTKMagnifyViewPrivate::timerEvent(QTimerEvent * event)
 {
   Q_UNUSED(event);
   Q_ASSERT(event->timerId() == this->EventHandler.TimerId);
+  this->processPendingEvent();
+}
 
+// --------------------------------------------------------------------------
+void ctkVTKMagnifyViewPrivate::processPendingEvent()
+{
   if (this->EventHandler.EventType == UpdatePixmapEvent)
     {
     this->updatePixmap();
@@ -239,6 +248,7 @@ void ctkVTKMagnifyViewPrivate::removePixmap()
 {
   Q_ASSERT(this->EventHandler.EventType == RemovePixmapEvent);
   Q_Q(ctkVTKMagnifyView);
+  this->WaitingForPaint = false;
   QPixmap nullPixmap;
   q->setPixmap(nullPixmap);
   q->update();
@@ -252,6 +262,12 @@ void ctkVTKMagnifyViewPrivate::updatePixmap()
   Q_ASSERT(!this->EventHandler.Widget.isNull());
   Q_Q(ctkVTKMagnifyView);
 
+  // The previous image has not been painted yet, keep the event pending
+  if (this->WaitingForPaint && q->isVisible())
+    {
+    return;
+    }
+
   // Retrieve buffer of given QVTKWidget from its render window
   vtkRenderWindow * renderWindow = this->EventHandler.Widget.data()->GetRenderWindow();
   if (!renderWindow)
@@ -354,27 +370,19 @@ void ctkVTKMagnifyViewPrivate::updatePixmap()
     }
   q->setAlignment(alignment);
 
-  // Retrieve the pixel data into a QImage (flip vertically to move from render
-  // window coordinates to Qt coordinates)
+  // Retrieve the pixel data of the region into the persistent buffer
   QSize actualSize(indexRight-indexLeft+1, indexTop-indexBottom+1);
-  QImage image(actualSize.width(), actualSize.height(), QImage::Format_RGB32);
-  vtkUnsignedCharArray * pixelData = vtkUnsignedCharArray::New();
-  pixelData->SetArray(image.bits(), actualSize.width() * actualSize.height() * 4, 1);
   int front = renderWindow->GetDoubleBuffer();
   int success = renderWindow->GetRGBACharPixelData(
-      indexLeft, indexBottom, indexRight, indexTop, front, pixelData);
+      indexLeft, indexBottom, indexRight, indexTop, front, this->PixelData);
   if (!success)
     {
     return;
     }
-  pixelData->Delete();
-  image = image.rgbSwapped();
-  image = image.mirrored();
 
-  // Scale the image to zoom, using FastTransformation to prevent smoothing
+  // Size of the image zoomed with nearest neighbour interpolation
   QSize imageSize = actualSize * this->Magnification;
-  image = image.scaled(imageSize, Qt::KeepAspectRatioByExpanding,
-                       Qt::FastTransformation);
+  QSize scaledSize = actualSize.scaled(imageSize, Qt::KeepAspectRatioByExpanding);
 
   // Crop the magnified image to solve the problem of magnified partial pixels
   double errorLeft
@@ -427,15 +435,74 @@ void ctkVTKMagnifyViewPrivate::updatePixmap()
     cropIndexTop -= diffHeight;
     }
 
-  // Finally crop the QImage for display
   QRect cropRect(QPoint(cropIndexLeft, cropIndexTop),
                  QPoint(cropIndexRight, cropIndexBottom));
-  image = image.copy(cropRect);
+  if (cropRect.width() <= 0 || cropRect.height() <= 0)
+    {
+    return;
+    }
 
+  // Only the cropped region of the magnified image is computed: each pixel
+  // is read from the RGBA render window buffer, swapped to ARGB, flipped
+  // vertically (render window rows go bottom to top) and replicated.
+  if (this->MagnifiedImage.size() != cropRect.size())
+    {
+    this->MagnifiedImage = QImage(cropRect.size(), QImage::Format_RGB32);
+    }
+  // Source column of each column of the magnified image, -1 when outside of
+  // the magnified image
+  this->SourceColumns.resize(cropRect.width());
+  for (int x = 0; x < cropRect.width(); ++x)
+    {
+    int magnifiedX = cropRect.left() + x;
+    this->SourceColumns[x] = (magnifiedX < 0 || magnifiedX >= scaledSize.width()) ? -1 :
+      (2 * magnifiedX + 1) * actualSize.width() / (2 * scaledSize.width());
+    }
+  const int* sourceColumns = this->SourceColumns.constData();
+  const unsigned char* pixels = this->PixelData->GetPointer(0);
+  const QRgb black = qRgb(0, 0, 0);
+  int previousSourceRow = -1;
+  for (int y = 0; y < cropRect.height(); ++y)
+    {
+    QRgb* outputRow = reinterpret_cast<QRgb*>(this->MagnifiedImage.scanLine(y));
+    int magnifiedY = cropRect.top() + y;
+    if (magnifiedY < 0 || magnifiedY >= scaledSize.height())
+      {
+      previousSourceRow = -1;
+      for (int x = 0; x < cropRect.width(); ++x)
+        {
+        outputRow[x] = black;
+        }
+      continue;
+      }
+    int sourceRow = actualSize.height() - 1 -
+      (2 * magnifiedY + 1) * actualSize.height() / (2 * scaledSize.height());
+    // Replicated rows are copied
+    if (sourceRow == previousSourceRow)
+      {
+      memcpy(outputRow, this->MagnifiedImage.scanLine(y - 1),
+             cropRect.width() * sizeof(QRgb));
+      continue;
+      }
+    previousSourceRow = sourceRow;
+    const unsigned char* sourceRowPtr = pixels + 4 * sourceRow * actualSize.width();
+    for (int x = 0; x < cropRect.width(); ++x)
+      {
+      const int sourceColumn = sourceColumns[x];
+      if (sourceColumn < 0)
+        {
+        outputRow[x] = black;
+        continue;
+        }
+      const unsigned char* rgba = sourceRowPtr + 4 * sourceColumn;
+      outputRow[x] = qRgb(rgba[0], rgba[1], rgba[2]);
+      }
+    }
 
   // Finally, set the pixelmap to the new one we have created and update
-  q->setPixmap(QPixmap::fromImage(image));
+  q->setPixmap(QPixmap::fromImage(this->MagnifiedImage));
   q->update();
+  this->WaitingForPaint = true;
   this->resetEventHandler();
 }
 
@@ -631,3 +698,17 @@ bool ctkVTKMagnifyView::eventFilter(QObject * obj, QEvent * event)
     }
   return this->Superclass::eventFilter(obj, event);
 }
+
+// --------------------------------------------------------------------------
+void ctkVTKMagnifyView::paintEvent(QPaintEvent * event)
+{
+  Q_D(ctkVTKMagnifyView);
+  this->Superclass::paintEvent(event);
+  d->WaitingForPaint = false;
+  // Events are not handled by a timer, process the one that was skipped
+  if (d->EventHandler.UpdateInterval == 0 &&
+      d->EventHandler.EventType == ctkVTKMagnifyViewPrivate::UpdatePixmapEvent)
+    {
+    QTimer::singleShot(0, d, SLOT(processPendingEvent()));
+    }
+}
@@ -68,7 +68,8 @@ public:
 
   /// Set/get a fixed interval, in milliseconds, at which this widget will update
   /// itself.  Default 20.  Specify an update interval of 0 to handle all events as
-  /// they occur.
+  /// they occur. In both cases, no update is done until the previous magnified
+  /// image has been painted.
   int updateInterval() const;
   void setUpdateInterval(int newInterval);
 
@@ -108,6 +109,9 @@ protected:
   /// enterEvent, leaveEvent and mouseMoveEvent).
   virtual bool eventFilter(QObject *obj, QEvent *event);
 
+  /// Reimplemented to allow the next update once the magnified image is painted
+  virtual void paintEvent(QPaintEvent * event);
+
 Q_SIGNALS:
   void enteredObservedWidget(QVTKWidget * widget);
   void leftObservedWidget(QVTKWidget * widget);
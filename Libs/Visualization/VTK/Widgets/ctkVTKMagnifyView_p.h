@@ -22,7 +22,9 @@
 #define __ctkVTKMagnifyView_p_h
 
 // Qt includes
+#include <QImage>
 #include <QObject>
+#include <QVector>
 class QPointF;
 class QTimerEvent;
 
@@ -31,7 +33,9 @@ class QTimerEvent;
 #include <ctkVTKObject.h>
 
 // VTK includes
+#include <vtkSmartPointer.h>
 class QVTKWidget;
+class vtkUnsignedCharArray;
 
 /// \ingroup Visualization_VTK_Widgets
 class ctkVTKMagnifyViewPrivate : public QObject
@@ -77,12 +81,22 @@ public Q_SLOTS:
   void pushUpdatePixmapEvent();
   void pushUpdatePixmapEvent(QPointF pos);
   void pushRemovePixmapEvent();
+  void processPendingEvent();
 
 public:
   QList<QVTKWidget *> ObservedQVTKWidgets;
   double Magnification;
   bool ObserveRenderWindowEvents;
   EventHandlerStruct EventHandler;
+
+  /// True when the last magnified image has been set but not painted yet,
+  /// updates are skipped in the meantime.
+  bool WaitingForPaint;
+
+  /// Buffers reused from one update to the next
+  vtkSmartPointer<vtkUnsignedCharArray> PixelData;
+  QVector<int> SourceColumns;
+  QImage MagnifiedImage;
 };
 
 #endif
@@ -0,0 +1,71 @@
+/*=========================================================================
+
+  Library:   CTK
+
+  Copyright (c) Kitware Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=========================================================================*/
+
+// Qt includes
+#include <QApplication>
+#include <QTextEdit>
+#include <QTime>
+#include <QTimer>
+
+// CTK includes
+#include "ctkConsole.h"
+
+// STD includes
+#include <cstdlib>
+#include <iostream>
+
+//-----------------------------------------------------------------------------
+int ctkConsoleTest2(int argc, char * argv [] )
+{
+  QApplication app(argc, argv);
+
+  ctkConsole console;
+
+  console.show();
+
+  // High volume output
+  console.setMaximumBlockCount(1000);
+  QTime time;
+  time.start();
+  for (int i = 0; i < 100000; ++i)
+    {
+    console.printMessage(QString("Line %1\n").arg(i), console.outputTextColor());
+    }
+  QApplication::processEvents();
+  std::cout << "ctkConsole: " << time.elapsed() << " ms to print 100000 lines" << std::endl;
+
+  QTextEdit* textEdit = console.findChild<QTextEdit*>();
+  if (!textEdit || textEdit->document()->blockCount() > 1000)
+    {
+    std::cerr << "ctkConsole::setMaximumBlockCount failed: "
+              << (textEdit ? textEdit->document()->blockCount() : -1) << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  QTimer autoExit;
+  if (argc < 2 || QString(argv[1]) != "-I")
+    {
+    QObject::connect(&autoExit, SIGNAL(timeout()), &app, SLOT(quit()));
+    autoExit.start(100);
+    }
+
+  return app.exec();
+}
+
@@ -0,0 +1,92 @@
+/*=========================================================================
+
+  Library:   CTK
+
+  Copyright (c) Kitware Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=========================================================================*/
+
+// Qt includes
+#include <QApplication>
+#include <QTime>
+#include <QTimer>
+
+// CTK includes
+#include "ctkQImageView.h"
+
+// STD includes
+#include <cstdlib>
+#include <iostream>
+
+//-----------------------------------------------------------------------------
+int ctkQImageViewTest1(int argc, char * argv [] )
+{
+  QApplication app(argc, argv);
+
+  ctkQImageView imageView;
+  imageView.resize(512, 512);
+  imageView.show();
+
+  // 2k x 2k 16 bits slices
+  const int size = 2048;
+  QVector<unsigned short> pixels(size * size);
+  for (int i = 0; i < pixels.size(); ++i)
+    {
+    pixels[i] = static_cast<unsigned short>((i % size) * 16 + (i / size));
+    }
+  imageView.addImage(pixels, size, size);
+  imageView.addImage(pixels, size, size);
+
+  if (imageView.numberOfSlices() != 2 ||
+      imageView.intensityWindow() <= 0)
+    {
+    std::cerr << "ctkQImageView::addImage failed. "
+              << imageView.numberOfSlices() << " "
+              << imageView.intensityWindow() << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  imageView.setPosition(10, 3);
+  if (imageView.positionValue() != 10 * 16 + 3)
+    {
+    std::cerr << "ctkQImageView::positionValue failed. "
+              << imageView.positionValue() << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  imageView.setZoom(4.);
+
+  // Pan, window/level, invert, flip and change slices
+  const int frames = 200;
+  QTime time;
+  time.start();
+  for (int frame = 0; frame < frames; ++frame)
+    {
+    imageView.setCenter(size / 2 + (frame % 50) * 4, size / 2);
+    imageView.setIntensityWindowLevel(20000 + (frame % 10) * 100, 16000);
+    imageView.setInvertImage(frame % 2);
+    imageView.setFlipXAxis((frame / 2) % 2);
+    imageView.setSliceNumber(frame % 2);
+    }
+  std::cout << "ctkQImageView: " << static_cast<double>(time.elapsed()) / (frames * 5)
+            << " ms per update on a " << size << "x" << size << " image" << std::endl;
+
+  if (argc < 2 || QString(argv[1]) != "-I" )
+    {
+    QTimer::singleShot(200, &app, SLOT(quit()));
+    }
+
+  return app.exec();
+}
@@ -0,0 +1,122 @@
+/*=========================================================================
+
+  Library:   CTK
+
+  Copyright (c) Kitware Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=========================================================================*/
+// Qt includes
+#include <QApplication>
+#include <QTime>
+#include <QTimer>
+
+// CTK includes
+#include "ctkQImageView.h"
+#include "ctkQImageViewSliceProvider.h"
+
+// STD includes
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+//-----------------------------------------------------------------------------
+class ctkQImageViewTestSliceProvider : public ctkQImageViewSliceProvider
+{
+public:
+  virtual int numberOfSlices() const
+    {
+    return 200;
+    }
+  virtual QImage loadSlice(int slice)
+    {
+    // 1MB per slice
+    QImage image(512, 512, QImage::Format_RGB32);
+    image.fill(qRgb(slice, slice, slice));
+    return image;
+    }
+};
+
+} // end of anonymous namespace
+
+//-----------------------------------------------------------------------------
+int ctkQImageViewTest2(int argc, char * argv [] )
+{
+  QApplication app(argc, argv);
+
+  ctkQImageViewTestSliceProvider provider;
+
+  ctkQImageView imageView;
+  imageView.setSliceCacheSize(16);
+  imageView.resize(256, 256);
+  imageView.show();
+
+  imageView.setSliceProvider(&provider);
+  if (imageView.sliceProvider() != &provider ||
+      imageView.numberOfSlices() != 200 ||
+      imageView.sliceCacheMemoryUsage() <= 0)
+    {
+    std::cerr << "ctkQImageView::setSliceProvider failed. "
+              << imageView.numberOfSlices() << " "
+              << imageView.sliceCacheMemoryUsage() << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Scroll through the stack forward, then backward
+  QTime time;
+  time.start();
+  for (int slice = 1; slice < 200; ++slice)
+    {
+    imageView.setSliceNumber(slice);
+    }
+  for (int slice = 198; slice >= 0; --slice)
+    {
+    imageView.setSliceNumber(slice);
+    }
+  std::cout << "ctkQImageView: " << static_cast<double>(time.elapsed()) / 398
+            << " ms per slice change" << std::endl;
+
+  if (imageView.sliceCacheMemoryUsage() > 16 * 1024 * 1024)
+    {
+    std::cerr << "ctkQImageView::setSliceCacheSize failed. "
+              << imageView.sliceCacheMemoryUsage() << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  imageView.setSliceNumber(42);
+  imageView.setPosition(10, 10);
+  if (imageView.positionValue() != 42)
+    {
+    std::cerr << "ctkQImageView::positionValue failed. "
+              << imageView.positionValue() << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  imageView.clearImages();
+  if (imageView.sliceProvider() != 0 ||
+      imageView.numberOfSlices() != 0 ||
+      imageView.sliceCacheMemoryUsage() != 0)
+    {
+    std::cerr << "ctkQImageView::clearImages failed." << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  if (argc < 2 || QString(argv[1]) != "-I" )
+    {
+    QTimer::singleShot(200, &app, SLOT(quit()));
+    }
+
+  return app.exec();
+}
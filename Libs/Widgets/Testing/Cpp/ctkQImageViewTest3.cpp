@@ -0,0 +1,114 @@
+/*=========================================================================
+
+  Library:   CTK
+
+  Copyright (c) Kitware Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=========================================================================*/
+// Qt includes
+// Qt includes
+#include <QApplication>
+#include <QImage>
+#include <QTimer>
+#include <QVector>
+
+// CTK includes
+#include "ctkQImageView.h"
+
+// STD includes
+#include <cstdlib>
+#include <iostream>
+
+//-----------------------------------------------------------------------------
+int ctkQImageViewTest3(int argc, char * argv [] )
+{
+  QApplication app(argc, argv);
+
+  ctkQImageView imageView;
+  imageView.resize(256, 256);
+  imageView.show();
+
+  // Slices of different sizes and formats
+  QImage large(512, 512, QImage::Format_RGB32);
+  large.fill(qRgb(128, 128, 128));
+  imageView.addImage(large);
+
+  QImage small(64, 32, QImage::Format_Indexed8);
+  QVector<QRgb> colorTable;
+  for (int i = 0; i < 256; ++i)
+    {
+    colorTable.append(qRgb(i, i, i));
+    }
+  small.setColorTable(colorTable);
+  small.fill(100);
+  imageView.addImage(small);
+
+  QVector<unsigned short> pixels(300 * 20, 1000);
+  imageView.addImage(pixels, 300, 20);
+
+  QImage tall(16, 400, QImage::Format_ARGB32);
+  tall.fill(qRgba(10, 20, 30, 255));
+  imageView.addImage(tall);
+
+  if (imageView.numberOfSlices() != 4)
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with addImage(): "
+              << imageView.numberOfSlices() << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Zoom into a corner of the large slice, then switch to the smaller ones
+  imageView.setSliceNumber(0);
+  imageView.setZoom(2.0);
+  imageView.setCenter(400, 400);
+  imageView.setFlipXAxis(true);
+  imageView.setFlipYAxis(true);
+  for (int slice = 1; slice < 4; ++slice)
+    {
+    imageView.setSliceNumber(slice);
+    imageView.setPosition(5, 5);
+    }
+  imageView.setIntensityWindowLevel(500, 1000);
+  imageView.setInvertImage(true);
+  for (int slice = 2; slice >= 0; --slice)
+    {
+    imageView.setSliceNumber(slice);
+    imageView.setZoom(0.5);
+    }
+  if (imageView.sliceNumber() != 0)
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with setSliceNumber(): "
+              << imageView.sliceNumber() << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Adding a smaller slice keeps the large one displayed
+  imageView.setZoom(1.0);
+  imageView.addImage(small);
+  if (imageView.xCenter() > 512 || imageView.yCenter() > 512)
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with addImage(): "
+              << imageView.xCenter() << " " << imageView.yCenter()
+              << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  if (argc < 2 || QString(argv[1]) != "-I" )
+    {
+    QTimer::singleShot(200, &app, SLOT(quit()));
+    }
+
+  return app.exec();
+}
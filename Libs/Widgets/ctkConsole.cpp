@@ -130,6 +130,15 @@ void ctkConsolePrivate::init()
 
   connect(this->verticalScrollBar(), SIGNAL(valueChanged(int)),
           SLOT(onScrollBarValueChanged(int)));
+
+  // Output printed within an event loop iteration is inserted at once
+  this->PendingOutputLineCount = 0;
+  this->PendingOutputTimer.setSingleShot(true);
+  this->PendingOutputTimer.setInterval(0);
+  connect(&this->PendingOutputTimer, SIGNAL(timeout()), SLOT(flushOutput()));
+
+  this->PromptDisplayed = false;
+  this->MaximumBlockCount = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -496,6 +505,9 @@ void ctkConsolePrivate::internalExecuteCommand()
     this->CommandPosition = this->CommandHistory.size() - 1;
     }
 
+  this->flushOutput();
+  this->PromptDisplayed = false;
+
   QTextCursor c(this->document());
   c.movePosition(QTextCursor::End);
   c.insertText("\n");
@@ -530,6 +542,8 @@ void ctkConsolePrivate::processInput()
     this->commandBuffer() = command; // Update buffer
     }
 
+  this->flushOutput();
+
   QTextCursor c(this->document());
   c.movePosition(QTextCursor::End);
   c.insertText("\n");
@@ -542,9 +556,95 @@ void ctkConsolePrivate::processInput()
 //-----------------------------------------------------------------------------
 void ctkConsolePrivate::printString(const QString& text)
 {
-  this->textCursor().movePosition(QTextCursor::End);
-  this->textCursor().insertText(text);
-  this->InteractivePosition = this->documentEnd();
+  QTextCharFormat format = this->currentCharFormat();
+  if (!this->PendingOutput.isEmpty() && this->PendingOutput.last().first == format)
+    {
+    this->PendingOutput.last().second.append(text);
+    }
+  else
+    {
+    this->PendingOutput.append(qMakePair(format, text));
+    }
+  this->PendingOutputLineCount += text.count('\n');
+
+  // A long running command can print more lines than the console keeps
+  // before the event loop is back
+  if (this->MaximumBlockCount > 0
+      && this->PendingOutputLineCount > 2 * this->MaximumBlockCount)
+    {
+    this->trimPendingOutput(this->MaximumBlockCount);
+    }
+
+  if (!this->PendingOutputTimer.isActive())
+    {
+    this->PendingOutputTimer.start();
+    }
+}
+
+//-----------------------------------------------------------------------------
+void ctkConsolePrivate::trimPendingOutput(int lineCount)
+{
+  int lines = 0;
+  for (int i = this->PendingOutput.size() - 1; i >= 0; --i)
+    {
+    QString& text = this->PendingOutput[i].second;
+    for (int j = text.size() - 1; j >= 0; --j)
+      {
+      if (text.at(j) == '\n' && ++lines > lineCount)
+        {
+        text.remove(0, j + 1);
+        this->PendingOutput.erase(this->PendingOutput.begin(),
+                                  this->PendingOutput.begin() + i);
+        this->PendingOutputLineCount = lineCount;
+        return;
+        }
+      }
+    }
+}
+
+//-----------------------------------------------------------------------------
+void ctkConsolePrivate::flushOutput()
+{
+  this->PendingOutputTimer.stop();
+  if (this->PendingOutput.isEmpty())
+    {
+    return;
+    }
+
+  // Follows the interactive area when text is inserted above it or when the
+  // first blocks are removed by the document
+  QTextCursor interactiveCursor(this->document());
+  interactiveCursor.setPosition(this->InteractivePosition);
+
+  bool abovePrompt = this->PromptDisplayed && this->InputEventLoop.isNull();
+  QTextCursor c(this->document());
+  if (abovePrompt)
+    {
+    c.setPosition(this->InteractivePosition);
+    c.movePosition(QTextCursor::StartOfBlock);
+    }
+  else
+    {
+    c.movePosition(QTextCursor::End);
+    }
+
+  c.beginEditBlock();
+  typedef QPair<QTextCharFormat, QString> OutputType;
+  foreach(const OutputType& output, this->PendingOutput)
+    {
+    c.insertText(output.second, output.first);
+    }
+  if (abovePrompt && !this->PendingOutput.last().second.endsWith('\n'))
+    {
+    // Keep the prompt on its own line
+    c.insertText("\n");
+    }
+  c.endEditBlock();
+
+  this->PendingOutput.clear();
+  this->PendingOutputLineCount = 0;
+
+  this->InteractivePosition = abovePrompt ? interactiveCursor.position() : c.position();
   this->ensureCursorVisible();
   this->scrollToBottom();
 }
@@ -595,6 +695,8 @@ void ctkConsolePrivate::promptForInput(const QString& indent)
 //-----------------------------------------------------------------------------
 void ctkConsolePrivate::prompt(const QString& text)
 {
+  this->flushOutput();
+
   QTextCursor text_cursor = this->textCursor();
 
   // If the cursor is currently on a clean line, do nothing, otherwise we move
@@ -610,6 +712,7 @@ void ctkConsolePrivate::prompt(const QString& text)
 
   this->textCursor().insertText(text);
   this->InteractivePosition = this->documentEnd();
+  this->PromptDisplayed = true;
   this->ensureCursorVisible();
   this->scrollToBottom();
 }
@@ -763,6 +866,21 @@ Qt::ScrollBarPolicy ctkConsole::scrollBarPolicy()const
   return d->verticalScrollBarPolicy();
 }
 
+//-----------------------------------------------------------------------------
+int ctkConsole::maximumBlockCount()const
+{
+  Q_D(const ctkConsole);
+  return d->MaximumBlockCount;
+}
+
+//-----------------------------------------------------------------------------
+void ctkConsole::setMaximumBlockCount(int count)
+{
+  Q_D(ctkConsole);
+  d->MaximumBlockCount = qMax(0, count);
+  d->document()->setMaximumBlockCount(d->MaximumBlockCount);
+}
+
 //-----------------------------------------------------------------------------
 void ctkConsole::setScrollBarPolicy(const Qt::ScrollBarPolicy& newScrollBarPolicy)
 {
@@ -793,7 +911,11 @@ void ctkConsole::clear()
 {
   Q_D(ctkConsole);
 
+  d->PendingOutput.clear();
+  d->PendingOutputLineCount = 0;
+  d->PromptDisplayed = false;
   d->clear();
+  d->document()->setMaximumBlockCount(d->MaximumBlockCount);
 
   // For some reason the QCompleter tries to set the focus policy to
   // NoFocus, set let's make sure we set it back to the default WheelFocus.
@@ -807,7 +929,11 @@ void ctkConsole::reset()
 {
   Q_D(ctkConsole);
 
+  d->PendingOutput.clear();
+  d->PendingOutputLineCount = 0;
+  d->PromptDisplayed = false;
   d->clear();
+  d->document()->setMaximumBlockCount(d->MaximumBlockCount);
 
   // For some reason the QCompleter tries to set the focus policy to
   // NoFocus, set let's make sure we set it back to the default WheelFocus.
@@ -852,6 +978,8 @@ QString ctkConsole::readInputLine()
 {
   Q_D(ctkConsole);
 
+  // Show the output printed before reading the input
+  d->flushOutput();
   d->moveCursor(QTextCursor::End);
 
   QScopedPointer<InputEventLoop> eventLoop(new InputEventLoop(qApp));
@@ -80,6 +80,7 @@ class CTK_WIDGETS_EXPORT ctkConsole : public QWidget
   Q_PROPERTY(EditorHints editorHints READ editorHints WRITE setEditorHints)
   Q_ENUMS(Qt::ScrollBarPolicy)
   Q_PROPERTY(Qt::ScrollBarPolicy scrollBarPolicy READ scrollBarPolicy WRITE setScrollBarPolicy)
+  Q_PROPERTY(int maximumBlockCount READ maximumBlockCount WRITE setMaximumBlockCount)
   
 public:
 
@@ -152,7 +153,16 @@ public:
   /// \sa scrollBarPolicy()
   void setScrollBarPolicy(const Qt::ScrollBarPolicy& newScrollBarPolicy);
 
-  /// Prints text on the console
+  /// Maximum number of blocks (lines) kept by the console. When it is
+  /// exceeded, the first blocks are removed. 0, the default, for no limit.
+  int maximumBlockCount()const;
+
+  /// \sa maximumBlockCount()
+  void setMaximumBlockCount(int count);
+
+  /// Prints text on the console.
+  /// The messages printed within an event loop iteration are written at
+  /// once. If the prompt is displayed, they are written above it.
   void printMessage(const QString& message, const QColor& color);
 
   /// Returns the string used as primary prompt
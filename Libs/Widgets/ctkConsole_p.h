@@ -25,6 +25,8 @@
 #include <QTextEdit>
 #include <QPointer>
 #include <QEventLoop>
+#include <QPair>
+#include <QTimer>
 
 // CTK includes
 #include "ctkConsole.h"
@@ -82,9 +84,14 @@ public:
 
   void processInput();
 
-  /// Writes the supplied text to the console
+  /// Queue the supplied text, it is written to the console with the
+  /// current format at the next event loop iteration.
+  /// \sa flushOutput()
   void printString(const QString& text);
 
+  /// Only keep the last \a lineCount lines of the queued output
+  void trimPendingOutput(int lineCount);
+
   /// Updates the current command.
   /// Unlike printMessage(), this will affect the current command being typed.
   void printCommand(const QString& cmd);
@@ -121,6 +128,10 @@ public Q_SLOTS:
   /// Update the value of ScrollbarAtBottom given the current position of the scollbar
   void onScrollBarValueChanged(int value);
 
+  /// Write the queued output to the console in a single edit. If the prompt
+  /// is displayed, the output is inserted above the prompt line.
+  void flushOutput();
+
 public:
 
   /// A custom completer
@@ -168,6 +179,17 @@ public:
   bool ScrollbarAtBottom;
 
   QPointer<QEventLoop> InputEventLoop;
+
+  /// Text printed since the last flushOutput(), with its format
+  QList<QPair<QTextCharFormat, QString> > PendingOutput;
+  int PendingOutputLineCount;
+  QTimer PendingOutputTimer;
+
+  /// True while the prompt waits for a command
+  bool PromptDisplayed;
+
+  /// Maximum number of blocks of the document, 0 for no limit
+  int MaximumBlockCount;
 };
 
 
@@ -22,6 +22,7 @@
 
 // CTK includes
 #include "ctkQImageView.h"
+#include "ctkQImageViewSliceProvider.h"
 
 // Qt includes
 #include <QApplication>
@@ -32,9 +33,16 @@
 #include <QMouseEvent>
 #include <QKeyEvent>
 #include <QPainter>
+#include <QCache>
 #include <QColor>
 #include <QTextEdit>
 #include <QDialog>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QRunnable>
+#include <QSet>
+#include <QThreadPool>
 
 #include <cmath>
 
@@ -51,6 +59,7 @@ protected:
 public:
 
   ctkQImageViewPrivate( ctkQImageView& object );
+  ~ctkQImageViewPrivate();
 
   void init();
 
@@ -74,6 +83,41 @@ public:
 
   QList< QImage > ImageList;
 
+  /// 16 bits pixels of the slices added as 16 bits grayscale images, empty
+  /// for the slices added as QImage. The QImage of such a slice only wraps
+  /// the pixels to give the slice geometry.
+  QList< QVector<unsigned short> > ImageData16List;
+
+  /// Whether each slice is grayscale, QImage::isGrayscale() can scan the
+  /// whole image
+  QList< bool > GrayscaleList;
+
+  /// Grayscale value to displayed color, for the current window/level and
+  /// invert setting
+  QVector< QRgb > LookupTable;
+  double LookupTableWindow;
+  double LookupTableLevel;
+  bool   LookupTableInvert;
+
+  /// Windowed, inverted and flipped visible regions
+  QCache< QString, QPixmap > PixmapCache;
+
+  /// Slices of the provider are null images until they are loaded
+  ctkQImageViewSliceProvider* SliceProvider;
+  /// Slices loaded from the provider, most recently displayed first
+  QList< int > LoadedSlices;
+  qint64 SliceCacheMemoryUsage;
+  /// In bytes
+  qint64 SliceCacheSize;
+  int    PrefetchCount;
+
+  /// Decodes the next slices in the scrolling direction
+  QThreadPool PrefetchThreadPool;
+  /// Protects PrefetchedSlices and PendingSlices
+  QMutex  PrefetchMutex;
+  QHash< int, QImage > PrefetchedSlices;
+  QSet< int > PendingSlices;
+
   QPixmap TmpImage;
   int     TmpXMin;
   int     TmpXMax;
@@ -93,16 +137,71 @@ public:
 
   double clamp( double x, double xMin, double xMax );
 
+  bool isGrayscale( int slice ) const;
+
+  void updateLookupTable( int size );
+
+  /// Visible region of the current slice, windowed, inverted and flipped.
+  QPixmap visiblePixmap();
+
   void fitImageRectangle( double x0, double y0, double x1, double y1 );
+
+  /// Load \a slice from the provider if it is not in memory and mark it as
+  /// the most recently used slice.
+  void loadSlice( int slice );
+  /// Unload the least recently used slices until the cache fits in
+  /// SliceCacheSize. The most recently used slice is always kept.
+  void evictSlices();
+  /// Decode in the background the slices following \a slice in
+  /// \a direction.
+  void prefetchSlices( int slice, int direction );
+  /// Wait for the pending prefetches and forget the provider and its slices.
+  void removeSliceProvider();
   
 };
 
+//--------------------------------------------------------------------------
+class ctkQImageViewPrefetchRunnable : public QRunnable
+{
+public:
+  ctkQImageViewPrefetchRunnable( ctkQImageViewPrivate* d,
+    ctkQImageViewSliceProvider* provider, int slice )
+    : D( d ), Provider( provider ), Slice( slice )
+    {
+    }
+
+  virtual void run()
+    {
+    QImage image = this->Provider->loadSlice( this->Slice );
+    QMutexLocker locker( &this->D->PrefetchMutex );
+    this->D->PendingSlices.remove( this->Slice );
+    this->D->PrefetchedSlices.insert( this->Slice, image );
+    }
+
+protected:
+  ctkQImageViewPrivate* D;
+  ctkQImageViewSliceProvider* Provider;
+  int Slice;
+};
+
 //--------------------------------------------------------------------------
 ctkQImageViewPrivate::ctkQImageViewPrivate(
   ctkQImageView& object )
   : q_ptr( &object )
 {
   this->Window = new QLabel();
+  this->SliceProvider = 0;
+  this->SliceCacheMemoryUsage = 0;
+  this->SliceCacheSize = 256 * 1024 * 1024;
+  this->PrefetchCount = 4;
+  this->PrefetchThreadPool.setMaxThreadCount( 1 );
+}
+
+//--------------------------------------------------------------------------
+ctkQImageViewPrivate::~ctkQImageViewPrivate()
+{
+  // The prefetch threads use the provider and the private members
+  this->PrefetchThreadPool.waitForDone();
 }
 
 //--------------------------------------------------------------------------
@@ -138,6 +237,14 @@ void ctkQImageViewPrivate::init()
   this->TransposeXY = false;
 
   this->ImageList.clear();
+  this->ImageData16List.clear();
+  this->GrayscaleList.clear();
+
+  this->LookupTableWindow = 0;
+  this->LookupTableLevel = 0;
+  this->LookupTableInvert = false;
+  // In kilobytes
+  this->PixmapCache.setMaxCost( 64 * 1024 );
 
   this->TmpXMin = 0;
   this->TmpXMax = 0;
@@ -170,6 +277,170 @@ double ctkQImageViewPrivate::clamp( double x, double xMin,
   return x;
 }
 
+//--------------------------------------------------------------------------
+bool ctkQImageViewPrivate::isGrayscale( int slice ) const
+{
+  return slice >= 0 && slice < this->GrayscaleList.size()
+    && this->GrayscaleList[ slice ];
+}
+
+//--------------------------------------------------------------------------
+void ctkQImageViewPrivate::updateLookupTable( int size )
+{
+  if( this->LookupTable.size() == size
+    && this->LookupTableWindow == this->IntensityWindow
+    && this->LookupTableLevel == this->IntensityLevel
+    && this->LookupTableInvert == this->InvertImage )
+    {
+    return;
+    }
+  this->LookupTable.resize( size );
+  this->LookupTableWindow = this->IntensityWindow;
+  this->LookupTableLevel = this->IntensityLevel;
+  this->LookupTableInvert = this->InvertImage;
+
+  double lower = this->IntensityLevel - this->IntensityWindow / 2.0;
+  QRgb* lut = this->LookupTable.data();
+  for( int value = 0; value < size; ++value )
+    {
+    int gray = 0;
+    if( this->IntensityWindow > 0 )
+      {
+      gray = static_cast<int>( this->clamp(
+        ( value - lower ) / this->IntensityWindow * 255.0, 0, 255 ) );
+      }
+    else
+      {
+      gray = value < this->IntensityLevel ? 0 : 255;
+      }
+    if( this->InvertImage )
+      {
+      gray = 255 - gray;
+      }
+    lut[ value ] = qRgb( gray, gray, gray );
+    }
+}
+
+//--------------------------------------------------------------------------
+QPixmap ctkQImageViewPrivate::visiblePixmap()
+{
+  const QImage & image = this->ImageList[ this->SliceNumber ];
+  // The pixels are read directly, never outside of the slice
+  const QRect region = QRect( this->TmpXMin, this->TmpYMin,
+    this->TmpXMax - this->TmpXMin, this->TmpYMax - this->TmpYMin )
+    .intersected( image.rect() );
+  if( region.isEmpty() )
+    {
+    return QPixmap();
+    }
+
+  QString key = QString( "%1:%2,%3,%4,%5:%6" )
+    .arg( image.cacheKey() )
+    .arg( region.x() ).arg( region.y() )
+    .arg( region.width() ).arg( region.height() )
+    .arg( this->InvertImage | ( this->FlipXAxis << 1 ) | ( this->FlipYAxis << 2 ) );
+  const bool grayscale = this->isGrayscale( this->SliceNumber );
+  if( grayscale )
+    {
+    key.append( QString( ":%1/%2" )
+      .arg( this->IntensityWindow, 0, 'g', 12 )
+      .arg( this->IntensityLevel, 0, 'g', 12 ) );
+    }
+  QPixmap* cachedPixmap = this->PixmapCache.object( key );
+  if( cachedPixmap )
+    {
+    return *cachedPixmap;
+    }
+
+  const QVector<unsigned short> & data16 =
+    this->ImageData16List[ this->SliceNumber ];
+  QVector< QRgb > indexLookupTable;
+  if( !data16.isEmpty() )
+    {
+    this->updateLookupTable( 65536 );
+    }
+  else if( grayscale )
+    {
+    this->updateLookupTable( 256 );
+    if( image.format() == QImage::Format_Indexed8 )
+      {
+      indexLookupTable.resize( 256 );
+      for( int index = 0; index < image.colorCount(); ++index )
+        {
+        indexLookupTable[ index ] = this->LookupTable[ qGray( image.color( index ) ) ];
+        }
+      }
+    }
+
+  // Only the visible region is converted
+  QImage converted( region.size(), QImage::Format_RGB32 );
+  const int width = region.width();
+  for( int y = 0; y < region.height(); ++y )
+    {
+    const int sourceY = this->FlipYAxis ? region.bottom() - y : region.top() + y;
+    QRgb* outPtr = reinterpret_cast< QRgb* >( converted.scanLine( y ) );
+    const int step = this->FlipXAxis ? -1 : 1;
+    const int sourceX = this->FlipXAxis ? region.right() : region.left();
+    if( !data16.isEmpty() )
+      {
+      const QRgb* lut = this->LookupTable.constData();
+      const unsigned short* inPtr =
+        data16.constData() + sourceY * image.width() + sourceX;
+      for( int x = 0; x < width; ++x, inPtr += step )
+        {
+        outPtr[ x ] = lut[ *inPtr ];
+        }
+      }
+    else if( !indexLookupTable.isEmpty() )
+      {
+      const QRgb* lut = indexLookupTable.constData();
+      const uchar* inPtr = image.scanLine( sourceY ) + sourceX;
+      for( int x = 0; x < width; ++x, inPtr += step )
+        {
+        outPtr[ x ] = lut[ *inPtr ];
+        }
+      }
+    else if( image.format() == QImage::Format_RGB32
+      || image.format() == QImage::Format_ARGB32 )
+      {
+      const QRgb* lut = this->LookupTable.constData();
+      const QRgb* inPtr =
+        reinterpret_cast< const QRgb* >( image.scanLine( sourceY ) ) + sourceX;
+      for( int x = 0; x < width; ++x, inPtr += step )
+        {
+        if( grayscale )
+          {
+          outPtr[ x ] = lut[ qGray( *inPtr ) ];
+          }
+        else
+          {
+          outPtr[ x ] = this->InvertImage ? ( ~*inPtr | 0xff000000 ) : *inPtr;
+          }
+        }
+      }
+    else
+      {
+      for( int x = 0; x < width; ++x )
+        {
+        QRgb pixel = image.pixel( sourceX + x * step, sourceY );
+        if( grayscale )
+          {
+          outPtr[ x ] = this->LookupTable[ qGray( pixel ) ];
+          }
+        else
+          {
+          outPtr[ x ] = this->InvertImage ? ( ~pixel | 0xff000000 ) : pixel;
+          }
+        }
+      }
+    }
+
+  QPixmap pixmap = QPixmap::fromImage( converted );
+  this->PixmapCache.insert( key, new QPixmap( pixmap ),
+    qMax( 1, region.width() * region.height() * 4 / 1024 ) );
+  return pixmap;
+}
+
 //--------------------------------------------------------------------------
 void ctkQImageViewPrivate::fitImageRectangle( double x0,
   double x1, double y0, double y1 )
@@ -187,6 +458,115 @@ void ctkQImageViewPrivate::fitImageRectangle( double x0,
     }
 }
 
+//--------------------------------------------------------------------------
+void ctkQImageViewPrivate::loadSlice( int slice )
+{
+  Q_Q( ctkQImageView );
+  if( !this->SliceProvider || slice < 0 || slice >= this->ImageList.size() )
+    {
+    return;
+    }
+  if( !this->ImageList[ slice ].isNull() )
+    {
+    this->LoadedSlices.removeOne( slice );
+    this->LoadedSlices.prepend( slice );
+    return;
+    }
+
+  QImage image;
+    {
+    QMutexLocker locker( &this->PrefetchMutex );
+    image = this->PrefetchedSlices.take( slice );
+    }
+  if( image.isNull() )
+    {
+    image = this->SliceProvider->loadSlice( slice );
+    }
+  if( image.isNull() )
+    {
+    return;
+    }
+  this->ImageList[ slice ] = image;
+  this->GrayscaleList[ slice ] = image.isGrayscale();
+  this->LoadedSlices.prepend( slice );
+  this->SliceCacheMemoryUsage += image.byteCount();
+  this->evictSlices();
+  emit q->sliceCacheMemoryUsageChanged( this->SliceCacheMemoryUsage );
+}
+
+//--------------------------------------------------------------------------
+void ctkQImageViewPrivate::evictSlices()
+{
+  while( this->SliceCacheMemoryUsage > this->SliceCacheSize
+    && this->LoadedSlices.size() > 1 )
+    {
+    int slice = this->LoadedSlices.takeLast();
+    this->SliceCacheMemoryUsage -= this->ImageList[ slice ].byteCount();
+    this->ImageList[ slice ] = QImage();
+    }
+}
+
+//--------------------------------------------------------------------------
+void ctkQImageViewPrivate::prefetchSlices( int slice, int direction )
+{
+  if( !this->SliceProvider || this->PrefetchCount <= 0 )
+    {
+    return;
+    }
+  QMutexLocker locker( &this->PrefetchMutex );
+  // Drop the prefetched slices that are out of reach, e.g. after a change
+  // of direction
+  QHash< int, QImage >::iterator it = this->PrefetchedSlices.begin();
+  while( it != this->PrefetchedSlices.end() )
+    {
+    if( qAbs( it.key() - slice ) > this->PrefetchCount )
+      {
+      it = this->PrefetchedSlices.erase( it );
+      }
+    else
+      {
+      ++it;
+      }
+    }
+  for( int i = 1; i <= this->PrefetchCount; ++i )
+    {
+    int next = slice + i * direction;
+    if( next < 0 || next >= this->ImageList.size() )
+      {
+      break;
+      }
+    if( !this->ImageList[ next ].isNull()
+      || this->PrefetchedSlices.contains( next )
+      || this->PendingSlices.contains( next ) )
+      {
+      continue;
+      }
+    this->PendingSlices.insert( next );
+    this->PrefetchThreadPool.start( new ctkQImageViewPrefetchRunnable(
+      this, this->SliceProvider, next ) );
+    }
+}
+
+//--------------------------------------------------------------------------
+void ctkQImageViewPrivate::removeSliceProvider()
+{
+  Q_Q( ctkQImageView );
+  if( !this->SliceProvider )
+    {
+    return;
+    }
+  this->PrefetchThreadPool.waitForDone();
+  this->PrefetchedSlices.clear();
+  this->PendingSlices.clear();
+  this->LoadedSlices.clear();
+  this->SliceProvider = 0;
+  this->ImageList.clear();
+  this->ImageData16List.clear();
+  this->GrayscaleList.clear();
+  this->PixmapCache.clear();
+  this->SliceCacheMemoryUsage = 0;
+  emit q->sliceCacheMemoryUsageChanged( 0 );
+}
 
 // -------------------------------------------------------------------------
 ctkQImageView::ctkQImageView( QWidget* _parent )
@@ -218,27 +598,74 @@ ctkQImageView::~ctkQImageView()
 void ctkQImageView::addImage( const QImage & image )
 {
   Q_D( ctkQImageView );
+  d->removeSliceProvider();
   d->ImageList.push_back( image );
-  d->TmpXMin = 0;
-  d->TmpXMax = image.width();
-  d->TmpYMin = 0;
-  d->TmpYMax = image.height();
-  if( image.isGrayscale() )
+  d->ImageData16List.push_back( QVector<unsigned short>() );
+  d->GrayscaleList.push_back( image.isGrayscale() );
+  // The current slice is still displayed, it may have another size
+  const int sliceWidth = d->ImageList[ d->SliceNumber ].width();
+  const int sliceHeight = d->ImageList[ d->SliceNumber ].height();
+  d->fitImageRectangle( 0, sliceWidth, 0, sliceHeight );
+  if( d->GrayscaleList.back() )
     {
+    // 32 bits grayscale images have no color table
+    int levels = image.colorCount() > 0 ? image.colorCount() : 256;
     d->IntensityMin = 0;
-    d->IntensityMax = image.colorCount();
-    this->setIntensityWindowLevel(
-      image.colorCount(), image.colorCount()/2 );
+    d->IntensityMax = levels;
+    this->setIntensityWindowLevel( levels, levels/2 );
     }
   this->update( true, false );
-  this->setCenter( image.width()/2.0, image.height()/2.0 );
+  this->setCenter( sliceWidth/2.0, sliceHeight/2.0 );
+}
+
+// -------------------------------------------------------------------------
+void ctkQImageView::addImage( const QVector<unsigned short> & pixels,
+  int width, int height )
+{
+  Q_D( ctkQImageView );
+  if( width <= 0 || height <= 0 || pixels.size() < width * height )
+    {
+    return;
+    }
+  d->removeSliceProvider();
+  d->ImageData16List.push_back( pixels );
+  // The image shares the pixels, it is never painted
+  const QVector<unsigned short> & data16 = d->ImageData16List.back();
+  d->ImageList.push_back( QImage(
+    reinterpret_cast< const uchar* >( data16.constData() ),
+    width, height, width * sizeof( unsigned short ), QImage::Format_RGB16 ) );
+  d->GrayscaleList.push_back( true );
+  // The current slice is still displayed, it may have another size
+  const int sliceWidth = d->ImageList[ d->SliceNumber ].width();
+  const int sliceHeight = d->ImageList[ d->SliceNumber ].height();
+  d->fitImageRectangle( 0, sliceWidth, 0, sliceHeight );
+
+  unsigned short minValue = 65535;
+  unsigned short maxValue = 0;
+  const unsigned short* ptr = data16.constData();
+  const unsigned short* endPtr = ptr + width * height;
+  for( ; ptr != endPtr; ++ptr )
+    {
+    minValue = qMin( minValue, *ptr );
+    maxValue = qMax( maxValue, *ptr );
+    }
+  d->IntensityMin = minValue;
+  d->IntensityMax = maxValue;
+  this->setIntensityWindowLevel( maxValue - minValue + 1,
+    ( maxValue + minValue + 1 ) / 2.0 );
+  this->update( true, false );
+  this->setCenter( sliceWidth/2.0, sliceHeight/2.0 );
 }
 
 // -------------------------------------------------------------------------
 void ctkQImageView::clearImages( void )
 {
   Q_D( ctkQImageView );
+  d->removeSliceProvider();
   d->ImageList.clear();
+  d->ImageData16List.clear();
+  d->GrayscaleList.clear();
+  d->PixmapCache.clear();
   this->update( true, true );
 }
 
@@ -309,6 +736,14 @@ double ctkQImageView::positionValue( void )
   Q_D( ctkQImageView );
   if( d->SliceNumber >= 0 && d->SliceNumber < d->ImageList.size() )
     {
+    const QVector<unsigned short> & data16 =
+      d->ImageData16List[ d->SliceNumber ];
+    if( !data16.isEmpty() )
+      {
+      return data16[ static_cast<int>( d->PositionY )
+        * d->ImageList[ d->SliceNumber ].width()
+        + static_cast<int>( d->PositionX ) ];
+      }
     QColor vc( d->ImageList[ d->SliceNumber ].pixel( d->PositionX,
       d->PositionY ) );
     return vc.value();
@@ -337,16 +772,134 @@ void ctkQImageView::setSliceNumber( int slicenum )
   if( slicenum >= 0 && slicenum < d->ImageList.size() 
     && slicenum != d->SliceNumber )
     {
+    int direction = slicenum > d->SliceNumber ? 1 : -1;
     d->SliceNumber = slicenum;
+    d->loadSlice( slicenum );
+    // Keep the displayed extents within the new slice
+    const int xMin = d->TmpXMin;
+    const int xMax = d->TmpXMax;
+    const int yMin = d->TmpYMin;
+    const int yMax = d->TmpYMax;
+    d->fitImageRectangle( xMin, xMax, yMin, yMax );
+    if( d->TmpXMax <= d->TmpXMin || d->TmpYMax <= d->TmpYMin )
+      {
+      d->fitImageRectangle( 0, d->ImageList[ slicenum ].width(),
+        0, d->ImageList[ slicenum ].height() );
+      }
+    const bool extentsChanged = d->TmpXMin != xMin || d->TmpXMax != xMax
+      || d->TmpYMin != yMin || d->TmpYMax != yMax;
     emit this->sliceNumberChanged( slicenum );
     emit this->xSpacingChanged( this->xSpacing() );
     emit this->ySpacingChanged( this->ySpacing() );
     emit this->sliceThicknessChanged( this->sliceThickness() );
     emit this->slicePositionChanged( this->slicePosition() );
-    this->update( false, false );
+    this->update( extentsChanged, false );
+    d->prefetchSlices( slicenum, direction );
     }
 }
 //
+// -------------------------------------------------------------------------
+int ctkQImageView::numberOfSlices( void ) const
+{
+  Q_D( const ctkQImageView );
+  return d->ImageList.size();
+}
+
+// -------------------------------------------------------------------------
+void ctkQImageView::setSliceProvider( ctkQImageViewSliceProvider * provider )
+{
+  Q_D( ctkQImageView );
+  if( provider == d->SliceProvider )
+    {
+    return;
+    }
+  d->removeSliceProvider();
+  d->ImageList.clear();
+  d->ImageData16List.clear();
+  d->GrayscaleList.clear();
+  d->PixmapCache.clear();
+  d->SliceNumber = 0;
+  d->SliceProvider = provider;
+  const int slices = provider ? provider->numberOfSlices() : 0;
+  for( int slice = 0; slice < slices; ++slice )
+    {
+    d->ImageList.push_back( QImage() );
+    d->ImageData16List.push_back( QVector<unsigned short>() );
+    d->GrayscaleList.push_back( false );
+    }
+  emit this->numberOfSlicesChanged( slices );
+  if( slices == 0 )
+    {
+    this->update( true, true );
+    return;
+    }
+
+  d->loadSlice( 0 );
+  const QImage & image = d->ImageList[ 0 ];
+  d->TmpXMin = 0;
+  d->TmpXMax = image.width();
+  d->TmpYMin = 0;
+  d->TmpYMax = image.height();
+  if( d->GrayscaleList[ 0 ] )
+    {
+    int levels = image.colorCount() > 0 ? image.colorCount() : 256;
+    d->IntensityMin = 0;
+    d->IntensityMax = levels;
+    this->setIntensityWindowLevel( levels, levels/2 );
+    }
+  this->update( true, false );
+  this->setCenter( image.width()/2.0, image.height()/2.0 );
+  d->prefetchSlices( 0, 1 );
+}
+
+// -------------------------------------------------------------------------
+ctkQImageViewSliceProvider * ctkQImageView::sliceProvider( void ) const
+{
+  Q_D( const ctkQImageView );
+  return d->SliceProvider;
+}
+
+// -------------------------------------------------------------------------
+void ctkQImageView::setSliceCacheSize( int megabytes )
+{
+  Q_D( ctkQImageView );
+  d->SliceCacheSize = qMax( 0, megabytes ) * qint64( 1024 * 1024 );
+  qint64 memoryUsage = d->SliceCacheMemoryUsage;
+  d->evictSlices();
+  if( d->SliceCacheMemoryUsage != memoryUsage )
+    {
+    emit this->sliceCacheMemoryUsageChanged( d->SliceCacheMemoryUsage );
+    }
+}
+
+// -------------------------------------------------------------------------
+int ctkQImageView::sliceCacheSize( void ) const
+{
+  Q_D( const ctkQImageView );
+  return static_cast<int>( d->SliceCacheSize / ( 1024 * 1024 ) );
+}
+
+// -------------------------------------------------------------------------
+void ctkQImageView::setPrefetchCount( int count )
+{
+  Q_D( ctkQImageView );
+  d->PrefetchCount = qMax( 0, count );
+}
+
+// -------------------------------------------------------------------------
+int ctkQImageView::prefetchCount( void ) const
+{
+  Q_D( const ctkQImageView );
+  return d->PrefetchCount;
+}
+
+// -------------------------------------------------------------------------
+qint64 ctkQImageView::sliceCacheMemoryUsage( void ) const
+{
+  Q_D( const ctkQImageView );
+  return d->SliceCacheMemoryUsage;
+}
+
 // -------------------------------------------------------------------------
 int ctkQImageView::sliceNumber( void ) const
 {
@@ -997,31 +1550,19 @@ void ctkQImageView::update( bool zoomChanged,
 
     if( d->TmpImage.width() > 0 &&  d->TmpImage.height() > 0)
       {
-      QRectF target( 0, 0, d->TmpImage.width(), d->TmpImage.height() );
-      double sourceX = d->TmpXMin;
-      double sourceY = d->TmpYMin;
       double sourceW = d->TmpXMax - d->TmpXMin;
       double sourceH = d->TmpYMax - d->TmpYMin;
       QPainter painter( &(d->TmpImage) );
-      QImage tmpI = *img;
-      if( d->InvertImage )
-        {
-        tmpI.invertPixels();
-        }
-      if( d->FlipXAxis || d->FlipYAxis )
+      // Only the visible region is windowed, inverted and flipped. It is
+      // clipped to the slice, the target is scaled accordingly.
+      QPixmap visible = d->visiblePixmap();
+      if( !visible.isNull() && sourceW > 0 && sourceH > 0 )
         {
-        tmpI = tmpI.mirrored( d->FlipXAxis, d->FlipYAxis );
-        if( d->FlipXAxis )
-          {
-          sourceX = tmpI.width() - (d->TmpXMax - d->TmpXMin) - d->TmpXMin;
-          }
-        if( d->FlipYAxis )
-          {
-          sourceY = tmpI.height() - (d->TmpYMax - d->TmpYMin) - d->TmpYMin;
-          }
+        QRectF target( 0, 0,
+          d->TmpImage.width() * visible.width() / sourceW,
+          d->TmpImage.height() * visible.height() / sourceH );
+        painter.drawPixmap( target, visible, QRectF( visible.rect() ) );
         }
-      QRectF source( sourceX, sourceY, sourceW, sourceH );
-      painter.drawPixmap( target, QPixmap::fromImage( tmpI ), source );
 
       //if( ! sizeChanged )
         {
@@ -1047,7 +1588,7 @@ void ctkQImageView::update( bool zoomChanged,
           QRectF spaceBound = painter.boundingRect( pointRect, textFlags,
             "X" );
     
-          if( img->isGrayscale() )
+          if( d->isGrayscale( d->SliceNumber ) )
             {
             QString intString = "Intensity Range = ";
             intString.append( QString::number( d->IntensityMin,
@@ -24,12 +24,14 @@
 /// Qt includes
 #include <QWidget>
 #include <QImage>
+#include <QVector>
 
 /// CTK includes
 #include "ctkPimpl.h"
 #include "ctkWidgetsExport.h"
 
 class ctkQImageViewPrivate;
+class ctkQImageViewSliceProvider;
 
 /// \ingroup Widgets
 ///
@@ -77,9 +79,35 @@ public:
 
   double zoom( void );
 
+  /// Display the slices of \a provider, decoded on demand. The view does
+  /// not take ownership of the provider. Only the recently displayed slices
+  /// are kept in memory, within sliceCacheSize(), and the next
+  /// prefetchCount() slices in the scrolling direction are decoded in the
+  /// background. addImage() and clearImages() remove the provider.
+  void setSliceProvider( ctkQImageViewSliceProvider * provider );
+  ctkQImageViewSliceProvider * sliceProvider( void ) const;
+
+  /// Maximum memory, in megabytes, of the slices loaded from the provider.
+  /// The displayed slice is always kept. 256 by default.
+  void setSliceCacheSize( int megabytes );
+  int sliceCacheSize( void ) const;
+
+  /// Number of slices prefetched in the scrolling direction, 4 by default.
+  void setPrefetchCount( int count );
+  int prefetchCount( void ) const;
+
+  /// Memory, in bytes, of the slices loaded from the provider
+  qint64 sliceCacheMemoryUsage( void ) const;
+
 public Q_SLOTS:
 
   void addImage( const QImage & image );
+
+  /// Add a 16 bits grayscale slice of \a width x \a height pixels, stored
+  /// row by row. The pixels are kept at full depth and mapped to the
+  /// display through the intensity window/level.
+  void addImage( const QVector<unsigned short> & pixels, int width, int height );
+
   void clearImages( void );
 
   void setSliceNumber( int slicenum );
@@ -135,6 +163,8 @@ Q_SIGNALS:
   void intensityWindowChanged( double intensityWindow );
   void intensityLevelChanged( double intensityLevel );
 
+  void sliceCacheMemoryUsageChanged( qint64 bytes );
+
 protected:
 
   virtual void resizeEvent( QResizeEvent* event );
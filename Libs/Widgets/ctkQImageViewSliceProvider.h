@@ -0,0 +1,49 @@
+/*=========================================================================
+
+  Library:   CTK
+
+  Copyright (c) Kitware Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=========================================================================*/
+
+#ifndef __ctkQImageViewSliceProvider_h
+#define __ctkQImageViewSliceProvider_h
+
+/// Qt includes
+#include <QImage>
+
+/// CTK includes
+#include "ctkWidgetsExport.h"
+
+/// \ingroup Widgets
+///
+/// ctkQImageViewSliceProvider loads the slices displayed by a ctkQImageView
+/// on demand, so that only the recently viewed slices are kept in memory.
+/// \sa ctkQImageView::setSliceProvider()
+class CTK_WIDGETS_EXPORT ctkQImageViewSliceProvider
+{
+public:
+  virtual ~ctkQImageViewSliceProvider() {}
+
+  /// Number of slices of the stack
+  virtual int numberOfSlices() const = 0;
+
+  /// Decode the slice \a slice.
+  /// \note Slices are prefetched in a background thread, this function
+  /// must be thread-safe.
+  virtual QImage loadSlice( int slice ) = 0;
+};
+
+#endif
@@ -0,0 +1,153 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+
+#include "ctkCMPidTaskQueue_p.h"
+
+#include <service/log/ctkLogService.h>
+
+#include <QRunnable>
+#include <QThreadPool>
+
+const int ctkCMPidTaskQueue::SLOW_TASK_TIME = 1000;
+
+class _ctkCMPidTaskRunnable : public QRunnable
+{
+
+public:
+
+  _ctkCMPidTaskRunnable(ctkCMPidTaskQueue* queue, const QString& pid)
+    : queue(queue), pid(pid)
+  {
+  }
+
+  void run()
+  {
+    queue->runNextTask(pid);
+  }
+
+private:
+
+  ctkCMPidTaskQueue* const queue;
+  const QString pid;
+};
+
+ctkCMPidTaskQueue::Metrics::Metrics()
+  : pendingTasks(0), maxPendingTasks(0), activePids(0), executedTasks(0),
+    totalWaitTime(0), maxWaitTime(0), totalRunTime(0), maxRunTime(0)
+{
+
+}
+
+ctkCMPidTaskQueue::ctkCMPidTaskQueue(const QString& queueName, QThreadPool* threadPool,
+                                     ctkLogService* log)
+  : queueName(queueName), threadPool(threadPool), log(log)
+{
+
+}
+
+ctkCMPidTaskQueue::~ctkCMPidTaskQueue()
+{
+  QMutexLocker lock(&mutex);
+  while (!tasks.isEmpty())
+  {
+    allTasksDone.wait(&mutex);
+  }
+
+  if (metrics.executedTasks > 0)
+  {
+    CTK_DEBUG(log) << queueName << ": " << metrics.executedTasks << " tasks, "
+                   << "max. " << metrics.maxPendingTasks << " pending, "
+                   << "wait time avg. " << metrics.totalWaitTime / metrics.executedTasks
+                   << " ms max. " << metrics.maxWaitTime << " ms, "
+                   << "run time avg. " << metrics.totalRunTime / metrics.executedTasks
+                   << " ms max. " << metrics.maxRunTime << " ms";
+  }
+}
+
+void ctkCMPidTaskQueue::put(const QString& pid, QRunnable* newTask)
+{
+  QueuedTask queuedTask;
+  queuedTask.task = newTask;
+  queuedTask.putTime.start();
+
+  QMutexLocker lock(&mutex);
+  bool idle = !tasks.contains(pid);
+  tasks[pid].push_back(queuedTask);
+  metrics.maxPendingTasks = qMax(metrics.maxPendingTasks, ++metrics.pendingTasks);
+  metrics.activePids = tasks.size();
+  if (idle)
+  {
+    threadPool->start(new _ctkCMPidTaskRunnable(this, pid));
+  }
+}
+
+ctkCMPidTaskQueue::Metrics ctkCMPidTaskQueue::getMetrics() const
+{
+  QMutexLocker lock(&mutex);
+  return metrics;
+}
+
+void ctkCMPidTaskQueue::runNextTask(const QString& pid)
+{
+  QueuedTask queuedTask;
+  {
+    QMutexLocker lock(&mutex);
+    queuedTask = tasks[pid].takeFirst();
+    --metrics.pendingTasks;
+  }
+
+  int waitTime = queuedTask.putTime.elapsed();
+  QTime runTime;
+  runTime.start();
+  queuedTask.task->run();
+  delete queuedTask.task;
+  int elapsed = runTime.elapsed();
+
+  if (elapsed > SLOW_TASK_TIME)
+  {
+    CTK_WARN(log) << queueName << ": task for " << pid << " took " << elapsed << " ms";
+  }
+
+  QMutexLocker lock(&mutex);
+  ++metrics.executedTasks;
+  metrics.totalWaitTime += waitTime;
+  metrics.maxWaitTime = qMax(metrics.maxWaitTime, waitTime);
+  metrics.totalRunTime += elapsed;
+  metrics.maxRunTime = qMax(metrics.maxRunTime, elapsed);
+
+  // keep the pid until its queue is empty, so that put does not schedule a
+  // second runnable for it while the next task is waiting for a thread
+  if (tasks[pid].isEmpty())
+  {
+    tasks.remove(pid);
+    metrics.activePids = tasks.size();
+    if (tasks.isEmpty())
+    {
+      allTasksDone.wakeAll();
+    }
+  }
+  else
+  {
+    threadPool->start(new _ctkCMPidTaskRunnable(this, pid));
+  }
+}
@@ -0,0 +1,102 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+
+#ifndef CTKCMPIDTASKQUEUE_P_H
+#define CTKCMPIDTASKQUEUE_P_H
+
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QTime>
+#include <QWaitCondition>
+
+class QRunnable;
+class QThreadPool;
+struct ctkLogService;
+
+/**
+ * ctkCMPidTaskQueue executes tasks asynchronously on a shared thread pool. Tasks put
+ * for the same pid are executed one after the other in the order they were put, while
+ * tasks for different pids may be executed concurrently.
+ */
+class ctkCMPidTaskQueue
+{
+
+public:
+
+  /**
+   * Statistics about the tasks put into a queue, times are in milliseconds.
+   * The wait time of a task is the time between put and the start of its execution.
+   */
+  struct Metrics
+  {
+    Metrics();
+
+    int pendingTasks;
+    int maxPendingTasks;
+    int activePids;
+    int executedTasks;
+    qint64 totalWaitTime;
+    int maxWaitTime;
+    qint64 totalRunTime;
+    int maxRunTime;
+  };
+
+  ctkCMPidTaskQueue(const QString& queueName, QThreadPool* threadPool, ctkLogService* log);
+
+  /**
+   * Waits for all the tasks which were put to be executed.
+   */
+  ~ctkCMPidTaskQueue();
+
+  void put(const QString& pid, QRunnable* newTask);
+
+  Metrics getMetrics() const;
+
+private:
+
+  friend class _ctkCMPidTaskRunnable;
+
+  static const int SLOW_TASK_TIME; // = 1000
+
+  struct QueuedTask
+  {
+    QRunnable* task;
+    QTime putTime;
+  };
+
+  const QString queueName;
+  QThreadPool* const threadPool;
+  ctkLogService* const log;
+
+  mutable QMutex mutex;
+  QWaitCondition allTasksDone;
+  /** pids with pending or running tasks, each has one runnable in the thread pool @GuardedBy mutex */
+  QHash<QString, QList<QueuedTask> > tasks;
+  /** @GuardedBy mutex */
+  Metrics metrics;
+
+  void runNextTask(const QString& pid);
+};
+
+#endif // CTKCMPIDTASKQUEUE_P_H
@@ -27,13 +27,17 @@
 #include "ctkConfigurationAdminImpl_p.h"
 #include "ctkConfigurationImpl_p.h"
 
+#include <QThread>
+
+const int ctkConfigurationAdminFactory::MAX_UPDATE_THREADS = 8;
+
 ctkConfigurationAdminFactory::ctkConfigurationAdminFactory(ctkPluginContext* context, ctkLogService* log)
   : eventDispatcher(context, log), pluginManager(context), logService(log),
     configurationStore(this, context),
-    managedServiceTracker(this, &configurationStore, context),
-    managedServiceFactoryTracker(this, &configurationStore, context)
+    managedServiceTracker(this, &configurationStore, &updateThreadPool, context),
+    managedServiceFactoryTracker(this, &configurationStore, &updateThreadPool, context)
 {
-
+  updateThreadPool.setMaxThreadCount(qBound(2, QThread::idealThreadCount(), MAX_UPDATE_THREADS));
 }
 
 ctkConfigurationAdminFactory::~ctkConfigurationAdminFactory()
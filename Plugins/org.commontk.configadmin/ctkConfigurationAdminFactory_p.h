@@ -24,6 +24,7 @@
 #define CTKCONFIGURATIONADMINFACTORY_P_H
 
 #include <QObject>
+#include <QThreadPool>
 
 #include <ctkPluginEvent.h>
 #include <ctkServiceFactory.h>
@@ -81,6 +82,8 @@ private:
   ctkCMPluginManager pluginManager;
   ctkLogService* logService;
   ctkConfigurationStore configurationStore;
+  static const int MAX_UPDATE_THREADS; // = 8
+  QThreadPool updateThreadPool;
   ctkManagedServiceTracker managedServiceTracker;
   ctkManagedServiceFactoryTracker managedServiceFactoryTracker;
 
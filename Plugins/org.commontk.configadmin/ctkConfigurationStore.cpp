@@ -24,18 +24,230 @@
 #include "ctkConfigurationAdminFactory_p.h"
 
 #include <ctkPluginContext.h>
+#include <ctkPluginConstants.h>
+#include <service/cm/ctkConfigurationAdmin.h>
 #include <service/log/ctkLogService.h>
 
+#include <QDataStream>
 #include <QDateTime>
 
+#ifdef Q_OS_WIN
+#include <windows.h>
+#include <io.h>
+#else
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 const QString ctkConfigurationStore::STORE_DIR = "store";
 const QString ctkConfigurationStore::PID_EXT = ".pid";
+const QString ctkConfigurationStore::JOURNAL_FILE = "configurations.journal";
+const int ctkConfigurationStore::COMPACTION_MIN_RECORDS = 1024;
+
+namespace {
+
+const quint32 JOURNAL_MAGIC = 0x434d4a4c; // "CMJL"
+const quint32 JOURNAL_VERSION = 1;
+const QString TMP_EXT = ".tmp";
+
+QByteArray serializeDictionary(const ctkDictionary& dictionary)
+{
+  QByteArray data;
+  QDataStream dataStream(&data, QIODevice::WriteOnly);
+  dataStream.setVersion(QDataStream::Qt_4_6);
+  dataStream << dictionary;
+  return data;
+}
+
+bool deserializeDictionary(const QByteArray& data, ctkDictionary& dictionary)
+{
+  QDataStream dataStream(data);
+  dataStream.setVersion(QDataStream::Qt_4_6);
+  dataStream >> dictionary;
+  return dataStream.status() == QDataStream::Ok;
+}
+
+QByteArray journalRecord(quint8 operation, const QString& pid,
+                         const QString& factoryPid = QString(),
+                         const QByteArray& dictionaryData = QByteArray())
+{
+  QByteArray record;
+  QDataStream dataStream(&record, QIODevice::WriteOnly);
+  dataStream.setVersion(QDataStream::Qt_4_6);
+  dataStream << operation << pid;
+  if (!dictionaryData.isNull())
+  {
+    dataStream << factoryPid << dictionaryData;
+  }
+  return record;
+}
+
+/**
+ * Frames a record as its size, its content and a checksum, so that
+ * a record which was only partially written can be detected.
+ */
+void writeJournalRecord(QDataStream& dataStream, const QByteArray& record)
+{
+  dataStream << static_cast<quint32>(record.size());
+  dataStream.writeRawData(record.constData(), record.size());
+  dataStream << qChecksum(record.constData(), record.size());
+}
+
+void writeJournalHeader(QDataStream& dataStream)
+{
+  dataStream << JOURNAL_MAGIC << JOURNAL_VERSION;
+}
+
+/**
+ * Writes the flushed content of <code>file</code> through to the disk.
+ */
+bool syncFile(QFile& file)
+{
+#ifdef Q_OS_WIN
+  return FlushFileBuffers(reinterpret_cast<HANDLE>(_get_osfhandle(file.handle()))) != 0;
+#else
+  return ::fsync(file.handle()) == 0;
+#endif
+}
+
+/**
+ * Writes the entries of <code>directory</code> through to the disk, so that
+ * a rename in it survives a crash. MoveFileEx already does this on Windows.
+ */
+bool syncDirectory(const QString& directory)
+{
+#ifdef Q_OS_WIN
+  Q_UNUSED(directory)
+  return true;
+#else
+  int fd = ::open(QFile::encodeName(directory).constData(), O_RDONLY);
+  if (fd < 0)
+  {
+    return false;
+  }
+  bool synced = ::fsync(fd) == 0;
+  ::close(fd);
+  return synced;
+#endif
+}
+
+/**
+ * Replaces <code>target</code> by <code>source</code> in a single step,
+ * so that readers see either the old or the new content.
+ */
+bool replaceFile(const QString& source, const QString& target)
+{
+#ifdef Q_OS_WIN
+  return MoveFileExW(reinterpret_cast<const wchar_t*>(QDir::toNativeSeparators(source).utf16()),
+                     reinterpret_cast<const wchar_t*>(QDir::toNativeSeparators(target).utf16()),
+                     MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+  return std::rename(QFile::encodeName(source).constData(),
+                     QFile::encodeName(target).constData()) == 0;
+#endif
+}
+
+/**
+ * Reads the value of an equality term of the form (attribute=value),
+ * returning false if the value contains wildcards.
+ */
+bool parseEqualityTerm(const QString& term, QString& attribute, QString& value)
+{
+  int equals = term.indexOf('=');
+  if (equals < 2 || !term.startsWith('(') || !term.endsWith(')'))
+  {
+    return false;
+  }
+  QChar op = term.at(equals - 1);
+  if (op == '~' || op == '<' || op == '>')
+  {
+    return false;
+  }
+  attribute = term.mid(1, equals - 1).trimmed();
+  value.clear();
+  for (int i = equals + 1; i < term.size() - 1; ++i)
+  {
+    QChar c = term.at(i);
+    if (c == '\\' && i + 1 < term.size() - 1)
+    {
+      c = term.at(++i);
+    }
+    else if (c == '*' || c == '(' || c == ')')
+    {
+      return false;
+    }
+    value.append(c);
+  }
+  return true;
+}
+
+/**
+ * Finds an equality on service.pid, or failing that on service.factoryPid, in a
+ * filter which is either that equality or a conjunction having it as one of its
+ * terms. All the configurations matching the filter then have that property value.
+ */
+bool findIndexedTerm(const QString& filter, QString& attribute, QString& value)
+{
+  QStringList terms;
+  if (filter.startsWith("(&") && filter.endsWith(')'))
+  {
+    int depth = 0;
+    int start = -1;
+    for (int i = 2; i < filter.size() - 1; ++i)
+    {
+      QChar c = filter.at(i);
+      if (c == '\\')
+      {
+        ++i;
+      }
+      else if (c == '(')
+      {
+        if (depth++ == 0) start = i;
+      }
+      else if (c == ')')
+      {
+        if (--depth == 0) terms << filter.mid(start, i - start + 1);
+      }
+    }
+  }
+  else
+  {
+    terms << filter;
+  }
+
+  bool found = false;
+  foreach (QString term, terms)
+  {
+    QString termAttribute;
+    QString termValue;
+    if (!parseEqualityTerm(term, termAttribute, termValue))
+    {
+      continue;
+    }
+    if (termAttribute.compare(ctkPluginConstants::SERVICE_PID, Qt::CaseInsensitive) == 0)
+    {
+      attribute = ctkPluginConstants::SERVICE_PID;
+      value = termValue;
+      return true;
+    }
+    if (!found && termAttribute.compare(ctkConfigurationAdmin::SERVICE_FACTORYPID, Qt::CaseInsensitive) == 0)
+    {
+      attribute = ctkConfigurationAdmin::SERVICE_FACTORYPID;
+      value = termValue;
+      found = true;
+    }
+  }
+  return found;
+}
+
+}
 
 ctkConfigurationStore::ctkConfigurationStore(
   ctkConfigurationAdminFactory* configurationAdminFactory,
   ctkPluginContext* context)
   : configurationAdminFactory(configurationAdminFactory),
-    createdPidCount(0)
+    createdPidCount(0), journalRecordCount(0)
 {
   store = context->getDataFile(STORE_DIR).absoluteDir();
 
@@ -44,59 +256,274 @@ ctkConfigurationStore::ctkConfigurationStore(
     return; // no persistent store
   }
 
+  QFile::remove(store.filePath(JOURNAL_FILE + TMP_EXT));
+  readJournal();
+  importConfigurationFiles();
+
+  QHashIterator<QString, StoredConfiguration> it(storedConfigurations);
+  while (it.hasNext())
+  {
+    it.next();
+    pidIndex.insert(it.key(), it.value().factoryPid);
+    if (!it.value().factoryPid.isEmpty())
+    {
+      factoryPidIndex.insert(it.value().factoryPid, it.key());
+    }
+  }
+}
+
+ctkConfigurationStore::~ctkConfigurationStore()
+{
+  QMutexLocker journalLock(&journalMutex);
+  journal.close();
+}
+
+void ctkConfigurationStore::readJournal()
+{
+  journal.setFileName(store.filePath(JOURNAL_FILE));
+  if (!journal.exists())
+  {
+    return;
+  }
+
+  if (!journal.open(QIODevice::ReadOnly))
+  {
+    QString errorMessage = QString("{Configuration Admin} could not read %1. %2").arg(journal.fileName()).arg(journal.errorString());
+    CTK_ERROR(configurationAdminFactory->getLogService()) << errorMessage;
+    return;
+  }
+
+  QDataStream dataStream(&journal);
+  dataStream.setVersion(QDataStream::Qt_4_6);
+  quint32 magic = 0;
+  quint32 version = 0;
+  dataStream >> magic >> version;
+  if (dataStream.status() != QDataStream::Ok || magic != JOURNAL_MAGIC || version != JOURNAL_VERSION)
+  {
+    journal.close();
+    QString errorMessage = QString("{Configuration Admin} %1 is not a configuration journal, configurations could not be restored.").arg(journal.fileName());
+    CTK_ERROR(configurationAdminFactory->getLogService()) << errorMessage;
+    QFile::remove(journal.fileName() + ".bad");
+    journal.rename(journal.fileName() + ".bad");
+    journal.setFileName(store.filePath(JOURNAL_FILE));
+    return;
+  }
+
+  qint64 validSize = journal.pos();
+  QByteArray record;
+  while (!dataStream.atEnd())
+  {
+    quint32 recordSize = 0;
+    dataStream >> recordSize;
+    if (dataStream.status() != QDataStream::Ok ||
+        static_cast<qint64>(recordSize) > journal.size() - journal.pos())
+    {
+      break;
+    }
+    record.resize(recordSize);
+    quint16 checksum = 0;
+    if (dataStream.readRawData(record.data(), recordSize) != static_cast<int>(recordSize))
+    {
+      break;
+    }
+    dataStream >> checksum;
+    if (dataStream.status() != QDataStream::Ok ||
+        checksum != qChecksum(record.constData(), record.size()))
+    {
+      break;
+    }
+
+    QDataStream recordStream(record);
+    recordStream.setVersion(QDataStream::Qt_4_6);
+    quint8 operation = 0;
+    QString pid;
+    recordStream >> operation >> pid;
+    if (operation == JOURNAL_SAVE)
+    {
+      StoredConfiguration stored;
+      recordStream >> stored.factoryPid >> stored.dictionaryData;
+      if (recordStream.status() == QDataStream::Ok)
+      {
+        storedConfigurations.insert(pid, stored);
+      }
+    }
+    else if (operation == JOURNAL_REMOVE)
+    {
+      storedConfigurations.remove(pid);
+    }
+    ++journalRecordCount;
+    validSize = journal.pos();
+  }
+
+  qint64 journalSize = journal.size();
+  journal.close();
+
+  if (validSize < journalSize)
+  {
+    // the last write was interrupted, keep the records before it
+    QString errorMessage = QString("{Configuration Admin} discarding %1 bytes of incomplete journal records in %2.").arg(journalSize - validSize).arg(journal.fileName());
+    CTK_WARN(configurationAdminFactory->getLogService()) << errorMessage;
+    journal.resize(validSize);
+  }
+}
+
+void ctkConfigurationStore::importConfigurationFiles()
+{
   QStringList nameFilters;
   nameFilters << QString('*') + PID_EXT;
   QFileInfoList configurationFiles = store.entryInfoList(nameFilters, QDir::Files | QDir::CaseSensitive);
+  QStringList importedFiles;
   foreach (QFileInfo configFileInfo, configurationFiles)
   {
     QString configurationFilePath = configFileInfo.absoluteFilePath();
     QString configurationFileName = configFileInfo.fileName();
     QString pid = configurationFileName.mid(0, configurationFileName.size() - PID_EXT.size());
 
-    bool deleteFile = false;
-    QIODevice* iodevice = new QFile(configurationFilePath);
-    iodevice->open(QIODevice::ReadOnly);
-    QDataStream dataStream(iodevice);
+    QFile configFile(configurationFilePath);
+    configFile.open(QIODevice::ReadOnly);
+    QDataStream dataStream(&configFile);
 
     ctkDictionary dictionary;
     dataStream >> dictionary;
     if (dataStream.status() == QDataStream::Ok)
     {
-      ctkConfigurationImplPtr config(new ctkConfigurationImpl(configurationAdminFactory, this, dictionary));
-      configurations.insert(config->getPid(), config);
+      pid = dictionary.value(ctkPluginConstants::SERVICE_PID, pid).toString();
+      StoredConfiguration stored;
+      stored.factoryPid = dictionary.value(ctkConfigurationAdmin::SERVICE_FACTORYPID).toString();
+      stored.dictionaryData = serializeDictionary(dictionary);
+      storedConfigurations.insert(pid, stored);
+      importedFiles << configurationFilePath;
     }
     else
     {
-      QString message = iodevice->errorString();
+      QString message = configFile.errorString();
       QString errorMessage = QString("{Configuration Admin - pid = %1} could not be restored. %2").arg(pid).arg(message);
       CTK_ERROR(configurationAdminFactory->getLogService()) << errorMessage;
-      deleteFile = true;
+      configFile.close();
+      configFile.remove();
     }
+  }
 
-    iodevice->close();
-    delete iodevice;
+  if (importedFiles.isEmpty() && journalRecordCount <= qMax(COMPACTION_MIN_RECORDS, 2 * storedConfigurations.size()))
+  {
+    openJournal();
+    return;
+  }
 
-    if (deleteFile)
+  // the imported configurations are only removed once they are in the journal
+  if (compactJournal())
+  {
+    foreach (QString configurationFilePath, importedFiles)
     {
       QFile::remove(configurationFilePath);
     }
   }
 }
 
+bool ctkConfigurationStore::openJournal()
+{
+  journal.setFileName(store.filePath(JOURNAL_FILE));
+  bool newJournal = !journal.exists() || journal.size() == 0;
+  if (!journal.open(QIODevice::WriteOnly | QIODevice::Append))
+  {
+    QString errorMessage = QString("{Configuration Admin} could not open %1, configurations will not be saved. %2").arg(journal.fileName()).arg(journal.errorString());
+    CTK_ERROR(configurationAdminFactory->getLogService()) << errorMessage;
+    return false;
+  }
+  if (newJournal)
+  {
+    QDataStream dataStream(&journal);
+    dataStream.setVersion(QDataStream::Qt_4_6);
+    writeJournalHeader(dataStream);
+    journal.flush();
+    syncFile(journal);
+  }
+  return true;
+}
+
+bool ctkConfigurationStore::appendJournalRecord(const QByteArray& record)
+{
+  if (!journal.isOpen())
+  {
+    return false;
+  }
+
+  QDataStream dataStream(&journal);
+  dataStream.setVersion(QDataStream::Qt_4_6);
+  writeJournalRecord(dataStream, record);
+  // the record is durable once saveConfiguration or removeConfiguration returns
+  bool synced = journal.flush() && syncFile(journal);
+  ++journalRecordCount;
+
+  if (journalRecordCount > qMax(COMPACTION_MIN_RECORDS, 2 * storedConfigurations.size()))
+  {
+    compactJournal();
+  }
+  return synced && dataStream.status() == QDataStream::Ok;
+}
+
+bool ctkConfigurationStore::compactJournal()
+{
+  QString journalFilePath = store.filePath(JOURNAL_FILE);
+  QFile snapshot(journalFilePath + TMP_EXT);
+  bool written = false;
+  if (snapshot.open(QIODevice::WriteOnly | QIODevice::Truncate))
+  {
+    QDataStream dataStream(&snapshot);
+    dataStream.setVersion(QDataStream::Qt_4_6);
+    writeJournalHeader(dataStream);
+    QHashIterator<QString, StoredConfiguration> it(storedConfigurations);
+    while (it.hasNext())
+    {
+      it.next();
+      writeJournalRecord(dataStream, journalRecord(JOURNAL_SAVE, it.key(), it.value().factoryPid,
+                                                   it.value().dictionaryData));
+    }
+    // the snapshot must be on disk before it replaces the journal
+    written = snapshot.flush() && syncFile(snapshot) &&
+              dataStream.status() == QDataStream::Ok && snapshot.error() == QFile::NoError;
+    snapshot.close();
+  }
+
+  journal.close();
+  bool replaced = written && replaceFile(snapshot.fileName(), journalFilePath);
+  if (replaced && !syncDirectory(store.absolutePath()))
+  {
+    QString errorMessage = QString("{Configuration Admin} could not sync %1, the compacted journal may not survive a crash.").arg(store.absolutePath());
+    CTK_WARN(configurationAdminFactory->getLogService()) << errorMessage;
+  }
+  if (replaced)
+  {
+    journalRecordCount = storedConfigurations.size();
+  }
+  else
+  {
+    QString errorMessage = QString("{Configuration Admin} could not compact %1. %2").arg(journalFilePath).arg(snapshot.errorString());
+    CTK_ERROR(configurationAdminFactory->getLogService()) << errorMessage;
+    snapshot.remove();
+  }
+  return openJournal() && replaced;
+}
+
 void ctkConfigurationStore::saveConfiguration(const QString& pid, ctkConfigurationImpl* config)
 {
   if (!store.exists())
     return; // no persistent store
 
   config->checkLocked();
-  QFile configFile(store.filePath(pid + PID_EXT));
   ctkDictionary configProperties = config->getAllProperties();
+  StoredConfiguration stored;
+  stored.factoryPid = config->getFactoryPid(false);
+  stored.dictionaryData = serializeDictionary(configProperties);
+  QByteArray record = journalRecord(JOURNAL_SAVE, pid, stored.factoryPid, stored.dictionaryData);
   //TODO security
 //  try
 //  {
 //    AccessController.doPrivileged(new PrivilegedExceptionAction() {
 //      public Object run() throws Exception {
-        writeConfigurationFile(configFile, configProperties);
+  QMutexLocker journalLock(&journalMutex);
+  storedConfigurations.insert(pid, stored);
+  appendJournalRecord(record); // ignore errors
 //        return null;
 //      }
 //    });
@@ -111,13 +538,21 @@ void ctkConfigurationStore::removeConfiguration(const QString& pid)
 {
   QMutexLocker lock(&mutex);
   configurations.remove(pid);
+  QString factoryPid = pidIndex.take(pid);
+  if (!factoryPid.isEmpty())
+  {
+    factoryPidIndex.remove(factoryPid, pid);
+  }
   if (!store.exists())
     return; // no persistent store
 
-  QFile configFile(store.filePath(pid + PID_EXT));
   //TODO security//  AccessController.doPrivileged(new PrivilegedAction() {
 //    public Object run() {
-  deleteConfigurationFile(configFile);
+  QMutexLocker journalLock(&journalMutex);
+  if (storedConfigurations.remove(pid) > 0)
+  {
+    appendJournalRecord(journalRecord(JOURNAL_REMOVE, pid));
+  }
 //      return null;
 //    }
 //  });
@@ -127,12 +562,13 @@ ctkConfigurationImplPtr ctkConfigurationStore::getConfiguration(
   const QString& pid, const QString& location)
 {
   QMutexLocker lock(&mutex);
-  ctkConfigurationImplPtr config = configurations.value(pid);
+  ctkConfigurationImplPtr config = loadConfiguration(pid);
   if (config.isNull())
   {
     config = ctkConfigurationImplPtr(new ctkConfigurationImpl(configurationAdminFactory, this,
                                                               QString(), pid, location));
     configurations.insert(pid, config);
+    pidIndex.insert(pid, QString());
   }
   return config;
 }
@@ -145,35 +581,44 @@ ctkConfigurationImplPtr ctkConfigurationStore::createFactoryConfiguration(
   QString pid = factoryPid + "-" + QDateTime::currentDateTime().toString("yyyyMMdd-hhmmsszzz") + "-" + QString::number(createdPidCount++);
   ctkConfigurationImplPtr config(new ctkConfigurationImpl(configurationAdminFactory, this, factoryPid, pid, location));
   configurations.insert(pid, config);
+  pidIndex.insert(pid, factoryPid);
+  factoryPidIndex.insert(factoryPid, pid);
   return config;
 }
 
 ctkConfigurationImplPtr ctkConfigurationStore::findConfiguration(const QString& pid)
 {
   QMutexLocker lock(&mutex);
-  return configurations.value(pid);
+  return loadConfiguration(pid);
 }
 
 QList<ctkConfigurationImplPtr> ctkConfigurationStore::getFactoryConfigurations(const QString& factoryPid)
 {
   QMutexLocker lock(&mutex);
-  QList<ctkConfigurationImplPtr> resultList;
-  foreach (ctkConfigurationImplPtr config, configurations)
-  {
-    QString otherFactoryPid = config->getFactoryPid();
-    if (otherFactoryPid == factoryPid)
-    {
-      resultList.push_back(config);
-    }
-  }
-  return resultList;
+  return loadConfigurations(factoryPidIndex.values(factoryPid));
 }
 
 QList<ctkConfigurationImplPtr> ctkConfigurationStore::listConfigurations(const ctkLDAPSearchFilter& filter)
 {
   QMutexLocker lock(&mutex);
+  QStringList candidatePids;
+  QString attribute;
+  QString value;
+  if (!findIndexedTerm(filter.toString(), attribute, value))
+  {
+    candidatePids = pidIndex.keys();
+  }
+  else if (attribute == ctkPluginConstants::SERVICE_PID)
+  {
+    if (pidIndex.contains(value)) candidatePids << value;
+  }
+  else
+  {
+    candidatePids = factoryPidIndex.values(value);
+  }
+
   QList<ctkConfigurationImplPtr> resultList;
-  foreach (ctkConfigurationImplPtr config, configurations)
+  foreach (ctkConfigurationImplPtr config, loadConfigurations(candidatePids))
   {
     ctkDictionary properties = config->getAllProperties();
     if (filter.match(properties))
@@ -187,25 +632,59 @@ QList<ctkConfigurationImplPtr> ctkConfigurationStore::listConfigurations(const c
 void ctkConfigurationStore::unbindConfigurations(QSharedPointer<ctkPlugin> plugin)
 {
   QMutexLocker lock(&mutex);
+  // configurations which were not loaded yet were never bound
   foreach (ctkConfigurationImplPtr config, configurations)
   {
     config->unbind(plugin);
   }
 }
 
-void ctkConfigurationStore::writeConfigurationFile(QFile& configFile,
-                            const ctkDictionary& configProperties)
+ctkConfigurationImplPtr ctkConfigurationStore::loadConfiguration(const QString& pid)
 {
-  QIODevice* iodevice = &configFile;
-  iodevice->open(QIODevice::WriteOnly);
-  QDataStream datastream(iodevice);
+  ctkConfigurationImplPtr config = configurations.value(pid);
+  if (!config.isNull() || !pidIndex.contains(pid))
+  {
+    return config;
+  }
+
+  QByteArray dictionaryData;
+  {
+    QMutexLocker journalLock(&journalMutex);
+    dictionaryData = storedConfigurations.value(pid).dictionaryData;
+  }
 
-  datastream << configProperties;
-  // ignore errors
-  iodevice->close();
+  ctkDictionary dictionary;
+  if (dictionaryData.isNull() || !deserializeDictionary(dictionaryData, dictionary))
+  {
+    QString errorMessage = QString("{Configuration Admin - pid = %1} could not be restored.").arg(pid);
+    CTK_ERROR(configurationAdminFactory->getLogService()) << errorMessage;
+    return config;
+  }
+
+  // a configuration saved before its first update has no properties
+  if (!dictionary.contains(ctkPluginConstants::SERVICE_PID))
+  {
+    dictionary.insert(ctkPluginConstants::SERVICE_PID, pid);
+    if (!pidIndex.value(pid).isEmpty())
+    {
+      dictionary.insert(ctkConfigurationAdmin::SERVICE_FACTORYPID, pidIndex.value(pid));
+    }
+  }
+  config = ctkConfigurationImplPtr(new ctkConfigurationImpl(configurationAdminFactory, this, dictionary));
+  configurations.insert(pid, config);
+  return config;
 }
 
-void ctkConfigurationStore::deleteConfigurationFile(QFile& configFile)
+QList<ctkConfigurationImplPtr> ctkConfigurationStore::loadConfigurations(const QStringList& pids)
 {
-  configFile.remove();
+  QList<ctkConfigurationImplPtr> resultList;
+  foreach (QString pid, pids)
+  {
+    ctkConfigurationImplPtr config = loadConfiguration(pid);
+    if (!config.isNull())
+    {
+      resultList.push_back(config);
+    }
+  }
+  return resultList;
 }
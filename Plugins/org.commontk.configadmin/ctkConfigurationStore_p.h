@@ -30,7 +30,9 @@
 #include <QSharedPointer>
 #include <QHash>
 #include <QDir>
+#include <QFile>
 #include <QMutex>
+#include <QStringList>
 
 class ctkConfigurationImpl;
 class ctkConfigurationAdminFactory;
@@ -39,9 +41,18 @@ class ctkPlugin;
 
 /**
  * ctkConfigurationStore manages all active configurations along with persistence. The current
- * implementation uses a filestore and serialization of the configuration dictionaries to files
- * identified by their pid. Persistence details are in the constructor, saveConfiguration, and
- * deleteConfiguration and can be factored out separately if required.
+ * implementation uses an append-only journal of serialized configuration dictionaries: each
+ * saveConfiguration and removeConfiguration appends a checksummed record, which is synced to
+ * the disk before returning, and the journal is compacted into a snapshot (written and synced to
+ * a temporary file, then atomically renamed) once most of its records are obsolete. A torn record at the end of the journal, left by a crash mid-write,
+ * is discarded on startup so that the previous version of the configuration is kept.
+ *
+ * Dictionaries read from the journal are only deserialized, and their ctkConfigurationImpl
+ * created, when the configuration is first accessed. Configurations are indexed by pid and
+ * factory pid, which is used by getFactoryConfigurations and by listConfigurations for filters
+ * which are, or are a conjunction containing, an equality on service.pid or service.factoryPid.
+ *
+ * Configurations stored in one file per pid by previous versions are imported on startup.
  */
 class ctkConfigurationStore
 {
@@ -50,6 +61,7 @@ public:
 
   ctkConfigurationStore(ctkConfigurationAdminFactory* configurationAdminFactory,
                         ctkPluginContext* context);
+  ~ctkConfigurationStore();
 
   void saveConfiguration(const QString& pid, ctkConfigurationImpl* config);
   void removeConfiguration(const QString& pid);
@@ -68,18 +80,56 @@ public:
 
 private:
 
+  enum JournalOperation
+  {
+    JOURNAL_SAVE = 1,
+    JOURNAL_REMOVE = 2
+  };
+
+  /**
+   * A configuration as stored in the journal.
+   */
+  struct StoredConfiguration
+  {
+    QString factoryPid;
+    QByteArray dictionaryData;
+  };
+
   QMutex mutex;
   ctkConfigurationAdminFactory* configurationAdminFactory;
   static const QString STORE_DIR; // = "store"
   static const QString PID_EXT; // = ".pid"
+  static const QString JOURNAL_FILE; // = "configurations.journal"
+  static const int COMPACTION_MIN_RECORDS; // = 1024
+  /** Materialized configurations @GuardedBy mutex */
   QHash<QString, ctkConfigurationImplPtr> configurations;
+  /** Factory pid (empty if none) of every known configuration, keyed by pid @GuardedBy mutex */
+  QHash<QString, QString> pidIndex;
+  /** pids of the known configurations, keyed by factory pid @GuardedBy mutex */
+  QMultiHash<QString, QString> factoryPidIndex;
   int createdPidCount;
   QDir store;
 
-
-  void writeConfigurationFile(QFile& configFile,
-                              const ctkDictionary& configProperties);
-  void deleteConfigurationFile(QFile& configFile);
+  /**
+   * Never held while acquiring the mutex or a configuration lock, since
+   * saveConfiguration is called with the configuration locked.
+   */
+  QMutex journalMutex;
+  /** Latest stored version of each configuration @GuardedBy journalMutex */
+  QHash<QString, StoredConfiguration> storedConfigurations;
+  /** @GuardedBy journalMutex */
+  QFile journal;
+  /** Number of records in the journal @GuardedBy journalMutex */
+  int journalRecordCount;
+
+  void readJournal();
+  void importConfigurationFiles();
+  bool appendJournalRecord(const QByteArray& record);
+  bool compactJournal();
+  bool openJournal();
+
+  ctkConfigurationImplPtr loadConfiguration(const QString& pid);
+  QList<ctkConfigurationImplPtr> loadConfigurations(const QStringList& pids);
 
 };
 
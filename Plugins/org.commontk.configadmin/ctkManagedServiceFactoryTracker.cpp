@@ -35,13 +35,14 @@
 ctkManagedServiceFactoryTracker::ctkManagedServiceFactoryTracker(
   ctkConfigurationAdminFactory* configurationAdminFactory,
   ctkConfigurationStore* configurationStore,
+  QThreadPool* updateThreadPool,
   ctkPluginContext* context)
   : ctkServiceTracker<ctkManagedServiceFactory*>(context),
     context(context),
     configurationAdminFactory(configurationAdminFactory),
     configurationStoreMutex(QMutex::Recursive),
     configurationStore(configurationStore),
-    queue("ctkManagedServiceFactory Update Queue")
+    queue("ctkManagedServiceFactory Update Queue", updateThreadPool, configurationAdminFactory->getLogService())
 {
 
 }
@@ -97,7 +98,7 @@ void ctkManagedServiceFactoryTracker::notifyDeleted(ctkConfigurationImpl* config
   ctkServiceReference reference = getManagedServiceFactoryReference(factoryPid);
   if (reference && config->bind(reference.getPlugin()))
   {
-    asynchDeleted(getManagedServiceFactory(factoryPid), config->getPid(false));
+    asynchDeleted(getManagedServiceFactory(factoryPid), factoryPid, config->getPid(false));
   }
 }
 
@@ -110,7 +111,7 @@ void ctkManagedServiceFactoryTracker::notifyUpdated(ctkConfigurationImpl* config
   {
     ctkDictionary properties = config->getProperties();
     configurationAdminFactory->modifyConfiguration(reference, properties);
-    asynchUpdated(getManagedServiceFactory(factoryPid), config->getPid(), properties);
+    asynchUpdated(getManagedServiceFactory(factoryPid), factoryPid, config->getPid(), properties);
   }
 }
 
@@ -133,7 +134,7 @@ void ctkManagedServiceFactoryTracker::addManagedServiceFactory(
       {
         ctkDictionary properties = config->getProperties();
         configurationAdminFactory->modifyConfiguration(reference, properties);
-        asynchUpdated(service, config->getPid(), properties);
+        asynchUpdated(service, factoryPid, config->getPid(), properties);
       }
       else
       {
@@ -236,9 +237,10 @@ private:
   ctkLogService* const log;
 };
 
-void ctkManagedServiceFactoryTracker::asynchDeleted(ctkManagedServiceFactory* service, const QString& pid)
+void ctkManagedServiceFactoryTracker::asynchDeleted(ctkManagedServiceFactory* service,
+                                                    const QString& factoryPid, const QString& pid)
 {
-  queue.put(new _AsynchDeleteRunnable(service, pid, configurationAdminFactory->getLogService()));
+  queue.put(factoryPid, new _AsynchDeleteRunnable(service, pid, configurationAdminFactory->getLogService()));
 }
 
 class _AsynchFactoryUpdateRunnable : public QRunnable
@@ -277,8 +279,8 @@ private:
   ctkLogService* const log;
 };
 
-void ctkManagedServiceFactoryTracker::asynchUpdated(ctkManagedServiceFactory* service, const QString& pid,
-                                                    const ctkDictionary& properties)
+void ctkManagedServiceFactoryTracker::asynchUpdated(ctkManagedServiceFactory* service, const QString& factoryPid,
+                                                    const QString& pid, const ctkDictionary& properties)
 {
-  queue.put(new _AsynchFactoryUpdateRunnable(service, pid, properties, configurationAdminFactory->getLogService()));
+  queue.put(factoryPid, new _AsynchFactoryUpdateRunnable(service, pid, properties, configurationAdminFactory->getLogService()));
 }
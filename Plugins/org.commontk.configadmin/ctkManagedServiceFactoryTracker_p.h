@@ -26,7 +26,7 @@
 #include <ctkServiceTracker.h>
 #include <service/cm/ctkManagedServiceFactory.h>
 
-#include "ctkCMSerializedTaskQueue_p.h"
+#include "ctkCMPidTaskQueue_p.h"
 
 class ctkConfigurationAdminFactory;
 class ctkConfigurationStore;
@@ -42,6 +42,7 @@ public:
 
   ctkManagedServiceFactoryTracker(ctkConfigurationAdminFactory* configurationAdminFactory,
                                   ctkConfigurationStore* configurationStore,
+                                  QThreadPool* updateThreadPool,
                                   ctkPluginContext* context);
 
   ctkManagedServiceFactory* addingService(const ctkServiceReference& reference);
@@ -63,7 +64,8 @@ private:
   QHash<QString, ctkManagedServiceFactory*> managedServiceFactories;
   QHash<QString, ctkServiceReference> managedServiceFactoryReferences;
 
-  ctkCMSerializedTaskQueue queue;
+  // calls to a ctkManagedServiceFactory are serialized by queueing them under its factory pid
+  ctkCMPidTaskQueue queue;
 
   void addManagedServiceFactory(const ctkServiceReference& reference,
                                 const QString& factoryPid,
@@ -85,10 +87,11 @@ private:
 
   QString getPidForManagedServiceFactory(ctkManagedServiceFactory* service) const;
 
-  void asynchDeleted(ctkManagedServiceFactory* service, const QString& pid);
+  void asynchDeleted(ctkManagedServiceFactory* service, const QString& factoryPid,
+                     const QString& pid);
 
-  void asynchUpdated(ctkManagedServiceFactory* service, const QString& pid,
-                     const ctkDictionary& properties);
+  void asynchUpdated(ctkManagedServiceFactory* service, const QString& factoryPid,
+                     const QString& pid, const ctkDictionary& properties);
 };
 
 #endif // CTKMANAGEDSERVICEFACTORYTRACKER_P_H
@@ -32,13 +32,14 @@
 
 ctkManagedServiceTracker::ctkManagedServiceTracker(ctkConfigurationAdminFactory* configurationAdminFactory,
                          ctkConfigurationStore* configurationStore,
+                         QThreadPool* updateThreadPool,
                          ctkPluginContext* context)
   : ctkServiceTracker<ctkManagedService*>(context),
     context(context),
     configurationAdminFactory(configurationAdminFactory),
     configurationStoreMutex(QMutex::Recursive),
     configurationStore(configurationStore),
-    queue("ctkManagedService Update Queue")
+    queue("ctkManagedService Update Queue", updateThreadPool, configurationAdminFactory->getLogService())
 {
 
 }
@@ -91,7 +92,7 @@ void ctkManagedServiceTracker::notifyDeleted(ctkConfigurationImpl* config)
   QString pid = config->getPid(false);
   ctkServiceReference reference = getManagedServiceReference(pid);
   if (reference && config->bind(reference.getPlugin()))
-    asynchUpdated(getManagedService(pid), ctkDictionary());
+    asynchUpdated(getManagedService(pid), pid, ctkDictionary());
 }
 
 void ctkManagedServiceTracker::notifyUpdated(ctkConfigurationImpl* config) {
@@ -102,7 +103,7 @@ void ctkManagedServiceTracker::notifyUpdated(ctkConfigurationImpl* config) {
   {
     ctkDictionary properties = config->getProperties();
     configurationAdminFactory->modifyConfiguration(reference, properties);
-    asynchUpdated(getManagedService(pid), properties);
+    asynchUpdated(getManagedService(pid), pid, properties);
   }
 }
 
@@ -113,7 +114,7 @@ void ctkManagedServiceTracker::addManagedService(const ctkServiceReference& refe
   ctkConfigurationImplPtr config = configurationStore->findConfiguration(pid);
   if (config.isNull() && trackManagedService(pid, reference, service))
   {
-    asynchUpdated(service, ctkDictionary());
+    asynchUpdated(service, pid, ctkDictionary());
   }
   else
   {
@@ -128,13 +129,13 @@ void ctkManagedServiceTracker::addManagedService(const ctkServiceReference& refe
       }
       else if (config->isDeleted())
       {
-        asynchUpdated(service, ctkDictionary());
+        asynchUpdated(service, pid, ctkDictionary());
       }
       else if (config->bind(reference.getPlugin()))
       {
         ctkDictionary properties = config->getProperties();
         configurationAdminFactory->modifyConfiguration(reference, properties);
-        asynchUpdated(service, properties);
+        asynchUpdated(service, pid, properties);
       }
       else
       {
@@ -247,7 +248,8 @@ private:
   ctkLogService * const log;
 };
 
-void ctkManagedServiceTracker::asynchUpdated(ctkManagedService* service, const ctkDictionary& properties)
+void ctkManagedServiceTracker::asynchUpdated(ctkManagedService* service, const QString& pid,
+                                             const ctkDictionary& properties)
 {
-  queue.put(new _AsynchUpdateRunnable(service, properties, configurationAdminFactory->getLogService()));
+  queue.put(pid, new _AsynchUpdateRunnable(service, properties, configurationAdminFactory->getLogService()));
 }
@@ -26,7 +26,7 @@
 #include <ctkServiceTracker.h>
 #include <service/cm/ctkManagedService.h>
 
-#include "ctkCMSerializedTaskQueue_p.h"
+#include "ctkCMPidTaskQueue_p.h"
 
 class ctkConfigurationAdminFactory;
 class ctkConfigurationStore;
@@ -42,6 +42,7 @@ public:
 
   ctkManagedServiceTracker(ctkConfigurationAdminFactory* configurationAdminFactory,
                            ctkConfigurationStore* configurationStore,
+                           QThreadPool* updateThreadPool,
                            ctkPluginContext* context);
 
   ctkManagedService* addingService(const ctkServiceReference& reference);
@@ -63,7 +64,7 @@ private:
   QHash<QString, ctkManagedService*> managedServices;
   QHash<QString, ctkServiceReference> managedServiceReferences;
 
-  ctkCMSerializedTaskQueue queue;
+  ctkCMPidTaskQueue queue;
 
   void addManagedService(const ctkServiceReference& reference, const QString& pid,
                          ctkManagedService* service);
@@ -81,7 +82,7 @@ private:
 
   QString getPidForManagedService(ctkManagedService* service) const;
 
-  void asynchUpdated(ctkManagedService* service, const ctkDictionary& properties);
+  void asynchUpdated(ctkManagedService* service, const QString& pid, const ctkDictionary& properties);
 };
 
 #endif // CTKMANAGEDSERVICETRACKER_P_H
@@ -168,6 +168,12 @@ QList<ctkDicomAppHosting::ObjectLocator> ctkDicomAbstractApp::getData(
   return this->objectLocatorCache()->getData(objectUUIDs);
 }
 
+//----------------------------------------------------------------------------
+void ctkDicomAbstractApp::releaseData(const QList<QUuid>& objectUUIDs)
+{
+  this->objectLocatorCache()->releaseData(objectUUIDs);
+}
+
 //----------------------------------------------------------------------------
 ctkDicomObjectLocatorCache* ctkDicomAbstractApp::objectLocatorCache()const
 {
@@ -92,6 +92,14 @@ public:
     const QList<QString>& acceptableTransferSyntaxUIDs,
     bool includeBulkData);
 
+  /**
+   * @brief Releases the data of the given objects: their locators are removed from
+   * the objectLocatorCache(), which frees the shared memory of the objects published there.
+   *
+   * @param objectUUIDs
+  */
+  virtual void releaseData(const QList<QUuid>& objectUUIDs);
+
   /**
    * @brief
    *
@@ -43,6 +43,8 @@ ctkDicomAppServer::ctkDicomAppServer(int port, QString path)
 {
   this->AppInterfaceTracker.open();
 
+  connect(&this->Server, SIGNAL(incomingSoapRequest(QByteArray,QByteArray*)),
+          this, SLOT(incomingSoapRequest(QByteArray,QByteArray*)));
   connect(&this->Server, SIGNAL(incomingSoapMessage(QtSoapMessage,QtSoapMessage*)),
           this, SLOT(incomingSoapMessage(QtSoapMessage,QtSoapMessage*)));
   connect(&this->Server, SIGNAL(incomingWSDLMessage(QString,QString*)),
@@ -92,6 +94,14 @@ void ctkDicomAppServer::incomingWSDLMessage(
   }
 }
 
+//----------------------------------------------------------------------------
+void ctkDicomAppServer::incomingSoapRequest(
+  const QByteArray& request, QByteArray* reply)
+{
+  QMutexLocker lock(&this->Mutex);
+  this->Processors.processStream(request, reply);
+}
+
 //----------------------------------------------------------------------------
 void ctkDicomAppServer::incomingSoapMessage(
   const QtSoapMessage& message,
@@ -49,6 +49,8 @@ public:
   ~ctkDicomAppServer();
 public Q_SLOTS:
 
+  void incomingSoapRequest(const QByteArray& request,
+                           QByteArray* reply);
   void incomingSoapMessage(const QtSoapMessage& message,
                            QtSoapMessage* reply);
   void incomingWSDLMessage(const QString& message, QString* reply);
@@ -0,0 +1,254 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+// Qt includes
+#include <QUuid>
+
+// CTK includes
+#include <ctkDicomAvailableDataHelper.h>
+#include <ctkDicomObjectLocatorCache.h>
+
+// STD includes
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+//----------------------------------------------------------------------------
+ctkDicomAppHosting::ObjectDescriptor createObjectDescriptor()
+{
+  ctkDicomAppHosting::ObjectDescriptor objectDescriptor;
+  objectDescriptor.descriptorUUID = QUuid::createUuid().toString();
+  objectDescriptor.mimeType = "application/dicom";
+  return objectDescriptor;
+}
+
+//----------------------------------------------------------------------------
+int countObjectDescriptors(const ctkDicomAppHosting::AvailableData& data)
+{
+  int count = data.objectDescriptors.count();
+  foreach(const ctkDicomAppHosting::Patient& patient, data.patients)
+    {
+    count += patient.objectDescriptors.count();
+    foreach(const ctkDicomAppHosting::Study& study, patient.studies)
+      {
+      count += study.objectDescriptors.count();
+      foreach(const ctkDicomAppHosting::Series& series, study.series)
+        {
+        count += series.objectDescriptors.count();
+        }
+      }
+    }
+  return count;
+}
+}
+
+//----------------------------------------------------------------------------
+int ctkDicomAvailableDataHelperTest1(int argc, char* argv[])
+{
+  Q_UNUSED(argc);
+  Q_UNUSED(argv);
+
+  using namespace ctkDicomAvailableDataHelper;
+
+  const int patientCount = 3;
+  const int studyCount = 2;
+  const int seriesCount = 2;
+  const int instanceCount = 50;
+
+  //----------------------------------------------------------------------------
+  // Build a tree through the accessor
+  ctkDicomAppHosting::AvailableData data;
+  ctkDicomAvailableDataAccessor accessor(data);
+  for (int p = 0; p < patientCount; ++p)
+    {
+    ctkDicomAppHosting::Patient patient;
+    patient.id = QString("patient%1").arg(p);
+    for (int s = 0; s < studyCount; ++s)
+      {
+      for (int se = 0; se < seriesCount; ++se)
+        {
+        for (int i = 0; i < instanceCount; ++i)
+          {
+          if (!accessor.addObjectDescriptor(patient,
+                                            QString("1.2.%1.%2").arg(p).arg(s),
+                                            QString("1.2.%1.%2.%3").arg(p).arg(s).arg(se),
+                                            createObjectDescriptor()))
+            {
+            std::cerr << "Line " << __LINE__ << " - Problem with addObjectDescriptor() method" << std::endl;
+            return EXIT_FAILURE;
+            }
+          }
+        }
+      }
+    }
+
+  if (data.patients.count() != patientCount ||
+      data.patients.at(1).studies.count() != studyCount ||
+      data.patients.at(1).studies.at(1).series.count() != seriesCount ||
+      countObjectDescriptors(data) != patientCount * studyCount * seriesCount * instanceCount)
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with addObjectDescriptor() method"
+              << " - unexpected tree" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  //----------------------------------------------------------------------------
+  ctkDicomAppHosting::Patient patient1;
+  patient1.id = "patient1";
+  if (accessor.getPatient(patient1) != &data.patients[1])
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with getPatient() method" << std::endl;
+    return EXIT_FAILURE;
+    }
+  if (accessor.getStudy("1.2.2.1") != &data.patients[2].studies[1] ||
+      accessor.getStudy("unknown") != NULL)
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with getStudy() method" << std::endl;
+    return EXIT_FAILURE;
+    }
+  if (accessor.getSeries("1.2.0.1.1") != &data.patients[0].studies[1].series[1] ||
+      accessor.getSeries("unknown") != NULL)
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with getSeries() method" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  ctkDicomAppHosting::Patient* patientFound;
+  ctkDicomAppHosting::Study* studyFound;
+  ctkDicomAppHosting::Series* seriesFound;
+  accessor.find(patient1, "1.2.1.0", "1.2.1.0.1", patientFound, studyFound, seriesFound);
+  if (patientFound != &data.patients[1] ||
+      studyFound != &data.patients[1].studies[0] ||
+      seriesFound != &data.patients[1].studies[0].series[1])
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with find() method" << std::endl;
+    return EXIT_FAILURE;
+    }
+  // the study exists, but not for this patient
+  accessor.find(patient1, "1.2.2.0", "1.2.2.0.1", patientFound, studyFound, seriesFound);
+  if (patientFound != &data.patients[1] || studyFound != NULL || seriesFound != NULL)
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with find() method"
+              << " - study of another patient" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  //----------------------------------------------------------------------------
+  // Descriptors are unique
+  ctkDicomAppHosting::ObjectDescriptor existing =
+    data.patients.at(0).studies.at(0).series.at(0).objectDescriptors.at(0);
+  if (!accessor.containsObjectDescriptor(existing.descriptorUUID) ||
+      accessor.addObjectDescriptor(existing) ||
+      accessor.addObjectDescriptor(patient1, "1.2.1.0", "1.2.1.0.0", existing))
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with addObjectDescriptor() method"
+              << " - duplicated descriptor" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  //----------------------------------------------------------------------------
+  // An accessor created on existing data indexes it
+  ctkDicomAvailableDataAccessor existingAccessor(data);
+  if (existingAccessor.getSeries("1.2.2.1.0") != &data.patients[2].studies[1].series[0] ||
+      !existingAccessor.containsObjectDescriptor(existing.descriptorUUID))
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with ctkDicomAvailableDataAccessor constructor" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  //----------------------------------------------------------------------------
+  // Merge data published in chunks, one per series, as with repeated
+  // notifyDataAvailable(lastData=false) calls.
+  ctkDicomAppHosting::AvailableData merged;
+  ctkDicomAvailableDataAccessor mergedAccessor(merged);
+  foreach(const ctkDicomAppHosting::Patient& patient, data.patients)
+    {
+    foreach(const ctkDicomAppHosting::Study& study, patient.studies)
+      {
+      foreach(const ctkDicomAppHosting::Series& series, study.series)
+        {
+        ctkDicomAppHosting::AvailableData chunk;
+        ctkDicomAppHosting::Patient chunkPatient(patient);
+        chunkPatient.studies.clear();
+        ctkDicomAppHosting::Study chunkStudy(study);
+        chunkStudy.series.clear();
+        chunkStudy.series << series;
+        chunkPatient.studies << chunkStudy;
+        chunk.patients << chunkPatient;
+        mergedAccessor.merge(chunk);
+        }
+      }
+    }
+  if (merged != data)
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with merge() method"
+              << " - merged != data" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // merging again is a no-op
+  mergedAccessor.merge(data);
+  if (merged != data)
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with merge() method"
+              << " - merging twice duplicated descriptors" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  //----------------------------------------------------------------------------
+  // The cache reports the published data
+  ctkDicomObjectLocatorCache cache;
+  if (cache.isCached(data))
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with isCached() method" << std::endl;
+    return EXIT_FAILURE;
+    }
+  foreach(const ctkDicomAppHosting::Patient& patient, data.patients)
+    {
+    foreach(const ctkDicomAppHosting::Study& study, patient.studies)
+      {
+      foreach(const ctkDicomAppHosting::Series& series, study.series)
+        {
+        foreach(const ctkDicomAppHosting::ObjectDescriptor& objectDescriptor, series.objectDescriptors)
+          {
+          ctkDicomAppHosting::ObjectLocator objectLocator;
+          objectLocator.locator = objectDescriptor.descriptorUUID;
+          cache.insert(objectDescriptor.descriptorUUID, objectLocator);
+          }
+        }
+      }
+    }
+  if (!cache.isCached(data))
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with isCached() method" << std::endl;
+    return EXIT_FAILURE;
+    }
+  cache.remove(existing.descriptorUUID);
+  if (cache.isCached(data))
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with isCached() method"
+              << " - removed descriptor" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
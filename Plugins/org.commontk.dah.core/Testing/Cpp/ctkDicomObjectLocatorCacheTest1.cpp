@@ -24,6 +24,7 @@
 
 // CTK includes
 #include <ctkDicomObjectLocatorCache.h>
+#include <ctkDicomSharedMemoryData.h>
 
 // STD includes
 #include <cstdlib>
@@ -212,5 +213,68 @@ int ctkDicomObjectLocatorCacheTest1(int argc, char* argv[])
     return EXIT_FAILURE;
     }
 
+  //----------------------------------------------------------------------------
+  // Data published in shared memory
+
+  QString sharedObjectUuid = QUuid::createUuid();
+  QByteArray sharedBytes(1024 * 1024, 'x');
+  ctkDicomAppHosting::ObjectLocator sharedObjectLocator;
+  sharedObjectLocator.transferSyntax = "1.2.840.10008.1.2.1";
+  if (!cache.insertSharedData(sharedObjectUuid, sharedBytes, sharedObjectLocator))
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with insertSharedData() method" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  ctkDicomAppHosting::ObjectLocator sharedObjectLocatorFound;
+  if (!cache.find(sharedObjectUuid, sharedObjectLocatorFound)
+      || sharedObjectLocatorFound != sharedObjectLocator
+      || !ctkDicomSharedMemoryData::isSharedMemoryLocator(sharedObjectLocator)
+      || sharedObjectLocator.length != sharedBytes.size()
+      || sharedObjectLocator.transferSyntax != "1.2.840.10008.1.2.1")
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with insertSharedData() method" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  {
+    ctkDicomSharedMemoryData sharedData(sharedObjectLocator);
+    if (!sharedData.isValid() || sharedData.toByteArray() != sharedBytes)
+      {
+      std::cerr << "Line " << __LINE__ << " - Problem with ctkDicomSharedMemoryData" << std::endl;
+      return EXIT_FAILURE;
+      }
+  }
+
+  // Reference count is two: the segment survives the first release
+  cache.insertSharedData(sharedObjectUuid, sharedBytes, sharedObjectLocator);
+  QList<QUuid> sharedObjectUUIDs;
+  sharedObjectUUIDs << QUuid(sharedObjectUuid);
+  cache.releaseData(sharedObjectUUIDs);
+  {
+    ctkDicomSharedMemoryData sharedData(sharedObjectLocator);
+    if (!sharedData.isValid())
+      {
+      std::cerr << "Line " << __LINE__ << " - Problem with releaseData() method" << std::endl;
+      return EXIT_FAILURE;
+      }
+  }
+
+  cache.releaseData(sharedObjectUUIDs);
+  if (cache.find(sharedObjectUuid, sharedObjectLocatorFound))
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with releaseData() method" << std::endl;
+    return EXIT_FAILURE;
+    }
+  {
+    ctkDicomSharedMemoryData sharedData(sharedObjectLocator);
+    if (sharedData.isValid())
+      {
+      std::cerr << "Line " << __LINE__ << " - Problem with releaseData() method"
+                << " - shared memory not released" << std::endl;
+      return EXIT_FAILURE;
+      }
+  }
+
   return EXIT_SUCCESS;
 }
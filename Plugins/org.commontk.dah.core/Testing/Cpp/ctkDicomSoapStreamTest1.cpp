@@ -0,0 +1,279 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+// Qt includes
+#include <QTime>
+#include <QUuid>
+#include <QXmlStreamReader>
+
+// CTK includes
+#include <ctkDicomAppHostingTypesHelper.h>
+#include <ctkDicomExchangeInterface.h>
+#include <ctkDicomSoapStream.h>
+#include <ctkExchangeSoapMessageProcessor.h>
+
+// STD includes
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+//----------------------------------------------------------------------------
+struct ctkDicomSoapStreamTestExchange : public ctkDicomExchangeInterface
+{
+  ctkDicomSoapStreamTestExchange() : LastData(false) {}
+
+  virtual bool notifyDataAvailable(const ctkDicomAppHosting::AvailableData& data, bool lastData)
+  {
+    this->Data = data;
+    this->LastData = lastData;
+    return true;
+  }
+
+  virtual QList<ctkDicomAppHosting::ObjectLocator> getData(
+    const QList<QUuid>& objectUUIDs,
+    const QList<QString>& acceptableTransferSyntaxUIDs,
+    bool includeBulkData)
+  {
+    Q_UNUSED(includeBulkData);
+    QList<ctkDicomAppHosting::ObjectLocator> locators;
+    foreach(const QUuid& uuid, objectUUIDs)
+      {
+      ctkDicomAppHosting::ObjectLocator locator;
+      locator.locator = uuid;
+      locator.source = uuid;
+      locator.length = 1024;
+      locator.offset = 0;
+      locator.transferSyntax = acceptableTransferSyntaxUIDs.value(0);
+      locator.URI = "file:///data/" + uuid.toString() + ".dcm";
+      locators << locator;
+      }
+    return locators;
+  }
+
+  virtual void releaseData(const QList<QUuid>& objectUUIDs)
+  {
+    this->Released = objectUUIDs;
+  }
+
+  ctkDicomAppHosting::AvailableData Data;
+  bool LastData;
+  QList<QUuid> Released;
+};
+
+//----------------------------------------------------------------------------
+ctkDicomAppHosting::AvailableData createAvailableData(int seriesCount, int instanceCount)
+{
+  ctkDicomAppHosting::Patient patient;
+  patient.name = "Doe^John";
+  patient.id = "PID-1";
+  patient.assigningAuthority = "CTK";
+  patient.sex = "M";
+  patient.birthDate = "19700101";
+
+  ctkDicomAppHosting::Study study;
+  study.studyUID = "1.2.3.4";
+  for (int s = 0; s < seriesCount; ++s)
+    {
+    ctkDicomAppHosting::Series series;
+    series.seriesUID = QString("1.2.3.4.%1").arg(s);
+    for (int i = 0; i < instanceCount; ++i)
+      {
+      ctkDicomAppHosting::ObjectDescriptor objectDescriptor;
+      objectDescriptor.descriptorUUID = QUuid::createUuid().toString();
+      objectDescriptor.mimeType = "application/dicom";
+      objectDescriptor.classUID = "1.2.840.10008.5.1.4.1.1.2";
+      objectDescriptor.transferSyntaxUID = "1.2.840.10008.1.2.1";
+      objectDescriptor.modality = "CT";
+      series.objectDescriptors << objectDescriptor;
+      }
+    study.series << series;
+    }
+  patient.studies << study;
+
+  ctkDicomAppHosting::AvailableData data;
+  data.patients << patient;
+  return data;
+}
+}
+
+//----------------------------------------------------------------------------
+int ctkDicomSoapStreamTest1(int argc, char* argv[])
+{
+  Q_UNUSED(argc);
+  Q_UNUSED(argv);
+
+  // 10k instances
+  const int seriesCount = 20;
+  const int instanceCount = 500;
+  const ctkDicomAppHosting::AvailableData data = createAvailableData(seriesCount, instanceCount);
+
+  ctkDicomSoapStreamTestExchange exchange;
+  ctkExchangeSoapMessageProcessor processor(&exchange);
+
+  //----------------------------------------------------------------------------
+  // NotifyDataAvailable request, as sent by ctkDicomExchangeService
+  QtSoapMessage request;
+  request.setMethod(QtSoapQName("NotifyDataAvailable", "http://dicom.nema.org/PS3.19/ApplicationService-20100825"));
+  request.addMethodArgument(new ctkDicomSoapAvailableData("data", data));
+  request.addMethodArgument(new ctkDicomSoapBool("lastData", true));
+  const QByteArray requestContent = request.toXmlString().toUtf8();
+
+  QTime time;
+  time.start();
+  QtSoapMessage domMessage;
+  QtSoapMessage domReply;
+  if (!domMessage.setContent(requestContent) || !processor.process(domMessage, &domReply))
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with process() method" << std::endl;
+    return EXIT_FAILURE;
+    }
+  int domElapsed = time.elapsed();
+  exchange.Data = ctkDicomAppHosting::AvailableData();
+
+  time.restart();
+  QByteArray streamedReply;
+  if (!processor.processStream(requestContent, &streamedReply))
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with processStream() method" << std::endl;
+    return EXIT_FAILURE;
+    }
+  int streamElapsed = time.elapsed();
+
+  std::cout << "NotifyDataAvailable with " << seriesCount * instanceCount << " instances ("
+            << requestContent.size() / 1024 << " KB): QtSoapMessage " << domElapsed
+            << " ms, streaming " << streamElapsed << " ms" << std::endl;
+
+  if (exchange.Data != data || !exchange.LastData)
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with processStream() method"
+              << " - received data differs from the sent data" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  QtSoapMessage reply;
+  if (!reply.setContent(streamedReply) || reply.isFault() ||
+      !ctkDicomSoapBool::getBool(reply.returnValue()))
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with processStream() method"
+              << " - invalid NotifyDataAvailable reply" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  //----------------------------------------------------------------------------
+  // Streamed serialization round trip
+  QByteArray content;
+  {
+    QXmlStreamWriter writer(&content);
+    ctkDicomSoapStreamWriter::writeStartEnvelope(writer, "NotifyDataAvailable", QString());
+    ctkDicomSoapStreamWriter::writeAvailableData(writer, "data", data);
+    ctkDicomSoapStreamWriter::writeEndEnvelope(writer);
+  }
+  QXmlStreamReader reader(content);
+  QString methodName;
+  if (!ctkDicomSoapStreamReader::readMethod(reader, methodName) ||
+      methodName != "NotifyDataAvailable" ||
+      !reader.readNextStartElement() ||
+      ctkDicomSoapStreamReader::readAvailableData(reader) != data)
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with readAvailableData()/writeAvailableData() methods" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  //----------------------------------------------------------------------------
+  // GetData request and reply
+  QList<QUuid> uuids;
+  foreach(const ctkDicomAppHosting::Series& series, data.patients[0].studies[0].series)
+    {
+    foreach(const ctkDicomAppHosting::ObjectDescriptor& objectDescriptor, series.objectDescriptors)
+      {
+      uuids << QUuid(objectDescriptor.descriptorUUID);
+      }
+    }
+  QtSoapMessage getDataRequest;
+  getDataRequest.setMethod(QtSoapQName("GetData", "http://dicom.nema.org/PS3.19/ApplicationService-20100825"));
+  getDataRequest.addMethodArgument(new ctkDicomSoapArrayOfUUIDS("objects", uuids));
+  getDataRequest.addMethodArgument(new ctkDicomSoapArrayOfStringType("UID", "acceptableTransferSyntaxes",
+                                                                     QStringList("1.2.840.10008.1.2.1")));
+  getDataRequest.addMethodArgument(new ctkDicomSoapBool("includeBulkData", false));
+
+  time.restart();
+  if (!processor.processStream(getDataRequest.toXmlString().toUtf8(), &streamedReply))
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with processStream() method" << std::endl;
+    return EXIT_FAILURE;
+    }
+  std::cout << "GetData of " << uuids.count() << " objects: streaming " << time.elapsed() << " ms" << std::endl;
+
+  QXmlStreamReader replyReader(streamedReply);
+  if (!ctkDicomSoapStreamReader::readMethod(replyReader, methodName) ||
+      methodName != "GetDataResponse" ||
+      !replyReader.readNextStartElement())
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with processStream() method"
+              << " - invalid GetData reply" << std::endl;
+    return EXIT_FAILURE;
+    }
+  QList<ctkDicomAppHosting::ObjectLocator> locators =
+    ctkDicomSoapStreamReader::readArrayOfObjectLocators(replyReader);
+  if (locators != exchange.getData(uuids, QStringList("1.2.840.10008.1.2.1"), false))
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with processStream() method"
+              << " - unexpected object locators" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  QtSoapMessage getDataReply;
+  if (!getDataReply.setContent(streamedReply) ||
+      ctkDicomSoapArrayOfObjectLocators::getArray(getDataReply.returnValue()).count() != uuids.count())
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with processStream() method"
+              << " - GetData reply not readable by QtSoapMessage" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  //----------------------------------------------------------------------------
+  // ReleaseData
+  QtSoapMessage releaseDataRequest;
+  releaseDataRequest.setMethod(QtSoapQName("ReleaseData", "http://dicom.nema.org/PS3.19/ApplicationService-20100825"));
+  releaseDataRequest.addMethodArgument(new ctkDicomSoapArrayOfUUIDS("objects", uuids.mid(0, 10)));
+  if (!processor.processStream(releaseDataRequest.toXmlString().toUtf8(), &streamedReply) ||
+      exchange.Released != uuids.mid(0, 10))
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with processStream() method"
+              << " - ReleaseData" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  //----------------------------------------------------------------------------
+  // Other methods are left to process()
+  QtSoapMessage otherRequest;
+  otherRequest.setMethod(QtSoapQName("GetState"));
+  if (processor.processStream(otherRequest.toXmlString().toUtf8(), &streamedReply) ||
+      processor.processStream("not xml", &streamedReply))
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with processStream() method"
+              << " - unknown method" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,112 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+// Qt includes
+#include <QCoreApplication>
+#include <QHostAddress>
+#include <QTime>
+
+// CTK includes
+#include <ctkSimpleSoapClient.h>
+#include <ctkSimpleSoapServer.h>
+#include <ctkSoapMessageProcessor.h>
+#include <ctkSoapReply.h>
+
+// STD includes
+#include <cstdlib>
+#include <iostream>
+
+//----------------------------------------------------------------------------
+class ctkSimpleSoapClientTestProcessor : public ctkSoapMessageProcessor
+{
+public:
+
+  virtual bool process(const QtSoapMessage& message, QtSoapMessage* reply) const
+  {
+    reply->setMethod(QtSoapQName(message.method().name().name() + "Response",
+                                 message.method().name().uri()));
+    reply->addMethodArgument("return", "", message.method()["value"].value().toInt());
+    return true;
+  }
+};
+
+//----------------------------------------------------------------------------
+int ctkSimpleSoapClientTest1(int argc, char* argv[])
+{
+  QCoreApplication app(argc, argv);
+
+  ctkSimpleSoapClientTestProcessor processor;
+  ctkSimpleSoapServer server;
+  server.setThreadSafeProcessor(&processor);
+  if (!server.listen(QHostAddress::LocalHost))
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with listen() method" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  ctkSimpleSoapClient client(server.serverPort(), "/Test");
+
+  //----------------------------------------------------------------------------
+  // All the requests are outstanding before the first response is read
+  const int requestCount = 200;
+  QTime time;
+  time.start();
+
+  QList<ctkSoapReply*> replies;
+  for (int i = 0; i < requestCount; ++i)
+    {
+    QList<QtSoapType*> list;
+    list << new QtSoapSimpleType(QtSoapQName("value"), i);
+    replies << client.submitSoapRequestAsync("Echo", list);
+    }
+
+  for (int i = 0; i < requestCount; ++i)
+    {
+    ctkSoapReply* reply = replies[i];
+    if (!reply->waitForFinished(10000))
+      {
+      std::cerr << "Line " << __LINE__ << " - Problem with waitForFinished() method" << std::endl;
+      return EXIT_FAILURE;
+      }
+    if (reply->methodName() != "Echo" || reply->response().isFault() ||
+        reply->returnValue().value().toInt() != i)
+      {
+      std::cerr << "Line " << __LINE__ << " - Problem with the reply of request " << i << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+  qDeleteAll(replies);
+
+  std::cout << requestCount << " asynchronous requests in " << time.elapsed() << " ms" << std::endl;
+
+  //----------------------------------------------------------------------------
+  // A request to a port nobody listens to finishes with a fault
+  ctkSimpleSoapClient unreachableClient(1, "/Test");
+  ctkSoapReply* reply = unreachableClient.submitSoapRequestAsync("Echo", QList<QtSoapType*>());
+  if (!reply->waitForFinished(10000) || !reply->response().isFault())
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with the reply of an unreachable service" << std::endl;
+    return EXIT_FAILURE;
+    }
+  delete reply;
+
+  return EXIT_SUCCESS;
+}
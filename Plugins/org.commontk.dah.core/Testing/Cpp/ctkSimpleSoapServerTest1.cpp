@@ -0,0 +1,248 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+// Qt includes
+#include <QCoreApplication>
+#include <QHostAddress>
+#include <QTcpSocket>
+#include <QTime>
+
+// CTK includes
+#include <ctkSimpleSoapServer.h>
+#include <ctkSoapMessageProcessor.h>
+
+// STD includes
+#include <cstdlib>
+#include <iostream>
+
+//----------------------------------------------------------------------------
+class ctkSimpleSoapServerTestProcessor : public ctkSoapMessageProcessor
+{
+public:
+
+  virtual bool process(const QtSoapMessage& message, QtSoapMessage* reply) const
+  {
+    reply->setMethod(QtSoapQName(message.method().name().name() + "Response",
+                                 message.method().name().uri()));
+    reply->addMethodArgument("return", "", message.method()["value"].value().toInt());
+    return true;
+  }
+};
+
+//----------------------------------------------------------------------------
+class ctkSimpleSoapServerTestReceiver : public QObject
+{
+  Q_OBJECT
+
+public:
+
+  ctkSimpleSoapServerTestProcessor Processor;
+
+public Q_SLOTS:
+
+  void incomingSoapMessage(const QtSoapMessage& message, QtSoapMessage* reply)
+  {
+    this->Processor.process(message, reply);
+  }
+
+  void incomingWSDLMessage(const QString& message, QString* reply)
+  {
+    *reply = "<wsdl request=\"" + message + "\"/>";
+  }
+};
+
+//----------------------------------------------------------------------------
+struct ctkSimpleSoapServerTestClient
+{
+  QTcpSocket Socket;
+  QByteArray Buffer;
+  QList<QByteArray> Replies;
+  bool Error;
+
+  ctkSimpleSoapServerTestClient() : Error(false) {}
+
+  // Move the complete HTTP replies of the buffer into Replies
+  void readReplies()
+  {
+    this->Buffer.append(this->Socket.readAll());
+    forever
+      {
+      int headerEnd = this->Buffer.indexOf("\r\n\r\n");
+      if (headerEnd < 0)
+        {
+        return;
+        }
+      QByteArray header = this->Buffer.left(headerEnd);
+      if (!header.startsWith("HTTP/1.1 200"))
+        {
+        this->Error = true;
+        }
+      int contentLength = 0;
+      foreach(QByteArray line, header.split('\n'))
+        {
+        if (line.toLower().startsWith("content-length:"))
+          {
+          contentLength = line.mid(15).trimmed().toInt();
+          }
+        }
+      if (this->Buffer.size() < headerEnd + 4 + contentLength)
+        {
+        return;
+        }
+      this->Replies.push_back(this->Buffer.mid(headerEnd + 4, contentLength));
+      this->Buffer.remove(0, headerEnd + 4 + contentLength);
+      }
+  }
+};
+
+//----------------------------------------------------------------------------
+static QByteArray soapRequest(int value)
+{
+  QtSoapMessage request;
+  request.setMethod(QtSoapQName("echo", "http://dicom.nema.org/PS3.19/Test"));
+  request.addMethodArgument("value", "", value);
+  QByteArray body = request.toXmlString().toUtf8();
+
+  QByteArray block;
+  block.append("POST /Test HTTP/1.1\r\n");
+  block.append("Host: 127.0.0.1\r\n");
+  block.append("Content-Type: text/xml;charset=utf-8\r\n");
+  block.append("SOAPAction: \"http://dicom.nema.org/PS3.19/Test/echo\"\r\n");
+  block.append("Content-Length: ").append(QByteArray::number(body.size())).append("\r\n");
+  block.append("\r\n");
+  block.append(body);
+  return block;
+}
+
+//----------------------------------------------------------------------------
+// Send requestCount pipelined requests on each of the clientCount keep-alive
+// connections and check that every request gets its reply, in order.
+static bool runLoad(ctkSimpleSoapServer& server, int clientCount, int requestCount, const char* mode)
+{
+  QList<ctkSimpleSoapServerTestClient*> clients;
+  QTime time;
+  time.start();
+
+  for (int i = 0; i < clientCount; ++i)
+    {
+    ctkSimpleSoapServerTestClient* client = new ctkSimpleSoapServerTestClient();
+    client->Socket.connectToHost(QHostAddress::LocalHost, server.serverPort());
+    for (int j = 0; j < requestCount; ++j)
+      {
+      client->Socket.write(soapRequest(j));
+      }
+    clients.push_back(client);
+    }
+
+  bool done = false;
+  while (!done && time.elapsed() < 30000)
+    {
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+    done = true;
+    foreach(ctkSimpleSoapServerTestClient* client, clients)
+      {
+      client->readReplies();
+      done = done && client->Replies.size() >= requestCount;
+      }
+    }
+  int elapsed = time.elapsed();
+
+  bool result = done;
+  foreach(ctkSimpleSoapServerTestClient* client, clients)
+    {
+    result = result && !client->Error;
+    for (int j = 0; result && j < client->Replies.size(); ++j)
+      {
+      QtSoapMessage reply;
+      result = reply.setContent(client->Replies[j]) && !reply.isFault() &&
+               reply.returnValue().value().toInt() == j;
+      }
+    }
+  qDeleteAll(clients);
+
+  std::cout << mode << ": " << clientCount * requestCount << " requests over "
+            << clientCount << " connections in " << elapsed << " ms" << std::endl;
+  return result;
+}
+
+//----------------------------------------------------------------------------
+int ctkSimpleSoapServerTest1(int argc, char* argv[])
+{
+  QCoreApplication app(argc, argv);
+
+  ctkSimpleSoapServerTestReceiver receiver;
+  ctkSimpleSoapServer server;
+  QObject::connect(&server, SIGNAL(incomingSoapMessage(QtSoapMessage,QtSoapMessage*)),
+                   &receiver, SLOT(incomingSoapMessage(QtSoapMessage,QtSoapMessage*)));
+  QObject::connect(&server, SIGNAL(incomingWSDLMessage(QString,QString*)),
+                   &receiver, SLOT(incomingWSDLMessage(QString,QString*)));
+
+  if (!server.listen(QHostAddress::LocalHost))
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with listen() method" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  //----------------------------------------------------------------------------
+  // A request asking to close the connection
+  ctkSimpleSoapServerTestClient wsdlClient;
+  wsdlClient.Socket.connectToHost(QHostAddress::LocalHost, server.serverPort());
+  wsdlClient.Socket.write("GET /Test?wsdl HTTP/1.1\r\nHost: 127.0.0.1\r\nConnection: close\r\n\r\n");
+  QTime time;
+  time.start();
+  while (wsdlClient.Socket.state() != QAbstractSocket::UnconnectedState && time.elapsed() < 10000)
+    {
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+    wsdlClient.readReplies();
+    }
+  if (wsdlClient.Socket.state() != QAbstractSocket::UnconnectedState ||
+      wsdlClient.Replies.size() != 1 || wsdlClient.Replies[0] != "<wsdl request=\"?wsdl\"/>")
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with the wsdl request" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  //----------------------------------------------------------------------------
+  if (!runLoad(server, 10, 100, "Signal dispatch"))
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with the signal dispatch" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  //----------------------------------------------------------------------------
+  ctkSimpleSoapServerTestProcessor processor;
+  server.setThreadSafeProcessor(&processor);
+  if (server.threadSafeProcessor() != &processor)
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with setThreadSafeProcessor() method" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  if (!runLoad(server, 10, 100, "Worker dispatch"))
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with the worker dispatch" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
+
+#include "moc_ctkSimpleSoapServerTest1.cpp"
@@ -19,9 +19,17 @@
 
 =============================================================================*/
 
+// Qt includes
+#include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QPair>
+#include <QSet>
+#include <QUuid>
+
 // CTK includes
 #include "ctkDicomAvailableDataHelper.h"
-#include "ctkDicomAvailableDataHelper.h"
 #include "ctkDicomObjectLocatorCache.h"
 #include <ctkDICOMDataset.h>
 
@@ -30,6 +38,16 @@
 
 namespace ctkDicomAvailableDataHelper {
 
+//------------------------------------------------------------------------------
+struct ctkDicomSeriesPosition
+{
+  ctkDicomSeriesPosition(int patient = -1, int study = -1, int series = -1)
+    : Patient(patient), Study(study), Series(series) {}
+  int Patient;
+  int Study;
+  int Series;
+};
+
 //------------------------------------------------------------------------------
 class ctkDicomAvailableDataAccessorPrivate
 {
@@ -40,69 +58,287 @@ public:
   ctkDicomAvailableDataAccessorPrivate(ctkDicomAppHosting::AvailableData& availableData) : 
       m_AvailableData(availableData) { };
 
+  /// Index the whole tree, called once at construction
+  void buildIndex();
+
+  /// Returns false if one of the descriptors was already indexed
+  bool indexObjectDescriptors(const ctkDicomAppHosting::ArrayOfObjectDescriptors& objectDescriptors);
+
+  /// Locate (patient, study, series) in the tree, -1 for the missing levels
+  ctkDicomSeriesPosition findPosition(const QString& patientId,
+                                      const QString& studyUID,
+                                      const QString& seriesUID) const;
+
+  /// Locate or append (without children) the patient, study and series
+  int findOrAddPatient(const ctkDicomAppHosting::Patient& patient);
+  int findOrAddStudy(int patientIndex, const ctkDicomAppHosting::Study& study);
+  int findOrAddSeries(int patientIndex, int studyIndex, const ctkDicomAppHosting::Series& series);
+
+  /// Append \a objectDescriptor to \a target unless its UUID is already indexed
+  bool addObjectDescriptor(ctkDicomAppHosting::ArrayOfObjectDescriptors& target,
+                           const ctkDicomAppHosting::ObjectDescriptor& objectDescriptor);
+
   ctkDicomAppHosting::AvailableData& m_AvailableData;
+
+  // Positions are stored as indexes in the lists, which stay valid
+  // since items are only ever appended through the accessor.
+  QHash<QString, int> m_PatientIndex;
+  QHash<QString, QPair<int, int> > m_StudyIndex;
+  QHash<QString, ctkDicomSeriesPosition> m_SeriesIndex;
+  QSet<QString> m_ObjectDescriptorIndex;
 };
 
+//----------------------------------------------------------------------------
+void ctkDicomAvailableDataAccessorPrivate::buildIndex()
+{
+  ctkDicomAppHosting::AvailableData& ad(m_AvailableData);
+  this->indexObjectDescriptors(ad.objectDescriptors);
+  for (int p = 0; p < ad.patients.count(); ++p)
+    {
+    const ctkDicomAppHosting::Patient& patient = ad.patients.at(p);
+    // keep the first occurrence, as the former linear searches did
+    if (!m_PatientIndex.contains(patient.id))
+      {
+      m_PatientIndex.insert(patient.id, p);
+      }
+    this->indexObjectDescriptors(patient.objectDescriptors);
+    for (int s = 0; s < patient.studies.count(); ++s)
+      {
+      const ctkDicomAppHosting::Study& study = patient.studies.at(s);
+      if (!m_StudyIndex.contains(study.studyUID))
+        {
+        m_StudyIndex.insert(study.studyUID, qMakePair(p, s));
+        }
+      this->indexObjectDescriptors(study.objectDescriptors);
+      for (int se = 0; se < study.series.count(); ++se)
+        {
+        const ctkDicomAppHosting::Series& series = study.series.at(se);
+        if (!m_SeriesIndex.contains(series.seriesUID))
+          {
+          m_SeriesIndex.insert(series.seriesUID, ctkDicomSeriesPosition(p, s, se));
+          }
+        this->indexObjectDescriptors(series.objectDescriptors);
+        }
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+bool ctkDicomAvailableDataAccessorPrivate::indexObjectDescriptors(
+  const ctkDicomAppHosting::ArrayOfObjectDescriptors& objectDescriptors)
+{
+  bool unique = true;
+  foreach(const ctkDicomAppHosting::ObjectDescriptor& objectDescriptor, objectDescriptors)
+    {
+    if (m_ObjectDescriptorIndex.contains(objectDescriptor.descriptorUUID))
+      {
+      unique = false;
+      continue;
+      }
+    m_ObjectDescriptorIndex.insert(objectDescriptor.descriptorUUID);
+    }
+  return unique;
+}
+
+//----------------------------------------------------------------------------
+ctkDicomSeriesPosition ctkDicomAvailableDataAccessorPrivate::findPosition(
+  const QString& patientId, const QString& studyUID, const QString& seriesUID) const
+{
+  ctkDicomSeriesPosition position;
+  position.Patient = m_PatientIndex.value(patientId, -1);
+  if (position.Patient < 0)
+    {
+    return position;
+    }
+  const ctkDicomAppHosting::Patient& patient = m_AvailableData.patients.at(position.Patient);
+
+  QHash<QString, QPair<int, int> >::const_iterator studyIt = m_StudyIndex.constFind(studyUID);
+  if (studyIt != m_StudyIndex.constEnd() && studyIt.value().first == position.Patient)
+    {
+    position.Study = studyIt.value().second;
+    }
+  else
+    {
+    // The same study UID may be listed under another patient id,
+    // only the first occurrence is indexed.
+    for (int s = 0; s < patient.studies.count(); ++s)
+      {
+      if (patient.studies.at(s).studyUID == studyUID)
+        {
+        position.Study = s;
+        break;
+        }
+      }
+    if (position.Study < 0)
+      {
+      return position;
+      }
+    }
+  if (seriesUID.isNull())
+    {
+    // only the patient and study were requested
+    return position;
+    }
+  const ctkDicomAppHosting::Study& study = patient.studies.at(position.Study);
+
+  QHash<QString, ctkDicomSeriesPosition>::const_iterator seriesIt = m_SeriesIndex.constFind(seriesUID);
+  if (seriesIt != m_SeriesIndex.constEnd() &&
+      seriesIt.value().Patient == position.Patient &&
+      seriesIt.value().Study == position.Study)
+    {
+    position.Series = seriesIt.value().Series;
+    }
+  else
+    {
+    for (int se = 0; se < study.series.count(); ++se)
+      {
+      if (study.series.at(se).seriesUID == seriesUID)
+        {
+        position.Series = se;
+        break;
+        }
+      }
+    }
+  return position;
+}
+
+//----------------------------------------------------------------------------
+int ctkDicomAvailableDataAccessorPrivate::findOrAddPatient(const ctkDicomAppHosting::Patient& patient)
+{
+  int patientIndex = m_PatientIndex.value(patient.id, -1);
+  if (patientIndex >= 0)
+    {
+    return patientIndex;
+    }
+  ctkDicomAppHosting::Patient newPatient(patient);
+  newPatient.objectDescriptors.clear();
+  newPatient.studies.clear();
+  patientIndex = m_AvailableData.patients.count();
+  m_AvailableData.patients.append(newPatient);
+  m_PatientIndex.insert(patient.id, patientIndex);
+  return patientIndex;
+}
+
+//----------------------------------------------------------------------------
+int ctkDicomAvailableDataAccessorPrivate::findOrAddStudy(int patientIndex,
+                                                         const ctkDicomAppHosting::Study& study)
+{
+  ctkDicomSeriesPosition position = this->findPosition(
+    m_AvailableData.patients.at(patientIndex).id, study.studyUID, QString());
+  if (position.Study >= 0)
+    {
+    return position.Study;
+    }
+  ctkDicomAppHosting::Study newStudy(study);
+  newStudy.objectDescriptors.clear();
+  newStudy.series.clear();
+  QList<ctkDicomAppHosting::Study>& studies = m_AvailableData.patients[patientIndex].studies;
+  int studyIndex = studies.count();
+  studies.append(newStudy);
+  if (!m_StudyIndex.contains(study.studyUID))
+    {
+    m_StudyIndex.insert(study.studyUID, qMakePair(patientIndex, studyIndex));
+    }
+  return studyIndex;
+}
+
+//----------------------------------------------------------------------------
+int ctkDicomAvailableDataAccessorPrivate::findOrAddSeries(int patientIndex, int studyIndex,
+                                                          const ctkDicomAppHosting::Series& series)
+{
+  const ctkDicomAppHosting::Patient& patient = m_AvailableData.patients.at(patientIndex);
+  ctkDicomSeriesPosition position = this->findPosition(
+    patient.id, patient.studies.at(studyIndex).studyUID, series.seriesUID);
+  if (position.Series >= 0)
+    {
+    return position.Series;
+    }
+  ctkDicomAppHosting::Series newSeries(series);
+  newSeries.objectDescriptors.clear();
+  QList<ctkDicomAppHosting::Series>& seriesList =
+    m_AvailableData.patients[patientIndex].studies[studyIndex].series;
+  int seriesIndex = seriesList.count();
+  seriesList.append(newSeries);
+  if (!m_SeriesIndex.contains(series.seriesUID))
+    {
+    m_SeriesIndex.insert(series.seriesUID, ctkDicomSeriesPosition(patientIndex, studyIndex, seriesIndex));
+    }
+  return seriesIndex;
+}
+
+//----------------------------------------------------------------------------
+bool ctkDicomAvailableDataAccessorPrivate::addObjectDescriptor(
+  ctkDicomAppHosting::ArrayOfObjectDescriptors& target,
+  const ctkDicomAppHosting::ObjectDescriptor& objectDescriptor)
+{
+  if (m_ObjectDescriptorIndex.contains(objectDescriptor.descriptorUUID))
+    {
+    return false;
+    }
+  m_ObjectDescriptorIndex.insert(objectDescriptor.descriptorUUID);
+  target.append(objectDescriptor);
+  return true;
+}
+
 //----------------------------------------------------------------------------
 ctkDicomAvailableDataAccessor::ctkDicomAvailableDataAccessor(ctkDicomAppHosting::AvailableData& ad)
   : d_ptr(new ctkDicomAvailableDataAccessorPrivate(ad))
 {
+  Q_D(ctkDicomAvailableDataAccessor);
+  d->buildIndex();
 }
 
 ctkDicomAvailableDataAccessor::~ctkDicomAvailableDataAccessor() {};
 
+//----------------------------------------------------------------------------
+ctkDicomAppHosting::AvailableData& ctkDicomAvailableDataAccessor::availableData() const
+{
+  const Q_D(ctkDicomAvailableDataAccessor);
+  return d->m_AvailableData;
+}
+
 //----------------------------------------------------------------------------
 ctkDicomAppHosting::Patient* ctkDicomAvailableDataAccessor::getPatient(const ctkDicomAppHosting::Patient& patient) const
 {
   const Q_D(ctkDicomAvailableDataAccessor);
-  ctkDicomAppHosting::AvailableData & ad(d->m_AvailableData);
-  for (QList<ctkDicomAppHosting::Patient>::Iterator pit = ad.patients.begin();
-    pit < ad.patients.end(); pit++)
+  int patientIndex = d->m_PatientIndex.value(patient.id, -1);
+  if (patientIndex < 0)
     {
-      if(pit->id==patient.id)
-        return &(*pit);
+    return NULL;
     }
-  return NULL;
+  return &d->m_AvailableData.patients[patientIndex];
 }
 
 //----------------------------------------------------------------------------
 ctkDicomAppHosting::Study* ctkDicomAvailableDataAccessor::getStudy(const QString& studyUID) const
 {
   const Q_D(ctkDicomAvailableDataAccessor);
-  ctkDicomAppHosting::AvailableData & ad(d->m_AvailableData);
-  for (QList<ctkDicomAppHosting::Patient>::Iterator pit = ad.patients.begin();
-    pit < ad.patients.end(); pit++)
+  QHash<QString, QPair<int, int> >::const_iterator it = d->m_StudyIndex.constFind(studyUID);
+  if (it == d->m_StudyIndex.constEnd())
     {
-    for (QList<ctkDicomAppHosting::Study>::Iterator sit = pit->studies.begin();
-      sit < pit->studies.end(); sit++)
-      {
-          if(sit->studyUID==studyUID)
-            return &(*sit);
-      }
+    return NULL;
     }
-  return NULL;
+  return &d->m_AvailableData.patients[it.value().first].studies[it.value().second];
 }
 
 //----------------------------------------------------------------------------
 ctkDicomAppHosting::Series* ctkDicomAvailableDataAccessor::getSeries(const QString& seriesUID) const
 {
   const Q_D(ctkDicomAvailableDataAccessor);
-  ctkDicomAppHosting::AvailableData & ad(d->m_AvailableData);
-  for (QList<ctkDicomAppHosting::Patient>::Iterator pit = ad.patients.begin();
-    pit < ad.patients.end(); pit++)
+  QHash<QString, ctkDicomSeriesPosition>::const_iterator it = d->m_SeriesIndex.constFind(seriesUID);
+  if (it == d->m_SeriesIndex.constEnd())
     {
-    for (QList<ctkDicomAppHosting::Study>::Iterator sit = pit->studies.begin();
-      sit < pit->studies.end(); sit++)
-      {
-      for (QList<ctkDicomAppHosting::Series>::Iterator seit = sit->series.begin();
-        seit < sit->series.end(); seit++)
-        {
-          if(seit->seriesUID==seriesUID)
-            return &(*seit);
-        }
-      }
+    return NULL;
     }
-  return NULL;
+  const ctkDicomSeriesPosition& position = it.value();
+  return &d->m_AvailableData.patients[position.Patient].studies[position.Study].series[position.Series];
+}
+
+//----------------------------------------------------------------------------
+bool ctkDicomAvailableDataAccessor::containsObjectDescriptor(const QString& descriptorUUID) const
+{
+  const Q_D(ctkDicomAvailableDataAccessor);
+  return d->m_ObjectDescriptorIndex.contains(descriptorUUID);
 }
 
 //----------------------------------------------------------------------------
@@ -118,37 +354,93 @@ void ctkDicomAvailableDataAccessor::find(const ctkDicomAppHosting::Patient& pati
   patientResult=NULL;
   studyResult=NULL;
   seriesResult=NULL;
-  for (QList<ctkDicomAppHosting::Patient>::Iterator pit = ad.patients.begin();
-    pit < ad.patients.end(); pit++)
+  ctkDicomSeriesPosition position = d->findPosition(patient.id, studyUID, seriesUID);
+  if (position.Patient < 0)
+    {
+    return;
+    }
+  patientResult = &ad.patients[position.Patient];
+  if (position.Study < 0)
     {
-    if(pit->id==patient.id)
+    return;
+    }
+  studyResult = &patientResult->studies[position.Study];
+  if (position.Series < 0)
+    {
+    return;
+    }
+  seriesResult = &studyResult->series[position.Series];
+}
+
+//----------------------------------------------------------------------------
+bool ctkDicomAvailableDataAccessor::addObjectDescriptor(const ctkDicomAppHosting::ObjectDescriptor& objectDescriptor)
+{
+  Q_D(ctkDicomAvailableDataAccessor);
+  return d->addObjectDescriptor(d->m_AvailableData.objectDescriptors, objectDescriptor);
+}
+
+//----------------------------------------------------------------------------
+bool ctkDicomAvailableDataAccessor::addObjectDescriptor(const ctkDicomAppHosting::Patient& patient,
+                                                        const QString& studyUID,
+                                                        const QString& seriesUID,
+                                                        const ctkDicomAppHosting::ObjectDescriptor& objectDescriptor)
+{
+  Q_D(ctkDicomAvailableDataAccessor);
+  if (d->m_ObjectDescriptorIndex.contains(objectDescriptor.descriptorUUID))
+    {
+    return false;
+    }
+  ctkDicomAppHosting::Study study;
+  study.studyUID = studyUID;
+  ctkDicomAppHosting::Series series;
+  series.seriesUID = seriesUID;
+
+  int p = d->findOrAddPatient(patient);
+  int s = d->findOrAddStudy(p, study);
+  int se = d->findOrAddSeries(p, s, series);
+  return d->addObjectDescriptor(
+    d->m_AvailableData.patients[p].studies[s].series[se].objectDescriptors, objectDescriptor);
+}
+
+//----------------------------------------------------------------------------
+void ctkDicomAvailableDataAccessor::merge(const ctkDicomAppHosting::AvailableData& data)
+{
+  Q_D(ctkDicomAvailableDataAccessor);
+  ctkDicomAppHosting::AvailableData & ad(d->m_AvailableData);
+  foreach(const ctkDicomAppHosting::ObjectDescriptor& objectDescriptor, data.objectDescriptors)
+    {
+    d->addObjectDescriptor(ad.objectDescriptors, objectDescriptor);
+    }
+  foreach(const ctkDicomAppHosting::Patient& patient, data.patients)
+    {
+    int p = d->findOrAddPatient(patient);
+    foreach(const ctkDicomAppHosting::ObjectDescriptor& objectDescriptor, patient.objectDescriptors)
       {
-      patientResult = &(*pit);
-      for (QList<ctkDicomAppHosting::Study>::Iterator sit = pit->studies.begin();
-        sit < pit->studies.end(); sit++)
+      d->addObjectDescriptor(ad.patients[p].objectDescriptors, objectDescriptor);
+      }
+    foreach(const ctkDicomAppHosting::Study& study, patient.studies)
+      {
+      int s = d->findOrAddStudy(p, study);
+      foreach(const ctkDicomAppHosting::ObjectDescriptor& objectDescriptor, study.objectDescriptors)
+        {
+        d->addObjectDescriptor(ad.patients[p].studies[s].objectDescriptors, objectDescriptor);
+        }
+      foreach(const ctkDicomAppHosting::Series& series, study.series)
         {
-        if(sit->studyUID==studyUID)
+        int se = d->findOrAddSeries(p, s, series);
+        ctkDicomAppHosting::ArrayOfObjectDescriptors& target =
+          ad.patients[p].studies[s].series[se].objectDescriptors;
+        foreach(const ctkDicomAppHosting::ObjectDescriptor& objectDescriptor, series.objectDescriptors)
           {
-          studyResult = &(*sit);
-          for (QList<ctkDicomAppHosting::Series>::Iterator seit = sit->series.begin();
-            seit < sit->series.end(); seit++)
-            {
-            if(seit->seriesUID==seriesUID)
-              {
-              seriesResult=&(*seit);
-              return;
-              }
-            }
-            return;
+          d->addObjectDescriptor(target, objectDescriptor);
           }
         }
-      return;
       }
     }
 }
 
 //----------------------------------------------------------------------------
-bool addNonDICOMToAvailableData(ctkDicomAppHosting::AvailableData& data, 
+bool addNonDICOMToAvailableData(ctkDicomAvailableDataAccessor& accessor, 
                         ctkDicomObjectLocatorCache* objectLocatorCache, 
                         long length, 
                         long offset, 
@@ -185,11 +477,7 @@ bool addNonDICOMToAvailableData(ctkDicomAppHosting::AvailableData& data,
   else
 	   objectDescriptor.mimeType = "text/plain"; //default
 
-  ctkDicomAppHosting::Patient* ppatient;
-  ctkDicomAppHosting::Study* pstudy;
-  ctkDicomAppHosting::Series* pseries;
-
-  data.objectDescriptors.append(objectDescriptor);
+  accessor.addObjectDescriptor(objectDescriptor);
 
   ctkDicomAppHosting::ObjectLocator locator;
   locator.locator = objectDescriptor.descriptorUUID;
@@ -204,16 +492,10 @@ bool addNonDICOMToAvailableData(ctkDicomAppHosting::AvailableData& data,
 }
 
 
-bool addToAvailableData(ctkDicomAppHosting::AvailableData& data, 
-                        ctkDicomObjectLocatorCache* objectLocatorCache, 
-                        const ctkDICOMDataset& dataset, 
-                        long length, 
-                        long offset, 
-                        const QString& uri)
+//----------------------------------------------------------------------------
+static ctkDicomAppHosting::ObjectDescriptor addDICOMObjectDescriptor(ctkDicomAvailableDataAccessor& accessor,
+                                                                     const ctkDICOMDataset& dataset)
 {
-  if(objectLocatorCache == NULL)
-    return false;
-  
   ctkDicomAppHosting::ObjectDescriptor objectDescriptor;
   ctkDicomAppHosting::Study study;
   ctkDicomAppHosting::Series series;
@@ -238,38 +520,22 @@ bool addToAvailableData(ctkDicomAppHosting::AvailableData& data,
   
 
 
-  ctkDicomAppHosting::Patient* ppatient;
-  ctkDicomAppHosting::Study* pstudy;
-  ctkDicomAppHosting::Series* pseries;
-  
-  ctkDicomAvailableDataAccessor(data).find(patient, study.studyUID, series.seriesUID,
-    ppatient, pstudy, pseries);
+  accessor.addObjectDescriptor(patient, study.studyUID, series.seriesUID, objectDescriptor);
+  return objectDescriptor;
+}
 
-  if(pseries==NULL)
-  {
-    series.objectDescriptors.append(objectDescriptor);
-    if(pstudy==NULL)
-    {
-      study.series.append(series);
-      if(ppatient==NULL)
-      {
-        patient.studies.append(study);
-        data.patients.append(patient);
-      }
-      else
-      {
-        ppatient->studies.append(study);
-      }
-    }
-    else
-    {
-      pstudy->series.append(series);
-    }
-  }
-  else
-  {
-    pseries->objectDescriptors.append(objectDescriptor);
-  }
+//----------------------------------------------------------------------------
+bool addToAvailableData(ctkDicomAvailableDataAccessor& accessor,
+                        ctkDicomObjectLocatorCache* objectLocatorCache, 
+                        const ctkDICOMDataset& dataset, 
+                        long length, 
+                        long offset, 
+                        const QString& uri)
+{
+  if(objectLocatorCache == NULL)
+    return false;
+  
+  ctkDicomAppHosting::ObjectDescriptor objectDescriptor = addDICOMObjectDescriptor(accessor, dataset);
 
   ctkDicomAppHosting::ObjectLocator locator;
   locator.locator = objectDescriptor.descriptorUUID;
@@ -284,7 +550,7 @@ bool addToAvailableData(ctkDicomAppHosting::AvailableData& data,
 }
 
 //----------------------------------------------------------------------------
-bool addToAvailableData(ctkDicomAppHosting::AvailableData& data,
+bool addToAvailableData(ctkDicomAvailableDataAccessor& accessor,
                         ctkDicomObjectLocatorCache* objectLocatorCache, 
                         const QString& filename)
 {
@@ -300,13 +566,85 @@ bool addToAvailableData(ctkDicomAppHosting::AvailableData& data,
   if ( (ext.compare("txt") == 0) || (ext.compare("xml") ==0) || (ext.compare("jpg") ==0) || (ext.compare("bmp") ==0) || (ext.compare("csv") ==0)|| (ext.compare("nii") ==0))
   {
   	  qDebug() << "adding Non DICOM File";
-      return addNonDICOMToAvailableData(data, objectLocatorCache, fileinfo.size(), 0, uri);
+      return addNonDICOMToAvailableData(accessor, objectLocatorCache, fileinfo.size(), 0, uri);
   }
   //this could be a DICOM file then
   ctkDICOMDataset ctkdataset;
   ctkdataset.InitializeFromFile(filename, EXS_Unknown, EGL_noChange, 400);
 
-  return addToAvailableData(data, objectLocatorCache, ctkdataset, fileinfo.size(), 0, uri);
+  return addToAvailableData(accessor, objectLocatorCache, ctkdataset, fileinfo.size(), 0, uri);
+
+}
+
+//----------------------------------------------------------------------------
+bool addToAvailableDataInSharedMemory(ctkDicomAvailableDataAccessor& accessor,
+                        ctkDicomObjectLocatorCache* objectLocatorCache,
+                        const QString& filename)
+{
+  if(objectLocatorCache == NULL)
+    return false;
+
+  QFile file(filename);
+  if (!file.open(QIODevice::ReadOnly))
+    {
+    qWarning() << "addToAvailableDataInSharedMemory - Failed to open" << filename;
+    return false;
+    }
+  QByteArray data = file.readAll();
+  file.close();
+
+  ctkDICOMDataset ctkdataset;
+  ctkdataset.InitializeFromFile(filename, EXS_Unknown, EGL_noChange, 400);
+
+  ctkDicomAppHosting::ObjectDescriptor objectDescriptor = addDICOMObjectDescriptor(accessor, ctkdataset);
+
+  ctkDicomAppHosting::ObjectLocator locator;
+  locator.transferSyntax = objectDescriptor.transferSyntaxUID;
+  if (objectLocatorCache->insertSharedData(objectDescriptor.descriptorUUID, data, locator))
+    {
+    return true;
+    }
+
+  // The segment could not be created, publish the file instead
+  QString uri("file:///");
+  uri.append(QFileInfo(filename).absoluteFilePath());
+  locator.locator = objectDescriptor.descriptorUUID;
+  locator.source = objectDescriptor.descriptorUUID;
+  locator.offset = 0;
+  locator.length = data.size();
+  locator.URI = uri;
+  objectLocatorCache->insert(objectDescriptor.descriptorUUID, locator);
+  return true;
+}
 
+//----------------------------------------------------------------------------
+bool addToAvailableData(ctkDicomAppHosting::AvailableData& data, 
+                        ctkDicomObjectLocatorCache* objectLocatorCache, 
+                        const ctkDICOMDataset& dataset, 
+                        long length, 
+                        long offset, 
+                        const QString& uri)
+{
+  ctkDicomAvailableDataAccessor accessor(data);
+  return addToAvailableData(accessor, objectLocatorCache, dataset, length, offset, uri);
+}
+
+//----------------------------------------------------------------------------
+bool addToAvailableData(ctkDicomAppHosting::AvailableData& data,
+                        ctkDicomObjectLocatorCache* objectLocatorCache, 
+                        const QString& filename)
+{
+  ctkDicomAvailableDataAccessor accessor(data);
+  return addToAvailableData(accessor, objectLocatorCache, filename);
 }
+
+//----------------------------------------------------------------------------
+bool addToAvailableDataInSharedMemory(ctkDicomAppHosting::AvailableData& data,
+                        ctkDicomObjectLocatorCache* objectLocatorCache,
+                        const QString& filename)
+{
+  ctkDicomAvailableDataAccessor accessor(data);
+  return addToAvailableDataInSharedMemory(accessor, objectLocatorCache, filename);
+}
+
 }
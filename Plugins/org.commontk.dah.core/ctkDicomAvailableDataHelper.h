@@ -38,18 +38,39 @@ namespace ctkDicomAvailableDataHelper {
 
 //----------------------------------------------------------------------------
 class ctkDicomAvailableDataAccessorPrivate;
+
+/**
+  * Indexed access to an AvailableData tree.
+  *
+  * Patients (by id), studies (by study UID), series (by series UID) and
+  * object descriptors (by UUID) are hashed when the accessor is created,
+  * and the indexes are kept up to date by addObjectDescriptor() and merge().
+  * Building an AvailableData with thousands of instances, or accumulating
+  * the data of repeated notifyDataAvailable() calls, is therefore linear
+  * as long as a single accessor is used for all the modifications.
+  *
+  * The indexes are not updated if the AvailableData is modified directly,
+  * create a new accessor in this case.
+  */
 class org_commontk_dah_core_EXPORT ctkDicomAvailableDataAccessor : public QObject
 {
 public:
   ctkDicomAvailableDataAccessor(ctkDicomAppHosting::AvailableData& ad);
   virtual ~ctkDicomAvailableDataAccessor();
 
+  ctkDicomAppHosting::AvailableData& availableData() const;
+
   ctkDicomAppHosting::Patient* getPatient(const ctkDicomAppHosting::Patient& patient) const;
 
   ctkDicomAppHosting::Study* getStudy(const QString& studyUID) const;
 
   ctkDicomAppHosting::Series* getSeries(const QString& seriesUID) const;
 
+  /**
+    * Returns true if a descriptor with this UUID is found at any level of the tree.
+    */
+  bool containsObjectDescriptor(const QString& descriptorUUID) const;
+
   void find(const ctkDicomAppHosting::Patient& patient, 
                                          const QString& studyUID, 
                                          const QString& seriesUID,
@@ -57,6 +78,29 @@ public:
                                          ctkDicomAppHosting::Study*& studyResult, 
                                          ctkDicomAppHosting::Series*& seriesResult) const;
 
+  /**
+    * Adds a top level (non patient related) object descriptor.
+    * Returns false if a descriptor with the same UUID is already available.
+    */
+  bool addObjectDescriptor(const ctkDicomAppHosting::ObjectDescriptor& objectDescriptor);
+
+  /**
+    * Adds an object descriptor to the series \a seriesUID of the study \a studyUID
+    * of \a patient. The patient, study and series are created if needed.
+    * Returns false if a descriptor with the same UUID is already available.
+    */
+  bool addObjectDescriptor(const ctkDicomAppHosting::Patient& patient,
+                           const QString& studyUID,
+                           const QString& seriesUID,
+                           const ctkDicomAppHosting::ObjectDescriptor& objectDescriptor);
+
+  /**
+    * Merges \a data into the accessed AvailableData: patients, studies and
+    * series are matched by id/UID and descriptors already available (same UUID)
+    * are skipped. The cost is linear in the size of \a data.
+    */
+  void merge(const ctkDicomAppHosting::AvailableData& data);
+
 protected:
   QScopedPointer<ctkDicomAvailableDataAccessorPrivate> d_ptr;
 
@@ -77,6 +121,39 @@ bool org_commontk_dah_core_EXPORT addToAvailableData(ctkDicomAppHosting::Availab
                         ctkDicomObjectLocatorCache* objectLocatorCache, 
                         const QString& filename);
 
+//----------------------------------------------------------------------------
+/**
+  * Same as above, but the data is added through \a accessor, whose indexes
+  * are reused from one call to the next. Prefer these overloads to add many files.
+  */
+bool org_commontk_dah_core_EXPORT addToAvailableData(ctkDicomAvailableDataAccessor& accessor,
+                        ctkDicomObjectLocatorCache* objectLocatorCache,
+                        const ctkDICOMDataset& dataset,
+                        long length,
+                        long offset,
+                        const QString& uri);
+
+//----------------------------------------------------------------------------
+bool org_commontk_dah_core_EXPORT addToAvailableData(ctkDicomAvailableDataAccessor& accessor,
+                        ctkDicomObjectLocatorCache* objectLocatorCache,
+                        const QString& filename);
+
+//----------------------------------------------------------------------------
+/**
+  * Same as addToAvailableData() for a DICOM file, but the content of the file is
+  * published in shared memory (see ctkDicomObjectLocatorCache::insertSharedData())
+  * so that a peer running on the same machine reads it without touching the disk.
+  * The file itself is published if the segment cannot be created.
+  */
+bool org_commontk_dah_core_EXPORT addToAvailableDataInSharedMemory(ctkDicomAppHosting::AvailableData& data,
+                        ctkDicomObjectLocatorCache* objectLocatorCache,
+                        const QString& filename);
+
+//----------------------------------------------------------------------------
+bool org_commontk_dah_core_EXPORT addToAvailableDataInSharedMemory(ctkDicomAvailableDataAccessor& accessor,
+                        ctkDicomObjectLocatorCache* objectLocatorCache,
+                        const QString& filename);
+
 }
 
 //----------------------------------------------------------------------------
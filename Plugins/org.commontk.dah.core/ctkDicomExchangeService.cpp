@@ -22,8 +22,13 @@
 #include "ctkDicomExchangeService.h"
 
 #include "ctkSimpleSoapClient.h"
+#include "ctkSoapReply.h"
 
 #include "ctkDicomAppHostingTypesHelper.h"
+#include "ctkDicomSharedMemoryData.h"
+
+// Maximum number of object UUIDs asked in a single GetData request
+static const int GetDataBatchSize = 500;
 
 //----------------------------------------------------------------------------
 ctkDicomExchangeService::ctkDicomExchangeService(ushort port, QString path)
@@ -54,31 +59,75 @@ QList<ctkDicomAppHosting::ObjectLocator> ctkDicomExchangeService::getData(
     const QList<QUuid>& objectUUIDs,
     const QList<QString>& acceptableTransferSyntaxUIDs, bool includeBulkData)
 {
-  //Q_D(ctkDicomService);
-  QList<QtSoapType*> list;
-
-  list << new ctkDicomSoapArrayOfUUIDS("objects",objectUUIDs);
-  list << new ctkDicomSoapArrayOfStringType("UID","acceptableTransferSyntaxes", acceptableTransferSyntaxUIDs);
-  list << new ctkDicomSoapBool("includeBulkData", includeBulkData);
-  const QtSoapType & result = submitSoapRequest("GetData",list);
-//QtSoapType *tt;
-//  list << (tt=new ctkDicomSoapArrayOfUUIDS("uuids",objectUUIDs));
-extern void DumpAll(const QtSoapType& type, int indent=0);
-//DumpAll(*tt);
-//  list << (tt=new ctkDicomSoapBool("includeBulkData", includeBulkData));
-//DumpAll(*tt);
-//  const QtSoapType & result = submitSoapRequest("getDataAsFile",list);
-DumpAll(result); //xxx
-
-  return ctkDicomSoapArrayOfObjectLocators::getArray(result);
+  // Large requests are split in batches which are all submitted before
+  // waiting for the first response, so that they travel pipelined.
+  QList<ctkSoapReply*> replies;
+  int i = 0;
+  do
+    {
+    QList<QtSoapType*> list;
+    list << new ctkDicomSoapArrayOfUUIDS("objects", objectUUIDs.mid(i, GetDataBatchSize));
+    list << new ctkDicomSoapArrayOfStringType("UID","acceptableTransferSyntaxes", acceptableTransferSyntaxUIDs);
+    list << new ctkDicomSoapBool("includeBulkData", includeBulkData);
+    replies << submitSoapRequestAsync("GetData", list);
+    i += GetDataBatchSize;
+    }
+  while (i < objectUUIDs.size());
+
+  QList<ctkDicomAppHosting::ObjectLocator> objectLocators;
+  foreach(ctkSoapReply* reply, replies)
+    {
+    reply->waitForFinished();
+    if (reply->response().isFault())
+      {
+      qCritical() << "ctkDicomExchangeService: server error in GetData:"
+                  << reply->response().faultString().toString();
+      }
+    objectLocators << ctkDicomSoapArrayOfObjectLocators::getArray(reply->returnValue());
+    delete reply;
+    }
+
+  QMutexLocker lock(&this->SharedMemoryDataMutex);
+  foreach(const ctkDicomAppHosting::ObjectLocator& objectLocator, objectLocators)
+    {
+    if (!ctkDicomSharedMemoryData::isSharedMemoryLocator(objectLocator) ||
+        this->SharedMemoryData.contains(objectLocator.locator))
+      {
+      continue;
+      }
+    QSharedPointer<ctkDicomSharedMemoryData> data(new ctkDicomSharedMemoryData(objectLocator));
+    if (!data->isValid())
+      {
+      qWarning() << "ctkDicomExchangeService: failed to resolve" << objectLocator.URI;
+      continue;
+      }
+    this->SharedMemoryData.insert(objectLocator.locator, data);
+    }
+  return objectLocators;
 }
 
 //----------------------------------------------------------------------------
 void ctkDicomExchangeService::releaseData(const QList<QUuid>& objectUUIDs)
 {
+  {
+  QMutexLocker lock(&this->SharedMemoryDataMutex);
+  foreach(const QUuid& uuid, objectUUIDs)
+    {
+    this->SharedMemoryData.remove(uuid.toString());
+    }
+  }
+
   QList<QtSoapType*> list;
 
   list << new ctkDicomSoapArrayOfUUIDS("objects",objectUUIDs);
    submitSoapRequest("ReleaseData",list);
   return;
 }
+
+//----------------------------------------------------------------------------
+QSharedPointer<ctkDicomSharedMemoryData> ctkDicomExchangeService::getSharedMemoryData(
+    const QUuid& objectUUID) const
+{
+  QMutexLocker lock(&this->SharedMemoryDataMutex);
+  return this->SharedMemoryData.value(objectUUID.toString());
+}
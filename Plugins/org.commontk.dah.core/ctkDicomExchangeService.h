@@ -26,8 +26,14 @@
 #include "ctkSimpleSoapClient.h"
 #include "ctkDicomExchangeInterface.h"
 
+#include <QHash>
+#include <QMutex>
+#include <QSharedPointer>
+
 #include <org_commontk_dah_core_Export.h>
 
+class ctkDicomSharedMemoryData;
+
 class org_commontk_dah_core_EXPORT ctkDicomExchangeService :
     public ctkSimpleSoapClient, public ctkDicomExchangeInterface
 {
@@ -39,6 +45,11 @@ public:
 
   bool notifyDataAvailable(const ctkDicomAppHosting::AvailableData& data, bool lastData);
 
+  /**
+   * Locators using the "shm:" scheme are resolved: their segment is attached
+   * here and stays attached until releaseData() is called for the object, so
+   * the data remains valid even if the peer releases its segment.
+   */
   QList<ctkDicomAppHosting::ObjectLocator> getData(
     const QList<QUuid>& objectUUIDs,
     const QList<QString>& acceptableTransferSyntaxUIDs,
@@ -46,6 +57,17 @@ public:
 
   void releaseData(const QList<QUuid>& objectUUIDs);
 
+  /**
+   * Shared memory data of an object located by getData(), null if the object
+   * was not published in shared memory or was released.
+   */
+  QSharedPointer<ctkDicomSharedMemoryData> getSharedMemoryData(const QUuid& objectUUID) const;
+
+private:
+
+  mutable QMutex SharedMemoryDataMutex;
+  QHash<QString, QSharedPointer<ctkDicomSharedMemoryData> > SharedMemoryData;
+
 };
 
 #endif // CTKDICOMEXCHANGESERVICE_H
@@ -22,11 +22,17 @@
 #include <QHash>
 #include <QUuid>
 #include <QSet>
+#include <QSharedMemory>
+#include <QSharedPointer>
 #include <QDebug>
 
 // CTK includes
 #include "ctkDicomAppHostingTypes.h"
 #include "ctkDicomObjectLocatorCache.h"
+#include "ctkDicomSharedMemoryData.h"
+
+// STD includes
+#include <cstring>
 
 namespace
 {
@@ -35,6 +41,9 @@ struct ObjectLocatorCacheItem
   ObjectLocatorCacheItem():RefCount(1){}
   ctkDicomAppHosting::ObjectLocator ObjectLocator;
   int RefCount;
+  // Segment holding the data, if published in shared memory.
+  // Detached (and destroyed if nobody else is attached) with the last copy of the item.
+  QSharedPointer<QSharedMemory> SharedMemory;
 };
 }
 
@@ -45,6 +54,11 @@ public:
 
   bool find(const QString& objectUuid, ObjectLocatorCacheItem& objectLocatorCacheItem)const;
 
+  /// Returns false if one of the descriptors isn't cached, sets \a hasDescriptors
+  /// to true if the list isn't empty.
+  bool contains(const ctkDicomAppHosting::ArrayOfObjectDescriptors& objectDescriptors,
+                bool& hasDescriptors)const;
+
   QHash<QString, ObjectLocatorCacheItem> ObjectLocatorMap;
   QSet<QString> TemporaryObjectLocatorSet;
 };
@@ -61,11 +75,27 @@ ctkDicomObjectLocatorCachePrivate::ctkDicomObjectLocatorCachePrivate()
 bool ctkDicomObjectLocatorCachePrivate::find(const QString& objectUuid,
                                              ObjectLocatorCacheItem& objectLocatorCacheItem)const
 {
-  if (!this->ObjectLocatorMap.contains(objectUuid))
+  QHash<QString, ObjectLocatorCacheItem>::const_iterator it = this->ObjectLocatorMap.constFind(objectUuid);
+  if (it == this->ObjectLocatorMap.constEnd())
     {
     return false;
     }
-  objectLocatorCacheItem = this->ObjectLocatorMap[objectUuid];
+  objectLocatorCacheItem = it.value();
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool ctkDicomObjectLocatorCachePrivate::contains(
+  const ctkDicomAppHosting::ArrayOfObjectDescriptors& objectDescriptors, bool& hasDescriptors)const
+{
+  foreach(const ctkDicomAppHosting::ObjectDescriptor& objectDescriptor, objectDescriptors)
+    {
+    hasDescriptors = true;
+    if (!this->ObjectLocatorMap.contains(objectDescriptor.descriptorUUID))
+      {
+      return false;
+      }
+    }
   return true;
 }
 
@@ -87,51 +117,29 @@ bool ctkDicomObjectLocatorCache::isCached(const ctkDicomAppHosting::AvailableDat
 {
   Q_D(const ctkDicomObjectLocatorCache);
   bool hasCachedData = false;
-  QList<QString> uuids = d->ObjectLocatorMap.keys();
-  // Loop over top level object descriptors
-  foreach(const ctkDicomAppHosting::ObjectDescriptor& objectDescriptor, availableData.objectDescriptors)
+  // Each descriptor is a single hash lookup: checking the data published
+  // by publishData() is linear in the number of descriptors.
+  if (!d->contains(availableData.objectDescriptors, hasCachedData))
     {
-    if (!hasCachedData) { hasCachedData = true; }
-    if (!uuids.contains(objectDescriptor.descriptorUUID))
-      {
-      return false;
-      }
+    return false;
     }
-  // Loop over patients
   foreach(const ctkDicomAppHosting::Patient& patient, availableData.patients)
     {
-    // Loop over patient level object descriptors
-    foreach(const ctkDicomAppHosting::ObjectDescriptor& objectDescriptor, patient.objectDescriptors)
+    if (!d->contains(patient.objectDescriptors, hasCachedData))
       {
-      hasCachedData = true;
-      if (!uuids.contains(objectDescriptor.descriptorUUID))
-        {
-        return false;
-        }
+      return false;
       }
-    // Loop over studies
     foreach(const ctkDicomAppHosting::Study& study, patient.studies)
-    {
-      // Loop over study level object descriptors
-      foreach(const ctkDicomAppHosting::ObjectDescriptor& objectDescriptor, study.objectDescriptors)
       {
-          if (!hasCachedData) { hasCachedData = true; }
-          if (!uuids.contains(objectDescriptor.descriptorUUID))
-          {
-          return false;
-          }
-      }
-      // Loop over series
+      if (!d->contains(study.objectDescriptors, hasCachedData))
+        {
+        return false;
+        }
       foreach(const ctkDicomAppHosting::Series& series, study.series)
-      {
-        // Loop over series level object descriptors
-        foreach(const ctkDicomAppHosting::ObjectDescriptor& objectDescriptor, series.objectDescriptors)
         {
-            if (!hasCachedData) { hasCachedData = true; }
-            if (!uuids.contains(objectDescriptor.descriptorUUID))
-            {
-            return false;
-            }
+        if (!d->contains(series.objectDescriptors, hasCachedData))
+          {
+          return false;
           }
         }
       }
@@ -145,13 +153,12 @@ bool ctkDicomObjectLocatorCache::find(const QString& objectUuid,
 {
   Q_D(const ctkDicomObjectLocatorCache);
 
-  ObjectLocatorCacheItem item;
-  bool found = d->find(objectUuid, item);
-  if (!found)
+  QHash<QString, ObjectLocatorCacheItem>::const_iterator it = d->ObjectLocatorMap.constFind(objectUuid);
+  if (it == d->ObjectLocatorMap.constEnd())
     {
     return false;
     }
-  objectLocator = item.ObjectLocator;
+  objectLocator = it.value().ObjectLocator;
   return true;
 }
 
@@ -161,15 +168,14 @@ void ctkDicomObjectLocatorCache::insert(const QString& objectUuid,
                                         bool temporary)
 {
   Q_D(ctkDicomObjectLocatorCache);
-  ObjectLocatorCacheItem item;
-  d->find(objectUuid, item);
-  if(d->ObjectLocatorMap.contains(objectUuid))
+  QHash<QString, ObjectLocatorCacheItem>::iterator it = d->ObjectLocatorMap.find(objectUuid);
+  if (it != d->ObjectLocatorMap.end())
     {
-    Q_ASSERT(objectLocator == item.ObjectLocator); // ObjectLocator are expected to match
-    item.RefCount++;
-    d->ObjectLocatorMap.insert(objectUuid, item);
+    Q_ASSERT(objectLocator == it.value().ObjectLocator); // ObjectLocator are expected to match
+    it.value().RefCount++;
     return;
     }
+  ObjectLocatorCacheItem item;
   item.ObjectLocator = objectLocator;
   d->ObjectLocatorMap.insert(objectUuid, item);
 
@@ -180,19 +186,59 @@ void ctkDicomObjectLocatorCache::insert(const QString& objectUuid,
 }
 
 //----------------------------------------------------------------------------
-bool ctkDicomObjectLocatorCache::remove(const QString& objectUuid)
+bool ctkDicomObjectLocatorCache::insertSharedData(const QString& objectUuid, const QByteArray& data,
+                                                  ctkDicomAppHosting::ObjectLocator& objectLocator,
+                                                  bool temporary)
 {
   Q_D(ctkDicomObjectLocatorCache);
   ObjectLocatorCacheItem item;
-  bool found = d->find(objectUuid, item);
-  if (!found)
+  if (d->find(objectUuid, item))
+    {
+    objectLocator = item.ObjectLocator;
+    this->insert(objectUuid, objectLocator, temporary);
+    return true;
+    }
+
+  QSharedPointer<QSharedMemory> memory(new QSharedMemory(ctkDicomSharedMemoryData::key(objectUuid)));
+  if (!memory->create(qMax(1, data.size())))
     {
+    qWarning() << "ctkDicomObjectLocatorCache::insertSharedData - Failed to create the segment for"
+               << objectUuid << ":" << memory->errorString();
     return false;
     }
-  Q_ASSERT(item.RefCount > 0);
-  item.RefCount--;
+  memory->lock();
+  memcpy(memory->data(), data.constData(), data.size());
+  memory->unlock();
+
+  objectLocator.locator = objectUuid;
+  objectLocator.source = objectUuid;
+  objectLocator.offset = 0;
+  objectLocator.length = data.size();
+  objectLocator.URI = ctkDicomSharedMemoryData::uri(memory->key());
+
+  item.ObjectLocator = objectLocator;
+  item.SharedMemory = memory;
   d->ObjectLocatorMap.insert(objectUuid, item);
-  if (item.RefCount == 0)
+
+  if (temporary)
+    {
+    d->TemporaryObjectLocatorSet.insert(objectUuid);
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool ctkDicomObjectLocatorCache::remove(const QString& objectUuid)
+{
+  Q_D(ctkDicomObjectLocatorCache);
+  QHash<QString, ObjectLocatorCacheItem>::iterator it = d->ObjectLocatorMap.find(objectUuid);
+  if (it == d->ObjectLocatorMap.end())
+    {
+    return false;
+    }
+  Q_ASSERT(it.value().RefCount > 0);
+  it.value().RefCount--;
+  if (it.value().RefCount == 0)
     {
     if (d->TemporaryObjectLocatorSet.contains(objectUuid))
       {
@@ -202,12 +248,20 @@ bool ctkDicomObjectLocatorCache::remove(const QString& objectUuid)
       bool removed = d->TemporaryObjectLocatorSet.remove(objectUuid);
       Q_ASSERT(removed);
       }
-    int removed = d->ObjectLocatorMap.remove(objectUuid);
-    Q_ASSERT(removed == 1);
+    d->ObjectLocatorMap.erase(it);
     }
   return true;
 }
 
+//----------------------------------------------------------------------------
+void ctkDicomObjectLocatorCache::releaseData(const QList<QUuid>& objectUUIDs)
+{
+  foreach(const QUuid& uuid, objectUUIDs)
+    {
+    this->remove(uuid);
+    }
+}
+
 //----------------------------------------------------------------------------
 QList<ctkDicomAppHosting::ObjectLocator> ctkDicomObjectLocatorCache::getData(const QList<QUuid>& objectUUIDs)
 {
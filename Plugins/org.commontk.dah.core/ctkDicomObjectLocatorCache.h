@@ -49,8 +49,27 @@ public:
   void insert(
     const QString& objectUuid, const ctkDicomAppHosting::ObjectLocator& objectLocator, bool temporary = false);
 
+  /**
+    * Copy <code>data</code> into a new shared memory segment and cache a locator
+    * referencing it (see ctkDicomSharedMemoryData). The segment is released when the
+    * reference count of the locator drops to zero in remove().
+    *
+    * On input, the transferSyntax of <code>objectLocator</code> is used; on output,
+    * the locator holds the inserted values. If the object is already cached, its
+    * reference count is incremented and its locator is returned.
+    *
+    * @return False if the segment could not be created.
+    */
+  bool insertSharedData(const QString& objectUuid, const QByteArray& data,
+                        ctkDicomAppHosting::ObjectLocator& objectLocator, bool temporary = false);
+
   bool remove(const QString& objectUuid);
 
+  /**
+    * Call remove() for each object, e.g. when the peer releases the data.
+    */
+  void releaseData(const QList<QUuid>& objectUUIDs);
+
   QList<ctkDicomAppHosting::ObjectLocator> getData(const QList<QUuid>& objectUUIDs);
 
 private:
@@ -0,0 +1,101 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+// Qt includes
+#include <QDebug>
+
+// CTK includes
+#include "ctkDicomSharedMemoryData.h"
+
+namespace
+{
+const char* const URIScheme = "shm:";
+}
+
+//----------------------------------------------------------------------------
+ctkDicomSharedMemoryData::ctkDicomSharedMemoryData(const ctkDicomAppHosting::ObjectLocator& objectLocator)
+  : Offset(objectLocator.offset), Length(objectLocator.length), Valid(false)
+{
+  if (!ctkDicomSharedMemoryData::isSharedMemoryLocator(objectLocator))
+    {
+    return;
+    }
+  this->Memory.setKey(objectLocator.URI.mid(QString(URIScheme).size()));
+  if (!this->Memory.attach(QSharedMemory::ReadOnly))
+    {
+    qWarning() << "ctkDicomSharedMemoryData - Failed to attach" << objectLocator.URI
+               << ":" << this->Memory.errorString();
+    return;
+    }
+  this->Valid = this->Offset >= 0 && this->Length >= 0 &&
+                this->Offset + this->Length <= this->Memory.size();
+}
+
+//----------------------------------------------------------------------------
+ctkDicomSharedMemoryData::~ctkDicomSharedMemoryData()
+{
+}
+
+//----------------------------------------------------------------------------
+bool ctkDicomSharedMemoryData::isSharedMemoryLocator(const ctkDicomAppHosting::ObjectLocator& objectLocator)
+{
+  return objectLocator.URI.startsWith(URIScheme);
+}
+
+//----------------------------------------------------------------------------
+QString ctkDicomSharedMemoryData::key(const QString& objectUuid)
+{
+  return "ctkDicomAppHosting/" + objectUuid;
+}
+
+//----------------------------------------------------------------------------
+QString ctkDicomSharedMemoryData::uri(const QString& key)
+{
+  return URIScheme + key;
+}
+
+//----------------------------------------------------------------------------
+bool ctkDicomSharedMemoryData::isValid() const
+{
+  return this->Valid;
+}
+
+//----------------------------------------------------------------------------
+const char* ctkDicomSharedMemoryData::data() const
+{
+  if (!this->Valid)
+    {
+    return 0;
+    }
+  return static_cast<const char*>(this->Memory.constData()) + this->Offset;
+}
+
+//----------------------------------------------------------------------------
+qint64 ctkDicomSharedMemoryData::size() const
+{
+  return this->Valid ? this->Length : 0;
+}
+
+//----------------------------------------------------------------------------
+QByteArray ctkDicomSharedMemoryData::toByteArray() const
+{
+  return QByteArray(this->data(), static_cast<int>(this->size()));
+}
@@ -0,0 +1,90 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#ifndef CTKDICOMSHAREDMEMORYDATA_H
+#define CTKDICOMSHAREDMEMORYDATA_H
+
+// Qt includes
+#include <QSharedMemory>
+
+// CTK includes
+#include "ctkDicomAppHostingTypes.h"
+#include <org_commontk_dah_core_Export.h>
+
+/**
+  * Read access to bulk data published in shared memory.
+  *
+  * A host (or an application) running on the same machine as its peer can
+  * publish the data of an object in a shared memory segment instead of a
+  * file, see ctkDicomObjectLocatorCache::insertSharedData(). The URI of the
+  * object locator then uses the "shm:" scheme followed by the key of the
+  * segment, and offset/length delimit the data inside the segment.
+  *
+  * The segment stays attached (and the data valid) as long as this object
+  * lives, even if the publisher releases it in the meantime.
+  */
+class org_commontk_dah_core_EXPORT ctkDicomSharedMemoryData
+{
+
+public:
+
+  explicit ctkDicomSharedMemoryData(const ctkDicomAppHosting::ObjectLocator& objectLocator);
+  ~ctkDicomSharedMemoryData();
+
+  /**
+    * True if the locator references data in shared memory.
+    */
+  static bool isSharedMemoryLocator(const ctkDicomAppHosting::ObjectLocator& objectLocator);
+
+  /**
+    * Key of the segment holding the data of the given object.
+    */
+  static QString key(const QString& objectUuid);
+
+  /**
+    * URI referencing the segment with the given key.
+    */
+  static QString uri(const QString& key);
+
+  /**
+    * True if the segment could be attached and contains the located data.
+    */
+  bool isValid() const;
+
+  const char* data() const;
+  qint64 size() const;
+
+  /**
+    * Copy of the located data.
+    */
+  QByteArray toByteArray() const;
+
+private:
+  QSharedMemory Memory;
+  qint64 Offset;
+  qint64 Length;
+  bool Valid;
+
+  Q_DISABLE_COPY(ctkDicomSharedMemoryData)
+};
+
+#endif // CTKDICOMSHAREDMEMORYDATA_H
@@ -0,0 +1,588 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+// Qt includes
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
+
+// CTK includes
+#include "ctkDicomSoapStream.h"
+
+namespace
+{
+const QString EnvelopeNamespace("http://schemas.xmlsoap.org/soap/envelope/");
+const QString EncodingNamespace("http://schemas.xmlsoap.org/soap/encoding/");
+const QString SchemaInstanceNamespace("http://www.w3.org/1999/XMLSchema-instance");
+const QString SchemaNamespace("http://www.w3.org/1999/XMLSchema");
+
+//----------------------------------------------------------------------------
+void writeSimpleType(QXmlStreamWriter& writer, const QString& name,
+                     const QString& type, const QString& value)
+{
+  writer.writeStartElement(name);
+  writer.writeAttribute(SchemaInstanceNamespace, "type", "xsd:" + type);
+  writer.writeCharacters(value);
+  writer.writeEndElement();
+}
+
+//----------------------------------------------------------------------------
+void writeStartArray(QXmlStreamWriter& writer, const QString& name,
+                     const QString& itemType, int count)
+{
+  writer.writeStartElement(name);
+  writer.writeAttribute(SchemaInstanceNamespace, "type", "SOAP-ENC:Array");
+  writer.writeAttribute(EncodingNamespace, "arrayType",
+                        QString("xsd:%1[%2]").arg(itemType).arg(count));
+}
+
+//----------------------------------------------------------------------------
+QString uuidString(const QUuid& uuid)
+{
+  // Same as ctkDicomSoapUUID: without the curly braces
+  QString uuidstring(uuid.toString());
+  uuidstring.remove(0,1).chop(1);
+  return uuidstring;
+}
+}
+
+//----------------------------------------------------------------------------
+// ctkDicomSoapStreamReader methods
+
+//----------------------------------------------------------------------------
+bool ctkDicomSoapStreamReader::readMethod(QXmlStreamReader& reader, QString& methodName)
+{
+  if (!reader.readNextStartElement() || reader.name() != "Envelope")
+    {
+    return false;
+    }
+  while (reader.readNextStartElement())
+    {
+    if (reader.name() != "Body")
+      {
+      // Header
+      reader.skipCurrentElement();
+      continue;
+      }
+    if (!reader.readNextStartElement())
+      {
+      return false;
+      }
+    methodName = reader.name().toString();
+    return true;
+    }
+  return false;
+}
+
+//----------------------------------------------------------------------------
+QString ctkDicomSoapStreamReader::readValue(QXmlStreamReader& reader)
+{
+  QString text;
+  QString value;
+  bool found = false;
+  int depth = 0;
+  while (!reader.atEnd())
+    {
+    QXmlStreamReader::TokenType token = reader.readNext();
+    if (token == QXmlStreamReader::StartElement)
+      {
+      ++depth;
+      text.clear();
+      }
+    else if (token == QXmlStreamReader::Characters)
+      {
+      if (!found)
+        {
+        text += reader.text();
+        }
+      }
+    else if (token == QXmlStreamReader::EndElement)
+      {
+      if (!found)
+        {
+        // end of the first leaf element (or of the current one if it is simple)
+        value = text;
+        found = true;
+        }
+      if (depth == 0)
+        {
+        break;
+        }
+      --depth;
+      }
+    }
+  return value;
+}
+
+//----------------------------------------------------------------------------
+QStringList ctkDicomSoapStreamReader::readLeafValues(QXmlStreamReader& reader)
+{
+  QStringList values;
+  QString text;
+  bool leaf = false;
+  int depth = 0;
+  while (!reader.atEnd())
+    {
+    QXmlStreamReader::TokenType token = reader.readNext();
+    if (token == QXmlStreamReader::StartElement)
+      {
+      ++depth;
+      text.clear();
+      leaf = true;
+      }
+    else if (token == QXmlStreamReader::Characters)
+      {
+      text += reader.text();
+      }
+    else if (token == QXmlStreamReader::EndElement)
+      {
+      if (depth == 0)
+        {
+        break;
+        }
+      if (leaf)
+        {
+        values << text;
+        }
+      // the parent has at least one child element
+      leaf = false;
+      --depth;
+      }
+    }
+  return values;
+}
+
+//----------------------------------------------------------------------------
+bool ctkDicomSoapStreamReader::readBool(QXmlStreamReader& reader)
+{
+  QString value = readValue(reader).trimmed();
+  return value == "true" || value == "1";
+}
+
+//----------------------------------------------------------------------------
+QString ctkDicomSoapStreamReader::readUuid(QXmlStreamReader& reader)
+{
+  // Same as ctkDicomSoapUUID::getUuid(): normalized through QUuid
+  return QUuid(readValue(reader)).toString();
+}
+
+//----------------------------------------------------------------------------
+QList<QUuid> ctkDicomSoapStreamReader::readArrayOfUUIDs(QXmlStreamReader& reader)
+{
+  QList<QUuid> list;
+  while (reader.readNextStartElement())
+    {
+    list << QUuid(readValue(reader));
+    }
+  return list;
+}
+
+//----------------------------------------------------------------------------
+ctkDicomAppHosting::ObjectDescriptor ctkDicomSoapStreamReader::readObjectDescriptor(QXmlStreamReader& reader)
+{
+  ctkDicomAppHosting::ObjectDescriptor od;
+  while (reader.readNextStartElement())
+    {
+    QStringRef name = reader.name();
+    if (name == "DescriptorUuid")
+      {
+      od.descriptorUUID = readUuid(reader);
+      }
+    else if (name == "MimeType")
+      {
+      od.mimeType = readValue(reader);
+      }
+    else if (name == "ClassUID")
+      {
+      od.classUID = readValue(reader);
+      }
+    else if (name == "TransferSyntaxUID")
+      {
+      od.transferSyntaxUID = readValue(reader);
+      }
+    else if (name == "Modality")
+      {
+      od.modality = readValue(reader);
+      }
+    else
+      {
+      reader.skipCurrentElement();
+      }
+    }
+  return od;
+}
+
+//----------------------------------------------------------------------------
+ctkDicomAppHosting::ArrayOfObjectDescriptors ctkDicomSoapStreamReader::readArrayOfObjectDescriptors(QXmlStreamReader& reader)
+{
+  ctkDicomAppHosting::ArrayOfObjectDescriptors list;
+  while (reader.readNextStartElement())
+    {
+    list.append(readObjectDescriptor(reader));
+    }
+  return list;
+}
+
+//----------------------------------------------------------------------------
+ctkDicomAppHosting::Series ctkDicomSoapStreamReader::readSeries(QXmlStreamReader& reader)
+{
+  ctkDicomAppHosting::Series s;
+  while (reader.readNextStartElement())
+    {
+    QStringRef name = reader.name();
+    if (name == "SeriesUID")
+      {
+      s.seriesUID = readValue(reader);
+      }
+    else if (name == "ObjectDescriptors")
+      {
+      s.objectDescriptors = readArrayOfObjectDescriptors(reader);
+      }
+    else
+      {
+      reader.skipCurrentElement();
+      }
+    }
+  return s;
+}
+
+//----------------------------------------------------------------------------
+ctkDicomAppHosting::Study ctkDicomSoapStreamReader::readStudy(QXmlStreamReader& reader)
+{
+  ctkDicomAppHosting::Study s;
+  while (reader.readNextStartElement())
+    {
+    QStringRef name = reader.name();
+    if (name == "StudyUID")
+      {
+      s.studyUID = readValue(reader);
+      }
+    else if (name == "ObjectDescriptors")
+      {
+      s.objectDescriptors = readArrayOfObjectDescriptors(reader);
+      }
+    else if (name == "Series")
+      {
+      while (reader.readNextStartElement())
+        {
+        s.series.append(readSeries(reader));
+        }
+      }
+    else
+      {
+      reader.skipCurrentElement();
+      }
+    }
+  return s;
+}
+
+//----------------------------------------------------------------------------
+ctkDicomAppHosting::Patient ctkDicomSoapStreamReader::readPatient(QXmlStreamReader& reader)
+{
+  ctkDicomAppHosting::Patient p;
+  while (reader.readNextStartElement())
+    {
+    QStringRef name = reader.name();
+    if (name == "Name")
+      {
+      p.name = readValue(reader);
+      }
+    else if (name == "ID")
+      {
+      p.id = readValue(reader);
+      }
+    else if (name == "AssigningAuthority")
+      {
+      p.assigningAuthority = readValue(reader);
+      }
+    else if (name == "Sex")
+      {
+      p.sex = readValue(reader);
+      }
+    else if (name == "DateOfBirth")
+      {
+      p.birthDate = readValue(reader);
+      }
+    else if (name == "ObjectDescriptors")
+      {
+      p.objectDescriptors = readArrayOfObjectDescriptors(reader);
+      }
+    else if (name == "Studies")
+      {
+      while (reader.readNextStartElement())
+        {
+        p.studies.append(readStudy(reader));
+        }
+      }
+    else
+      {
+      reader.skipCurrentElement();
+      }
+    }
+  return p;
+}
+
+//----------------------------------------------------------------------------
+ctkDicomAppHosting::AvailableData ctkDicomSoapStreamReader::readAvailableData(QXmlStreamReader& reader)
+{
+  ctkDicomAppHosting::AvailableData ad;
+  while (reader.readNextStartElement())
+    {
+    QStringRef name = reader.name();
+    if (name == "ObjectDescriptors")
+      {
+      ad.objectDescriptors = readArrayOfObjectDescriptors(reader);
+      }
+    else if (name == "Patients")
+      {
+      while (reader.readNextStartElement())
+        {
+        ad.patients.append(readPatient(reader));
+        }
+      }
+    else
+      {
+      reader.skipCurrentElement();
+      }
+    }
+  return ad;
+}
+
+//----------------------------------------------------------------------------
+ctkDicomAppHosting::ObjectLocator ctkDicomSoapStreamReader::readObjectLocator(QXmlStreamReader& reader)
+{
+  ctkDicomAppHosting::ObjectLocator ol;
+  while (reader.readNextStartElement())
+    {
+    QStringRef name = reader.name();
+    if (name == "Length")
+      {
+      ol.length = readValue(reader).toLongLong();
+      }
+    else if (name == "Offset")
+      {
+      ol.offset = readValue(reader).toLongLong();
+      }
+    else if (name == "TransferSyntax")
+      {
+      ol.transferSyntax = readValue(reader);
+      }
+    else if (name == "URI")
+      {
+      ol.URI = readValue(reader);
+      }
+    else if (name == "Locator")
+      {
+      ol.locator = readUuid(reader);
+      }
+    else if (name == "Source")
+      {
+      ol.source = readUuid(reader);
+      }
+    else
+      {
+      reader.skipCurrentElement();
+      }
+    }
+  return ol;
+}
+
+//----------------------------------------------------------------------------
+QList<ctkDicomAppHosting::ObjectLocator> ctkDicomSoapStreamReader::readArrayOfObjectLocators(QXmlStreamReader& reader)
+{
+  QList<ctkDicomAppHosting::ObjectLocator> list;
+  while (reader.readNextStartElement())
+    {
+    list << readObjectLocator(reader);
+    }
+  return list;
+}
+
+//----------------------------------------------------------------------------
+// ctkDicomSoapStreamWriter methods
+
+//----------------------------------------------------------------------------
+void ctkDicomSoapStreamWriter::writeStartEnvelope(QXmlStreamWriter& writer,
+                                                  const QString& methodName,
+                                                  const QString& methodNamespace)
+{
+  writer.writeStartDocument();
+  writer.writeNamespace(EnvelopeNamespace, "SOAP-ENV");
+  writer.writeNamespace(EncodingNamespace, "SOAP-ENC");
+  writer.writeNamespace(SchemaInstanceNamespace, "xsi");
+  writer.writeNamespace(SchemaNamespace, "xsd");
+  writer.writeStartElement(EnvelopeNamespace, "Envelope");
+  writer.writeAttribute(EnvelopeNamespace, "encodingStyle", EncodingNamespace);
+  writer.writeStartElement(EnvelopeNamespace, "Body");
+  if (methodNamespace.isEmpty())
+    {
+    writer.writeStartElement(methodName);
+    }
+  else
+    {
+    writer.writeNamespace(methodNamespace, "ns");
+    writer.writeStartElement(methodNamespace, methodName);
+    }
+}
+
+//----------------------------------------------------------------------------
+void ctkDicomSoapStreamWriter::writeEndEnvelope(QXmlStreamWriter& writer)
+{
+  writer.writeEndDocument();
+}
+
+//----------------------------------------------------------------------------
+void ctkDicomSoapStreamWriter::writeBool(QXmlStreamWriter& writer, const QString& name, bool value)
+{
+  writeSimpleType(writer, name, "boolean", value ? "true" : "false");
+}
+
+//----------------------------------------------------------------------------
+void ctkDicomSoapStreamWriter::writeUID(QXmlStreamWriter& writer, const QString& name, const QString& uid)
+{
+  writer.writeStartElement(name);
+  writeSimpleType(writer, "Uid", "string", uid);
+  writer.writeEndElement();
+}
+
+//----------------------------------------------------------------------------
+void ctkDicomSoapStreamWriter::writeUuid(QXmlStreamWriter& writer, const QString& name, const QUuid& uuid)
+{
+  writer.writeStartElement(name);
+  writeSimpleType(writer, "Uuid", "string", uuidString(uuid));
+  writer.writeEndElement();
+}
+
+//----------------------------------------------------------------------------
+void ctkDicomSoapStreamWriter::writeObjectDescriptor(QXmlStreamWriter& writer, const QString& name,
+                                                     const ctkDicomAppHosting::ObjectDescriptor& od)
+{
+  writer.writeStartElement(name);
+  writeUuid(writer, "DescriptorUuid", od.descriptorUUID);
+  writer.writeStartElement("MimeType");
+  writeSimpleType(writer, "Type", "string", od.mimeType);
+  writer.writeEndElement();
+  writeUID(writer, "ClassUID", od.classUID);
+  writeUID(writer, "TransferSyntaxUID", od.transferSyntaxUID);
+  writer.writeStartElement("Modality");
+  writeSimpleType(writer, "Modality", "string", od.modality);
+  writer.writeEndElement();
+  writer.writeEndElement();
+}
+
+//----------------------------------------------------------------------------
+void ctkDicomSoapStreamWriter::writeArrayOfObjectDescriptors(QXmlStreamWriter& writer, const QString& name,
+                                                             const ctkDicomAppHosting::ArrayOfObjectDescriptors& ods)
+{
+  writeStartArray(writer, name, "other", ods.size());
+  foreach(const ctkDicomAppHosting::ObjectDescriptor& od, ods)
+    {
+    writeObjectDescriptor(writer, "ObjectDescriptor", od);
+    }
+  writer.writeEndElement();
+}
+
+//----------------------------------------------------------------------------
+void ctkDicomSoapStreamWriter::writeSeries(QXmlStreamWriter& writer, const QString& name,
+                                           const ctkDicomAppHosting::Series& s)
+{
+  writer.writeStartElement(name);
+  writeUID(writer, "SeriesUID", s.seriesUID);
+  writeArrayOfObjectDescriptors(writer, "ObjectDescriptors", s.objectDescriptors);
+  writer.writeEndElement();
+}
+
+//----------------------------------------------------------------------------
+void ctkDicomSoapStreamWriter::writeStudy(QXmlStreamWriter& writer, const QString& name,
+                                          const ctkDicomAppHosting::Study& s)
+{
+  writer.writeStartElement(name);
+  writeUID(writer, "StudyUID", s.studyUID);
+  writeArrayOfObjectDescriptors(writer, "ObjectDescriptors", s.objectDescriptors);
+  writeStartArray(writer, "Series", "other", s.series.size());
+  foreach(const ctkDicomAppHosting::Series& series, s.series)
+    {
+    writeSeries(writer, "Series", series);
+    }
+  writer.writeEndElement();
+  writer.writeEndElement();
+}
+
+//----------------------------------------------------------------------------
+void ctkDicomSoapStreamWriter::writePatient(QXmlStreamWriter& writer, const QString& name,
+                                            const ctkDicomAppHosting::Patient& p)
+{
+  writer.writeStartElement(name);
+  writeSimpleType(writer, "Name", "string", p.name);
+  writeSimpleType(writer, "ID", "string", p.id);
+  writeSimpleType(writer, "AssigningAuthority", "string", p.assigningAuthority);
+  writeSimpleType(writer, "Sex", "string", p.sex);
+  writeSimpleType(writer, "DateOfBirth", "string", p.birthDate);
+  writeArrayOfObjectDescriptors(writer, "ObjectDescriptors", p.objectDescriptors);
+  writeStartArray(writer, "Studies", "other", p.studies.size());
+  foreach(const ctkDicomAppHosting::Study& study, p.studies)
+    {
+    writeStudy(writer, "Study", study);
+    }
+  writer.writeEndElement();
+  writer.writeEndElement();
+}
+
+//----------------------------------------------------------------------------
+void ctkDicomSoapStreamWriter::writeAvailableData(QXmlStreamWriter& writer, const QString& name,
+                                                  const ctkDicomAppHosting::AvailableData& ad)
+{
+  writer.writeStartElement(name);
+  writeArrayOfObjectDescriptors(writer, "ObjectDescriptors", ad.objectDescriptors);
+  writeStartArray(writer, "Patients", "other", ad.patients.size());
+  foreach(const ctkDicomAppHosting::Patient& patient, ad.patients)
+    {
+    writePatient(writer, "Patient", patient);
+    }
+  writer.writeEndElement();
+  writer.writeEndElement();
+}
+
+//----------------------------------------------------------------------------
+void ctkDicomSoapStreamWriter::writeObjectLocator(QXmlStreamWriter& writer, const QString& name,
+                                                  const ctkDicomAppHosting::ObjectLocator& ol)
+{
+  writer.writeStartElement(name);
+  writeSimpleType(writer, "Length", "long", QString::number(ol.length));
+  writeSimpleType(writer, "Offset", "long", QString::number(ol.offset));
+  writeUID(writer, "TransferSyntax", ol.transferSyntax);
+  writeSimpleType(writer, "URI", "string", ol.URI);
+  writeUuid(writer, "Locator", ol.locator);
+  writeUuid(writer, "Source", ol.source);
+  writer.writeEndElement();
+}
+
+//----------------------------------------------------------------------------
+void ctkDicomSoapStreamWriter::writeArrayOfObjectLocators(QXmlStreamWriter& writer, const QString& name,
+                                                          const QList<ctkDicomAppHosting::ObjectLocator>& array)
+{
+  // Same array type as ctkDicomSoapArrayOfObjectLocators
+  writeStartArray(writer, name, "string", array.size());
+  foreach(const ctkDicomAppHosting::ObjectLocator& ol, array)
+    {
+    writeObjectLocator(writer, "ObjectLocator", ol);
+    }
+  writer.writeEndElement();
+}
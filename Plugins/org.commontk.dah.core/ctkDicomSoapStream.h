@@ -0,0 +1,128 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#ifndef CTKDICOMSOAPSTREAM_H
+#define CTKDICOMSOAPSTREAM_H
+
+// Qt includes
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QUuid>
+
+// CTK includes
+#include <org_commontk_dah_core_Export.h>
+#include <ctkDicomAppHostingTypes.h>
+
+class QXmlStreamReader;
+class QXmlStreamWriter;
+
+/**
+ * Streaming (SAX-style) parsing of the DAH SOAP payloads.
+ *
+ * The elements are the same as the ones read and written by the ctkDicomSoap*
+ * QtSoapType helpers, but they are converted straight from and to the
+ * ctkDicomAppHosting types, without building a QtSoapMessage DOM tree first.
+ *
+ * All the read methods expect the reader to be positioned on the start element
+ * of the value and leave it on the matching end element. Element namespaces and
+ * attributes are ignored.
+ */
+struct org_commontk_dah_core_EXPORT ctkDicomSoapStreamReader
+{
+  /**
+   * Read the envelope up to the method element of the body.
+   *
+   * @param reader Reader positioned at the beginning of the document.
+   * @param methodName Set to the local name of the method element.
+   * @return False if the document is not a SOAP envelope with a method.
+   */
+  static bool readMethod(QXmlStreamReader& reader, QString& methodName);
+
+  /**
+   * The text of a simple element, or of the first leaf element of a struct
+   * (like ctkDicomSoapUID::getUID()).
+   */
+  static QString readValue(QXmlStreamReader& reader);
+
+  /**
+   * The text of all the leaf elements below the current element.
+   */
+  static QStringList readLeafValues(QXmlStreamReader& reader);
+
+  static bool readBool(QXmlStreamReader& reader);
+  static QString readUuid(QXmlStreamReader& reader);
+  static QList<QUuid> readArrayOfUUIDs(QXmlStreamReader& reader);
+
+  static ctkDicomAppHosting::ObjectDescriptor readObjectDescriptor(QXmlStreamReader& reader);
+  static ctkDicomAppHosting::ArrayOfObjectDescriptors readArrayOfObjectDescriptors(QXmlStreamReader& reader);
+  static ctkDicomAppHosting::Series readSeries(QXmlStreamReader& reader);
+  static ctkDicomAppHosting::Study readStudy(QXmlStreamReader& reader);
+  static ctkDicomAppHosting::Patient readPatient(QXmlStreamReader& reader);
+  static ctkDicomAppHosting::AvailableData readAvailableData(QXmlStreamReader& reader);
+
+  static ctkDicomAppHosting::ObjectLocator readObjectLocator(QXmlStreamReader& reader);
+  static QList<ctkDicomAppHosting::ObjectLocator> readArrayOfObjectLocators(QXmlStreamReader& reader);
+};
+
+/**
+ * Streaming serialization of the DAH SOAP payloads, producing the same
+ * elements as the ctkDicomSoap* QtSoapType helpers.
+ */
+struct org_commontk_dah_core_EXPORT ctkDicomSoapStreamWriter
+{
+  /**
+   * Write the start of the document, of the envelope and body, and the start
+   * element of the method.
+   */
+  static void writeStartEnvelope(QXmlStreamWriter& writer,
+                                 const QString& methodName, const QString& methodNamespace);
+
+  /**
+   * Close all the open elements and the document.
+   */
+  static void writeEndEnvelope(QXmlStreamWriter& writer);
+
+  static void writeBool(QXmlStreamWriter& writer, const QString& name, bool value);
+  static void writeUID(QXmlStreamWriter& writer, const QString& name, const QString& uid);
+  static void writeUuid(QXmlStreamWriter& writer, const QString& name, const QUuid& uuid);
+
+  static void writeObjectDescriptor(QXmlStreamWriter& writer, const QString& name,
+                                    const ctkDicomAppHosting::ObjectDescriptor& od);
+  static void writeArrayOfObjectDescriptors(QXmlStreamWriter& writer, const QString& name,
+                                            const ctkDicomAppHosting::ArrayOfObjectDescriptors& ods);
+  static void writeSeries(QXmlStreamWriter& writer, const QString& name,
+                          const ctkDicomAppHosting::Series& s);
+  static void writeStudy(QXmlStreamWriter& writer, const QString& name,
+                         const ctkDicomAppHosting::Study& s);
+  static void writePatient(QXmlStreamWriter& writer, const QString& name,
+                           const ctkDicomAppHosting::Patient& p);
+  static void writeAvailableData(QXmlStreamWriter& writer, const QString& name,
+                                 const ctkDicomAppHosting::AvailableData& ad);
+
+  static void writeObjectLocator(QXmlStreamWriter& writer, const QString& name,
+                                 const ctkDicomAppHosting::ObjectLocator& ol);
+  static void writeArrayOfObjectLocators(QXmlStreamWriter& writer, const QString& name,
+                                         const QList<ctkDicomAppHosting::ObjectLocator>& array);
+};
+
+#endif // CTKDICOMSOAPSTREAM_H
@@ -23,9 +23,13 @@
 #include "ctkSoapLog.h"
 
 #include <ctkDicomAppHostingTypesHelper.h>
+#include <ctkDicomSoapStream.h>
 
+#include <QBuffer>
 #include <QFile>
 #include <QTextStream>
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
 
 //----------------------------------------------------------------------------
 ctkExchangeSoapMessageProcessor::ctkExchangeSoapMessageProcessor(ctkDicomExchangeInterface* inter)
@@ -121,3 +125,153 @@ void ctkExchangeSoapMessageProcessor::processReleaseData(
   exchangeInterface->releaseData(objectUUIDs);
   // set reply message: nothing to be done
 }
+
+//----------------------------------------------------------------------------
+bool ctkExchangeSoapMessageProcessor::processStream(
+  const QByteArray& request, QByteArray* reply) const
+{
+  QXmlStreamReader reader(request);
+  QString methodName;
+  if (!ctkDicomSoapStreamReader::readMethod(reader, methodName))
+    {
+    // let the QtSoapMessage parsing report the error
+    return false;
+    }
+
+  QByteArray content;
+  QBuffer buffer(&content);
+  buffer.open(QIODevice::WriteOnly);
+  QXmlStreamWriter writer(&buffer);
+
+  bool processed = false;
+  if (methodName == "NotifyDataAvailable")
+    {
+    processed = processNotifyDataAvailable(reader, writer);
+    }
+  else if (methodName == "GetData")
+    {
+    processed = processGetData(reader, writer);
+    }
+  else if (methodName == "ReleaseData")
+    {
+    processed = processReleaseData(reader, writer);
+    }
+  if (!processed)
+    {
+    return false;
+    }
+
+  ctkDicomSoapStreamWriter::writeEndEnvelope(writer);
+  buffer.close();
+  *reply = content;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool ctkExchangeSoapMessageProcessor::processNotifyDataAvailable(
+  QXmlStreamReader& reader, QXmlStreamWriter& writer) const
+{
+  // extract arguments from input message
+  ctkDicomAppHosting::AvailableData data;
+  bool lastData = false;
+  bool hasData = false;
+  while (reader.readNextStartElement())
+    {
+    if (reader.name() == "lastData")
+      {
+      lastData = ctkDicomSoapStreamReader::readBool(reader);
+      }
+    else if (!hasData)
+      {
+      // first argument, whatever its name
+      data = ctkDicomSoapStreamReader::readAvailableData(reader);
+      hasData = true;
+      }
+    else
+      {
+      reader.skipCurrentElement();
+      }
+    }
+  if (reader.hasError())
+    {
+    return false;
+    }
+
+  CTK_SOAP_LOG_HIGHLEVEL( << "  NotifyDataAvailable: patients.count: " << data.patients.count());
+  // query interface
+  bool result = exchangeInterface->notifyDataAvailable(data, lastData);
+  // set reply message
+  ctkDicomSoapStreamWriter::writeStartEnvelope(writer, "NotifyDataAvailableResponse", QString());
+  ctkDicomSoapStreamWriter::writeBool(writer, "NotifyDataAvailableResult", result);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool ctkExchangeSoapMessageProcessor::processGetData(
+  QXmlStreamReader& reader, QXmlStreamWriter& writer) const
+{
+  // extract arguments from input message
+  QList<QUuid> objectUUIDs;
+  QStringList acceptableTransferSyntaxUIDs;
+  bool includeBulkData = false;
+  while (reader.readNextStartElement())
+    {
+    if (reader.name() == "objects")
+      {
+      objectUUIDs = ctkDicomSoapStreamReader::readArrayOfUUIDs(reader);
+      }
+    else if (reader.name() == "acceptableTransferSyntaxes")
+      {
+      acceptableTransferSyntaxUIDs = ctkDicomSoapStreamReader::readLeafValues(reader);
+      }
+    else if (reader.name() == "includeBulkData")
+      {
+      includeBulkData = ctkDicomSoapStreamReader::readBool(reader);
+      }
+    else
+      {
+      reader.skipCurrentElement();
+      }
+    }
+  if (reader.hasError())
+    {
+    return false;
+    }
+
+  // query interface
+  const QList<ctkDicomAppHosting::ObjectLocator> result = exchangeInterface->getData(
+    objectUUIDs, acceptableTransferSyntaxUIDs, includeBulkData);
+  // set reply message
+  ctkDicomSoapStreamWriter::writeStartEnvelope(writer, "GetDataResponse",
+    "http://dicom.nema.org/PS3.19/ApplicationService-20100825");
+  ctkDicomSoapStreamWriter::writeArrayOfObjectLocators(writer, "GetDataResult", result);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool ctkExchangeSoapMessageProcessor::processReleaseData(
+  QXmlStreamReader& reader, QXmlStreamWriter& writer) const
+{
+  // extract arguments from input message
+  QList<QUuid> objectUUIDs;
+  while (reader.readNextStartElement())
+    {
+    if (reader.name() == "objects")
+      {
+      objectUUIDs = ctkDicomSoapStreamReader::readArrayOfUUIDs(reader);
+      }
+    else
+      {
+      reader.skipCurrentElement();
+      }
+    }
+  if (reader.hasError())
+    {
+    return false;
+    }
+  // query interface
+  exchangeInterface->releaseData(objectUUIDs);
+  // set reply message: empty response
+  ctkDicomSoapStreamWriter::writeStartEnvelope(writer, "ReleaseDataResponse", QString());
+  return true;
+}
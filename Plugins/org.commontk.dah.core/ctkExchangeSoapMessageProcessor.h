@@ -26,6 +26,9 @@
 #include "ctkDicomExchangeInterface.h"
 #include <org_commontk_dah_core_Export.h>
 
+class QXmlStreamReader;
+class QXmlStreamWriter;
+
 class org_commontk_dah_core_EXPORT ctkExchangeSoapMessageProcessor : public ctkSoapMessageProcessor
 {
 
@@ -36,6 +39,15 @@ public:
   virtual bool process(
     const QtSoapMessage& message,
     QtSoapMessage* reply) const;
+
+  /**
+   * NotifyDataAvailable, GetData and ReleaseData requests are parsed and
+   * their replies written with ctkDicomSoapStreamReader/Writer, without
+   * materializing the QtSoapMessage of large descriptors and locator lists.
+   */
+  virtual bool processStream(
+    const QByteArray& request,
+    QByteArray* reply) const;
     
 private:
 
@@ -45,6 +57,13 @@ private:
                        QtSoapMessage* reply) const;
   void processReleaseData(const QtSoapMessage& message,
                            QtSoapMessage* reply) const;
+
+  bool processNotifyDataAvailable(QXmlStreamReader& reader,
+                                  QXmlStreamWriter& writer) const;
+  bool processGetData(QXmlStreamReader& reader,
+                      QXmlStreamWriter& writer) const;
+  bool processReleaseData(QXmlStreamReader& reader,
+                          QXmlStreamWriter& writer) const;
                
   ctkDicomExchangeInterface* exchangeInterface;
 
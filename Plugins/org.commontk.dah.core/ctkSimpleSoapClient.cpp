@@ -20,24 +20,28 @@
 =============================================================================*/
 
 #include "ctkSimpleSoapClient.h"
+#include "ctkSoapReply.h"
 #include "ctkDicomAppHostingTypes.h"
 #include "ctkSoapLog.h"
 
 #include <QApplication>
 #include <QCursor>
+#include <QNetworkAccessManager>
 #include <QNetworkReply>
-#include <QtSoapHttpTransport>
+#include <QNetworkRequest>
+#include <QtSoapMessage>
 
 //----------------------------------------------------------------------------
 class ctkSimpleSoapClientPrivate
 {
 public:
 
-  QEventLoop BlockingLoop;
-  QtSoapHttpTransport Http;
+  QNetworkAccessManager Network;
+  QtSoapMessage Response;
 
   int Port;
   QString Path;
+  QUrl Url;
 };
 
 //----------------------------------------------------------------------------
@@ -48,10 +52,7 @@ ctkSimpleSoapClient::ctkSimpleSoapClient(int port, QString path)
 
   d->Port = port;
   d->Path = path;
-
-  connect(&d->Http, SIGNAL(responseReady()), this, SLOT(responseReady()));
-
-  d->Http.setHost("127.0.0.1", false, port);
+  d->Url = QUrl(QString("http://127.0.0.1:%1%2").arg(port).arg(path));
 }
 
 //----------------------------------------------------------------------------
@@ -60,13 +61,6 @@ ctkSimpleSoapClient::~ctkSimpleSoapClient()
 
 }
 
-//----------------------------------------------------------------------------
-void ctkSimpleSoapClient::responseReady()
-{
-  Q_D(ctkSimpleSoapClient);
-  d->BlockingLoop.exit();
-}
-
 //----------------------------------------------------------------------------
 const QtSoapType & ctkSimpleSoapClient::submitSoapRequest(const QString& methodName,
                                                    QtSoapType* soapType )
@@ -82,47 +76,18 @@ const QtSoapType & ctkSimpleSoapClient::submitSoapRequest(const QString& methodN
 {
   Q_D(ctkSimpleSoapClient);
 
-  /*QString action="\"";
-  //action.append(methodName);
-  action.append("\"");
-  d->Http.setAction(action);*/
-  QString action = "http://dicom.nema.org/PS3.19/IHostService/" + methodName;
-
-  d->Http.setAction(action);
-
-  CTK_SOAP_LOG( << "Submitting action " << action
-                << " method " << methodName
-                << " to path " << d->Path );
-
-  QtSoapMessage request;
-  //request.setMethod(QtSoapQName(methodName,"http://wg23.dicom.nema.org/"));
-  request.setMethod(QtSoapQName(methodName,"http://dicom.nema.org/PS3.19" + d->Path ));
-  if(!soapTypes.isEmpty())
-    {
-    for (QList<QtSoapType*>::ConstIterator it = soapTypes.begin();
-         it < soapTypes.constEnd(); it++)
-      {
-      request.addMethodArgument(*it);
-      CTK_SOAP_LOG( << "  Argument type added " << (*it)->typeName() << ". "
-                    << " Argument name is " << (*it)->name().name() );
-      }
-    }
-  CTK_SOAP_LOG_LOWLEVEL( << "Submitting request " << methodName);
-  CTK_SOAP_LOG_LOWLEVEL( << request.toXmlString());
-
-  d->Http.submitRequest(request, d->Path);;
-
-  CTK_SOAP_LOG_LOWLEVEL( << "Submitted request " << methodName);
+  ctkSoapReply* reply = submitSoapRequestAsync(methodName, soapTypes);
 
   QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
 
-  d->BlockingLoop.exec(QEventLoop::ExcludeUserInputEvents | QEventLoop::WaitForMoreEvents);
+  reply->waitForFinished();
 
   QApplication::restoreOverrideCursor();
 
-  //qDebug() << "Reply error: " << reply->errorString();
-  //qDebug() << reply->readAll();
-  const QtSoapMessage& response = d->Http.getResponse();
+  d->Response = reply->response();
+  delete reply;
+
+  const QtSoapMessage& response = d->Response;
 
   CTK_SOAP_LOG( << "Got Response." );
 
@@ -135,8 +100,6 @@ const QtSoapType & ctkSimpleSoapClient::submitSoapRequest(const QString& methodN
     //    throw std::runtime_error("ctkSimpleSoapClient: server error (response.IsFault())");
     }
 
-  CTK_SOAP_LOG_LOWLEVEL( << "Response: " << response.toXmlString() );
-
   const QtSoapType &returnValue = response.returnValue();
 
   CTK_SOAP_LOG( << "  ReturnValue valid:" << returnValue.isValid() << "     "
@@ -145,3 +108,45 @@ const QtSoapType & ctkSimpleSoapClient::submitSoapRequest(const QString& methodN
 
   return returnValue;
 }
+
+//----------------------------------------------------------------------------
+ctkSoapReply* ctkSimpleSoapClient::submitSoapRequestAsync(const QString& methodName,
+                                                          const QList<QtSoapType*>& soapTypes)
+{
+  Q_D(ctkSimpleSoapClient);
+
+  QString action = "http://dicom.nema.org/PS3.19/IHostService/" + methodName;
+
+  CTK_SOAP_LOG( << "Submitting action " << action
+                << " method " << methodName
+                << " to path " << d->Path );
+
+  QtSoapMessage request;
+  request.setMethod(QtSoapQName(methodName,"http://dicom.nema.org/PS3.19" + d->Path ));
+  foreach(QtSoapType* soapType, soapTypes)
+    {
+    if (soapType == 0)
+      {
+      continue;
+      }
+    request.addMethodArgument(soapType);
+    CTK_SOAP_LOG( << "  Argument type added " << soapType->typeName() << ". "
+                  << " Argument name is " << soapType->name().name() );
+    }
+  CTK_SOAP_LOG_LOWLEVEL( << "Submitting request " << methodName);
+  CTK_SOAP_LOG_LOWLEVEL( << request.toXmlString());
+
+  QNetworkRequest networkRequest(d->Url);
+  networkRequest.setHeader(QNetworkRequest::ContentTypeHeader, "text/xml;charset=utf-8");
+  networkRequest.setRawHeader("SOAPAction", action.toAscii());
+#if QT_VERSION >= 0x040700
+  // Requests are written without waiting for the previous responses
+  networkRequest.setAttribute(QNetworkRequest::HttpPipeliningAllowedAttribute, true);
+#endif
+
+  QNetworkReply* networkReply = d->Network.post(networkRequest, request.toXmlString().toUtf8());
+
+  CTK_SOAP_LOG_LOWLEVEL( << "Submitted request " << methodName);
+
+  return new ctkSoapReply(methodName, networkReply, this);
+}
@@ -30,7 +30,15 @@
 #include <org_commontk_dah_core_Export.h>
 
 class ctkSimpleSoapClientPrivate;
-
+class ctkSoapReply;
+
+/**
+ * SOAP client talking to the DAH service at 127.0.0.1:port/path.
+ *
+ * Requests are sent over persistent HTTP connections and several requests
+ * can be outstanding at the same time. submitSoapRequestAsync() returns
+ * immediately, whereas submitSoapRequest() waits for the response.
+ */
 class org_commontk_dah_core_EXPORT ctkSimpleSoapClient : public QObject
 {
   Q_OBJECT
@@ -39,12 +47,23 @@ public:
   ctkSimpleSoapClient(int port, QString path);
   virtual ~ctkSimpleSoapClient();
 
+  /**
+   * Submit the request and wait for its response.
+   *
+   * The returned value is valid until the next call to submitSoapRequest().
+   * The client takes ownership of the soap types.
+   */
   const QtSoapType & submitSoapRequest(const QString& methodName, const QList<QtSoapType*>& soapTypes);
   const QtSoapType & submitSoapRequest(const QString& methodName, QtSoapType* soapType);
 
-private Q_SLOTS:
-
-  void responseReady();
+  /**
+   * Submit the request without waiting for its response.
+   *
+   * The client takes ownership of the soap types. The returned reply
+   * emits ctkSoapReply::finished() when the response is available; it is
+   * owned by the client and should be deleted once it has been used.
+   */
+  ctkSoapReply* submitSoapRequestAsync(const QString& methodName, const QList<QtSoapType*>& soapTypes);
 
 private:
 
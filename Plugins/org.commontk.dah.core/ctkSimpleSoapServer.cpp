@@ -22,28 +22,52 @@
 
 #include "ctkSimpleSoapServer.h"
 
-#include "ctkSoapConnectionRunnable_p.h"
+#include "ctkSoapConnection_p.h"
 
 //----------------------------------------------------------------------------
 ctkSimpleSoapServer::ctkSimpleSoapServer(QObject *parent) :
-    QTcpServer(parent)
+    QTcpServer(parent), ThreadSafeProcessor(0)
 {
   qRegisterMetaType<QtSoapMessage>("QtSoapMessage");
 }
 
+//----------------------------------------------------------------------------
+void ctkSimpleSoapServer::setThreadSafeProcessor(const ctkSoapMessageProcessor* processor)
+{
+  this->ThreadSafeProcessor = processor;
+  foreach(ctkSoapConnection* connection, this->findChildren<ctkSoapConnection*>())
+    {
+    connection->setThreadSafeProcessor(processor);
+    }
+}
+
+//----------------------------------------------------------------------------
+const ctkSoapMessageProcessor* ctkSimpleSoapServer::threadSafeProcessor() const
+{
+  return this->ThreadSafeProcessor;
+}
+
 //----------------------------------------------------------------------------
 void ctkSimpleSoapServer::incomingConnection(int socketDescriptor)
 {
   qDebug() << "New incoming connection";
-  ctkSoapConnectionRunnable* runnable = new ctkSoapConnectionRunnable(socketDescriptor);
+  QTcpSocket* socket = new QTcpSocket();
+  if (!socket->setSocketDescriptor(socketDescriptor))
+    {
+    qCritical() << "Accepting the connection failed:" << socket->errorString();
+    delete socket;
+    return;
+    }
+
+  ctkSoapConnection* connection = new ctkSoapConnection(socket, this);
+  connection->setThreadSafeProcessor(this->ThreadSafeProcessor);
 
-  connect(runnable, SIGNAL(incomingSoapMessage(QtSoapMessage,QtSoapMessage*)),
-          this, SIGNAL(incomingSoapMessage(QtSoapMessage,QtSoapMessage*)),
-          Qt::BlockingQueuedConnection);
+  connect(connection, SIGNAL(incomingSoapRequest(QByteArray,QByteArray*)),
+          this, SIGNAL(incomingSoapRequest(QByteArray,QByteArray*)));
 
-  connect(runnable, SIGNAL(incomingWSDLMessage(QString,QString*)),
-          this, SIGNAL(incomingWSDLMessage(QString,QString*)),
-          Qt::BlockingQueuedConnection);
+  connect(connection, SIGNAL(incomingSoapMessage(QtSoapMessage,QtSoapMessage*)),
+          this, SIGNAL(incomingSoapMessage(QtSoapMessage,QtSoapMessage*)));
 
-  QThreadPool::globalInstance()->start(runnable);
+  connect(connection, SIGNAL(incomingWSDLMessage(QString,QString*)),
+          this, SIGNAL(incomingWSDLMessage(QString,QString*)));
 }
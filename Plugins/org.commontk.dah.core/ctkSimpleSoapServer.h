@@ -33,6 +33,19 @@
 #include <org_commontk_dah_core_Export.h>
 #include <ctkDicomAppHostingTypes.h>
 
+class ctkSoapMessageProcessor;
+
+/**
+ * HTTP/SOAP server driven by the event loop of the thread it lives in.
+ *
+ * Requests are framed by their Content-Length header and connections are
+ * kept alive (unless the client asks for "Connection: close"), so several
+ * requests can be sent over the same connection. By default the SOAP
+ * messages are handed out through the incomingSoapRequest() and
+ * incomingSoapMessage() signals, in the thread of the server. If a
+ * thread-safe processor is set, the messages are parsed and processed on
+ * the global thread pool instead.
+ */
 class org_commontk_dah_core_EXPORT ctkSimpleSoapServer : public QTcpServer
 {
   Q_OBJECT
@@ -41,8 +54,24 @@ public:
 
   ctkSimpleSoapServer(QObject *parent = 0);
 
+  /**
+   * Process the incoming SOAP messages with <code>processor</code> on the
+   * global thread pool, instead of emitting incomingSoapMessage().
+   * The processor must be thread-safe and must outlive the server.
+   * Pass 0 to go back to the signal based dispatch.
+   */
+  void setThreadSafeProcessor(const ctkSoapMessageProcessor* processor);
+  const ctkSoapMessageProcessor* threadSafeProcessor() const;
+
 Q_SIGNALS:
 
+  /**
+   * Emitted with the raw request, before it is parsed for
+   * incomingSoapMessage().
+   * If a receiver (connected directly) sets <code>reply</code>, it is sent
+   * as is and incomingSoapMessage() is not emitted for this request.
+   */
+  void incomingSoapRequest(const QByteArray& request, QByteArray* reply);
   void incomingSoapMessage(const QtSoapMessage& message, QtSoapMessage* reply);
   void incomingWSDLMessage(const QString& message, QString* reply);
 
@@ -52,6 +81,10 @@ protected:
 
   virtual void incomingConnection(int socketDescriptor);
 
+private:
+
+  const ctkSoapMessageProcessor* ThreadSafeProcessor;
+
 };
 
 #endif // CTKSIMPLESOAPSERVER_H
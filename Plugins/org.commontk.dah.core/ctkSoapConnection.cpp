@@ -0,0 +1,273 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+// Qt includes
+#include <QDebug>
+#include <QPointer>
+#include <QThreadPool>
+
+// CTK includes
+#include "ctkSoapConnection_p.h"
+#include "ctkSoapConnectionRunnable_p.h"
+#include "ctkSoapLog.h"
+
+// Headers bigger than this are considered as garbage
+static const int MaxHeaderSize = 64 * 1024;
+// Requests bigger than this are refused instead of being buffered
+static const int MaxContentLength = 256 * 1024 * 1024;
+
+//----------------------------------------------------------------------------
+ctkSoapConnection::ctkSoapConnection(QTcpSocket* socket, QObject* parent)
+  : QObject(parent), Socket(socket), ThreadSafeProcessor(0),
+    HeaderParsed(false), Busy(false), ContentLength(0), KeepAlive(true)
+{
+  this->Socket->setParent(this);
+  connect(this->Socket, SIGNAL(readyRead()), this, SLOT(readClient()));
+  connect(this->Socket, SIGNAL(disconnected()), this, SLOT(deleteLater()));
+}
+
+//----------------------------------------------------------------------------
+void ctkSoapConnection::setThreadSafeProcessor(const ctkSoapMessageProcessor* processor)
+{
+  this->ThreadSafeProcessor = processor;
+}
+
+//----------------------------------------------------------------------------
+void ctkSoapConnection::readClient()
+{
+  this->Buffer.append(this->Socket->readAll());
+  this->processRequests();
+}
+
+//----------------------------------------------------------------------------
+void ctkSoapConnection::processRequests()
+{
+  // The requests of a persistent connection are answered in order,
+  // so a request waits until the reply of the previous one is written.
+  while (!this->Busy)
+    {
+    if (!this->HeaderParsed && !this->parseHeader())
+      {
+      if (this->Buffer.size() > MaxHeaderSize)
+        {
+        qCritical() << "HTTP header too big, closing the connection.";
+        this->Buffer.clear();
+        this->Socket->abort();
+        }
+      return;
+      }
+
+    if (this->Buffer.size() < this->ContentLength)
+      {
+      CTK_SOAP_LOG_LOWLEVEL( << " Expected content-length: " << this->ContentLength
+                             << ". Bytes read so far: " << this->Buffer.size() );
+      return;
+      }
+
+    QByteArray body = this->Buffer.left(this->ContentLength);
+    this->Buffer.remove(0, this->ContentLength);
+    this->HeaderParsed = false;
+
+    // The handlers may run a nested event loop that deletes the connection
+    QPointer<ctkSoapConnection> connection(this);
+    this->dispatchRequest(body);
+    if (connection.isNull())
+      {
+      return;
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+bool ctkSoapConnection::parseHeader()
+{
+  int crlfEnd = this->Buffer.indexOf("\r\n\r\n");
+  int lfEnd = this->Buffer.indexOf("\n\n");
+  int headerSize = -1;
+  if (crlfEnd >= 0 && (lfEnd < 0 || crlfEnd < lfEnd))
+    {
+    headerSize = crlfEnd + 4;
+    }
+  else if (lfEnd >= 0)
+    {
+    headerSize = lfEnd + 2;
+    }
+  if (headerSize < 0)
+    {
+    return false;
+    }
+
+  QList<QByteArray> lines = this->Buffer.left(headerSize).trimmed().split('\n');
+  this->Buffer.remove(0, headerSize);
+
+  this->RequestType.clear();
+  this->ContentLength = 0;
+  this->KeepAlive = true;
+  for (int i = 0; i < lines.size(); ++i)
+    {
+    QByteArray line = lines[i].trimmed();
+    CTK_SOAP_LOG_LOWLEVEL( << line );
+    if (i == 0)
+      {
+      // Request line
+      if (line.contains("?wsdl"))
+        {
+        this->RequestType = "?wsdl";
+        }
+      else if (line.contains("?xsd=1"))
+        {
+        this->RequestType = "?xsd=1";
+        }
+      if (line.endsWith("HTTP/1.0"))
+        {
+        this->KeepAlive = false;
+        }
+      continue;
+      }
+
+    int colon = line.indexOf(':');
+    if (colon < 0)
+      {
+      continue;
+      }
+    QByteArray name = line.left(colon).trimmed().toLower();
+    QByteArray value = line.mid(colon + 1).trimmed().toLower();
+    if (name == "content-length")
+      {
+      bool ok = false;
+      qlonglong contentLength = value.toLongLong(&ok);
+      if (!ok || contentLength < 0 || contentLength > MaxContentLength)
+        {
+        qCritical() << "Invalid HTTP Content-Length" << value << ", closing the connection.";
+        this->Buffer.clear();
+        this->Socket->abort();
+        return false;
+        }
+      this->ContentLength = static_cast<int>(contentLength);
+      }
+    else if (name == "connection")
+      {
+      this->KeepAlive = value != "close";
+      }
+    }
+
+  this->HeaderParsed = true;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void ctkSoapConnection::dispatchRequest(const QByteArray& body)
+{
+  // The next requests stay in the buffer until the reply is written, even if
+  // a handler runs a nested event loop in which readClient() is called
+  this->Busy = true;
+
+  if (this->RequestType.startsWith("?"))
+    {
+    QString content;
+    emit incomingWSDLMessage(this->RequestType, &content);
+    this->finishRequest(content.toUtf8(), false);
+    return;
+    }
+
+  if (body.trimmed().isEmpty())
+    {
+    this->finishRequest(QByteArray(), false);
+    return;
+    }
+
+  if (this->ThreadSafeProcessor)
+    {
+    ctkSoapConnectionRunnable* runnable = new ctkSoapConnectionRunnable(this->ThreadSafeProcessor, body);
+    connect(runnable, SIGNAL(messageProcessed(QByteArray,bool)),
+            this, SLOT(messageProcessed(QByteArray,bool)), Qt::QueuedConnection);
+    QThreadPool::globalInstance()->start(runnable);
+    return;
+    }
+
+  QByteArray streamedReply;
+  emit incomingSoapRequest(body, &streamedReply);
+  if (!streamedReply.isEmpty())
+    {
+    this->finishRequest(streamedReply, false);
+    return;
+    }
+
+  QtSoapMessage msg;
+  QtSoapMessage reply;
+  if (!msg.setContent(body))
+    {
+    qCritical() << "QtSoap import failed:" << msg.errorString();
+    reply.setFaultCode(QtSoapMessage::Client);
+    reply.setFaultString(msg.errorString());
+    }
+  else
+    {
+    CTK_SOAP_LOG(<< "###################" << msg.toXmlString());
+    emit incomingSoapMessage(msg, &reply);
+    }
+
+  this->finishRequest(reply.toXmlString().toUtf8(), reply.isFault());
+}
+
+//----------------------------------------------------------------------------
+void ctkSoapConnection::messageProcessed(const QByteArray& reply, bool fault)
+{
+  this->finishRequest(reply, fault);
+  this->processRequests();
+}
+
+//----------------------------------------------------------------------------
+void ctkSoapConnection::finishRequest(const QByteArray& content, bool fault)
+{
+  this->writeReply(content, fault);
+  this->Busy = false;
+}
+
+//----------------------------------------------------------------------------
+void ctkSoapConnection::writeReply(const QByteArray& content, bool fault)
+{
+  if (fault)
+    {
+    qCritical() << "QtSoap reply faulty";
+    }
+
+  QByteArray block;
+  block.append(fault ? "HTTP/1.1 500 Internal Server Error\r\n" : "HTTP/1.1 200 OK\r\n");
+  block.append("Content-Type: text/xml;charset=utf-8\r\n");
+  block.append("Content-Length: ").append(QByteArray::number(content.size())).append("\r\n");
+  if (!this->KeepAlive)
+    {
+    block.append("Connection: close\r\n");
+    }
+  block.append("\r\n");
+
+  block.append(content);
+
+  CTK_SOAP_LOG_LOWLEVEL( << block );
+
+  this->Socket->write(block);
+
+  if (!this->KeepAlive)
+    {
+    this->Socket->disconnectFromHost();
+    }
+}
@@ -20,17 +20,18 @@
 =============================================================================*/
 
 // Qt includes
-#include <QTcpSocket>
+#include <QDebug>
 
 // CTK includes
 #include "ctkSoapConnectionRunnable_p.h"
+#include "ctkSoapMessageProcessor.h"
 #include "ctkSoapLog.h"
 
 //----------------------------------------------------------------------------
-ctkSoapConnectionRunnable::ctkSoapConnectionRunnable(int socketDescriptor)
-  : socketDescriptor(socketDescriptor), isAboutToQuit(0)
+ctkSoapConnectionRunnable::ctkSoapConnectionRunnable(const ctkSoapMessageProcessor* processor,
+                                                     const QByteArray& body)
+  : Processor(processor), Body(body)
 {
-  connect(qApp, SIGNAL(aboutToQuit()), this, SLOT(aboutToQuit()));
 }
 
 //----------------------------------------------------------------------------
@@ -42,120 +43,26 @@ ctkSoapConnectionRunnable::~ctkSoapConnectionRunnable()
 //----------------------------------------------------------------------------
 void ctkSoapConnectionRunnable::run()
 {
-  QTcpSocket tcpSocket;
-  if (!tcpSocket.setSocketDescriptor(socketDescriptor))
+  QByteArray streamedReply;
+  if (this->Processor->processStream(this->Body, &streamedReply))
     {
-    // error handling
+    emit messageProcessed(streamedReply, false);
     return;
     }
 
-  const int timeout = 1 * 1000;
-  while (tcpSocket.state() == QTcpSocket::ConnectedState &&
-         isAboutToQuit.fetchAndAddOrdered(0) == 0)
+  QtSoapMessage msg;
+  QtSoapMessage reply;
+  if (!msg.setContent(this->Body))
     {
-
-    tcpSocket.waitForReadyRead(timeout);
-
-    readClient(tcpSocket);
+    qCritical() << "QtSoap import failed:" << msg.errorString();
+    reply.setFaultCode(QtSoapMessage::Client);
+    reply.setFaultString(msg.errorString());
     }
-
-}
-
-//----------------------------------------------------------------------------
-void ctkSoapConnectionRunnable::readClient(QTcpSocket& socket)
-{
-  QString requestType;
-  int contentLength = -1;
-  //qDebug() << socket->readAll();
-  while (socket.canReadLine()) {
-    QString line = socket.readLine();
-    CTK_SOAP_LOG_LOWLEVEL( << line );
-    if(line.contains("?wsdl HTTP"))
-      {
-      requestType = "?wsdl";
-      }
-    if(line.contains("?xsd=1"))
-      {
-      requestType = "?xsd=1";
-      }
-    if(line.contains("SoapAction"))
-      {
-      requestType = line;
-      }
-    if(line.contains("Content-Length: "))
-      {
-      contentLength = line.section(':',1).trimmed().toInt();
-      }
-    if (line.trimmed().isEmpty())
-      {
-      QString content;
-      if(requestType.startsWith("?"))
-        {
-        QByteArray body = socket.readAll();
-        emit incomingWSDLMessage(requestType, &content);
-        }
-      else
-        {
-        // Read the http body, which contains the soap message
-        int bytesRead = 0;
-        QByteArray body;
-        while(body.size() < contentLength)
-          {
-          QByteArray bodyPart = socket.read(contentLength);
-          CTK_SOAP_LOG_LOWLEVEL( << bodyPart );
-          bytesRead += bodyPart.size();
-          body.append(bodyPart);
-          CTK_SOAP_LOG_LOWLEVEL( << " Expected content-length: " << contentLength << ". Bytes read so far: " << body.size() );
-          if (body.size()<contentLength)
-            {
-            qCritical() << " Message body too small. Trying to read more.";
-            socket.waitForReadyRead(-1);
-            }
-          }
-        if(body.trimmed().isEmpty()==false)
-          {
-          QtSoapMessage msg;
-          if (!msg.setContent(body))
-            {
-            qCritical() << "QtSoap import failed:" << msg.errorString();
-            return;
-            }
-
-          QtSoapMessage reply;
-          CTK_SOAP_LOG(<< "###################" << msg.toXmlString());
-          emit incomingSoapMessage(msg, &reply);
-
-          if (reply.isFault())
-            {
-            qCritical() << "QtSoap reply faulty";
-            return;
-            }
-
-          CTK_SOAP_LOG_LOWLEVEL( << "SOAP reply:" );
-
-          content = reply.toXmlString();
-          }
-        }
-
-      QByteArray block;
-      block.append("HTTP/1.1 200 OK\n");
-      block.append("Content-Type: text/xml;charset=utf-8\n");
-      block.append("Content-Length: ").append(QString::number(content.size())).append("\n");
-      block.append("\n");
-
-      block.append(content);
-
-      CTK_SOAP_LOG_LOWLEVEL( << block );
-
-      socket.write(block);
-
-      requestType = "";
-      contentLength = -1;
-      }
+  else
+    {
+    CTK_SOAP_LOG(<< "###################" << msg.toXmlString());
+    this->Processor->process(msg, &reply);
     }
-}
 
-void ctkSoapConnectionRunnable::aboutToQuit()
-{
-  isAboutToQuit.testAndSetOrdered(0, 1);
+  emit messageProcessed(reply.toXmlString().toUtf8(), reply.isFault());
 }
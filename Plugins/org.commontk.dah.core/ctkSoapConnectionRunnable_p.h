@@ -25,37 +25,34 @@
 
 #include <QObject>
 #include <QRunnable>
-#include <QTcpSocket>
 
 #include <qtsoap.h>
 
+class ctkSoapMessageProcessor;
+
+/**
+ * Parses and processes one SOAP request on a pool thread, on behalf of a
+ * ctkSoapConnection whose server has a thread-safe processor.
+ */
 class ctkSoapConnectionRunnable : public QObject, public QRunnable
 {
   Q_OBJECT
 
 public:
 
-  ctkSoapConnectionRunnable(int socketDescriptor);
+  ctkSoapConnectionRunnable(const ctkSoapMessageProcessor* processor, const QByteArray& body);
   virtual ~ctkSoapConnectionRunnable();
 
   void run();
 
 Q_SIGNALS:
 
-  void incomingSoapMessage(const QtSoapMessage& message, QtSoapMessage* reply);
-  void incomingWSDLMessage(const QString& message, QString* reply);
-
-protected Q_SLOTS:
-
-  void aboutToQuit();
+  void messageProcessed(const QByteArray& reply, bool fault);
 
 private:
 
-  void readClient(QTcpSocket& socket);
-
-  int socketDescriptor;
-
-  QAtomicInt isAboutToQuit;
+  const ctkSoapMessageProcessor* Processor;
+  QByteArray Body;
 
 };
 
@@ -0,0 +1,83 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#ifndef CTKSOAPCONNECTION_P_H
+#define CTKSOAPCONNECTION_P_H
+
+#include <QObject>
+#include <QTcpSocket>
+
+#include <qtsoap.h>
+
+class ctkSoapMessageProcessor;
+
+/**
+ * Serves the HTTP requests of one client connection of ctkSimpleSoapServer.
+ *
+ * The connection reads from its socket when data is available, frames the
+ * requests with their Content-Length header and answers them in order, one
+ * at a time. It deletes itself when the client disconnects.
+ */
+class ctkSoapConnection : public QObject
+{
+  Q_OBJECT
+
+public:
+
+  ctkSoapConnection(QTcpSocket* socket, QObject* parent = 0);
+
+  void setThreadSafeProcessor(const ctkSoapMessageProcessor* processor);
+
+Q_SIGNALS:
+
+  void incomingSoapRequest(const QByteArray& request, QByteArray* reply);
+  void incomingSoapMessage(const QtSoapMessage& message, QtSoapMessage* reply);
+  void incomingWSDLMessage(const QString& message, QString* reply);
+
+private Q_SLOTS:
+
+  void readClient();
+  void messageProcessed(const QByteArray& reply, bool fault);
+
+private:
+
+  void processRequests();
+  bool parseHeader();
+  void dispatchRequest(const QByteArray& body);
+  void finishRequest(const QByteArray& content, bool fault);
+  void writeReply(const QByteArray& content, bool fault);
+
+  QTcpSocket* Socket;
+  const ctkSoapMessageProcessor* ThreadSafeProcessor;
+
+  QByteArray Buffer;
+  bool HeaderParsed;
+  bool Busy;
+
+  // State of the request being read
+  QString RequestType;
+  int ContentLength;
+  bool KeepAlive;
+
+};
+
+#endif // CTKSOAPCONNECTION_P_H
@@ -37,6 +37,15 @@ bool ctkSoapMessageProcessor::process(
   return false;
 }
 
+//----------------------------------------------------------------------------
+bool ctkSoapMessageProcessor::processStream(
+  const QByteArray& request, QByteArray* reply) const
+{
+  Q_UNUSED(request)
+  Q_UNUSED(reply)
+  return false;
+}
+
 //----------------------------------------------------------------------------
 bool ctkSoapMessageProcessor::operator==(const ctkSoapMessageProcessor& rhs)
 {
@@ -45,6 +45,18 @@ public:
   virtual bool process(const QtSoapMessage& message,
                        QtSoapMessage* reply) const;
 
+  /**
+   * Process a raw Soap request without building its QtSoapMessage.
+   * The default implementation returns false, in which case the request is
+   * parsed and given to process().
+   *
+   * @param request The raw request (the SOAP envelope).
+   * @param reply The raw reply to the request.
+   * @return True if the request could be processed.
+   */
+  virtual bool processStream(const QByteArray& request,
+                             QByteArray* reply) const;
+
   bool operator==(const ctkSoapMessageProcessor& rhs);
 
 };
@@ -45,8 +45,10 @@ bool ctkSoapMessageProcessorList::process(
     const QtSoapMessage& message,
     QtSoapMessage* reply ) const
 {
+#ifdef CTK_SOAP_DUMP_MESSAGES
   extern void DumpAll(const QtSoapType& type, int indent=0);
   DumpAll(message.method());
+#endif
 
   foreach(ctkSoapMessageProcessor* processor, this->Processors)
   {
@@ -61,3 +63,18 @@ bool ctkSoapMessageProcessorList::process(
   return false;
 }
 
+//----------------------------------------------------------------------------
+bool ctkSoapMessageProcessorList::processStream(
+    const QByteArray& request,
+    QByteArray* reply ) const
+{
+  foreach(ctkSoapMessageProcessor* processor, this->Processors)
+  {
+    if( processor->processStream( request, reply ) )
+    {
+      return true;
+    }
+  }
+  // the request will be parsed and given to process()
+  return false;
+}
@@ -44,6 +44,9 @@ public:
   virtual bool process(const QtSoapMessage& message,
                QtSoapMessage* reply) const;
 
+  virtual bool processStream(const QByteArray& request,
+                             QByteArray* reply) const;
+
 private:
 
   QList<ctkSoapMessageProcessor*> Processors;
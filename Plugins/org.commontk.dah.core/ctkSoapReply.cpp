@@ -0,0 +1,117 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#include "ctkSoapReply.h"
+#include "ctkSoapLog.h"
+
+#include <QEventLoop>
+#include <QNetworkReply>
+#include <QTimer>
+
+//----------------------------------------------------------------------------
+ctkSoapReply::ctkSoapReply(const QString& methodName, QNetworkReply* networkReply, QObject* parent)
+  : QObject(parent), MethodName(methodName), NetworkReply(networkReply), Finished(false)
+{
+  connect(networkReply, SIGNAL(finished()), this, SLOT(networkReplyFinished()));
+}
+
+//----------------------------------------------------------------------------
+ctkSoapReply::~ctkSoapReply()
+{
+  if (this->NetworkReply)
+    {
+    this->NetworkReply->disconnect(this);
+    this->NetworkReply->abort();
+    this->NetworkReply->deleteLater();
+    }
+}
+
+//----------------------------------------------------------------------------
+QString ctkSoapReply::methodName() const
+{
+  return this->MethodName;
+}
+
+//----------------------------------------------------------------------------
+bool ctkSoapReply::isFinished() const
+{
+  return this->Finished;
+}
+
+//----------------------------------------------------------------------------
+const QtSoapMessage& ctkSoapReply::response() const
+{
+  return this->Response;
+}
+
+//----------------------------------------------------------------------------
+const QtSoapType& ctkSoapReply::returnValue() const
+{
+  return this->Response.returnValue();
+}
+
+//----------------------------------------------------------------------------
+bool ctkSoapReply::waitForFinished(int msecs)
+{
+  if (this->Finished)
+    {
+    return true;
+    }
+
+  QEventLoop loop;
+  connect(this, SIGNAL(finished()), &loop, SLOT(quit()));
+  if (msecs >= 0)
+    {
+    QTimer::singleShot(msecs, &loop, SLOT(quit()));
+    }
+  loop.exec(QEventLoop::ExcludeUserInputEvents | QEventLoop::WaitForMoreEvents);
+  return this->Finished;
+}
+
+//----------------------------------------------------------------------------
+void ctkSoapReply::networkReplyFinished()
+{
+  QByteArray data = this->NetworkReply->readAll();
+  int httpStatus = this->NetworkReply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+
+  if (data.isEmpty() && this->NetworkReply->error() != QNetworkReply::NoError)
+    {
+    this->Response.setFaultCode(QtSoapMessage::Client);
+    this->Response.setFaultString(this->NetworkReply->errorString());
+    }
+  else if (!this->Response.setContent(data))
+    {
+    this->Response.setFaultCode(QtSoapMessage::Client);
+    this->Response.setFaultString("Invalid SOAP response: " + this->Response.errorString());
+    }
+  else if (httpStatus != 200 && !this->Response.isFault())
+    {
+    this->Response.setFaultCode(QtSoapMessage::Server);
+    this->Response.setFaultString(QString("HTTP status %1").arg(httpStatus));
+    }
+
+  CTK_SOAP_LOG_LOWLEVEL( << "Response to " << this->MethodName << ": " << this->Response.toXmlString() );
+
+  this->NetworkReply->deleteLater();
+  this->NetworkReply = 0;
+  this->Finished = true;
+  emit finished();
+}
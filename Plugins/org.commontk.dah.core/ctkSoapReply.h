@@ -0,0 +1,94 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CTKSOAPREPLY_H
+#define CTKSOAPREPLY_H
+
+#include <QObject>
+
+#include <QtSoapMessage>
+
+#include <org_commontk_dah_core_Export.h>
+
+class QNetworkReply;
+
+/**
+ * The reply of a request submitted with ctkSimpleSoapClient::submitSoapRequestAsync().
+ *
+ * The finished() signal is emitted when the response has been received (or
+ * the request failed, in which case the response is a fault). The reply is
+ * owned by the client which submitted the request; delete it (or call
+ * deleteLater()) once the response has been used.
+ */
+class org_commontk_dah_core_EXPORT ctkSoapReply : public QObject
+{
+  Q_OBJECT
+
+public:
+
+  virtual ~ctkSoapReply();
+
+  QString methodName() const;
+
+  bool isFinished() const;
+
+  /**
+   * The SOAP response. Only valid once the reply is finished.
+   */
+  const QtSoapMessage& response() const;
+
+  /**
+   * The return value of the response. Only valid once the reply is finished.
+   */
+  const QtSoapType& returnValue() const;
+
+  /**
+   * Process the events (except user input) until the reply is finished or
+   * <code>msecs</code> milliseconds elapsed.
+   *
+   * @param msecs The timeout in milliseconds, -1 to wait forever.
+   * @return True if the reply is finished.
+   */
+  bool waitForFinished(int msecs = -1);
+
+Q_SIGNALS:
+
+  void finished();
+
+private Q_SLOTS:
+
+  void networkReplyFinished();
+
+private:
+
+  friend class ctkSimpleSoapClient;
+
+  ctkSoapReply(const QString& methodName, QNetworkReply* networkReply, QObject* parent);
+
+  QString MethodName;
+  QNetworkReply* NetworkReply;
+  QtSoapMessage Response;
+  bool Finished;
+
+  Q_DISABLE_COPY(ctkSoapReply)
+};
+
+#endif // CTKSOAPREPLY_H
@@ -26,14 +26,19 @@
 #include <QPushButton>
 #include <QApplication>
 #include <QLabel>
+#include <QScopedPointer>
 
 // CTK includes
 #include "ctkDICOMImage.h"
+#include <ctkDicomExchangeService.h>
+#include <ctkDicomSharedMemoryData.h>
 #include "ctkExampleDicomAppLogic_p.h"
 #include "ctkExampleDicomAppPlugin_p.h"
 
 // DCMTK includes
 #include <dcmimage.h>
+#include <dcmtk/dcmdata/dcfilefo.h>
+#include <dcmtk/dcmdata/dcistrmb.h>
 
 //----------------------------------------------------------------------------
 ctkExampleDicomAppLogic::ctkExampleDicomAppLogic():
@@ -204,7 +209,7 @@ QList<ctkDicomAppHosting::ObjectLocator> ctkExampleDicomAppLogic::getData(
 //----------------------------------------------------------------------------
 void ctkExampleDicomAppLogic::releaseData(const QList<QUuid>& objectUUIDs)
 {
-  Q_UNUSED(objectUUIDs)
+  ctkDicomAbstractApp::releaseData(objectUUIDs);
 }
 
 
@@ -226,12 +231,44 @@ void ctkExampleDicomAppLogic::buttonClicked()
   {
     s=s+" URI: "+locators.begin()->URI +" locatorUUID: "+locators.begin()->locator+" sourceUUID: "+locators.begin()->source;
     qDebug() << "URI: " << locators.begin()->URI;
-    QString filename = locators.begin()->URI;
-    if(filename.startsWith("file:/",Qt::CaseInsensitive))
-      filename=filename.remove(0,8);
-    qDebug()<<filename;
-    DicomImage dcmtkImage(filename.toLatin1().data());
-    ctkDICOMImage ctkImage(&dcmtkImage);
+    DcmFileFormat fileFormat;
+    QScopedPointer<DicomImage> dcmtkImage;
+    if(ctkDicomSharedMemoryData::isSharedMemoryLocator(*locators.begin()))
+    {
+      // the data is read from the segment attached by getData()
+      ctkDicomExchangeService* exchangeService = dynamic_cast<ctkDicomExchangeService*>(getHostInterface());
+      QSharedPointer<ctkDicomSharedMemoryData> data;
+      if(exchangeService)
+        data = exchangeService->getSharedMemoryData(uuid);
+      if(!data)
+        data = QSharedPointer<ctkDicomSharedMemoryData>(new ctkDicomSharedMemoryData(*locators.begin()));
+      if(!data->isValid())
+      {
+        qCritical() << "Failed to attach" << locators.begin()->URI;
+        this->Button->setText(s);
+        return;
+      }
+      DcmInputBufferStream dcmbuffer;
+      dcmbuffer.setBuffer(data->data(), data->size());
+      dcmbuffer.setEos();
+      fileFormat.transferInit();
+      OFCondition condition = fileFormat.read(dcmbuffer);
+      fileFormat.transferEnd();
+      if(condition.bad())
+      {
+        qCritical() << "Failed to read the shared data:" << condition.text();
+      }
+      dcmtkImage.reset(new DicomImage(&fileFormat, EXS_Unknown));
+    }
+    else
+    {
+      QString filename = locators.begin()->URI;
+      if(filename.startsWith("file:/",Qt::CaseInsensitive))
+        filename=filename.remove(0,8);
+      qDebug()<<filename;
+      dcmtkImage.reset(new DicomImage(filename.toLatin1().data()));
+    }
+    ctkDICOMImage ctkImage(dcmtkImage.data());
 
     QLabel* qtImage = new QLabel;
     QPixmap pixmap = QPixmap::fromImage(ctkImage.frame(0),Qt::AvoidDither);
@@ -123,7 +123,8 @@ void ctkExampleDicomHost::onAppReady()
 void ctkExampleDicomHost::onStartProgress()
 {
   ctkDicomAppHosting::AvailableData data;
-  ctkDicomAvailableDataHelper::addToAvailableData(data, 
+  // The app runs on the same machine, publish the data in shared memory
+  ctkDicomAvailableDataHelper::addToAvailableDataInSharedMemory(data, 
     this->objectLocatorCache(), 
     "C:/XIP/XIPHost/dicom-dataset-demo/1.3.6.1.4.1.9328.50.1.10698.dcm");
 
@@ -175,7 +176,7 @@ void ctkExampleDicomHost::onReleaseAvailableResources()
 //----------------------------------------------------------------------------
 void ctkExampleDicomHost::releaseData(const QList<QUuid>& objectUUIDs)
 {
-  Q_UNUSED(objectUUIDs)
+  ctkDicomAbstractHost::releaseData(objectUUIDs);
 }
 
 void ctkExampleDicomHost::exitApplication()
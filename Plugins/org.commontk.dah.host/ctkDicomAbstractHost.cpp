@@ -122,6 +122,12 @@ QList<ctkDicomAppHosting::ObjectLocator> ctkDicomAbstractHost::getData(
   return this->objectLocatorCache()->getData(objectUUIDs);
 }
 
+//----------------------------------------------------------------------------
+void ctkDicomAbstractHost::releaseData(const QList<QUuid>& objectUUIDs)
+{
+  this->objectLocatorCache()->releaseData(objectUUIDs);
+}
+
 //----------------------------------------------------------------------------
 ctkDicomObjectLocatorCache* ctkDicomAbstractHost::objectLocatorCache()const
 {
@@ -37,6 +37,8 @@
 ctkDicomHostServerPrivate::ctkDicomHostServerPrivate(ctkDicomHostInterface* hostInterface, int port, QString path) :
     Port(port), Path(path), HostInterface(hostInterface)
 {
+  connect(&this->Server, SIGNAL(incomingSoapRequest(QByteArray,QByteArray*)),
+          this, SLOT(incomingSoapRequest(QByteArray,QByteArray*)));
   connect(&this->Server, SIGNAL(incomingSoapMessage(QtSoapMessage,QtSoapMessage*)),
           this, SLOT(incomingSoapMessage(QtSoapMessage,QtSoapMessage*)));
   connect(&this->Server, SIGNAL(incomingWSDLMessage(QString,QString*)),
@@ -85,6 +87,13 @@ void ctkDicomHostServerPrivate::incomingWSDLMessage(
     }
 }
 
+//----------------------------------------------------------------------------
+void ctkDicomHostServerPrivate::incomingSoapRequest(
+  const QByteArray& request, QByteArray* reply)
+{
+  this->Processors.processStream(request, reply);
+}
+
 //----------------------------------------------------------------------------
 void ctkDicomHostServerPrivate::incomingSoapMessage(
   const QtSoapMessage& message, QtSoapMessage* reply)
@@ -64,6 +64,8 @@ int main(int argc, char** argv)
   fwProps.insert("event.impl", "org.commontk.eventadmin");
 
   fwProps.insert("org.commontk.eventadmin.ThreadPoolSize", 10);
+  // keep the timeout test suite short
+  fwProps.insert("org.commontk.eventadmin.Timeout", 1000);
 
   testRunner.init(fwProps);
   return testRunner.run(argc, argv);
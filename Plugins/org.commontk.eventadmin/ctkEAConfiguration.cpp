@@ -45,7 +45,7 @@ const QString ctkEAConfiguration::PROP_LOG_LEVEL = "org.commontk.eventadmin.LogL
 
 
 ctkEAConfiguration::ctkEAConfiguration(ctkPluginContext* pluginContext )
-  : pluginContext(pluginContext), sync_pool(0), async_pool(0), admin(0)
+  : pluginContext(pluginContext), async_pool(0), admin(0)
 {
   // default configuration
   configure(ctkDictionary());
@@ -202,12 +202,6 @@ void ctkEAConfiguration::destroy()
     delete async_pool;
     async_pool = 0;
   }
-  if (sync_pool)
-  {
-    sync_pool->close();
-    delete sync_pool;
-    sync_pool = 0;
-  }
 }
 
 void ctkEAConfiguration::startOrUpdate()
@@ -235,15 +229,6 @@ void ctkEAConfiguration::startOrUpdate()
   // demand - in case none of its cached threads is free - until threadPoolSize
   // is reached. Subsequently, a threadPoolSize of 2 effectively disables
   // caching of threads.
-  if (sync_pool == 0)
-  {
-    sync_pool = new ctkEADefaultThreadPool(threadPoolSize, true);
-  }
-  else
-  {
-    sync_pool->configure(threadPoolSize);
-  }
-
   int asyncThreadPoolSize = threadPoolSize > 5 ? threadPoolSize / 2 : 2;
   if (async_pool == 0)
   {
@@ -264,7 +249,7 @@ void ctkEAConfiguration::startOrUpdate()
 
   if (admin == 0)
   {
-    admin = new ctkEventAdminService(pluginContext, handlerTasks, sync_pool, async_pool,
+    admin = new ctkEventAdminService(pluginContext, handlerTasks, async_pool,
                                      timeout, ignoreTimeout);
 
     // Finally, adapt the outside events to our kind of events as per spec
@@ -51,11 +51,9 @@ class ctkEAAbstractAdapter;
  *      <tt>org.commontk.eventadmin.ThreadPoolSize</tt> - The size of the thread
  *          pool.
  * </p>
- * The default value is 10. Increase in case of a large amount of synchronous events
- * where the <tt>ctkEventHandler</tt> services in turn send new synchronous events in
- * the event dispatching thread or a lot of timeouts are to be expected. A value of
- * less then 2 triggers the default value. A value of 2 effectively disables thread
- * pooling.
+ * The default value is 10. The asynchronous delivery uses half of it, synchronous
+ * events are delivered in the sending thread. A value of less then 2 triggers the
+ * default value. A value of 2 effectively disables thread pooling.
  * </p>
  * <p>
  * <p>
@@ -131,7 +129,6 @@ private:
   int logLevel;
 
   // The thread pool used - this is a member because we need to close it on stop
-  ctkEADefaultThreadPool* sync_pool;
   ctkEADefaultThreadPool* async_pool;
 
   // The actual implementation of the service - this is a member because we need to
@@ -25,16 +25,15 @@
 
 template<class HandlerTasks, class SyncDeliverTasks, class AsyncDeliverTasks>
 ctkEventAdminImpl<HandlerTasks,SyncDeliverTasks,AsyncDeliverTasks>::ctkEventAdminImpl(
-  HandlerTasksInterface* managers, ctkEADefaultThreadPool* syncPool,
+  HandlerTasksInterface* managers,
   ctkEADefaultThreadPool* asyncPool, int timeout,
   const QStringList& ignoreTimeout)
   : managers(managers)
 {
   checkNull(managers, "Managers");
-  checkNull(syncPool, "syncPool");
   checkNull(asyncPool, "asyncPool");
 
-  sendManager = new SyncDeliverTasks(syncPool, &syncMasterThread,
+  sendManager = new SyncDeliverTasks(&timeoutWatchdog,
                                      (timeout > 100 ? timeout : 0),
                                      ignoreTimeout);
 
@@ -86,7 +85,7 @@ void ctkEventAdminImpl<HandlerTasks,SyncDeliverTasks,AsyncDeliverTasks>::stop()
   HandlerTasksInterface* oldManagers =
       this->managers.fetchAndStoreOrdered(&stoppedHandlerTasks);
   delete oldManagers;
-  syncMasterThread.stop();
+  timeoutWatchdog.stop();
 }
 
 template<class HandlerTasks, class SyncDeliverTasks, class AsyncDeliverTasks>
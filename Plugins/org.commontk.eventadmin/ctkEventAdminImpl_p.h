@@ -25,7 +25,7 @@
 
 #include "handler/ctkEAHandlerTasks_p.h"
 #include "tasks/ctkEADeliverTask_p.h"
-#include "dispatch/ctkEASyncMasterThread_p.h"
+#include "dispatch/ctkEATimeoutWatchdog_p.h"
 
 class ctkEADefaultThreadPool;
 
@@ -60,8 +60,8 @@ private:
   // The asynchronous event dispatcher
   AsyncDeliverTaskInterface* postManager;
 
-  // The (interruptible) thread where sync events are handled
-  ctkEASyncMasterThread syncMasterThread;
+  // The monitor thread detecting handlers which exceed the timeout
+  ctkEATimeoutWatchdog timeoutWatchdog;
 
   // The synchronous event dispatcher
   SyncDeliverTasks* sendManager;
@@ -96,11 +96,9 @@ public:
    * <tt>ctkEADeliverTasks</tt> are used to dispatch the event.
    *
    * @param managers The factory used to determine applicable <tt>ctkEventHandler</tt>
-   * @param syncPool The synchronous thread pool
    * @param asyncPool The asynchronous thread pool
    */
   ctkEventAdminImpl(HandlerTasksInterface* managers,
-                    ctkEADefaultThreadPool* syncPool,
                     ctkEADefaultThreadPool* asyncPool,
                     int timeout,
                     const QStringList& ignoreTimeout);
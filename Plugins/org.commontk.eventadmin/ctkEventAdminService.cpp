@@ -28,11 +28,10 @@
 
 ctkEventAdminService::ctkEventAdminService(ctkPluginContext* context,
                                            HandlerTasksInterface* managers,
-                                           ctkEADefaultThreadPool* syncPool,
                                            ctkEADefaultThreadPool* asyncPool,
                                            int timeout,
                                            const QStringList& ignoreTimeout)
-  : impl(managers, syncPool, asyncPool, timeout, ignoreTimeout),
+  : impl(managers, asyncPool, timeout, ignoreTimeout),
     context(context)
 {
 
@@ -77,7 +77,6 @@ private:
 public:
   ctkEventAdminService(ctkPluginContext* context,
                        HandlerTasksInterface* managers,
-                       ctkEADefaultThreadPool* syncPool,
                        ctkEADefaultThreadPool* asyncPool,
                        int timeout,
                        const QStringList& ignoreTimeout);
@@ -0,0 +1,186 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#include "ctkEATimeoutWatchdog_p.h"
+
+#if QT_VERSION < 0x040700
+#include <QDateTime>
+#endif
+
+ctkEATimeoutWatchdog::ctkEATimeoutWatchdog()
+  : nextHandle(0), wakeupTime(-1), stopped(false)
+{
+  this->setObjectName("ctkEATimeoutWatchdog");
+#if QT_VERSION >= 0x040700
+  clock.start();
+#endif
+  this->start();
+}
+
+ctkEATimeoutWatchdog::~ctkEATimeoutWatchdog()
+{
+  stop();
+}
+
+quint64 ctkEATimeoutWatchdog::watch(Target* target, long timeout)
+{
+  QThread* const currThread = QThread::currentThread();
+
+  QMutexLocker l(&mutex);
+  const qint64 now = currentMSecs();
+
+  // suspend the deadline of the handler which is sending a cascaded event
+  QList<quint64>& stack = threadStacks[currThread];
+  if (!stack.isEmpty())
+  {
+    Entry& outer = entries[stack.back()];
+    if (!outer.suspended)
+    {
+      outer.remaining = outer.deadline - now;
+      outer.suspended = true;
+    }
+  }
+
+  Entry entry;
+  entry.target = target;
+  entry.thread = currThread;
+  entry.deadline = now + timeout;
+  entry.remaining = 0;
+  entry.suspended = false;
+  entry.expired = false;
+
+  const quint64 handle = nextHandle++;
+  entries.insert(handle, entry);
+  stack.push_back(handle);
+
+  // only wake up the monitor thread if it would otherwise miss the deadline
+  if (wakeupTime < 0 || entry.deadline < wakeupTime)
+  {
+    wakeupTime = entry.deadline;
+    waitCond.wakeOne();
+  }
+
+  return handle;
+}
+
+void ctkEATimeoutWatchdog::release(quint64 handle)
+{
+  QMutexLocker l(&mutex);
+  const qint64 now = currentMSecs();
+
+  const Entry entry = entries.take(handle);
+
+  QHash<QThread*, QList<quint64> >::iterator stackIter = threadStacks.find(entry.thread);
+  if (stackIter != threadStacks.end())
+  {
+    QList<quint64>& stack = stackIter.value();
+    stack.removeOne(handle);
+    if (stack.isEmpty())
+    {
+      threadStacks.erase(stackIter);
+    }
+    else
+    {
+      // resume the deadline of the handler which sent the cascaded event
+      Entry& outer = entries[stack.back()];
+      if (outer.suspended)
+      {
+        outer.deadline = now + outer.remaining;
+        outer.suspended = false;
+        if (wakeupTime < 0 || outer.deadline < wakeupTime)
+        {
+          wakeupTime = outer.deadline;
+          waitCond.wakeOne();
+        }
+      }
+    }
+  }
+
+  const bool overrun = !entry.expired && now > entry.deadline;
+  l.unlock();
+
+  if (overrun)
+  {
+    entry.target->timedOut();
+  }
+}
+
+void ctkEATimeoutWatchdog::stop()
+{
+  {
+    QMutexLocker l(&mutex);
+    stopped = true;
+    waitCond.wakeAll();
+  }
+  this->wait();
+}
+
+void ctkEATimeoutWatchdog::run()
+{
+  QMutexLocker l(&mutex);
+  while (!stopped)
+  {
+    const qint64 now = currentMSecs();
+    qint64 next = -1;
+
+    QMutableHashIterator<quint64, Entry> iter(entries);
+    while (iter.hasNext())
+    {
+      Entry& entry = iter.next().value();
+      if (entry.suspended || entry.expired) continue;
+
+      if (entry.deadline <= now)
+      {
+        // The handler is still running. The mutex is held while notifying
+        // the target, hence release() cannot return (and the target
+        // cannot be destroyed) until we are done.
+        entry.expired = true;
+        entry.target->timedOut();
+      }
+      else if (next < 0 || entry.deadline < next)
+      {
+        next = entry.deadline;
+      }
+    }
+
+    wakeupTime = next;
+    if (next < 0)
+    {
+      waitCond.wait(&mutex);
+    }
+    else
+    {
+      waitCond.wait(&mutex, static_cast<unsigned long>(next - now));
+    }
+  }
+}
+
+qint64 ctkEATimeoutWatchdog::currentMSecs() const
+{
+#if QT_VERSION >= 0x040700
+  return clock.elapsed();
+#else
+  // Qt 4.6 has no monotonic clock, fall back to the system time
+  const QDateTime now = QDateTime::currentDateTime();
+  return static_cast<qint64>(now.toTime_t()) * 1000 + now.time().msec();
+#endif
+}
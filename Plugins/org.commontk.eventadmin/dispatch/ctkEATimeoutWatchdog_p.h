@@ -0,0 +1,146 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#ifndef CTKEATIMEOUTWATCHDOG_P_H
+#define CTKEATIMEOUTWATCHDOG_P_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QHash>
+#include <QList>
+
+#if QT_VERSION >= 0x040700
+#include <QElapsedTimer>
+#endif
+
+/**
+ * A single monitor thread which detects event handlers that exceed
+ * the configured delivery timeout.
+ *
+ * Synchronous event delivery executes the handlers directly in the
+ * sending thread. Before a handler is called, it is registered with
+ * the watchdog via watch() and it is unregistered via release() after
+ * it returned. If a handler is still running when its deadline passes,
+ * the watchdog notifies the corresponding Target (which usually blacklists
+ * the handler) from within the monitor thread. The sending thread itself
+ * is never handed over to another thread.
+ *
+ * The monitor thread is only woken up if it is idle or if a new deadline
+ * is earlier than the one it is currently sleeping for. Since all handlers
+ * share the same timeout, a steady stream of sends does not cause a
+ * context switch per handler call.
+ *
+ * If a handler sends an event itself (a cascaded event), the deadline of
+ * the outer handler is suspended for the delivery time of the inner event.
+ */
+class ctkEATimeoutWatchdog : public QThread
+{
+  Q_OBJECT
+
+public:
+
+  /**
+   * Callback interface for handlers which exceeded their timeout.
+   */
+  struct Target
+  {
+    virtual ~Target() {}
+
+    /**
+     * Called at most once per watch() call, either from the monitor
+     * thread or from release().
+     */
+    virtual void timedOut() = 0;
+  };
+
+  ctkEATimeoutWatchdog();
+  ~ctkEATimeoutWatchdog();
+
+  /**
+   * Start watching the given target in the calling thread.
+   *
+   * @param target The target to notify if the timeout is exceeded.
+   * @param timeout The timeout in milliseconds.
+   * @return A handle which must be passed to release().
+   */
+  quint64 watch(Target* target, long timeout);
+
+  /**
+   * Stop watching the target associated with <code>handle</code>. If the
+   * deadline passed but the monitor thread did not notice it yet, the
+   * target is notified in the calling thread. The target is guaranteed to
+   * not be accessed by the monitor thread after this method returns.
+   *
+   * @param handle The handle returned by watch().
+   */
+  void release(quint64 handle);
+
+  /**
+   * Stops the monitor thread.
+   */
+  void stop();
+
+protected:
+
+  void run();
+
+private:
+
+  struct Entry
+  {
+    Target* target;
+    QThread* thread;
+    /** The absolute deadline in msecs, only valid if not suspended. */
+    qint64 deadline;
+    /** The remaining time of a suspended entry. */
+    qint64 remaining;
+    bool suspended;
+    bool expired;
+  };
+
+  /** Milliseconds elapsed since the watchdog was created. */
+  qint64 currentMSecs() const;
+
+#if QT_VERSION >= 0x040700
+  /** Monotonic clock, deadlines are not affected by changes of the system time. */
+  QElapsedTimer clock;
+#endif
+
+  QMutex mutex;
+  QWaitCondition waitCond;
+
+  QHash<quint64, Entry> entries;
+
+  /** The stack of active handles per thread, used for cascaded events. */
+  QHash<QThread*, QList<quint64> > threadStacks;
+
+  /** Handles are never reused, 64 bits do not wrap around. */
+  quint64 nextHandle;
+
+  /** The time the monitor thread will wake up, -1 if waiting forever. */
+  qint64 wakeupTime;
+
+  bool stopped;
+};
+
+#endif // CTKEATIMEOUTWATCHDOG_P_H
@@ -20,79 +20,41 @@
 =============================================================================*/
 
 
-#include "ctkEASyncThread_p.h"
-
-#include <dispatch/ctkEADefaultThreadPool_p.h>
-#include <dispatch/ctkEASyncMasterThread_p.h>
-#include <util/ctkEARendezvous_p.h>
-#include <util/ctkEATimeoutException_p.h>
-
-#include <QDateTime>
+#include <dispatch/ctkEATimeoutWatchdog_p.h>
 
 template<class HandlerTask>
-class _TimeoutRunnable : public ctkEARunnable
+class _BlackListOnTimeout : public ctkEATimeoutWatchdog::Target
 {
 public:
 
-  ctkEARendezvous timerBarrier;
-  ctkEARendezvous startBarrier;
-
-  _TimeoutRunnable(HandlerTask* task)
-    : task(task)
+  _BlackListOnTimeout(ctkEATimeoutWatchdog* watchdog, HandlerTask* task, long timeout)
+    : watchdog(watchdog), task(task)
   {
-
+    handle = watchdog->watch(this, timeout);
   }
 
-  void run()
+  ~_BlackListOnTimeout()
   {
-    try
-    {
-      // notify the outer thread to start the timer
-      startBarrier.waitForRendezvous();
-      // execute the task
-      task->execute();
-      // stop the timer
-      timerBarrier.waitForRendezvous();
-    }
-    catch (const std::logic_error& )
-    {
-      // this can happen on shutdown, so we ignore it
-    }
-  }
-
-private:
-
-  HandlerTask* task;
-};
-
-template<class HandlerTask>
-class _RunInSyncMaster : public QRunnable
-{
-public:
-
-  _RunInSyncMaster(ctkEASyncDeliverTasks<HandlerTask>* handlerTasks,
-                   const QList<HandlerTask>& tasks)
-    : handlerTasks(handlerTasks), tasks(tasks)
-  {
-
+    watchdog->release(handle);
   }
 
-  void run()
+  void timedOut()
   {
-    handlerTasks->executeInSyncMaster(tasks);
+    // if we timed out, we have to blacklist the handler
+    task->blackListHandler();
   }
 
 private:
 
-  ctkEASyncDeliverTasks<HandlerTask>* handlerTasks;
-  const QList<HandlerTask>& tasks;
+  ctkEATimeoutWatchdog* watchdog;
+  HandlerTask* task;
+  quint64 handle;
 };
 
 template<class HandlerTask>
 ctkEASyncDeliverTasks<HandlerTask>::ctkEASyncDeliverTasks(
-  ctkEADefaultThreadPool* pool, ctkEASyncMasterThread* syncMasterThread,
-  long timeout, const QList<QString>& ignoreTimeout)
-  : pool(pool), syncMasterThread(syncMasterThread)
+  ctkEATimeoutWatchdog* watchdog, long timeout, const QList<QString>& ignoreTimeout)
+  : watchdog(watchdog)
 {
   update(timeout, ignoreTimeout);
 }
@@ -134,71 +96,28 @@ void ctkEASyncDeliverTasks<HandlerTask>::update(long timeout, const QList<QStrin
 template<class HandlerTask>
 void ctkEASyncDeliverTasks<HandlerTask>::execute(const QList<HandlerTask>& tasks)
 {
-  _RunInSyncMaster<HandlerTask> runnable(this, tasks);
-  runnable.setAutoDelete(false);
-  syncMasterThread->syncRun(&runnable);
-}
-
-template<class HandlerTask>
-void ctkEASyncDeliverTasks<HandlerTask>::executeInSyncMaster(const QList<HandlerTask>& tasks)
-{
-  QThread* const sleepingThread = QThread::currentThread();
-  ctkEASyncThread* const syncThread = qobject_cast<ctkEASyncThread*>(sleepingThread);
-
+  long t = 0;
   foreach(HandlerTask task, tasks)
   {
-    if (!useTimeout(task))
+    if (!useTimeout(task, t))
     {
       // no timeout, we can directly execute
       task.execute();
     }
-    else if (syncThread != 0)
-    {
-      // if this is a cascaded event, we directly use this thread
-      // otherwise we could end up in a starvation
-      //TODO use Qt4.7 API
-      //long startTime = System.currentTimeMillis();
-      QDateTime startTime = QDateTime::currentDateTime();
-      task.execute();
-      if (startTime.time().msecsTo(QDateTime::currentDateTime().time()) > timeout)
-      {
-        task.blackListHandler();
-      }
-    }
     else
     {
-      _TimeoutRunnable<HandlerTask>* timeoutRunnable
-          = new _TimeoutRunnable<HandlerTask>(&task);
-      ctkEAScopedRunnableReference runnableRef(timeoutRunnable);
-
-      ctkEARendezvous* startBarrier = &timeoutRunnable->startBarrier;
-      ctkEARendezvous* timerBarrier = &timeoutRunnable->timerBarrier;
-      pool->executeTask(timeoutRunnable);
-
-      // we wait for the inner thread to start
-      startBarrier->waitForRendezvous();
-
-      // timeout handling
-      // we sleep for the sleep time
-      // if someone wakes us up it's the finished inner task
-      try
-      {
-        timerBarrier->waitAttemptForRendezvous(timeout);
-      }
-      catch (const ctkEATimeoutException& )
-      {
-        // if we timed out, we have to blacklist the handler
-        task.blackListHandler();
-      }
+      // the watchdog blacklists the handler if it is still running
+      // after the timeout, or when it returns too late
+      _BlackListOnTimeout<HandlerTask> timeoutGuard(watchdog, &task, t);
+      task.execute();
     }
   }
 }
 
 template<class HandlerTask>
-bool ctkEASyncDeliverTasks<HandlerTask>::useTimeout(const HandlerTask& task)
+bool ctkEASyncDeliverTasks<HandlerTask>::useTimeout(const HandlerTask& task, long& t)
 {
   // we only check the classname if a timeout is configured
-  long t = 0;
   {
     QMutexLocker l(&mutex);
     t = timeout;
@@ -27,28 +27,22 @@
 
 #include <QMutex>
 
-class ctkEADefaultThreadPool;
-class ctkEASyncMasterThread;
+class ctkEATimeoutWatchdog;
 
 /**
  * This class does the actual work of the synchronous event delivery.
  *
- * This is the heart of the event delivery. If an event is delivered
- * without timeout handling, the event is directly delivered using
- * the calling thread.
- * If timeout handling is enabled, a new thread is taken from the
- * thread pool and this thread is used to deliver the event.
- * The calling thread is blocked until either the deliver is finished
- * or the timeout occurs.
+ * This is the heart of the event delivery. Events are always delivered
+ * directly using the calling thread.
+ * If timeout handling is enabled, each handler call is registered with
+ * a ctkEATimeoutWatchdog. A single monitor thread blacklists handlers
+ * which are still running when their timeout expires, and handlers
+ * which returned too late are blacklisted by the calling thread.
  * <p><tt>
- * Note that in case of a timeout while a task is disabled the thread
- * is released and we spin-off a new thread that resumes the disabled
- * task hence, this is the only place were we break the semantics of
- * the synchronous delivery. While the only one to notice this is the
- * timed-out handler - it is the fault of this handler too (i.e., it
- * blocked the dispatch for to long) but since it will not receive
- * events anymore it will not notice this semantic difference except
- * that it might not see events it already sent before.
+ * Note that in contrast to a thread-per-handler design, the calling
+ * thread is not released when a handler times out; it returns as soon
+ * as the handler returns. The timed-out handler will not receive any
+ * further events.
  * </tt></pre>
  *
  * If during an event delivery a new event should be delivered from
@@ -61,11 +55,8 @@ class ctkEASyncDeliverTasks : public ctkEADeliverTask<ctkEASyncDeliverTasks<Hand
 
 private:
 
-  /** The thread pool used to spin-off new threads. */
-  ctkEADefaultThreadPool* pool;
-
-  /** This is a ctkEAInterruptibleThread used to execute the handlers */
-  ctkEASyncMasterThread* syncMasterThread;
+  /** The watchdog used to detect handlers exceeding the timeout. */
+  ctkEATimeoutWatchdog* watchdog;
 
   /** The timeout for event handlers, 0 = disabled. */
   long timeout;
@@ -107,17 +98,17 @@ public:
 
   /**
    * Construct a new sync deliver tasks.
-   * @param pool The thread pool used to spin-off new threads.
+   * @param watchdog The watchdog used to detect timed-out handlers.
    * @param timeout The timeout for an event handler, 0 = disabled
    */
-  ctkEASyncDeliverTasks(ctkEADefaultThreadPool* pool, ctkEASyncMasterThread* syncMasterThread,
+  ctkEASyncDeliverTasks(ctkEATimeoutWatchdog* watchdog,
                         long timeout, const QList<QString>& ignoreTimeout);
 
   void update(long timeout, const QList<QString>& ignoreTimeout);
 
   /**
-   * This blocks an unrelated thread used to send a synchronous event until the
-   * event is send (or a timeout occurs).
+   * This delivers a synchronous event to the given handlers using the
+   * calling thread. Handlers exceeding the timeout are blacklisted.
    *
    * @param tasks The event handler dispatch tasks to execute
    *
@@ -125,16 +116,15 @@ public:
    */
   void execute(const QList<HandlerTask>& tasks);
 
-  void executeInSyncMaster(const QList<HandlerTask>& tasks);
-
 private:
 
   /**
    * This method defines if a timeout handling should be used for the
    * task.
-   * @param tasks The event handler dispatch tasks to execute
+   * @param task The event handler dispatch task to execute
+   * @param timeout Set to the current timeout if timeout handling is used
    */
-  bool useTimeout(const HandlerTask& task);
+  bool useTimeout(const HandlerTask& task, long& timeout);
 
 };
 
@@ -31,6 +31,9 @@ public:
     int var() {return m_Var;}
 
 public Q_SLOTS:
+    /// Test slot that will increment the value of m_Var by the given amount.
+    void incrementVar(int amount) {m_Var += amount;}
+
     /// Test slot that will increment the value of m_Var when an UPDATE_OBJECT event is raised.
     // no return value
     void setObjectValue0(){};
@@ -59,6 +62,8 @@ public Q_SLOTS:
     int setObjectValue10WithReturnValue(int v1, int v2, int v3, int v4, int v5, int v6, int v7, int v8, int v9, int v10){return v1 + v2 + v3 + v4 +v5 + v6 + v7 + v8 + v9 + v10;};
 
 Q_SIGNALS:
+    void signalIncrementVar(int amount);
+
     void signalSetObjectValue0();
     void signalSetObjectValue1(int v1);
     void signalSetObjectValue2(int v1, int v2);
@@ -132,6 +137,9 @@ private Q_SLOTS:
     /// notify event test which cover all the possibilities in terms of arguments with returned value
     void notifyEventWitReturnValueTest();
 
+    /// local event throughput benchmark.
+    void notifyEventBenchmarkTest();
+
 private:
     testObjectCustomForDispatcherLocal *m_ObjTest; ///< Test Object var
     ctkEventDispatcherLocal *m_EventDispatcherLocal; ///< Test var.
@@ -419,5 +427,31 @@ void ctkEventDispatcherLocalTest::notifyEventWitReturnValueTest() {
     delete propCallback10;
 }
 
+void ctkEventDispatcherLocalTest::notifyEventBenchmarkTest() {
+    QString topic = "ctk/local/incrementVar";
+
+    ctkBusEvent *propSignal = new ctkBusEvent(topic, ctkEventTypeLocal, ctkSignatureTypeSignal, m_ObjTest, "signalIncrementVar(int)");
+    m_EventDispatcherLocal->registerSignal(*propSignal);
+
+    ctkBusEvent *propCallback = new ctkBusEvent(topic, ctkEventTypeLocal, ctkSignatureTypeCallback, m_ObjTest, "incrementVar(int)");
+    m_EventDispatcherLocal->addObserver(*propCallback);
+
+    int amount = 1;
+    ctkEventArgumentsList argList;
+    argList.append(ctkEventArgument(int, amount));
+    ctkBusEvent notEvent(topic, ctkDictionary());
+
+    int varBefore = m_ObjTest->var();
+    m_EventDispatcherLocal->notifyEvent(notEvent, &argList);
+    QCOMPARE(m_ObjTest->var(), varBefore + 1);
+
+    QBENCHMARK {
+        m_EventDispatcherLocal->notifyEvent(notEvent, &argList);
+    }
+
+    // removing the signal deletes also the properties of its callbacks.
+    m_EventDispatcherLocal->removeSignal(*propSignal);
+}
+
 CTK_REGISTER_TEST(ctkEventDispatcherLocalTest);
 #include "ctkEventDispatcherLocalTest.moc"
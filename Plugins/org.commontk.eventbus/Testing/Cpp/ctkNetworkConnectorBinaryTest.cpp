@@ -0,0 +1,170 @@
+/*
+ *  ctkNetworkConnectorBinaryTest.cpp
+ *  ctkNetworkConnectorBinaryTest
+ *
+ *  Created by Daniele Giunchi on 27/03/09.
+ *  Copyright 2009 B3C. All rights reserved.
+ *
+ *  See Licence at: http://tiny.cc/QXJ4D
+ *
+ */
+
+#include "ctkTestSuite.h"
+#include <ctkNetworkConnectorBinary.h>
+#include <ctkEventBusManager.h>
+
+#include <QApplication>
+
+using namespace ctkEventBus;
+
+//-------------------------------------------------------------------------
+/**
+ Class name: ctkObjectCustom
+ Custom object needed for testing.
+ */
+class testObjectCustomForNetworkConnectorBinary : public QObject {
+    Q_OBJECT
+
+public:
+    /// constructor.
+    testObjectCustomForNetworkConnectorBinary();
+
+    /// Return tha var's value.
+    int var() {return m_Var;}
+
+public Q_SLOTS:
+    /// Test slot that will increment the value of m_Var when an UPDATE_OBJECT event is raised.
+    void updateObject();
+
+private:
+    int m_Var; ///< Test var.
+};
+
+testObjectCustomForNetworkConnectorBinary::testObjectCustomForNetworkConnectorBinary() : m_Var(0) {
+}
+
+void testObjectCustomForNetworkConnectorBinary::updateObject() {
+    m_Var++;
+}
+
+/// Process the events until the test object reaches the expected value (or the timeout expires).
+static bool waitForValue(testObjectCustomForNetworkConnectorBinary *obj, int value, int msecs = 3000) {
+    QTime dieTime = QTime::currentTime().addMSecs(msecs);
+    while(obj->var() != value && QTime::currentTime() < dieTime) {
+       QCoreApplication::processEvents(QEventLoop::AllEvents, 3);
+    }
+    return obj->var() == value;
+}
+
+/**
+ Class name: ctkNetworkConnectorBinaryTest
+ This class implements the test suite for ctkNetworkConnectorBinary.
+ */
+
+//! <title>
+//ctkNetworkConnectorBinary
+//! </title>
+//! <description>
+//ctkNetworkConnectorBinary provides a persistent connection with a binary,
+//length prefixed and pipelined protocol.
+//! </description>
+
+class ctkNetworkConnectorBinaryTest : public QObject {
+    Q_OBJECT
+
+private Q_SLOTS:
+    /// Initialize test variables
+    void initTestCase() {
+        m_EventBus = ctkEventBusManager::instance();
+        m_NetWorkConnectorBinary = new ctkEventBus::ctkNetworkConnectorBinary();
+        m_ObjectTest = new testObjectCustomForNetworkConnectorBinary();
+
+        m_EventParameters.append("ctk/local/eventBus/globalUpdate");
+        m_EventParameters.append(ctkEventTypeLocal);
+        m_EventParameters.append(ctkSignatureTypeCallback);
+        m_EventParameters.append("updateObject()");
+        m_ListToSend.append(ctkEventArgument(QVariantList, m_EventParameters));
+        m_ListToSend.append(ctkEventArgument(QVariantList, m_DataParameters));
+    }
+
+    /// Cleanup tes variables memory allocation.
+    void cleanupTestCase() {
+        if(m_ObjectTest) {
+            delete m_ObjectTest;
+            m_ObjectTest = NULL;
+        }
+        delete m_NetWorkConnectorBinary;
+        m_EventBus->shutdown();
+    }
+
+    /// Check the existence of the ctkNetworkConnectorBinary creation.
+    void ctkNetworkConnectorBinaryConstructorTest();
+
+    /// Check a request/response round trip over loopback tcp.
+    void ctkNetworkConnectorBinaryCommunictionTest();
+
+    /// Check that many requests are sent without waiting for the replies.
+    void ctkNetworkConnectorBinaryPipeliningTest();
+
+    /// Measure the throughput of a batch of pipelined requests.
+    void ctkNetworkConnectorBinaryThroughputBenchmark();
+
+private:
+    ctkEventBusManager *m_EventBus; ///< event bus instance
+    ctkNetworkConnectorBinary *m_NetWorkConnectorBinary; ///< EventBus test variable instance.
+    testObjectCustomForNetworkConnectorBinary *m_ObjectTest;
+    QVariantList m_EventParameters; ///< parameters of the request which notify the global update.
+    QVariantList m_DataParameters; ///< data of the request which notify the global update.
+    ctkEventArgumentsList m_ListToSend; ///< request which notify the global update.
+};
+
+void ctkNetworkConnectorBinaryTest::ctkNetworkConnectorBinaryConstructorTest() {
+    QVERIFY(m_NetWorkConnectorBinary != NULL);
+    QCOMPARE(m_NetWorkConnectorBinary->protocol(), QString("BINARY"));
+}
+
+void ctkNetworkConnectorBinaryTest::ctkNetworkConnectorBinaryCommunictionTest() {
+    m_NetWorkConnectorBinary->createServer(8020);
+    m_NetWorkConnectorBinary->startListen();
+
+    // Register callback (done by the remote object).
+    ctkRegisterLocalCallback("ctk/local/eventBus/globalUpdate", m_ObjectTest, "updateObject()");
+
+    m_NetWorkConnectorBinary->createClient("localhost", 8020);
+    m_NetWorkConnectorBinary->send("ctk/remote/eventBus/comunication/send/binary", &m_ListToSend);
+
+    QVERIFY(waitForValue(m_ObjectTest, 1));
+    QTime dieTime = QTime::currentTime().addSecs(3);
+    while(m_NetWorkConnectorBinary->pendingRequestsCount() != 0 && QTime::currentTime() < dieTime) {
+       QCoreApplication::processEvents(QEventLoop::AllEvents, 3);
+    }
+    QCOMPARE(m_NetWorkConnectorBinary->pendingRequestsCount(), 0);
+}
+
+void ctkNetworkConnectorBinaryTest::ctkNetworkConnectorBinaryPipeliningTest() {
+    int expected = m_ObjectTest->var() + 100;
+    for(int i = 0; i < 100; ++i) {
+        m_NetWorkConnectorBinary->send("ctk/remote/eventBus/comunication/send/binary", &m_ListToSend);
+    }
+    QCOMPARE(m_NetWorkConnectorBinary->pendingRequestsCount(), 100);
+
+    QVERIFY(waitForValue(m_ObjectTest, expected));
+    QTime dieTime = QTime::currentTime().addSecs(3);
+    while(m_NetWorkConnectorBinary->pendingRequestsCount() != 0 && QTime::currentTime() < dieTime) {
+       QCoreApplication::processEvents(QEventLoop::AllEvents, 3);
+    }
+    QCOMPARE(m_NetWorkConnectorBinary->pendingRequestsCount(), 0);
+}
+
+void ctkNetworkConnectorBinaryTest::ctkNetworkConnectorBinaryThroughputBenchmark() {
+    QBENCHMARK {
+        int expected = m_ObjectTest->var() + 1000;
+        for(int i = 0; i < 1000; ++i) {
+            m_NetWorkConnectorBinary->send("ctk/remote/eventBus/comunication/send/binary", &m_ListToSend);
+        }
+        QVERIFY(waitForValue(m_ObjectTest, expected, 10000));
+    }
+}
+
+CTK_REGISTER_TEST(ctkNetworkConnectorBinaryTest);
+#include "ctkNetworkConnectorBinaryTest.moc"
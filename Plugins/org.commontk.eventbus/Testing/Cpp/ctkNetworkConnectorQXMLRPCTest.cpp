@@ -97,6 +97,9 @@ private Q_SLOTS:
     /// Check the existence of the ctkNetworkConnectorQXMLRPCe singletone creation.
     void ctkNetworkConnectorQXMLRPCCommunictionTest();
 
+    /// Measure the latency of a request/response round trip (to be compared with ctkNetworkConnectorZeroMQ).
+    void ctkNetworkConnectorQXMLRPCRoundTripBenchmark();
+
 private:
     ctkEventBusManager *m_EventBus; ///< event bus instance
     ctkNetworkConnectorQXMLRPC *m_NetWorkConnectorQXMLRPC; ///< EventBus test variable instance.
@@ -144,6 +147,30 @@ void ctkNetworkConnectorQXMLRPCTest::ctkNetworkConnectorQXMLRPCCommunictionTest(
     }
 }
 
+void ctkNetworkConnectorQXMLRPCTest::ctkNetworkConnectorQXMLRPCRoundTripBenchmark() {
+    QVariantList eventParameters;
+    eventParameters.append("ctk/local/eventBus/globalUpdate");
+    eventParameters.append(ctkEventTypeLocal);
+    eventParameters.append(ctkSignatureTypeCallback);
+    eventParameters.append("updateObject()");
+
+    QVariantList dataParameters;
+
+    ctkEventArgumentsList listToSend;
+    listToSend.append(ctkEventArgument(QVariantList, eventParameters));
+    listToSend.append(ctkEventArgument(QVariantList, dataParameters));
+
+    QBENCHMARK {
+        int expected = m_ObjectTest->var() + 1;
+        m_NetWorkConnectorQXMLRPC->send("ctk/remote/eventBus/comunication/send/xmlrpc", &listToSend);
+        QTime dieTime = QTime::currentTime().addSecs(3);
+        while(m_ObjectTest->var() != expected && QTime::currentTime() < dieTime) {
+           QCoreApplication::processEvents(QEventLoop::AllEvents, 3);
+        }
+        QCOMPARE(m_ObjectTest->var(), expected);
+    }
+}
+
 CTK_REGISTER_TEST(ctkNetworkConnectorQXMLRPCTest);
 #include "ctkNetworkConnectorQXMLRPCTest.moc"
 
@@ -57,6 +57,15 @@ void testObjectCustomForNetworkConnectorZeroMQ::setObjectValue(int v) {
 }
 
 
+/// Process the events until the test object reaches the expected value (or the timeout expires).
+static bool waitForValue(testObjectCustomForNetworkConnectorZeroMQ *obj, int value, int msecs = 3000) {
+    QTime dieTime = QTime::currentTime().addMSecs(msecs);
+    while(obj->var() != value && QTime::currentTime() < dieTime) {
+       QCoreApplication::processEvents(QEventLoop::AllEvents, 3);
+    }
+    return obj->var() == value;
+}
+
 /**
  Class name: ctkNetworkConnectorZeroMQTest
  This class implements the test suite for ctkNetworkConnectorZeroMQ.
@@ -67,7 +76,7 @@ void testObjectCustomForNetworkConnectorZeroMQ::setObjectValue(int v) {
 //! </title>
 //! <description>
 //ctkNetworkConnectorZeroMQ provides the connection with 0MQ library.
-//It has been used qxmlrpc library.
+//Requests go through DEALER/ROUTER sockets, broadcast events through PUB/SUB sockets.
 //! </description>
 
 class ctkNetworkConnectorZeroMQTest : public QObject {
@@ -94,27 +103,96 @@ private Q_SLOTS:
     /// Check the existence of the ctkNetworkConnectorZeroMQe singletone creation.
     void ctkNetworkConnectorZeroMQConstructorTest();
 
-    /// Check the existence of the ctkNetworkConnectorZeroMQe singletone creation.
+    /// Check a request/response round trip over loopback tcp.
     void ctkNetworkConnectorZeroMQCommunictionTest();
 
+    /// Measure the latency of a request/response round trip over loopback tcp.
+    void ctkNetworkConnectorZeroMQRoundTripBenchmark();
+
+    /// Check the delivery of a broadcast event over ipc.
+    void ctkNetworkConnectorZeroMQPublishTest();
+
 private:
+    /// Fill the list with the arguments of a request which notify the global update.
+    void fillGlobalUpdateRequest(ctkEventArgumentsList &listToSend, QVariantList &eventParameters, QVariantList &dataParameters);
+
     ctkEventBusManager *m_EventBus; ///< event bus instance
     ctkNetworkConnectorZeroMQ *m_NetWorkConnectorZeroMQ; ///< EventBus test variable instance.
     testObjectCustomForNetworkConnectorZeroMQ *m_ObjectTest;
 };
 
+void ctkNetworkConnectorZeroMQTest::fillGlobalUpdateRequest(ctkEventArgumentsList &listToSend, QVariantList &eventParameters, QVariantList &dataParameters) {
+    eventParameters.append("ctk/local/eventBus/globalUpdate");
+    eventParameters.append(ctkEventTypeLocal);
+    eventParameters.append(ctkSignatureTypeCallback);
+    eventParameters.append("updateObject()");
+
+    listToSend.append(ctkEventArgument(QVariantList, eventParameters));
+    listToSend.append(ctkEventArgument(QVariantList, dataParameters));
+}
+
 void ctkNetworkConnectorZeroMQTest::ctkNetworkConnectorZeroMQConstructorTest() {
     QVERIFY(m_NetWorkConnectorZeroMQ != NULL);
+    QCOMPARE(m_NetWorkConnectorZeroMQ->protocol(), QString("ZEROMQ"));
 }
 
-
 void ctkNetworkConnectorZeroMQTest::ctkNetworkConnectorZeroMQCommunictionTest() {
+    m_NetWorkConnectorZeroMQ->createServer(8010);
+    m_NetWorkConnectorZeroMQ->startListen();
+
+    // Register callback (done by the remote object).
+    ctkRegisterLocalCallback("ctk/local/eventBus/globalUpdate", m_ObjectTest, "updateObject()");
+
+    m_NetWorkConnectorZeroMQ->createClient("127.0.0.1", 8010);
+
+    QVariantList eventParameters;
+    QVariantList dataParameters;
+    ctkEventArgumentsList listToSend;
+    fillGlobalUpdateRequest(listToSend, eventParameters, dataParameters);
+
+    m_NetWorkConnectorZeroMQ->send("ctk/remote/eventBus/comunication/send/zeromq", &listToSend);
+
+    QVERIFY(waitForValue(m_ObjectTest, 1));
+}
+
+void ctkNetworkConnectorZeroMQTest::ctkNetworkConnectorZeroMQRoundTripBenchmark() {
+    QVariantList eventParameters;
+    QVariantList dataParameters;
+    ctkEventArgumentsList listToSend;
+    fillGlobalUpdateRequest(listToSend, eventParameters, dataParameters);
+
+    QBENCHMARK {
+        int expected = m_ObjectTest->var() + 1;
+        m_NetWorkConnectorZeroMQ->send("ctk/remote/eventBus/comunication/send/zeromq", &listToSend);
+        QVERIFY(waitForValue(m_ObjectTest, expected));
+    }
+}
+
+void ctkNetworkConnectorZeroMQTest::ctkNetworkConnectorZeroMQPublishTest() {
+#ifdef Q_OS_WIN
+    QSKIP("ipc transport is not available on Windows", SkipAll);
+#else
+    m_NetWorkConnectorZeroMQ->bindServer("ipc:///tmp/ctkNetworkConnectorZeroMQTest-request", "ipc:///tmp/ctkNetworkConnectorZeroMQTest-publish");
+    m_NetWorkConnectorZeroMQ->startListen();
+    m_NetWorkConnectorZeroMQ->subscribe("ctk/local/zeromq/");
+    QVERIFY(m_NetWorkConnectorZeroMQ->connectClient("ipc:///tmp/ctkNetworkConnectorZeroMQTest-request", "ipc:///tmp/ctkNetworkConnectorZeroMQTest-publish"));
+
+    ctkRegisterLocalSignal("ctk/local/zeromq/setValue", m_ObjectTest, "valueModified(int)");
+    ctkRegisterLocalCallback("ctk/local/zeromq/setValue", m_ObjectTest, "setObjectValue(int)");
+
+    int value = 42;
+    ctkEventArgumentsList listToSend;
+    listToSend.append(ctkEventArgument(int, value));
+
+    // the subscription needs some time to reach the publisher: publish until the event is received.
     QTime dieTime = QTime::currentTime().addSecs(3);
-    while(QTime::currentTime() < dieTime) {
-       QCoreApplication::processEvents(QEventLoop::AllEvents, 3);
+    while(m_ObjectTest->var() != value && QTime::currentTime() < dieTime) {
+        m_NetWorkConnectorZeroMQ->publish("ctk/local/zeromq/setValue", &listToSend);
+        waitForValue(m_ObjectTest, value, 50);
     }
+    QCOMPARE(m_ObjectTest->var(), value);
+#endif
 }
 
 CTK_REGISTER_TEST(ctkNetworkConnectorZeroMQTest);
 #include "ctkNetworkConnectorZeroMQTest.moc"
-
@@ -12,6 +12,8 @@
 #include "ctkTopicRegistry.h"
 #include "ctkNetworkConnectorQtSoap.h"
 #include "ctkNetworkConnectorQXMLRPC.h"
+#include "ctkNetworkConnectorZeroMQ.h"
+#include "ctkNetworkConnectorBinary.h"
 
 using namespace ctkEventBus;
 
@@ -67,6 +69,8 @@ void ctkEventBusManager::shutdown() {
 void ctkEventBusManager::initializeNetworkConnectors() {
     plugNetworkConnector("SOAP", new ctkNetworkConnectorQtSoap());
     plugNetworkConnector("XMLRPC", new ctkNetworkConnectorQXMLRPC());
+    plugNetworkConnector("ZEROMQ", new ctkNetworkConnectorZeroMQ());
+    plugNetworkConnector("BINARY", new ctkNetworkConnectorBinary());
 }
 
 bool ctkEventBusManager::addEventProperty(ctkBusEvent &props) const {
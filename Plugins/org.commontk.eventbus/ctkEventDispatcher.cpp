@@ -42,6 +42,7 @@ void ctkEventDispatcher::resetHashes() {
         delete i.value();
     }
     m_SignalsHash.clear();
+    m_SignalMethodsHash.clear();
 }
 
 void ctkEventDispatcher::initializeGlobalEvents() {
@@ -144,6 +145,7 @@ bool ctkEventDispatcher::removeEventItem(ctkBusEvent &props) {
                 i++;
             }
             m_SignalsHash.remove(props[TOPIC].toString()); //in signal hash the id is unique
+            m_SignalMethodsHash.remove(props[TOPIC].toString());
             m_CallbacksHash.remove(props[TOPIC].toString()); //remove also all the id associated in callback
         }
 
@@ -236,6 +238,9 @@ bool ctkEventDispatcher::removeFromHash(ctkEventsHashType *hash, const QObject *
                 }
                 disconnectItem = disconnectItem && currentDisconnetFlag;
                 if(currentDisconnetFlag) {
+                    if(hash == &m_SignalsHash) {
+                        m_SignalMethodsHash.remove(topic);
+                    }
                     delete i.value();
                     i = hash->erase(i);
                 } else {
@@ -267,6 +272,9 @@ bool ctkEventDispatcher::removeFromHash(ctkEventsHashType *hash, const QObject *
                 }
                 disconnectItem = disconnectItem && currentDisconnetFlag;
                 if(currentDisconnetFlag) {
+                    if(hash == &m_SignalsHash) {
+                        m_SignalMethodsHash.remove(i.key());
+                    }
                     delete i.value();
                     i = hash->erase(i);
                 } else {
@@ -319,6 +327,7 @@ bool ctkEventDispatcher::registerSignal(ctkBusEvent &props) {
         // Add the new signal to the Hash.
         ctkBusEvent *dict = const_cast<ctkBusEvent *>(&props);
         this->m_SignalsHash.insert(topic, dict);
+        resolveSignalMethod(topic, props);
         return true;
     }
 
@@ -342,6 +351,7 @@ bool ctkEventDispatcher::registerSignal(ctkBusEvent &props) {
          }
          ctkBusEvent *dict = const_cast<ctkBusEvent *>(&props);
          this->m_SignalsHash.insert(topic, dict);
+         resolveSignalMethod(topic, props);
     }
 
     return cumulativeConnect;
@@ -351,6 +361,26 @@ bool ctkEventDispatcher::removeSignal(ctkBusEvent &props) {
     return removeEventItem(props);
 }
 
+void ctkEventDispatcher::resolveSignalMethod(const QString &topic, ctkBusEvent &props) {
+    QObject *obj = props[OBJECT].value<QObject *>();
+    QString sig = props[SIGNATURE].toString();
+    if(obj == NULL || sig.isEmpty()) {
+        return;
+    }
+
+    QByteArray normalizedSig = QMetaObject::normalizedSignature(sig.toAscii());
+    int index = obj->metaObject()->indexOfMethod(normalizedSig);
+    if(index < 0) {
+        qWarning("%s", tr("Signal %1 not found in object %2 for topic '%3'").arg(sig, obj->metaObject()->className(), topic).toAscii().data());
+        return;
+    }
+
+    ctkEventSignalMethod item;
+    item.object = obj;
+    item.method = obj->metaObject()->method(index);
+    m_SignalMethodsHash.insert(topic, item);
+}
+
 void ctkEventDispatcher::notifyEvent(ctkBusEvent &event_dictionary, ctkEventArgumentsList *argList, ctkGenericReturnArgument *returnArg) const {
     Q_UNUSED(event_dictionary);
     Q_UNUSED(argList);
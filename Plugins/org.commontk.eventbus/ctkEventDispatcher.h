@@ -14,8 +14,19 @@
 
 #include "ctkEventDefinitions.h"
 
+#include <QMetaMethod>
+
 namespace ctkEventBus {
 
+/// Signal resolved at registration time, used to emit the events of a topic without per-event lookups.
+struct ctkEventSignalMethod {
+    QObject *object; ///< Object owning the signal.
+    QMetaMethod method; ///< Pre-resolved signal method.
+};
+
+/// Types definitions for the resolved signals' hash.
+typedef QHash<QString, ctkEventSignalMethod> ctkEventSignalMethodsHash;
+
 /**
  Class name: ctkEventDispatcher
  This allows dispatching events coming from local application to attached observers.
@@ -82,6 +93,9 @@ protected:
     /// Return the signal item property associated to the given ID.
     ctkEventItemListType signalItemProperty(const QString topic) const;
 
+    /// Return the signal resolved at registration for the given topic, NULL if not present.
+    const ctkEventSignalMethod *signalMethod(const QString &topic) const;
+
 private:
     /// method used to check if the given object has been already registered for the given id and signature.
     bool isSignaturePresent(ctkBusEvent &props) const;
@@ -96,8 +110,12 @@ private:
     /// Remove the given object from the has passed as argument
     bool removeFromHash(ctkEventsHashType *hash, const QObject *obj, const QString topic, bool qt_disconnect = true);
 
+    /// Resolve the signal of the given property once and store it into the resolved signals' hash.
+    void resolveSignalMethod(const QString &topic, ctkBusEvent &props);
+
     ctkEventsHashType m_CallbacksHash; ///< Callbacks' hash for receiving events like updates or refreshes.
     ctkEventsHashType m_SignalsHash; ///< Signals' hash for sending events.
+    ctkEventSignalMethodsHash m_SignalMethodsHash; ///< Signals resolved to their QMetaMethod, used for dispatching.
 };
 
 /////////////////////////////////////////////////////////////
@@ -108,6 +126,11 @@ inline ctkEventItemListType ctkEventDispatcher::signalItemProperty(const QString
     return m_SignalsHash.values(topic);
 }
 
+inline const ctkEventSignalMethod *ctkEventDispatcher::signalMethod(const QString &topic) const {
+    ctkEventSignalMethodsHash::const_iterator i = m_SignalMethodsHash.constFind(topic);
+    return i != m_SignalMethodsHash.constEnd() ? &(i.value()) : NULL;
+}
+
 } // namespace ctkEventBus
 
 #endif // CTKEVENTDISPATCHER_H
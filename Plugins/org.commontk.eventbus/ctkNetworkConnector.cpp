@@ -10,6 +10,9 @@
  */
 
 #include "ctkNetworkConnector.h"
+#include "ctkEventBusManager.h"
+
+#include <QDataStream>
 
 using namespace ctkEventBus;
 
@@ -20,3 +23,67 @@ ctkNetworkConnector::ctkNetworkConnector() {
 QString ctkNetworkConnector::protocol() {
     return m_Protocol;
 }
+
+bool ctkNetworkConnector::writeArguments(QDataStream &stream, ctkEventArgumentsList *argList) {
+    QVariantList variants;
+    if(argList != NULL) {
+        int i = 0, size = argList->count();
+        for(; i < size; ++i) {
+            const QGenericArgument &arg = argList->at(i);
+            int type = QMetaType::type(arg.name());
+            if(type == 0) {
+                qWarning("%s", tr("Argument of type %1 can not be sent over network").arg(arg.name()).toAscii().data());
+                return false;
+            }
+            variants.append(QVariant(type, arg.data()));
+        }
+    }
+    stream << variants;
+    return stream.status() == QDataStream::Ok;
+}
+
+bool ctkNetworkConnector::readArguments(QDataStream &stream, QVariantList &arguments) {
+    stream >> arguments;
+    return stream.status() == QDataStream::Ok;
+}
+
+ctkEventArgumentsList ctkNetworkConnector::argumentsFromVariants(QVariantList &variants) {
+    ctkEventArgumentsList argList;
+    QVariantList::iterator it = variants.begin();
+    for(; it != variants.end(); ++it) {
+        argList.append(QGenericArgument(it->typeName(), it->data()));
+    }
+    return argList;
+}
+
+bool ctkNetworkConnector::notifyRemoteRequest(const QVariantList &arguments) {
+    enum {
+      EVENT_PARAMETERS,
+      DATA_PARAMETERS,
+    };
+
+    if(arguments.isEmpty() || arguments.at(EVENT_PARAMETERS).toList().isEmpty()) {
+        return false;
+    }
+
+    //first argument regards local signal to be called.
+    QString id_name = arguments.at(EVENT_PARAMETERS).toList().at(0).toString();
+    if(!ctkEventBusManager::instance()->isLocalSignalPresent(id_name)) {
+        return false;
+    }
+
+    ctkEventArgumentsList *argList = NULL;
+    QVariantList p;
+    if(arguments.count() > DATA_PARAMETERS) {
+        p = arguments.at(DATA_PARAMETERS).toList();
+    }
+    if(p.count() != 0) {
+        argList = new ctkEventArgumentsList();
+        argList->push_back(Q_ARG(QVariantList, p));
+    }
+
+    ctkBusEvent dictionary(id_name, ctkEventTypeLocal, 0, NULL, "");
+    ctkEventBusManager::instance()->notifyEvent(dictionary, argList);
+    delete argList;
+    return true;
+}
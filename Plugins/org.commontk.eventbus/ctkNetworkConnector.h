@@ -15,6 +15,8 @@
 //include list
 #include "ctkEventDefinitions.h"
 
+class QDataStream;
+
 namespace ctkEventBus {
 
 /**
@@ -56,6 +58,24 @@ Q_SIGNALS:
     void remoteCommunication(const QString event_id, ctkEventArgumentsList *argList);
 
 protected:
+    /// Write the arguments of an event into the stream as a list of QVariant.
+    /** Every argument type must be known to QMetaType and streamable through QDataStream.
+    Return false (and write nothing) if one of the arguments can not be encoded. */
+    static bool writeArguments(QDataStream &stream, ctkEventArgumentsList *argList);
+
+    /// Read a list of arguments previously written by writeArguments.
+    static bool readArguments(QDataStream &stream, QVariantList &arguments);
+
+    /// Build an arguments list which points to the values stored into the given variants.
+    /** The returned list is valid as long as the variants are alive and unmodified. */
+    static ctkEventArgumentsList argumentsFromVariants(QVariantList &variants);
+
+    /// Dispatch locally a remote request received by the server side of the connector.
+    /** The first argument contains the event parameters (the first one is the local topic to notify),
+    the second one (optional) contains the data parameters forwarded as a QVariantList.
+    Return true if the topic has been found and notified. */
+    static bool notifyRemoteRequest(const QVariantList &arguments);
+
     QString m_Protocol; ///< define the protocol of the connector (xmlrpc, soap, etc...)
 };
 
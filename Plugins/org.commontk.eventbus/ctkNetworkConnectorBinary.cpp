@@ -0,0 +1,283 @@
+/*
+ *  ctkNetworkConnectorBinary.cpp
+ *  ctkEventBus
+ *
+ *  Created by Daniele Giunchi on 11/04/10.
+ *  Copyright 2009 B3C. All rights reserved.
+ *
+ *  See Licence at: http://tiny.cc/QXJ4D
+ *
+ */
+
+#include "ctkNetworkConnectorBinary.h"
+#include "ctkEventBusManager.h"
+
+#include <QDataStream>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QtEndian>
+
+using namespace ctkEventBus;
+
+/// Size of the queued requests over which they are written without waiting for the end of the event loop iteration.
+#define CTK_BINARY_MAX_BATCH_SIZE 65536
+/// Frames announced bigger than this are considered as garbage and close the connection.
+#define CTK_BINARY_MAX_FRAME_SIZE (64 * 1024 * 1024)
+
+ctkNetworkConnectorBinary::ctkNetworkConnectorBinary() : ctkNetworkConnector(), m_Client(NULL), m_Server(NULL),
+    m_FlushScheduled(false), m_RequestId(0), m_Port(0) {
+    m_Protocol = "BINARY";
+}
+
+void ctkNetworkConnectorBinary::initializeForEventBus() {
+    ctkRegisterRemoteSignal("ctk/remote/eventBus/comunication/send/binary", this, "remoteCommunication(const QString, ctkEventArgumentsList *)");
+    ctkRegisterRemoteCallback("ctk/remote/eventBus/comunication/send/binary", this, "send(const QString, ctkEventArgumentsList *)");
+}
+
+ctkNetworkConnectorBinary::~ctkNetworkConnectorBinary() {
+    if(m_Client) {
+        m_Client->disconnect(this);
+        delete m_Client;
+        m_Client = NULL;
+    }
+    if(m_Server) {
+        stopServer();
+    }
+}
+
+//retrieve an instance of the object
+ctkNetworkConnector *ctkNetworkConnectorBinary::clone() {
+    ctkNetworkConnectorBinary *copy = new ctkNetworkConnectorBinary();
+    return copy;
+}
+
+void ctkNetworkConnectorBinary::appendFrame(QByteArray &buffer, const QByteArray &payload) {
+    uchar length[sizeof(quint32)];
+    qToBigEndian<quint32>(payload.size(), length);
+    buffer.append(reinterpret_cast<const char *>(length), sizeof(length));
+    buffer.append(payload);
+}
+
+bool ctkNetworkConnectorBinary::takeFrames(QByteArray &buffer, QList<QByteArray> &frames) {
+    int offset = 0;
+    while(buffer.size() - offset >= int(sizeof(quint32))) {
+        quint32 length = qFromBigEndian<quint32>(reinterpret_cast<const uchar *>(buffer.constData() + offset));
+        if(length > CTK_BINARY_MAX_FRAME_SIZE) {
+            buffer.clear();
+            return false;
+        }
+        if(quint32(buffer.size() - offset) - sizeof(quint32) < length) {
+            break;
+        }
+        frames.append(buffer.mid(offset + sizeof(quint32), length));
+        offset += sizeof(quint32) + length;
+    }
+    buffer.remove(0, offset);
+    return true;
+}
+
+void ctkNetworkConnectorBinary::createClient(const QString hostName, const unsigned int port) {
+    if(m_Client == NULL) {
+        m_Client = new QTcpSocket(this);
+        m_Client->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+        connect(m_Client, SIGNAL(connected()), this, SLOT(flush()));
+        connect(m_Client, SIGNAL(readyRead()), this, SLOT(readReplies()));
+        connect(m_Client, SIGNAL(disconnected()), this, SLOT(clientDisconnected()));
+    } else {
+        m_Client->abort();
+        clientDisconnected();
+    }
+    m_Client->connectToHost(hostName, port);
+}
+
+void ctkNetworkConnectorBinary::createServer(const unsigned int port) {
+    if(m_Server != NULL && m_Port != port) {
+        stopServer();
+    }
+    if(m_Server == NULL) {
+        m_Server = new QTcpServer(this);
+        connect(m_Server, SIGNAL(newConnection()), this, SLOT(acceptConnections()));
+    }
+    m_Port = port;
+}
+
+void ctkNetworkConnectorBinary::stopServer() {
+    foreach(QTcpSocket *connection, m_ServerBuffers.keys()) {
+        connection->disconnect(this);
+        connection->deleteLater();
+    }
+    m_ServerBuffers.clear();
+    if(m_Server) {
+        delete m_Server;
+        m_Server = NULL;
+    }
+}
+
+void ctkNetworkConnectorBinary::startListen() {
+    if(m_Server == NULL) {
+        qWarning("%s", tr("Server can not start. Create it first, then call startListen again!!").toAscii().data());
+        return;
+    }
+    if(m_Server->isListening()) {
+        qDebug("%s", tr("Server is already listening on port %1").arg(m_Port).toAscii().data());
+        return;
+    }
+    if(m_Server->listen(QHostAddress::Any, m_Port)) {
+        qDebug() << "Listening for binary requests on port" << m_Port;
+    } else {
+        qDebug() << "Error listening port" << m_Port << m_Server->errorString();
+    }
+}
+
+int ctkNetworkConnectorBinary::pendingRequestsCount() const {
+    return m_PendingRequests.count();
+}
+
+void ctkNetworkConnectorBinary::send(const QString event_id, ctkEventArgumentsList *argList) {
+    if(m_Client == NULL) {
+        qWarning("%s", tr("Client not created, call createClient before sending requests").toAscii().data());
+        return;
+    }
+    if(argList == NULL || argList->count() == 0) {
+        qWarning("%s", tr("Remote Dispatcher need to have at least one argument that is a QVariantList").toAscii().data());
+        return;
+    }
+
+    QByteArray payload;
+    QDataStream out(&payload, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_4_6);
+    int requestId = ++m_RequestId;
+    out << qint32(requestId) << event_id;
+    if(!writeArguments(out, argList)) {
+        return;
+    }
+
+    appendFrame(m_OutgoingBuffer, payload);
+    m_PendingRequests.insert(requestId);
+
+    if(m_OutgoingBuffer.size() >= CTK_BINARY_MAX_BATCH_SIZE) {
+        flush();
+    } else if(!m_FlushScheduled) {
+        m_FlushScheduled = true;
+        QMetaObject::invokeMethod(this, "flush", Qt::QueuedConnection);
+    }
+}
+
+void ctkNetworkConnectorBinary::flush() {
+    m_FlushScheduled = false;
+    // requests are kept until the connection is established, then flushed by the connected() signal.
+    if(m_OutgoingBuffer.isEmpty() || m_Client == NULL || m_Client->state() != QAbstractSocket::ConnectedState) {
+        return;
+    }
+    m_Client->write(m_OutgoingBuffer);
+    m_OutgoingBuffer.clear();
+}
+
+void ctkNetworkConnectorBinary::readReplies() {
+    m_ClientBuffer.append(m_Client->readAll());
+
+    QList<QByteArray> frames;
+    if(!takeFrames(m_ClientBuffer, frames)) {
+        qWarning("%s", tr("Binary reply frame bigger than %1 bytes, closing the connection").arg(CTK_BINARY_MAX_FRAME_SIZE).toAscii().data());
+        m_Client->abort();
+        return;
+    }
+    foreach(QByteArray frame, frames) {
+        QDataStream in(frame);
+        in.setVersion(QDataStream::Qt_4_6);
+        qint32 requestId = 0;
+        QString value;
+        in >> requestId >> value;
+        if(in.status() != QDataStream::Ok) {
+            qWarning("%s", tr("Malformed binary reply frame, closing the connection").toAscii().data());
+            m_Client->abort();
+            return;
+        }
+        processReturnValue(requestId, value);
+    }
+}
+
+void ctkNetworkConnectorBinary::clientDisconnected() {
+    m_ClientBuffer.clear();
+    m_OutgoingBuffer.clear();
+    int i = 0, size = m_PendingRequests.count();
+    m_PendingRequests.clear();
+    for(; i < size; ++i) {
+        ctkEventBusManager::instance()->notifyEvent("ctk/local/eventBus/remoteCommunicationFailed", ctkEventTypeLocal);
+    }
+}
+
+void ctkNetworkConnectorBinary::acceptConnections() {
+    while(m_Server->hasPendingConnections()) {
+        QTcpSocket *connection = m_Server->nextPendingConnection();
+        connection->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+        m_ServerBuffers.insert(connection, QByteArray());
+        connect(connection, SIGNAL(readyRead()), this, SLOT(readRequests()));
+        connect(connection, SIGNAL(disconnected()), this, SLOT(serverConnectionClosed()));
+    }
+}
+
+void ctkNetworkConnectorBinary::readRequests() {
+    QTcpSocket *connection = qobject_cast<QTcpSocket *>(QObject::sender());
+    if(connection == NULL || !m_ServerBuffers.contains(connection)) {
+        return;
+    }
+
+    QByteArray &buffer = m_ServerBuffers[connection];
+    buffer.append(connection->readAll());
+
+    QList<QByteArray> frames;
+    if(!takeFrames(buffer, frames)) {
+        qWarning("%s", tr("Binary request frame bigger than %1 bytes, closing the connection").arg(CTK_BINARY_MAX_FRAME_SIZE).toAscii().data());
+        connection->abort();
+        return;
+    }
+
+    // replies of all the requests received in this read are written at once.
+    QByteArray replies;
+    foreach(QByteArray frame, frames) {
+        QDataStream in(frame);
+        in.setVersion(QDataStream::Qt_4_6);
+        qint32 requestId = 0;
+        QString methodName;
+        QVariantList arguments;
+        in >> requestId >> methodName;
+        if(in.status() != QDataStream::Ok) {
+            // the request can not be answered without its id, the peer is not speaking this protocol.
+            qWarning("%s", tr("Malformed binary request frame, closing the connection").toAscii().data());
+            connection->abort();
+            return;
+        }
+
+        //here eventually can be used a filter for events, based on methodName
+        bool res = readArguments(in, arguments) && notifyRemoteRequest(arguments);
+
+        QByteArray reply;
+        QDataStream out(&reply, QIODevice::WriteOnly);
+        out.setVersion(QDataStream::Qt_4_6);
+        out << requestId << QString(res ? "OK" : "FAIL");
+        appendFrame(replies, reply);
+    }
+
+    if(!replies.isEmpty()) {
+        connection->write(replies);
+    }
+}
+
+void ctkNetworkConnectorBinary::serverConnectionClosed() {
+    QTcpSocket *connection = qobject_cast<QTcpSocket *>(QObject::sender());
+    if(connection && m_ServerBuffers.remove(connection)) {
+        connection->deleteLater();
+    }
+}
+
+void ctkNetworkConnectorBinary::processReturnValue( int requestId, QVariant value ) {
+    if(!m_PendingRequests.remove(requestId)) {
+        return;
+    }
+    if(value.toString() == "OK") {
+        ctkEventBusManager::instance()->notifyEvent("ctk/local/eventBus/remoteCommunicationDone", ctkEventTypeLocal);
+    } else {
+        ctkEventBusManager::instance()->notifyEvent("ctk/local/eventBus/remoteCommunicationFailed", ctkEventTypeLocal);
+    }
+}
@@ -0,0 +1,113 @@
+/*
+ *  ctkNetworkConnectorBinary.h
+ *  ctkEventBus
+ *
+ *  Created by Daniele Giunchi on 11/04/10.
+ *  Copyright 2009 B3C. All rights reserved.
+ *
+ *  See Licence at: http://tiny.cc/QXJ4D
+ *
+ */
+
+#ifndef ctkNetworkConnectorBinary_H
+#define ctkNetworkConnectorBinary_H
+
+// include list
+#include "ctkNetworkConnector.h"
+
+#include <QSet>
+
+class QTcpServer;
+class QTcpSocket;
+
+namespace ctkEventBus {
+
+/**
+ Class name: ctkNetworkConnectorBinary
+ This class is the implementation class for client/server objects that works over a persistent
+ tcp connection with a binary protocol. Each message is a frame made of a 32 bit length followed
+ by a payload serialized with QDataStream. Requests carry a correlation id which is echoed by the
+ reply, so the client does not wait for a reply before sending the next request (pipelining);
+ requests sent during the same event loop iteration are written to the socket in a single batch.
+ */
+class org_commontk_eventbus_EXPORT ctkNetworkConnectorBinary : public ctkNetworkConnector {
+    Q_OBJECT
+
+public:
+    /// object constructor.
+    ctkNetworkConnectorBinary();
+
+    /// object destructor.
+    /*virtual*/ ~ctkNetworkConnectorBinary();
+
+    /// create the unique instance of the client.
+    /*virtual*/ void createClient(const QString hostName, const unsigned int port);
+
+    /// create the unique instance of the server.
+    /*virtual*/ void createServer(const unsigned int port);
+
+    /// Start the server.
+    /*virtual*/ void startListen();
+
+    //retrieve an instance of the object
+    /*virtual*/ ctkNetworkConnector *clone();
+
+    /// register all the signals and slots
+    /*virtual*/ void initializeForEventBus();
+
+    /// Return the number of requests sent whose reply has not been received yet.
+    int pendingRequestsCount() const;
+
+public Q_SLOTS:
+    /// Allow to send a network request.
+    /** The request is queued and written with the other requests sent during the same event loop iteration. */
+    /*virtual*/ void send(const QString event_id, ctkEventArgumentsList *argList);
+
+    /// Write immediately all the queued requests.
+    void flush();
+
+private Q_SLOTS:
+    /// callback for the client which retrieve the variable from the server
+    virtual void processReturnValue( int requestId, QVariant value );
+
+    /// read the replies received by the client.
+    void readReplies();
+
+    /// the client lost the connection: pending requests are failed.
+    void clientDisconnected();
+
+    /// accept the connections waiting on the server.
+    void acceptConnections();
+
+    /// read the requests received on a server connection.
+    void readRequests();
+
+    /// forget a closed server connection.
+    void serverConnectionClosed();
+
+private:
+    /// stop and destroy the server instance.
+    void stopServer();
+
+    /// append a complete frame (length + payload) to the buffer.
+    static void appendFrame(QByteArray &buffer, const QByteArray &payload);
+
+    /// move the complete frames available at the beginning of the buffer into the list.
+    /// Return false if a frame is announced bigger than CTK_BINARY_MAX_FRAME_SIZE; the connection has then to be closed.
+    static bool takeFrames(QByteArray &buffer, QList<QByteArray> &frames);
+
+    QTcpSocket *m_Client; ///< persistent connection of the client.
+    QTcpServer *m_Server; ///< server accepting the client connections.
+    QHash<QTcpSocket *, QByteArray> m_ServerBuffers; ///< partial frames received on each server connection.
+    QByteArray m_ClientBuffer; ///< partial frames received by the client.
+    QByteArray m_OutgoingBuffer; ///< requests waiting to be written.
+    bool m_FlushScheduled; ///< true if a flush is already scheduled in the event loop.
+    QSet<int> m_PendingRequests; ///< correlation ids of the requests waiting for a reply.
+    int m_RequestId; ///< correlation id of the last request.
+    unsigned int m_Port; ///< port of the server.
+};
+
+} //namespace ctkEventBus
+
+
+#endif // ctkNetworkConnectorBinary_H
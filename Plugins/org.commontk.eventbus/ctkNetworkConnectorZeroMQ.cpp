@@ -12,22 +12,42 @@
 #include "ctkNetworkConnectorZeroMQ.h"
 #include "ctkEventBusManager.h"
 
-#include <service/event/ctkEvent.h>
+#include <QDataStream>
+#include <QSocketNotifier>
 
-using namespace ctkEventBus;
+#include <zmq.h>
+
+#include <cstring>
 
-ctkNetworkConnectorZeroMQ::ctkNetworkConnectorZeroMQ() : ctkNetworkConnector() {
+// 0MQ 2.0 only knows the old names of the request/response sockets.
+#ifndef ZMQ_DEALER
+#define ZMQ_DEALER ZMQ_XREQ
+#endif
+#ifndef ZMQ_ROUTER
+#define ZMQ_ROUTER ZMQ_XREP
+#endif
 
-    m_Protocol = "SOCKET";
+using namespace ctkEventBus;
+
+ctkNetworkConnectorZeroMQ::ctkNetworkConnectorZeroMQ() : ctkNetworkConnector(), m_Context(NULL),
+    m_DealerSocket(NULL), m_SubscriberSocket(NULL), m_RouterSocket(NULL), m_PublisherSocket(NULL),
+    m_DealerNotifier(NULL), m_SubscriberNotifier(NULL), m_RouterNotifier(NULL), m_RequestId(0) {
+    m_Protocol = "ZEROMQ";
 }
 
 void ctkNetworkConnectorZeroMQ::initializeForEventBus() {
-    //ctkRegisterRemoteSignal("ctk/remote/eventBus/comunication/??????????", this, "remoteCommunication(const QString, ctkEventArgumentsList *)");
-    //ctkRegisterRemoteCallback("ctk/remote/eventBus/comunication/????????????", this, "send(const QString, ctkEventArgumentsList *)");
+    ctkRegisterRemoteSignal("ctk/remote/eventBus/comunication/send/zeromq", this, "remoteCommunication(const QString, ctkEventArgumentsList *)");
+    ctkRegisterRemoteCallback("ctk/remote/eventBus/comunication/send/zeromq", this, "send(const QString, ctkEventArgumentsList *)");
 }
 
 ctkNetworkConnectorZeroMQ::~ctkNetworkConnectorZeroMQ() {
+    stopClient();
+    stopServer();
+    if(m_Context) {
+        zmq_term(m_Context);
+        m_Context = NULL;
     }
+}
 
 //retrieve an instance of the object
 ctkNetworkConnector *ctkNetworkConnectorZeroMQ::clone() {
@@ -35,35 +55,299 @@ ctkNetworkConnector *ctkNetworkConnectorZeroMQ::clone() {
     return copy;
 }
 
+void *ctkNetworkConnectorZeroMQ::createSocket(int type, QSocketNotifier **notifier, const char *member) {
+    // the context and its I/O thread are only created when the connector is started.
+    if(m_Context == NULL) {
+        m_Context = zmq_init(1);
+        if(m_Context == NULL) {
+            qWarning("%s", tr("Unable to create the 0MQ context: %1").arg(zmq_strerror(zmq_errno())).toAscii().data());
+            return NULL;
+        }
+    }
+
+    void *socket = zmq_socket(m_Context, type);
+    if(socket == NULL) {
+        qWarning("%s", tr("Unable to create the 0MQ socket: %1").arg(zmq_strerror(zmq_errno())).toAscii().data());
+        return NULL;
+    }
+
+#ifdef ZMQ_LINGER
+    // Do not keep pending messages alive when the connector is destroyed.
+    int linger = 0;
+    zmq_setsockopt(socket, ZMQ_LINGER, &linger, sizeof(linger));
+#endif
+
+    if(notifier) {
+#ifdef Q_OS_WIN
+        SOCKET fd;
+#else
+        int fd;
+#endif
+        size_t size = sizeof(fd);
+        zmq_getsockopt(socket, ZMQ_FD, &fd, &size);
+        // The descriptor is edge triggered: the connected slot must read all the pending messages.
+        *notifier = new QSocketNotifier(static_cast<int>(fd), QSocketNotifier::Read, this);
+        connect(*notifier, SIGNAL(activated(int)), this, member);
+    }
+    return socket;
+}
+
+void ctkNetworkConnectorZeroMQ::closeSocket(void **socket, QSocketNotifier **notifier) {
+    if(notifier && *notifier) {
+        delete *notifier;
+        *notifier = NULL;
+    }
+    if(*socket) {
+        zmq_close(*socket);
+        *socket = NULL;
+    }
+}
+
+bool ctkNetworkConnectorZeroMQ::hasPendingMessage(void *socket) const {
+    if(socket == NULL) {
+        return false;
+    }
+    quint32 events = 0;
+    size_t size = sizeof(events);
+    return zmq_getsockopt(socket, ZMQ_EVENTS, &events, &size) == 0 && (events & ZMQ_POLLIN);
+}
+
+bool ctkNetworkConnectorZeroMQ::receiveMessage(void *socket, QList<QByteArray> &parts) {
+    parts.clear();
+    qint64 more = 0;
+    do {
+        zmq_msg_t msg;
+        zmq_msg_init(&msg);
+        // only the first part can be missing, the others are delivered atomically with it.
+        if(zmq_recv(socket, &msg, ZMQ_NOBLOCK) != 0) {
+            zmq_msg_close(&msg);
+            return false;
+        }
+        parts.append(QByteArray(static_cast<const char *>(zmq_msg_data(&msg)), zmq_msg_size(&msg)));
+        zmq_msg_close(&msg);
+
+        size_t size = sizeof(more);
+        zmq_getsockopt(socket, ZMQ_RCVMORE, &more, &size);
+    } while(more);
+    return true;
+}
+
+bool ctkNetworkConnectorZeroMQ::sendMessage(void *socket, const QList<QByteArray> &parts) {
+    int i = 0, size = parts.count();
+    for(; i < size; ++i) {
+        const QByteArray &part = parts.at(i);
+        zmq_msg_t msg;
+        zmq_msg_init_size(&msg, part.size());
+        memcpy(zmq_msg_data(&msg), part.constData(), part.size());
+        int rc = zmq_send(socket, &msg, i < size - 1 ? ZMQ_SNDMORE : 0);
+        zmq_msg_close(&msg);
+        if(rc != 0) {
+            qWarning("%s", tr("Unable to send the 0MQ message: %1").arg(zmq_strerror(zmq_errno())).toAscii().data());
+            return false;
+        }
+    }
+    return true;
+}
+
 void ctkNetworkConnectorZeroMQ::createClient(const QString hostName, const unsigned int port) {
-    Q_UNUSED(hostName);
-    Q_UNUSED(port);
-    //@@ TODO
+    connectClient(QString("tcp://%1:%2").arg(hostName).arg(port),
+                  QString("tcp://%1:%2").arg(hostName).arg(port + 1));
+}
+
+bool ctkNetworkConnectorZeroMQ::connectClient(const QString &requestEndpoint, const QString &publishEndpoint) {
+    stopClient();
+
+    m_DealerSocket = createSocket(ZMQ_DEALER, &m_DealerNotifier, SLOT(readReplies()));
+    m_SubscriberSocket = createSocket(ZMQ_SUB, &m_SubscriberNotifier, SLOT(readPublished()));
+    if(m_DealerSocket == NULL || m_SubscriberSocket == NULL) {
+        stopClient();
+        return false;
+    }
+
+    if(zmq_connect(m_DealerSocket, requestEndpoint.toAscii().constData()) != 0 ||
+       zmq_connect(m_SubscriberSocket, publishEndpoint.toAscii().constData()) != 0) {
+        qWarning("%s", tr("Unable to connect to %1: %2").arg(requestEndpoint, zmq_strerror(zmq_errno())).toAscii().data());
+        stopClient();
+        return false;
+    }
+
+    foreach(QString topicPrefix, m_Subscriptions) {
+        QByteArray prefix = topicPrefix.toUtf8();
+        zmq_setsockopt(m_SubscriberSocket, ZMQ_SUBSCRIBE, prefix.constData(), prefix.size());
+    }
+    return true;
+}
+
+void ctkNetworkConnectorZeroMQ::stopClient() {
+    closeSocket(&m_DealerSocket, &m_DealerNotifier);
+    closeSocket(&m_SubscriberSocket, &m_SubscriberNotifier);
+}
+
+void ctkNetworkConnectorZeroMQ::subscribe(const QString &topicPrefix) {
+    if(m_Subscriptions.contains(topicPrefix)) {
+        return;
+    }
+    m_Subscriptions.append(topicPrefix);
+    if(m_SubscriberSocket) {
+        QByteArray prefix = topicPrefix.toUtf8();
+        zmq_setsockopt(m_SubscriberSocket, ZMQ_SUBSCRIBE, prefix.constData(), prefix.size());
+    }
 }
 
 void ctkNetworkConnectorZeroMQ::createServer(const unsigned int port) {
-   Q_UNUSED(port);
-   //@@ TODO
+    bindServer(QString("tcp://*:%1").arg(port), QString("tcp://*:%1").arg(port + 1));
 }
 
-void ctkNetworkConnectorZeroMQ::stopServer() {
-    //@@ TODO
+void ctkNetworkConnectorZeroMQ::bindServer(const QString &requestEndpoint, const QString &publishEndpoint) {
+    if(m_RouterSocket != NULL && (m_RequestEndpoint != requestEndpoint || m_PublishEndpoint != publishEndpoint)) {
+        stopServer();
+    }
+    m_RequestEndpoint = requestEndpoint;
+    m_PublishEndpoint = publishEndpoint;
 }
 
+void ctkNetworkConnectorZeroMQ::stopServer() {
+    closeSocket(&m_RouterSocket, &m_RouterNotifier);
+    closeSocket(&m_PublisherSocket, NULL);
+}
 
 void ctkNetworkConnectorZeroMQ::startListen() {
-    //@@ TODO
+    if(m_RouterSocket != NULL) {
+        qDebug("%s", tr("Server is already listening on %1").arg(m_RequestEndpoint).toAscii().data());
+        return;
+    }
+
+    m_RouterSocket = createSocket(ZMQ_ROUTER, &m_RouterNotifier, SLOT(readRequests()));
+    m_PublisherSocket = createSocket(ZMQ_PUB, NULL, NULL);
+    if(m_RouterSocket == NULL || m_PublisherSocket == NULL) {
+        stopServer();
+        return;
+    }
+
+    if(zmq_bind(m_RouterSocket, m_RequestEndpoint.toAscii().constData()) == 0 &&
+       zmq_bind(m_PublisherSocket, m_PublishEndpoint.toAscii().constData()) == 0) {
+        qDebug() << "Listening for 0MQ requests on" << m_RequestEndpoint;
+    } else {
+        qDebug() << "Error listening on" << m_RequestEndpoint << zmq_strerror(zmq_errno());
+        stopServer();
+    }
 }
 
 void ctkNetworkConnectorZeroMQ::send(const QString event_id, ctkEventArgumentsList *argList) {
-	Q_UNUSED(event_id);
-	Q_UNUSED(argList);
-    //@@ TODO
+    if(m_DealerSocket == NULL) {
+        qWarning("%s", tr("Client not created, call createClient before sending requests").toAscii().data());
+        return;
+    }
+    if(argList == NULL || argList->count() == 0) {
+        qWarning("%s", tr("Remote Dispatcher need to have at least one argument that is a QVariantList").toAscii().data());
+        return;
+    }
+
+    // payload: request id, method name and the arguments.
+    QByteArray payload;
+    QDataStream out(&payload, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_4_6);
+    out << qint32(++m_RequestId) << event_id;
+    if(!writeArguments(out, argList)) {
+        return;
+    }
+
+    sendMessage(m_DealerSocket, QList<QByteArray>() << payload);
+    // sending may have consumed the edge of the descriptor, so look for replies already arrived.
+    QMetaObject::invokeMethod(this, "readReplies", Qt::QueuedConnection);
 }
 
+void ctkNetworkConnectorZeroMQ::publish(const QString event_id, ctkEventArgumentsList *argList) {
+    if(m_PublisherSocket == NULL) {
+        qWarning("%s", tr("Server not listening, call startListen before publishing events").toAscii().data());
+        return;
+    }
+
+    QByteArray payload;
+    QDataStream out(&payload, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_4_6);
+    if(!writeArguments(out, argList)) {
+        return;
+    }
+
+    // the topic travels in its own frame so that subscribers can filter on it.
+    sendMessage(m_PublisherSocket, QList<QByteArray>() << event_id.toUtf8() << payload);
+}
+
+void ctkNetworkConnectorZeroMQ::readReplies() {
+    QList<QByteArray> parts;
+    while(hasPendingMessage(m_DealerSocket) && receiveMessage(m_DealerSocket, parts)) {
+        QDataStream in(parts.last());
+        in.setVersion(QDataStream::Qt_4_6);
+        qint32 requestId = 0;
+        QString value;
+        in >> requestId >> value;
+        if(in.status() != QDataStream::Ok) {
+            qWarning("%s", tr("Malformed ZeroMQ reply dropped").toAscii().data());
+            continue;
+        }
+        processReturnValue(requestId, value);
+    }
+}
+
+void ctkNetworkConnectorZeroMQ::readRequests() {
+    QList<QByteArray> parts;
+    while(hasPendingMessage(m_RouterSocket) && receiveMessage(m_RouterSocket, parts)) {
+        if(parts.count() < 2) {
+            continue;
+        }
+
+        QDataStream in(parts.last());
+        in.setVersion(QDataStream::Qt_4_6);
+        qint32 requestId = 0;
+        QString methodName;
+        QVariantList arguments;
+        in >> requestId >> methodName;
+        if(in.status() != QDataStream::Ok) {
+            // the request can not be answered without its id.
+            qWarning("%s", tr("Malformed ZeroMQ request dropped").toAscii().data());
+            continue;
+        }
+
+        //here eventually can be used a filter for events, based on methodName
+        bool res = readArguments(in, arguments) && notifyRemoteRequest(arguments);
+
+        QByteArray reply;
+        QDataStream out(&reply, QIODevice::WriteOnly);
+        out.setVersion(QDataStream::Qt_4_6);
+        out << requestId << QString(res ? "OK" : "FAIL");
+
+        // first part is the identity of the client, used by the router to route back the reply.
+        sendMessage(m_RouterSocket, QList<QByteArray>() << parts.first() << reply);
+    }
+}
+
+void ctkNetworkConnectorZeroMQ::readPublished() {
+    QList<QByteArray> parts;
+    while(hasPendingMessage(m_SubscriberSocket) && receiveMessage(m_SubscriberSocket, parts)) {
+        if(parts.count() != 2) {
+            continue;
+        }
+
+        QString id_name = QString::fromUtf8(parts.at(0));
+        QDataStream in(parts.at(1));
+        in.setVersion(QDataStream::Qt_4_6);
+        QVariantList arguments;
+        if(!readArguments(in, arguments) || !ctkEventBusManager::instance()->isLocalSignalPresent(id_name)) {
+            continue;
+        }
+
+        ctkEventArgumentsList argList = argumentsFromVariants(arguments);
+        ctkBusEvent dictionary(id_name, ctkEventTypeLocal, 0, NULL, "");
+        ctkEventBusManager::instance()->notifyEvent(dictionary, argList.isEmpty() ? NULL : &argList);
+    }
+}
 
 void ctkNetworkConnectorZeroMQ::processReturnValue( int requestId, QVariant value ) {
-	Q_UNUSED(requestId);
-	Q_UNUSED(value);
-    //@@ TODO
+    Q_UNUSED( requestId );
+    if(value.toString() == "OK") {
+        ctkEventBusManager::instance()->notifyEvent("ctk/local/eventBus/remoteCommunicationDone", ctkEventTypeLocal);
+    } else {
+        ctkEventBusManager::instance()->notifyEvent("ctk/local/eventBus/remoteCommunicationFailed", ctkEventTypeLocal);
+    }
 }
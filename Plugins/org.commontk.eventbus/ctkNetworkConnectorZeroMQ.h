@@ -15,19 +15,23 @@
 // include list
 #include "ctkNetworkConnector.h"
 
+class QSocketNotifier;
+
 namespace ctkEventBus {
 
 /**
  Class name: ctkNetworkConnectorZeroMQ
  This class is the implementation class for client/server objects that works over network
- with xml-rpc protocol. The server side part also create a new ID named REGISTER_SERVER_METHODS_XXX
- (where the XXX is the port on which run the server) that allows you to register your own remote
- callbacks. The library used is qxmlrpc.
+ with the 0MQ library. Requests sent by the client go through a DEALER socket to the ROUTER socket
+ of the server, which dispatches them locally and replies with "OK" or "FAIL"; events published
+ by the server go through a PUB socket to the SUB socket of every connected client.
+ Arguments are encoded in binary form with QDataStream (see ctkNetworkConnector::writeArguments).
+ createServer(port) and createClient(host, port) use tcp on port (requests) and port + 1 (broadcast);
+ bindServer and connectClient accept any 0MQ endpoint (e.g. ipc://).
  */
 class org_commontk_eventbus_EXPORT ctkNetworkConnectorZeroMQ : public ctkNetworkConnector {
     Q_OBJECT
 
-
 public:
     /// object constructor.
     ctkNetworkConnectorZeroMQ();
@@ -41,6 +45,12 @@ public:
     /// create the unique instance of the server.
     /*virtual*/ void createServer(const unsigned int port);
 
+    /// Connect the client to the given request and broadcast endpoints.
+    bool connectClient(const QString &requestEndpoint, const QString &publishEndpoint);
+
+    /// Define the request and broadcast endpoints on which the server will listen.
+    void bindServer(const QString &requestEndpoint, const QString &publishEndpoint);
+
     /// Start the server.
     /*virtual*/ void startListen();
 
@@ -50,27 +60,66 @@ public:
     /// register all the signals and slots
     /*virtual*/ void initializeForEventBus();
 
+    /// Receive on the client side the broadcast events whose topic starts with the given prefix.
+    void subscribe(const QString &topicPrefix);
+
+public Q_SLOTS:
     /// Allow to send a network request.
-    /** Contains the conversion between maf datatypes and qxmlrpc datatype based both on QVariant. */
+    /** The arguments are encoded in binary form; the first one must be the QVariantList containing the event parameters. */
     /*virtual*/ void send(const QString event_id, ctkEventArgumentsList *argList);
 
+    /// Broadcast the event to all the subscribed clients, which will notify it on their local channel.
+    void publish(const QString event_id, ctkEventArgumentsList *argList);
+
 private Q_SLOTS:
     /// callback for the client which retrieve the variable from the server
     virtual void processReturnValue( int requestId, QVariant value );
 
-    //// here goes slots which handle the connection
+    /// read all the pending replies on the client request socket.
+    void readReplies();
+
+    /// read all the pending requests on the server socket.
+    void readRequests();
+
+    /// read all the pending broadcast events on the client subscriber socket.
+    void readPublished();
 
-    
 protected:
-    //here goes zeromq vars
-    
+    void *m_Context; ///< 0MQ context shared by all the sockets of the connector, created by the first one.
+    void *m_DealerSocket; ///< client socket used to send requests.
+    void *m_SubscriberSocket; ///< client socket used to receive broadcast events.
+    void *m_RouterSocket; ///< server socket used to receive requests and send replies.
+    void *m_PublisherSocket; ///< server socket used to broadcast events.
+
 private:
-    //here ges function for zeromq connection
-    
     /// stop and destroy the server instance.
     void stopServer();
 
-    
+    /// close the client sockets.
+    void stopClient();
+
+    /// create a socket and watch its file descriptor for incoming messages.
+    void *createSocket(int type, QSocketNotifier **notifier, const char *member);
+
+    /// close the socket and its notifier.
+    void closeSocket(void **socket, QSocketNotifier **notifier);
+
+    /// return true if a message can be read without blocking.
+    bool hasPendingMessage(void *socket) const;
+
+    /// receive a complete (multipart) message without blocking.
+    bool receiveMessage(void *socket, QList<QByteArray> &parts);
+
+    /// send a complete (multipart) message.
+    bool sendMessage(void *socket, const QList<QByteArray> &parts);
+
+    QSocketNotifier *m_DealerNotifier; ///< notifier of the client request socket.
+    QSocketNotifier *m_SubscriberNotifier; ///< notifier of the client subscriber socket.
+    QSocketNotifier *m_RouterNotifier; ///< notifier of the server socket.
+    QString m_RequestEndpoint; ///< endpoint on which the server receive requests.
+    QString m_PublishEndpoint; ///< endpoint on which the server broadcast events.
+    QStringList m_Subscriptions; ///< topic prefixes the client is subscribed to.
+    int m_RequestId; ///< id of the last request sent by the client.
 };
 
 } //namespace ctkEventBus
@@ -0,0 +1,334 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+// Qt includes
+#include <QCoreApplication>
+#include <QEventLoop>
+#include <QMutex>
+#include <QStringList>
+#include <QThread>
+#include <QTime>
+#include <QTimer>
+
+// CTK includes
+#include <ctkPluginException.h>
+#include <ctkPluginFramework.h>
+#include <ctkPluginFrameworkFactory.h>
+#include <ctkServiceRegistration.h>
+#include "ctkLogReaderServiceImpl_p.h"
+
+// STD includes
+#include <cstdlib>
+#include <iostream>
+
+//----------------------------------------------------------------------------
+class ctkLogReaderServiceTestListener : public QObject, public ctkLogListener
+{
+  Q_OBJECT
+  Q_INTERFACES(ctkLogListener)
+
+public:
+
+  void logged(ctkLogEntryPtr entry)
+  {
+    QMutexLocker lock(&this->Mutex);
+    this->Messages.push_back(entry->getMessage());
+  }
+
+  QStringList messages() const
+  {
+    QMutexLocker lock(&this->Mutex);
+    return this->Messages;
+  }
+
+public Q_SLOTS:
+
+  void onLogged(ctkLogEntryPtr entry)
+  {
+    this->logged(entry);
+  }
+
+private:
+
+  mutable QMutex Mutex;
+  QStringList Messages;
+};
+
+//----------------------------------------------------------------------------
+class ctkLogReaderServiceTestProducer : public QThread
+{
+public:
+
+  ctkLogReaderServiceTestProducer(ctkLogReaderServiceImpl* logReaderService,
+                                  int id, int count)
+    : LogReaderService(logReaderService), Id(id), Count(count)
+  {
+  }
+
+protected:
+
+  void run()
+  {
+    for (int i = 0; i < this->Count; ++i)
+      {
+      ctkLogRecord record;
+      record.level = 1;
+      record.message = QString("producer %1 entry %2").arg(this->Id).arg(i);
+      this->LogReaderService->addLogRecord(record);
+      }
+  }
+
+private:
+
+  ctkLogReaderServiceImpl* const LogReaderService;
+  const int Id;
+  const int Count;
+};
+
+namespace
+{
+//----------------------------------------------------------------------------
+void addEntries(ctkLogReaderServiceImpl& logReaderService, int first, int count)
+{
+  for (int i = first; i < first + count; ++i)
+    {
+    ctkLogRecord record;
+    record.level = 1;
+    record.message = QString("entry %1").arg(i);
+    logReaderService.addLogRecord(record);
+    }
+}
+
+//----------------------------------------------------------------------------
+// Processes events until all listeners received count entries or the timeout elapsed
+bool waitForEntries(const QList<ctkLogReaderServiceTestListener*>& listeners, int count)
+{
+  QTime time;
+  time.start();
+  while (time.elapsed() < 10000)
+    {
+    bool done = true;
+    foreach (ctkLogReaderServiceTestListener* listener, listeners)
+      {
+      done = done && listener->messages().size() >= count;
+      }
+    if (done)
+      {
+      return true;
+      }
+    QEventLoop loop;
+    QTimer::singleShot(10, &loop, SLOT(quit()));
+    loop.exec();
+    }
+  return false;
+}
+
+//----------------------------------------------------------------------------
+bool checkEntries(const QStringList& messages, int count)
+{
+  if (messages.size() != count)
+    {
+    std::cerr << "Received " << messages.size() << " entries instead of "
+              << count << std::endl;
+    return false;
+    }
+  for (int i = 0; i < count; ++i)
+    {
+    if (messages[i] != QString("entry %1").arg(i))
+      {
+      std::cerr << "Received " << qPrintable(messages[i]) << " at position "
+                << i << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+}
+
+//----------------------------------------------------------------------------
+int ctkLogReaderServiceTest1(int argc, char* argv[])
+{
+  QCoreApplication app(argc, argv);
+
+  ctkPluginFrameworkFactory fwFactory;
+  QSharedPointer<ctkPluginFramework> framework = fwFactory.getFramework();
+  try
+    {
+    framework->init();
+    }
+  catch (const ctkPluginException& exc)
+    {
+    std::cerr << "Failed to initialize the plug-in framework: " << exc.what() << std::endl;
+    return EXIT_FAILURE;
+    }
+  ctkPluginContext* context = framework->getPluginContext();
+
+  const int capacity = ctkLogRingBuffer::CAPACITY;
+
+  //----------------------------------------------------------------------------
+  // getLog() returns the newest entry first
+  {
+  ctkLogReaderServiceImpl logReaderService(context);
+  if (!logReaderService.getLog().isEmpty())
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with getLog() of an empty log" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  addEntries(logReaderService, 0, 5);
+  QList<ctkLogEntryPtr> log = logReaderService.getLog();
+  if (log.size() != 5)
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with getLog(): "
+              << log.size() << " entries" << std::endl;
+    return EXIT_FAILURE;
+    }
+  for (int i = 0; i < log.size(); ++i)
+    {
+    if (log[i]->getMessage() != QString("entry %1").arg(4 - i))
+      {
+      std::cerr << "Line " << __LINE__ << " - Problem with the order of getLog()" << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  // only the most recent entries are kept
+  addEntries(logReaderService, 5, capacity);
+  log = logReaderService.getLog();
+  if (log.size() != capacity ||
+      log.first()->getMessage() != QString("entry %1").arg(capacity + 4) ||
+      log.last()->getMessage() != QString("entry %1").arg(5))
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with getLog() of a full log" << std::endl;
+    return EXIT_FAILURE;
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // every listener receives every entry in order
+  {
+  ctkLogReaderServiceTestListener listener1;
+  ctkLogReaderServiceTestListener listener2;
+  ctkLogReaderServiceTestListener slotListener;
+  ctkServiceRegistration registration1 = context->registerService<ctkLogListener>(&listener1);
+  ctkServiceRegistration registration2 = context->registerService<ctkLogListener>(&listener2);
+
+  const int count = 600;
+  {
+  ctkLogReaderServiceImpl logReaderService(context);
+  if (!logReaderService.connectLogListener(&slotListener, SLOT(onLogged(ctkLogEntryPtr))))
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with connectLogListener()" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  addEntries(logReaderService, 0, count);
+  QList<ctkLogReaderServiceTestListener*> listeners;
+  listeners << &listener1 << &listener2 << &slotListener;
+  if (!waitForEntries(listeners, count))
+    {
+    std::cerr << "Line " << __LINE__ << " - Timeout waiting for the listeners" << std::endl;
+    }
+  }
+  registration1.unregister();
+  registration2.unregister();
+
+  if (!checkEntries(listener1.messages(), count) ||
+      !checkEntries(listener2.messages(), count) ||
+      !checkEntries(slotListener.messages(), count))
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with the notification of listeners" << std::endl;
+    return EXIT_FAILURE;
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // no entry is lost with concurrent producers
+  {
+  ctkLogReaderServiceTestListener listener;
+  ctkServiceRegistration registration = context->registerService<ctkLogListener>(&listener);
+
+  // all entries fit into the ring buffer
+  const int producerCount = 4;
+  const int count = capacity / producerCount;
+  QList<ctkLogEntryPtr> log;
+  {
+  ctkLogReaderServiceImpl logReaderService(context);
+  QList<ctkLogReaderServiceTestProducer*> producers;
+  for (int i = 0; i < producerCount; ++i)
+    {
+    producers << new ctkLogReaderServiceTestProducer(&logReaderService, i, count);
+    }
+  foreach (ctkLogReaderServiceTestProducer* producer, producers)
+    {
+    producer->start();
+    }
+  foreach (ctkLogReaderServiceTestProducer* producer, producers)
+    {
+    producer->wait();
+    delete producer;
+    }
+
+  waitForEntries(QList<ctkLogReaderServiceTestListener*>() << &listener,
+                 producerCount * count);
+  log = logReaderService.getLog();
+  }
+  registration.unregister();
+
+  if (log.size() != producerCount * count)
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with getLog() after concurrent logging: "
+              << log.size() << " entries" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  QStringList messages = listener.messages();
+  if (messages.size() != producerCount * count)
+    {
+    std::cerr << "Line " << __LINE__ << " - Listener received " << messages.size()
+              << " entries instead of " << producerCount * count << std::endl;
+    return EXIT_FAILURE;
+    }
+  // the entries of each producer are received in the order they were logged
+  QList<int> nextEntry;
+  for (int i = 0; i < producerCount; ++i)
+    {
+    nextEntry << 0;
+    }
+  foreach (const QString& message, messages)
+    {
+    QStringList parts = message.split(' ');
+    int producer = parts[1].toInt();
+    int entry = parts[3].toInt();
+    if (entry != nextEntry[producer])
+      {
+      std::cerr << "Line " << __LINE__ << " - Received " << qPrintable(message)
+                << " out of order" << std::endl;
+      return EXIT_FAILURE;
+      }
+    ++nextEntry[producer];
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
+
+#include "moc_ctkLogReaderServiceTest1.cpp"
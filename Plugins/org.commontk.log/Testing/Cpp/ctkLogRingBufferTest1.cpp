@@ -0,0 +1,172 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+// CTK includes
+#include "ctkLogRingBuffer_p.h"
+
+// STD includes
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+//----------------------------------------------------------------------------
+ctkLogRecord createRecord(int index)
+{
+  ctkLogRecord record;
+  record.level = 1;
+  record.message = QString("entry %1").arg(index);
+  return record;
+}
+
+//----------------------------------------------------------------------------
+bool checkRecord(const ctkLogRingBuffer& ringBuffer, quint32 sequence, int index)
+{
+  ctkLogRecord record;
+  bool overwritten = true;
+  if (!ringBuffer.read(sequence, record, &overwritten) || overwritten)
+    {
+    std::cerr << "Failed to read record " << sequence << std::endl;
+    return false;
+    }
+  if (record.message != QString("entry %1").arg(index))
+    {
+    std::cerr << "Record " << sequence << " has the wrong message: "
+              << qPrintable(record.message) << std::endl;
+    return false;
+    }
+  return true;
+}
+}
+
+//----------------------------------------------------------------------------
+int ctkLogRingBufferTest1(int argc, char* argv[])
+{
+  Q_UNUSED(argc);
+  Q_UNUSED(argv);
+
+  const int capacity = ctkLogRingBuffer::CAPACITY;
+
+  //----------------------------------------------------------------------------
+  // append / read
+  ctkLogRingBuffer ringBuffer;
+  ctkLogRecord record;
+  bool overwritten = true;
+  if (ringBuffer.nextSequence() != 0 ||
+      ringBuffer.read(0, record, &overwritten) || overwritten)
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with an empty ring buffer" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  for (int i = 0; i < capacity; ++i)
+    {
+    if (ringBuffer.append(createRecord(i)) != static_cast<quint32>(i))
+      {
+      std::cerr << "Line " << __LINE__ << " - Problem with append()" << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+  if (ringBuffer.nextSequence() != static_cast<quint32>(capacity))
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with nextSequence()" << std::endl;
+    return EXIT_FAILURE;
+    }
+  for (int i = 0; i < capacity; ++i)
+    {
+    if (!checkRecord(ringBuffer, i, i))
+      {
+      std::cerr << "Line " << __LINE__ << " - Problem with read()" << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+  if (ringBuffer.read(capacity, record, &overwritten) || overwritten)
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with reading an unwritten record" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  //----------------------------------------------------------------------------
+  // overwrite when full
+  const int extra = 10;
+  for (int i = capacity; i < capacity + extra; ++i)
+    {
+    ringBuffer.append(createRecord(i));
+    }
+  for (int i = 0; i < extra; ++i)
+    {
+    overwritten = false;
+    if (ringBuffer.read(i, record, &overwritten) || !overwritten)
+      {
+      std::cerr << "Line " << __LINE__ << " - Record " << i
+                << " was not reported as overwritten" << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+  for (int i = extra; i < capacity + extra; ++i)
+    {
+    if (!checkRecord(ringBuffer, i, i))
+      {
+      std::cerr << "Line " << __LINE__ << " - Problem with read() after overwrite" << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  //----------------------------------------------------------------------------
+  // sequence number wrap
+  const quint32 firstSequence = 0xFFFFFFFFu - 4;
+  ctkLogRingBuffer wrappingRingBuffer(firstSequence);
+  const int count = capacity + 20;
+  for (int i = 0; i < count; ++i)
+    {
+    if (wrappingRingBuffer.append(createRecord(i)) != firstSequence + i)
+      {
+      std::cerr << "Line " << __LINE__ << " - Problem with append() at the wrap" << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+  if (wrappingRingBuffer.nextSequence() != firstSequence + count)
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with nextSequence() at the wrap" << std::endl;
+    return EXIT_FAILURE;
+    }
+  // the records before the wrap were replaced by the ones after it
+  for (int i = 0; i < count - capacity; ++i)
+    {
+    overwritten = false;
+    if (wrappingRingBuffer.read(firstSequence + i, record, &overwritten) || !overwritten)
+      {
+      std::cerr << "Line " << __LINE__ << " - Record " << firstSequence + i
+                << " was not reported as overwritten" << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+  for (int i = count - capacity; i < count; ++i)
+    {
+    if (!checkRecord(wrappingRingBuffer, firstSequence + i, i))
+      {
+      std::cerr << "Line " << __LINE__ << " - Problem with read() at the wrap" << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
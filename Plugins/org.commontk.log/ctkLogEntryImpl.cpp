@@ -0,0 +1,83 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#include "ctkLogEntryImpl_p.h"
+
+#include <ctkPlugin.h>
+
+ctkLogEntryImpl::ctkLogEntryImpl(const ctkLogRecord& record)
+  : record(record)
+{
+  if (!record.exception.isNull())
+  {
+    exception.reset(new ctkRuntimeException(record.exception));
+  }
+}
+
+QSharedPointer<ctkPlugin> ctkLogEntryImpl::getPlugin() const
+{
+  if (record.reference)
+  {
+    return record.reference->getPlugin();
+  }
+  return QSharedPointer<ctkPlugin>();
+}
+
+ctkServiceReference ctkLogEntryImpl::getServiceReference() const
+{
+  return record.reference ? *record.reference : ctkServiceReference();
+}
+
+int ctkLogEntryImpl::getLevel() const
+{
+  return record.level;
+}
+
+QString ctkLogEntryImpl::getMessage() const
+{
+  return record.message;
+}
+
+QString ctkLogEntryImpl::getFileName() const
+{
+  return record.file ? QString(record.file) : QString();
+}
+
+QString ctkLogEntryImpl::getFunctionName() const
+{
+  return record.function ? QString(record.function) : QString();
+}
+
+int ctkLogEntryImpl::getLineNumber() const
+{
+  return record.line > 0 ? record.line : 0;
+}
+
+ctkRuntimeException* ctkLogEntryImpl::getException() const
+{
+  return exception.data();
+}
+
+QDateTime ctkLogEntryImpl::getTime() const
+{
+  return record.time;
+}
@@ -0,0 +1,59 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#ifndef CTKLOGENTRYIMPL_P_H
+#define CTKLOGENTRYIMPL_P_H
+
+#include <service/log/ctkLogEntry.h>
+
+#include <QScopedPointer>
+
+#include "ctkLogRingBuffer_p.h"
+
+/**
+ * ctkLogEntry implementation created from a ctkLogRecord
+ * when it is read from the log.
+ */
+class ctkLogEntryImpl : public ctkLogEntry
+{
+
+public:
+
+  ctkLogEntryImpl(const ctkLogRecord& record);
+
+  QSharedPointer<ctkPlugin> getPlugin() const;
+  ctkServiceReference getServiceReference() const;
+  int getLevel() const;
+  QString getMessage() const;
+  QString getFileName() const;
+  QString getFunctionName() const;
+  int getLineNumber() const;
+  ctkRuntimeException* getException() const;
+  QDateTime getTime() const;
+
+private:
+
+  const ctkLogRecord record;
+  QScopedPointer<ctkRuntimeException> exception;
+};
+
+#endif // CTKLOGENTRYIMPL_P_H
@@ -23,20 +23,23 @@
 #include "ctkLogPlugin_p.h"
 
 #include "ctkLogQDebug_p.h"
+#include "ctkLogReaderServiceImpl_p.h"
 
 #include <QtPlugin>
 #include <QStringList>
 
 ctkLogPlugin::ctkLogPlugin()
-  : logService(0)
+  : logService(0), logReaderService(0)
 {
 
 }
 
 void ctkLogPlugin::start(ctkPluginContext* context)
 {
-  logService = new ctkLogQDebug();
+  logReaderService = new ctkLogReaderServiceImpl(context);
+  logService = new ctkLogQDebug(logReaderService);
   context->registerService(QStringList("ctkLogService"), logService);
+  context->registerService<ctkLogReaderService>(logReaderService);
 }
 
 void ctkLogPlugin::stop(ctkPluginContext* context)
@@ -47,6 +50,11 @@ void ctkLogPlugin::stop(ctkPluginContext* context)
     delete logService;
     logService = 0;
   }
+  if (logReaderService)
+  {
+    delete logReaderService;
+    logReaderService = 0;
+  }
 }
 
 Q_EXPORT_PLUGIN2(org_commontk_log, ctkLogPlugin)
@@ -26,6 +26,7 @@
 #include <ctkPluginActivator.h>
 
 class ctkLogQDebug;
+class ctkLogReaderServiceImpl;
 
 class ctkLogPlugin :
   public QObject, public ctkPluginActivator
@@ -43,6 +44,7 @@ public:
 private:
 
   ctkLogQDebug* logService;
+  ctkLogReaderServiceImpl* logReaderService;
 
 }; // ctkLogPlugin
 
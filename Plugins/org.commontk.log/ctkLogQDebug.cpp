@@ -21,86 +21,314 @@
 
 
 #include "ctkLogQDebug_p.h"
+#include "ctkLogReaderServiceImpl_p.h"
 
 #include <QDateTime>
 #include <QDebug>
 #include <QStringList>
+#include <QThread>
 
 #include <ctkPluginConstants.h>
 
-ctkLogQDebug::ctkLogQDebug()
-  : logLevel(ctkLogService::LOG_DEBUG)
+const int ctkLogQDebug::FLUSH_INTERVAL = 100;
+
+/**
+ * A ring buffer with a single producer, the thread owning the buffer, and a
+ * single consumer, the sink thread. The two only synchronize through head and tail.
+ */
+class ctkLogQDebugBuffer
 {
-}
 
-void ctkLogQDebug::log(int level, const QString& message, const std::exception* exception,
-                       const char* file, const char* function, int line)
+public:
+
+  static const int CAPACITY = 1024;
+
+  ctkLogQDebugBuffer()
+    : orphaned(0), head(0), tail(0)
+  {
+  }
+
+  /**
+   * Called by the owning thread, returns false if the buffer is full.
+   */
+  bool push(const ctkLogRecord& entry, bool* halfFull)
+  {
+    int h = head;
+    int next = (h + 1) % CAPACITY;
+    int t = tail.fetchAndAddAcquire(0);
+    if (next == t)
+    {
+      return false;
+    }
+    entries[h] = entry;
+    head.fetchAndStoreRelease(next);
+    *halfFull = (next - t + CAPACITY) % CAPACITY >= CAPACITY / 2;
+    return true;
+  }
+
+  /**
+   * Called by the sink thread, returns false if the buffer is empty.
+   */
+  bool pop(ctkLogRecord& entry)
+  {
+    int t = tail;
+    if (t == head.fetchAndAddAcquire(0))
+    {
+      return false;
+    }
+    entry = entries[t];
+    // release the entry data here rather than in the logging thread
+    entries[t].message.clear();
+    entries[t].exception.clear();
+    entries[t].reference.clear();
+    tail.fetchAndStoreRelease((t + 1) % CAPACITY);
+    return true;
+  }
+
+  /** Set when the owning thread finished, the sink thread then deletes the buffer */
+  QAtomicInt orphaned;
+
+private:
+
+  ctkLogRecord entries[CAPACITY];
+  QAtomicInt head;
+  QAtomicInt tail;
+};
+
+/**
+ * Thread local reference to a buffer, deleted when its thread finishes.
+ */
+class ctkLogQDebugBufferReference
 {
-  Q_UNUSED(function)
 
-  QString s = QDateTime::currentDateTime().toString(Qt::ISODate)
-      .append(" - ").append(message);
+public:
 
-  if (exception != 0)
+  ctkLogQDebugBufferReference(ctkLogQDebugBuffer* buffer)
+    : buffer(buffer)
   {
-    s.append(" (").append(exception->what()).append(")");
   }
 
-  if (file)
+  ~ctkLogQDebugBufferReference()
   {
-    s.append(" [at ").append(file).append(":").append(QString::number(line)).append("]");
+    buffer->orphaned.fetchAndStoreRelease(1);
   }
 
-  if (level == ctkLogService::LOG_WARNING)
+  ctkLogQDebugBuffer* const buffer;
+};
+
+class ctkLogQDebugSinkThread : public QThread
+{
+
+public:
+
+  ctkLogQDebugSinkThread(ctkLogQDebug* logService)
+    : logService(logService)
   {
-    qWarning() << s;
+    setObjectName("ctkLogQDebug Sink");
   }
-  else if (level == ctkLogService::LOG_ERROR)
+
+protected:
+
+  void run()
   {
-    qCritical() << s;
+    logService->runSink();
   }
-  else
+
+private:
+
+  ctkLogQDebug* const logService;
+};
+
+ctkLogQDebug::ctkLogQDebug(ctkLogReaderServiceImpl* logReaderService)
+  : logLevel(ctkLogService::LOG_DEBUG), logReaderService(logReaderService),
+    stopping(0), sinkThread(0)
+{
+  sinkThread = new ctkLogQDebugSinkThread(this);
+  sinkThread->start();
+}
+
+ctkLogQDebug::~ctkLogQDebug()
+{
+  stopping.fetchAndStoreOrdered(1);
+  sinkWakeUp.wakeAll();
+  sinkThread->wait();
+  delete sinkThread;
+
+  // Buffers of threads which are still running are not referenced any more:
+  // thread local data of a destroyed QThreadStorage is not accessed again.
+  qDeleteAll(buffers);
+}
+
+void ctkLogQDebug::log(int level, const QString& message, const std::exception* exception,
+                       const char* file, const char* function, int line)
+{
+  ctkLogRecord entry;
+  entry.level = level;
+  entry.time = QDateTime::currentDateTime();
+  entry.message = message;
+  if (exception != 0)
   {
-    qDebug() << s;
+    entry.exception = exception->what();
   }
+  entry.file = file;
+  entry.function = function;
+  entry.line = line;
+  logReaderService->addLogRecord(entry);
+  enqueue(entry);
 }
 
 void ctkLogQDebug::log(const ctkServiceReference& sr, int level, const QString& message,
                        const std::exception* exception,
                        const char* file, const char* function, int line)
 {
-  Q_UNUSED(function)
+  ctkLogRecord entry;
+  entry.level = level;
+  entry.time = QDateTime::currentDateTime();
+  entry.message = message;
+  if (exception != 0)
+  {
+    entry.exception = exception->what();
+  }
+  if (sr)
+  {
+    entry.reference = QSharedPointer<const ctkServiceReference>(new ctkServiceReference(sr));
+  }
+  entry.file = file;
+  entry.function = function;
+  entry.line = line;
+  logReaderService->addLogRecord(entry);
+  enqueue(entry);
+}
+
+int ctkLogQDebug::getLogLevel() const
+{
+  return logLevel;
+}
 
-  QString s = QDateTime::currentDateTime().toString(Qt::ISODate)
-      .append(" - [");
+ctkLogQDebugBuffer* ctkLogQDebug::getLocalBuffer()
+{
+  ctkLogQDebugBufferReference* reference = localBuffer.localData();
+  if (reference == 0)
+  {
+    ctkLogQDebugBuffer* buffer = new ctkLogQDebugBuffer();
+    {
+      QMutexLocker lock(&buffersMutex);
+      buffers.push_back(buffer);
+    }
+    reference = new ctkLogQDebugBufferReference(buffer);
+    localBuffer.setLocalData(reference);
+  }
+  return reference->buffer;
+}
 
-  s.append(sr.getProperty(ctkPluginConstants::SERVICE_ID).toString());
-  s.append(";");
-  QStringList clazzes = sr.getProperty(ctkPluginConstants::OBJECTCLASS).toStringList();
-  int i = 0;
-  foreach (QString clazz, clazzes)
+void ctkLogQDebug::enqueue(const ctkLogRecord& entry)
+{
+  if (stopping)
   {
-    if (i > 0) s.append(",");
-    s.append(clazz);
+    write(entry);
+    return;
   }
 
-  s.append(message);
+  ctkLogQDebugBuffer* buffer = getLocalBuffer();
+  bool halfFull = false;
+  while (!buffer->push(entry, &halfFull))
+  {
+    // let the sink thread catch up, writing the entry directly
+    // would reorder it with the ones of this thread still buffered
+    sinkWakeUp.wakeOne();
+    QThread::yieldCurrentThread();
+    if (stopping)
+    {
+      write(entry);
+      return;
+    }
+  }
 
-  if(exception != 0)
+  if (halfFull || entry.level <= ctkLogService::LOG_WARNING)
   {
-    s.append(" (").append(exception->what()).append(")");
+    sinkWakeUp.wakeOne();
   }
+}
 
-  if (file)
+void ctkLogQDebug::runSink()
+{
+  while (!stopping)
+  {
+    if (drainBuffers() == 0)
+    {
+      QMutexLocker lock(&buffersMutex);
+      if (!stopping)
+      {
+        sinkWakeUp.wait(&buffersMutex, FLUSH_INTERVAL);
+      }
+    }
+  }
+  drainBuffers();
+}
+
+int ctkLogQDebug::drainBuffers()
+{
+  QList<ctkLogQDebugBuffer*> currentBuffers;
   {
-    s.append(" [at ").append(file).append(":").append(QString::number(line)).append("]");
+    QMutexLocker lock(&buffersMutex);
+    currentBuffers = buffers;
   }
 
-  if (level == ctkLogService::LOG_WARNING)
+  int count = 0;
+  ctkLogRecord entry;
+  foreach (ctkLogQDebugBuffer* buffer, currentBuffers)
+  {
+    // read the flag first, entries logged before the thread finished are then visible
+    bool orphaned = buffer->orphaned.fetchAndAddAcquire(0);
+    int bufferCount = 0;
+    while (bufferCount < ctkLogQDebugBuffer::CAPACITY && buffer->pop(entry))
+    {
+      write(entry);
+      ++bufferCount;
+    }
+    count += bufferCount;
+
+    if (orphaned && bufferCount < ctkLogQDebugBuffer::CAPACITY)
+    {
+      QMutexLocker lock(&buffersMutex);
+      buffers.removeOne(buffer);
+      delete buffer;
+    }
+  }
+  return count;
+}
+
+void ctkLogQDebug::write(const ctkLogRecord& entry)
+{
+  QString s = entry.time.toString(Qt::ISODate).append(" - ");
+
+  if (entry.reference)
+  {
+    s.append("[");
+    s.append(entry.reference->getProperty(ctkPluginConstants::SERVICE_ID).toString());
+    s.append(";");
+    QStringList clazzes = entry.reference->getProperty(ctkPluginConstants::OBJECTCLASS).toStringList();
+    s.append(clazzes.join(","));
+    s.append("] ");
+  }
+
+  s.append(entry.message);
+
+  if (!entry.exception.isNull())
+  {
+    s.append(" (").append(entry.exception).append(")");
+  }
+
+  if (entry.file)
+  {
+    s.append(" [at ").append(entry.file).append(":").append(QString::number(entry.line)).append("]");
+  }
+
+  if (entry.level == ctkLogService::LOG_WARNING)
   {
     qWarning() << s;
   }
-  else if (level == ctkLogService::LOG_ERROR)
+  else if (entry.level == ctkLogService::LOG_ERROR)
   {
     qCritical() << s;
   }
@@ -109,8 +337,3 @@ void ctkLogQDebug::log(const ctkServiceReference& sr, int level, const QString&
     qDebug() << s;
   }
 }
-
-int ctkLogQDebug::getLogLevel() const
-{
-  return logLevel;
-}
@@ -26,7 +26,30 @@
 #include <service/log/ctkLogService.h>
 
 #include <QObject>
-
+#include <QAtomicInt>
+#include <QList>
+#include <QMutex>
+#include <QThreadStorage>
+#include <QWaitCondition>
+
+struct ctkLogRecord;
+class ctkLogQDebugBuffer;
+class ctkLogQDebugBufferReference;
+class ctkLogQDebugSinkThread;
+class ctkLogReaderServiceImpl;
+
+/**
+ * Writes log entries using qDebug(), qWarning() and qCritical().
+ *
+ * The logging thread only stores the entry in a ring buffer owned by that thread,
+ * without taking a lock. The entries are formatted and written by a sink thread,
+ * which is woken up for warnings and errors or when a buffer fills up and otherwise
+ * polls the buffers every FLUSH_INTERVAL milliseconds. Entries logged by one thread
+ * are written in order, entries of different threads may be interleaved differently
+ * than they were logged.
+ *
+ * Every entry is also added to the history of the ctkLogReaderServiceImpl.
+ */
 class ctkLogQDebug : public QObject, public ctkLogService
 {
 
@@ -35,7 +58,8 @@ class ctkLogQDebug : public QObject, public ctkLogService
 
 public:
 
-  ctkLogQDebug();
+  ctkLogQDebug(ctkLogReaderServiceImpl* logReaderService);
+  ~ctkLogQDebug();
 
   void log(int level, const QString& message, const std::exception* exception = 0,
            const char* file = 0, const char* function = 0, int line = -1);
@@ -46,7 +70,28 @@ public:
 
 private:
 
+  friend class ctkLogQDebugSinkThread;
+
+  static const int FLUSH_INTERVAL; // = 100
+
   int logLevel;
+  ctkLogReaderServiceImpl* const logReaderService;
+
+  QThreadStorage<ctkLogQDebugBufferReference*> localBuffer;
+
+  /** guards buffers, also used to wait for sinkWakeUp */
+  QMutex buffersMutex;
+  QList<ctkLogQDebugBuffer*> buffers;
+  QWaitCondition sinkWakeUp;
+  QAtomicInt stopping;
+  ctkLogQDebugSinkThread* sinkThread;
+
+  ctkLogQDebugBuffer* getLocalBuffer();
+  void enqueue(const ctkLogRecord& entry);
+
+  void runSink();
+  int drainBuffers();
+  static void write(const ctkLogRecord& entry);
 };
 
 #endif // CTKLOGQDEBUG_P_H
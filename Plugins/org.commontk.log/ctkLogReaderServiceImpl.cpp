@@ -0,0 +1,169 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#include "ctkLogReaderServiceImpl_p.h"
+#include "ctkLogEntryImpl_p.h"
+
+#include <QThread>
+
+const int ctkLogReaderServiceImpl::NOTIFY_INTERVAL = 50;
+const int ctkLogReaderServiceImpl::NOTIFY_BATCH_SIZE = 256;
+
+class ctkLogNotifierThread : public QThread
+{
+
+public:
+
+  ctkLogNotifierThread(ctkLogReaderServiceImpl* logReaderService)
+    : logReaderService(logReaderService)
+  {
+    setObjectName("ctkLogReaderService Notifier");
+  }
+
+protected:
+
+  void run()
+  {
+    logReaderService->runNotifier();
+  }
+
+private:
+
+  ctkLogReaderServiceImpl* const logReaderService;
+};
+
+ctkLogReaderServiceImpl::ctkLogReaderServiceImpl(ctkPluginContext* context)
+  : listenerTracker(context), stopping(0), notifierThread(0)
+{
+  qRegisterMetaType<ctkLogEntryPtr>("ctkLogEntryPtr");
+  listenerTracker.open();
+  notifierThread = new ctkLogNotifierThread(this);
+  notifierThread->start();
+}
+
+ctkLogReaderServiceImpl::~ctkLogReaderServiceImpl()
+{
+  {
+    QMutexLocker lock(&notifierMutex);
+    stopping.fetchAndStoreOrdered(1);
+    notifierWakeUp.wakeAll();
+  }
+  notifierThread->wait();
+  delete notifierThread;
+  listenerTracker.close();
+}
+
+void ctkLogReaderServiceImpl::addLogRecord(const ctkLogRecord& record)
+{
+  quint32 sequence = ringBuffer.append(record);
+  if ((sequence + 1) % NOTIFY_BATCH_SIZE == 0)
+  {
+    notifierWakeUp.wakeOne();
+  }
+}
+
+bool ctkLogReaderServiceImpl::connectLogListener(const QObject* receiver, const char* slot)
+{
+  return connect(this, SIGNAL(logged(ctkLogEntryPtr)), receiver, slot, Qt::UniqueConnection);
+}
+
+QList<ctkLogEntryPtr> ctkLogReaderServiceImpl::getLog()
+{
+  QList<ctkLogEntryPtr> entries;
+  quint32 sequence = ringBuffer.nextSequence();
+  ctkLogRecord record;
+  for (int i = 0; i < ctkLogRingBuffer::CAPACITY; ++i)
+  {
+    bool overwritten = false;
+    if (ringBuffer.read(--sequence, record, &overwritten))
+    {
+      entries.push_back(ctkLogEntryPtr(new ctkLogEntryImpl(record)));
+    }
+  }
+  return entries;
+}
+
+void ctkLogReaderServiceImpl::runNotifier()
+{
+  quint32 sequence = 0;
+  while (!stopping)
+  {
+    {
+      QMutexLocker lock(&notifierMutex);
+      if (!stopping && sequence == ringBuffer.nextSequence())
+      {
+        notifierWakeUp.wait(&notifierMutex, NOTIFY_INTERVAL);
+      }
+    }
+    sequence = notifyListeners(sequence);
+  }
+  notifyListeners(sequence);
+}
+
+quint32 ctkLogReaderServiceImpl::notifyListeners(quint32 sequence)
+{
+  quint32 end = ringBuffer.nextSequence();
+  if (static_cast<qint32>(end - sequence) > ctkLogRingBuffer::CAPACITY)
+  {
+    // the entries in between were already replaced
+    sequence = end - ctkLogRingBuffer::CAPACITY;
+  }
+
+  QList<ctkLogEntryPtr> entries;
+  ctkLogRecord record;
+  for (; sequence != end; ++sequence)
+  {
+    bool overwritten = false;
+    if (ringBuffer.read(sequence, record, &overwritten))
+    {
+      entries.push_back(ctkLogEntryPtr(new ctkLogEntryImpl(record)));
+    }
+    else if (!overwritten)
+    {
+      // still being written, continue with it in the next batch
+      break;
+    }
+  }
+
+  if (entries.isEmpty())
+  {
+    return sequence;
+  }
+
+  QList<ctkLogListener*> listeners = listenerTracker.getServices();
+  foreach (ctkLogEntryPtr entry, entries)
+  {
+    foreach (ctkLogListener* listener, listeners)
+    {
+      try
+      {
+        listener->logged(entry);
+      }
+      catch (...)
+      {
+        // a failing listener must not prevent the notification of the others
+      }
+    }
+    emit logged(entry);
+  }
+  return sequence;
+}
@@ -0,0 +1,89 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#ifndef CTKLOGREADERSERVICEIMPL_P_H
+#define CTKLOGREADERSERVICEIMPL_P_H
+
+#include <service/log/ctkLogReaderService.h>
+#include <service/log/ctkLogListener.h>
+#include <ctkServiceTracker.h>
+
+#include <QObject>
+#include <QMutex>
+#include <QWaitCondition>
+
+#include "ctkLogRingBuffer_p.h"
+
+#include <org_commontk_log_Export.h>
+
+class ctkLogNotifierThread;
+
+/**
+ * ctkLogReaderServiceImpl keeps the most recent log entries in a ctkLogRingBuffer.
+ *
+ * Logging threads only append to the ring buffer. A notifier thread reads the new
+ * entries in batches and passes them to the registered ctkLogListener services and
+ * the connected slots, so slow listeners do not slow down logging. The notifier
+ * thread polls every NOTIFY_INTERVAL milliseconds and is woken up after every
+ * NOTIFY_BATCH_SIZE entries. Listeners which fall more than the ring buffer capacity
+ * behind miss the replaced entries.
+ */
+class org_commontk_log_EXPORT ctkLogReaderServiceImpl : public QObject, public ctkLogReaderService
+{
+
+  Q_OBJECT
+  Q_INTERFACES(ctkLogReaderService)
+
+public:
+
+  ctkLogReaderServiceImpl(ctkPluginContext* context);
+  ~ctkLogReaderServiceImpl();
+
+  void addLogRecord(const ctkLogRecord& record);
+
+  bool connectLogListener(const QObject* receiver, const char* slot);
+  QList<ctkLogEntryPtr> getLog();
+
+Q_SIGNALS:
+
+  void logged(ctkLogEntryPtr entry);
+
+private:
+
+  friend class ctkLogNotifierThread;
+
+  static const int NOTIFY_INTERVAL; // = 50
+  static const int NOTIFY_BATCH_SIZE; // = 256
+
+  ctkLogRingBuffer ringBuffer;
+  ctkServiceTracker<ctkLogListener*> listenerTracker;
+
+  QMutex notifierMutex;
+  QWaitCondition notifierWakeUp;
+  QAtomicInt stopping;
+  ctkLogNotifierThread* notifierThread;
+
+  void runNotifier();
+  quint32 notifyListeners(quint32 sequence);
+};
+
+#endif // CTKLOGREADERSERVICEIMPL_P_H
@@ -0,0 +1,88 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#include "ctkLogRingBuffer_p.h"
+
+#include <QThread>
+
+ctkLogRecord::ctkLogRecord()
+  : level(0), file(0), function(0), line(-1)
+{
+}
+
+ctkLogRingBuffer::Slot::Slot()
+  : busy(0), valid(false), sequence(0)
+{
+}
+
+ctkLogRingBuffer::ctkLogRingBuffer(quint32 firstSequence)
+  : next(static_cast<int>(firstSequence))
+{
+}
+
+quint32 ctkLogRingBuffer::append(const ctkLogRecord& record)
+{
+  quint32 sequence = static_cast<quint32>(next.fetchAndAddOrdered(1));
+  Slot& slot = entries[sequence & (CAPACITY - 1)];
+  lock(slot);
+  // a thread which claimed its number CAPACITY records later may have been faster
+  if (!slot.valid || static_cast<qint32>(sequence - slot.sequence) > 0)
+  {
+    slot.record = record;
+    slot.sequence = sequence;
+    slot.valid = true;
+  }
+  unlock(slot);
+  return sequence;
+}
+
+bool ctkLogRingBuffer::read(quint32 sequence, ctkLogRecord& record, bool* overwritten) const
+{
+  Slot& slot = entries[sequence & (CAPACITY - 1)];
+  lock(slot);
+  bool found = slot.valid && slot.sequence == sequence;
+  if (found)
+  {
+    record = slot.record;
+  }
+  *overwritten = slot.valid && static_cast<qint32>(slot.sequence - sequence) > 0;
+  unlock(slot);
+  return found;
+}
+
+quint32 ctkLogRingBuffer::nextSequence() const
+{
+  return static_cast<quint32>(next.fetchAndAddAcquire(0));
+}
+
+void ctkLogRingBuffer::lock(Slot& slot)
+{
+  while (!slot.busy.testAndSetAcquire(0, 1))
+  {
+    QThread::yieldCurrentThread();
+  }
+}
+
+void ctkLogRingBuffer::unlock(Slot& slot)
+{
+  slot.busy.fetchAndStoreRelease(0);
+}
@@ -0,0 +1,113 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#ifndef CTKLOGRINGBUFFER_P_H
+#define CTKLOGRINGBUFFER_P_H
+
+#include <ctkServiceReference.h>
+
+#include <QAtomicInt>
+#include <QDateTime>
+#include <QSharedPointer>
+#include <QString>
+
+#include <org_commontk_log_Export.h>
+
+/**
+ * The data of a log entry as passed to the log service.
+ */
+struct org_commontk_log_EXPORT ctkLogRecord
+{
+  ctkLogRecord();
+
+  int level;
+  QDateTime time;
+  QString message;
+  QString exception;
+  /** Null unless the entry was logged for a service, a default constructed
+      ctkServiceReference would be allocated for every record */
+  QSharedPointer<const ctkServiceReference> reference;
+  const char* file;
+  const char* function;
+  int line;
+};
+
+/**
+ * ctkLogRingBuffer keeps the most recent CAPACITY log records, each appended
+ * record replacing the oldest one. Appended records are numbered consecutively,
+ * the numbers wrapping around after 2^32 records.
+ *
+ * There is no lock shared by all threads: an appending thread claims a sequence
+ * number with an atomic increment and each slot is guarded by its own spin flag,
+ * so threads only contend when accessing the same slot.
+ */
+class org_commontk_log_EXPORT ctkLogRingBuffer
+{
+
+public:
+
+  static const int CAPACITY = 1024; // must be a power of two
+
+  /**
+   * Creates an empty ring buffer numbering the appended records
+   * starting with <code>firstSequence</code>.
+   */
+  ctkLogRingBuffer(quint32 firstSequence = 0);
+
+  /**
+   * Appends a record and returns its sequence number.
+   */
+  quint32 append(const ctkLogRecord& record);
+
+  /**
+   * Copies the record with the given sequence number.
+   *
+   * @return <code>false</code> if the record was not written yet or was replaced,
+   *         <code>overwritten</code> is set in the latter case.
+   */
+  bool read(quint32 sequence, ctkLogRecord& record, bool* overwritten) const;
+
+  /**
+   * The sequence number of the next record to be appended.
+   */
+  quint32 nextSequence() const;
+
+private:
+
+  struct Slot
+  {
+    Slot();
+
+    QAtomicInt busy;
+    bool valid;
+    quint32 sequence;
+    ctkLogRecord record;
+  };
+
+  mutable Slot entries[CAPACITY];
+  mutable QAtomicInt next;
+
+  static void lock(Slot& slot);
+  static void unlock(Slot& slot);
+};
+
+#endif // CTKLOGRINGBUFFER_P_H